@@ -63,6 +63,7 @@ typedef const struct _cmsis_i2c_resource
 {
     I2C_Type *base;            /*!< I2C peripheral base address.      */
     uint32_t (*GetFreq)(void); /*!< Function to get the clock frequency. */
+    uint32_t irqPriority;      /*!< NVIC priority of the I2C interrupt. */
 
 } cmsis_i2c_resource_t;
 
@@ -78,6 +79,7 @@ typedef struct _cmsis_i2c_interrupt_driver_state
     cmsis_i2c_handle_t *handle;
     ARM_I2C_SignalEvent_t cb_event; /*!< Callback function.     */
     bool isInitialized;             /*!< Is initialized or not. */
+    bool isSlave;                   /*!< Last transfer was started in slave mode. */
 } cmsis_i2c_interrupt_driver_state_t;
 
 #if (defined(FSL_FEATURE_SOC_DMA_COUNT) && FSL_FEATURE_SOC_DMA_COUNT)
@@ -124,8 +126,15 @@ static const ARM_I2C_CAPABILITIES s_i2cDriverCapabilities = {
 };
 
 static const clock_ip_name_t s_i2cClocks[] = I2C_CLOCKS;
+static const IRQn_Type s_i2cIrqs[] = I2C_IRQS;
 extern uint32_t I2C_GetInstance(I2C_Type *base);
 
+/* Apply the RTE_Device.h priority so the bus interrupt ranks correctly against UART and DMA. */
+static void I2Cx_SetIrqPriority(cmsis_i2c_resource_t *resource)
+{
+    NVIC_SetPriority(s_i2cIrqs[I2C_GetInstance(resource->base)], resource->irqPriority);
+}
+
 static ARM_DRIVER_VERSION I2Cx_GetVersion(void)
 {
     return s_i2cDriverVersion;
@@ -163,14 +172,22 @@ void KSDK_I2C_MASTER_DmaCallback(I2C_Type *base, i2c_master_dma_handle_t *handle
 
 static int32_t I2C_Master_DmaInitialize(ARM_I2C_SignalEvent_t cb_event, cmsis_i2c_dma_driver_state_t *i2c)
 {
+    dmamgr_channel_config_t config;
+
     if (!(i2c->isInitialized))
     {
-        /* Configure DMAMUX channel */
-        DMAMUX_SetSource(i2c->dmaResource->i2cDmamuxBase, i2c->dmaResource->i2cDmaChannel,
-                         (uint8_t)i2c->dmaResource->i2cDmaRequest);
-        DMAMUX_EnableChannel(i2c->dmaResource->i2cDmamuxBase, i2c->dmaResource->i2cDmaChannel);
-        /* Creat dmahandle  */
-        DMA_CreateHandle(i2c->dmaHandle, i2c->dmaResource->i2cDmaBase, i2c->dmaResource->i2cDmaChannel);
+        /* Take the channel from the DMA manager, which also creates the dmahandle */
+        DMAMGR_GetDefaultChannelConfig(&config);
+        config.requestSource = i2c->dmaResource->i2cDmaRequest;
+        config.channel = i2c->dmaResource->i2cDmaChannel;
+        config.priority = kDMAMGR_PriorityHigh;
+        if (kStatus_Success != DMAMGR_RequestChannel(i2c->dmaHandle, &config))
+        {
+            return ARM_DRIVER_ERROR;
+        }
+        /* The DMA completion drives the I2C state machine, so it shares the I2C priority. */
+        I2Cx_SetIrqPriority(i2c->resource);
+        NVIC_SetPriority((IRQn_Type)(DMA0_IRQn + i2c->dmaHandle->channel), i2c->resource->irqPriority);
         /* Create master_dma_handle. */
         I2C_MasterTransferCreateHandleDMA(i2c->resource->base, i2c->master_dma_handle, KSDK_I2C_MASTER_DmaCallback,
                                           (void *)cb_event, i2c->dmaHandle);
@@ -181,6 +198,10 @@ static int32_t I2C_Master_DmaInitialize(ARM_I2C_SignalEvent_t cb_event, cmsis_i2
 
 int32_t I2C_Master_DmaUninitialize(cmsis_i2c_dma_driver_state_t *i2c)
 {
+    if (i2c->isInitialized)
+    {
+        DMAMGR_ReleaseChannel(i2c->dmaHandle);
+    }
     i2c->isInitialized = false;
     return ARM_DRIVER_OK;
 }
@@ -378,11 +399,10 @@ int32_t I2C_Master_DmaPowerControl(ARM_POWER_STATE state, cmsis_i2c_dma_driver_s
 {
     switch (state)
     {
-        /* Terminates any pending data transfers, disable i2c moduole and i2c clock and related dma */
+        /* Terminates any pending data transfers, disable i2c moduole and i2c clock, the dma channel is kept until uninitialize */
         case ARM_POWER_OFF:
             I2C_Master_DmaControl(ARM_I2C_ABORT_TRANSFER, 0, i2c);
             I2C_MasterDeinit(i2c->resource->base);
-            DMAMUX_DisableChannel(i2c->dmaResource->i2cDmamuxBase, i2c->dmaResource->i2cDmaChannel);
             return ARM_DRIVER_OK;
 
         /* Not supported */
@@ -728,6 +748,12 @@ static void KSDK_I2C_SLAVE_InterruptCallback(I2C_Type *base, i2c_slave_transfer_
             event = ARM_I2C_EVENT_GENERAL_CALL;
             break;
 
+        case kI2C_SlaveReceiveEvent:
+            /* Receive buffer is exhausted: NAK the following bytes so an oversized write is cut
+             * short by the master instead of costing one interrupt per discarded byte. */
+            base->C1 |= I2C_C1_TXAK_MASK;
+            return;
+
         default:
             event = ARM_I2C_EVENT_TRANSFER_INCOMPLETE;
             break;
@@ -773,6 +799,7 @@ static void KSDK_I2C_MASTER_InterruptCallback(I2C_Type *base,
 
 static int32_t I2C_InterruptInitialize(ARM_I2C_SignalEvent_t cb_event, cmsis_i2c_interrupt_driver_state_t *i2c)
 {
+    I2Cx_SetIrqPriority(i2c->resource);
     i2c->cb_event = cb_event; /* cb_event is CMSIS driver callback. */
     return ARM_DRIVER_OK;
 }
@@ -799,6 +826,7 @@ int32_t I2C_Master_InterruptTransmit(
     /* Create master_handle */
     I2C_MasterTransferCreateHandle(i2c->resource->base, &(i2c->handle->master_handle),
                                    KSDK_I2C_MASTER_InterruptCallback, (void *)i2c->cb_event);
+    i2c->isSlave = false;
 
     masterXfer.slaveAddress = addr;              /*7-bit slave address.*/
     masterXfer.direction = kI2C_Write;           /* Transfer direction.*/
@@ -858,6 +886,7 @@ int32_t I2C_Master_InterruptReceive(
     /* Create master_handle */
     I2C_MasterTransferCreateHandle(i2c->resource->base, &(i2c->handle->master_handle),
                                    KSDK_I2C_MASTER_InterruptCallback, (void *)i2c->cb_event);
+    i2c->isSlave = false;
 
     masterXfer.slaveAddress = addr;              /*7-bit slave address.*/
     masterXfer.direction = kI2C_Read;            /* Transfer direction.*/
@@ -905,11 +934,15 @@ int32_t I2C_Slave_InterruptTransmit(const uint8_t *data, uint32_t num, cmsis_i2c
 {
     int32_t status;
     int32_t ret;
+    uint32_t primask;
 
     /* Create slave_handle */
     I2C_SlaveTransferCreateHandle(i2c->resource->base, &(i2c->handle->slave_handle), KSDK_I2C_SLAVE_InterruptCallback,
                                   (void *)i2c->cb_event);
+    i2c->isSlave = true;
 
+    /* The buffer must be in place before the first address match can be serviced. */
+    primask = DisableGlobalIRQ();
     status = I2C_SlaveTransferNonBlocking(i2c->resource->base, &(i2c->handle->slave_handle), kI2C_SlaveCompletionEvent);
 
     i2c->handle->slave_handle.transfer.data =
@@ -917,6 +950,7 @@ int32_t I2C_Slave_InterruptTransmit(const uint8_t *data, uint32_t num, cmsis_i2c
     i2c->handle->slave_handle.transfer.dataSize = num; /* Number of data bytes to transmit */
     i2c->handle->slave_handle.transfer.transferredCount =
         0; /* Number of bytes actually transferred since start or last repeated start. */
+    EnableGlobalIRQ(primask);
 
     switch (status)
     {
@@ -939,19 +973,24 @@ int32_t I2C_Slave_InterruptReceive(uint8_t *data, uint32_t num, cmsis_i2c_interr
 {
     int32_t status;
     int32_t ret;
+    uint32_t primask;
 
     i2c->resource->base->C2 = I2C_C2_GCAEN(1); /* Enable general call */
 
     /* Create slave_handle */
     I2C_SlaveTransferCreateHandle(i2c->resource->base, &(i2c->handle->slave_handle), KSDK_I2C_SLAVE_InterruptCallback,
                                   (void *)i2c->cb_event);
+    i2c->isSlave = true;
 
+    /* The buffer must be in place before the first address match can be serviced. */
+    primask = DisableGlobalIRQ();
     status = I2C_SlaveTransferNonBlocking(i2c->resource->base, &(i2c->handle->slave_handle), kI2C_SlaveCompletionEvent);
 
     i2c->handle->slave_handle.transfer.data = data;    /* Pointer to buffer with data to transmit to I2C Master */
     i2c->handle->slave_handle.transfer.dataSize = num; /* Number of data bytes to transmit */
     i2c->handle->slave_handle.transfer.transferredCount =
         0; /* Number of bytes actually transferred since start or last repeated start. */
+    EnableGlobalIRQ(primask);
 
     switch (status)
     {
@@ -974,13 +1013,14 @@ int32_t I2C_InterruptGetDataCount(cmsis_i2c_interrupt_driver_state_t *i2c)
 {
     uint32_t cnt; /* The number of currently transferred data bytes */
 
-    if (i2c->handle->slave_handle.transfer.transferredCount)
+    /* Master and slave handles share storage, so only read the one that was last started. */
+    if (i2c->isSlave)
     {
         cnt = i2c->handle->slave_handle.transfer.transferredCount;
     }
     else
     {
-        cnt = &(i2c->handle->master_handle).transferSize - &(i2c->handle->master_handle).transfer.dataSize;
+        cnt = i2c->handle->master_handle.transferSize - i2c->handle->master_handle.transfer.dataSize;
     }
 
     return cnt;
@@ -1121,7 +1161,7 @@ extern uint32_t I2C0_GetFreq(void);
 extern void I2C0_InitPins(void);
 extern void I2C0_DeinitPins(void);
 
-cmsis_i2c_resource_t I2C0_Resource = {I2C0, I2C0_GetFreq};
+cmsis_i2c_resource_t I2C0_Resource = {I2C0, I2C0_GetFreq, RTE_I2C0_IRQ_PRIORITY};
 
 #if RTE_I2C0_DMA_EN
 
@@ -1344,7 +1384,7 @@ extern uint32_t I2C1_GetFreq(void);
 extern void I2C1_InitPins(void);
 extern void I2C1_DeinitPins(void);
 
-cmsis_i2c_resource_t I2C1_Resource = {I2C1, I2C1_GetFreq};
+cmsis_i2c_resource_t I2C1_Resource = {I2C1, I2C1_GetFreq, RTE_I2C1_IRQ_PRIORITY};
 
 #if RTE_I2C1_DMA_EN
 
@@ -1566,7 +1606,7 @@ extern uint32_t I2C2_GetFreq(void);
 extern void I2C2_InitPins(void);
 extern void I2C2_DeinitPins(void);
 
-cmsis_i2c_resource_t I2C2_Resource = {I2C2, I2C2_GetFreq};
+cmsis_i2c_resource_t I2C2_Resource = {I2C2, I2C2_GetFreq, RTE_I2C2_IRQ_PRIORITY};
 
 #if RTE_I2C2_DMA_EN
 
@@ -1789,7 +1829,7 @@ extern uint32_t I2C3_GetFreq(void);
 extern void I2C3_InitPins(void);
 extern void I2C3_DeinitPins(void);
 
-cmsis_i2c_resource_t I2C3_Resource = {I2C3, I2C3_GetFreq};
+cmsis_i2c_resource_t I2C3_Resource = {I2C3, I2C3_GetFreq, RTE_I2C3_IRQ_PRIORITY};
 
 #if RTE_I2C3_DMA_EN
 
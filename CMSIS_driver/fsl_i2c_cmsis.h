@@ -54,12 +54,27 @@
 #include "fsl_dmamux.h"
 #endif
 #if (defined(FSL_FEATURE_SOC_DMA_COUNT) && FSL_FEATURE_SOC_DMA_COUNT)
+#include "fsl_dma_manager.h"
 #include "fsl_i2c_dma.h"
 #endif
 #if (defined(FSL_FEATURE_SOC_EDMA_COUNT) && FSL_FEATURE_SOC_EDMA_COUNT)
 #include "fsl_i2c_edma.h"
 #endif
 
+/* Default interrupt priorities when RTE_Device.h does not rank the instances. */
+#ifndef RTE_I2C0_IRQ_PRIORITY
+#define RTE_I2C0_IRQ_PRIORITY 0
+#endif
+#ifndef RTE_I2C1_IRQ_PRIORITY
+#define RTE_I2C1_IRQ_PRIORITY 0
+#endif
+#ifndef RTE_I2C2_IRQ_PRIORITY
+#define RTE_I2C2_IRQ_PRIORITY 0
+#endif
+#ifndef RTE_I2C3_IRQ_PRIORITY
+#define RTE_I2C3_IRQ_PRIORITY 0
+#endif
+
 #if defined(I2C0)
 extern ARM_DRIVER_I2C Driver_I2C0;
 #endif
@@ -0,0 +1,1035 @@
+/*
+ * Copyright (c) 2013-2016 ARM Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+
+ * Copyright (c) 2016, Freescale Semiconductor, Inc.
+ * Copyright 2016-2017 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fsl_spi_cmsis.h"
+
+#if ((RTE_SPI0 && defined(SPI0)) || (RTE_SPI1 && defined(SPI1)))
+
+#define ARM_SPI_DRV_VERSION ARM_DRIVER_VERSION_MAJOR_MINOR(2, 0)
+
+/*
+ * ARMCC does not support split the data section automatically, so the driver
+ * needs to split the data to separate sections explicitly, to reduce codesize.
+ */
+#if defined(__CC_ARM)
+#define ARMCC_SECTION(section_name) __attribute__((section(section_name)))
+#endif
+
+/* Driver state flags. */
+enum _spi_driver_flags
+{
+    kSPI_FlagInit = (1U << 0),       /*!< Initialize has been called. */
+    kSPI_FlagPower = (1U << 1),      /*!< Powered on by PowerControl. */
+    kSPI_FlagConfigured = (1U << 2), /*!< Mode set by Control, the module is enabled. */
+    kSPI_FlagMaster = (1U << 3),     /*!< Configured as master, slave otherwise. */
+};
+
+/* Busy state of the fsl_spi handles, the enum is private to the driver. */
+#define SPI_TRANSFER_BUSY 1U
+
+typedef const struct _cmsis_spi_resource
+{
+    SPI_Type *base;            /*!< SPI peripheral base address. */
+    uint32_t (*GetFreq)(void); /*!< Function to get the clock frequency. */
+    uint32_t irqPriority;      /*!< NVIC priority of the SPI and DMA interrupts. */
+} cmsis_spi_resource_t;
+
+#if (defined(FSL_FEATURE_SOC_DMA_COUNT) && FSL_FEATURE_SOC_DMA_COUNT)
+typedef const struct _cmsis_spi_dma_resource
+{
+    DMA_Type *txDmaBase;       /*!< DMA peripheral base address for TX. */
+    uint32_t txDmaChannel;     /*!< DMA channel for TX. */
+    DMAMUX_Type *txDmamuxBase; /*!< DMAMUX peripheral base address for TX. */
+    uint16_t txDmaRequest;     /*!< TX DMA request source. */
+    DMA_Type *rxDmaBase;       /*!< DMA peripheral base address for RX. */
+    uint32_t rxDmaChannel;     /*!< DMA channel for RX. */
+    DMAMUX_Type *rxDmamuxBase; /*!< DMAMUX peripheral base address for RX. */
+    uint16_t rxDmaRequest;     /*!< RX DMA request source. */
+} cmsis_spi_dma_resource_t;
+
+/* Take both DMA channels from the DMA manager; their completion interrupts share the peripheral priority. */
+static status_t SPI_DmaSetup(cmsis_spi_dma_resource_t *dmaResource,
+                           dma_handle_t *txHandle,
+                           dma_handle_t *rxHandle,
+                           uint32_t irqPriority)
+{
+    dmamgr_channel_config_t config;
+    status_t status;
+
+    DMAMGR_GetDefaultChannelConfig(&config);
+    /* A slave cannot stall its master, take the channels that win arbitration */
+    config.priority = kDMAMGR_PriorityHigh;
+
+    config.requestSource = dmaResource->txDmaRequest;
+    config.channel = dmaResource->txDmaChannel;
+    status = DMAMGR_RequestChannel(txHandle, &config);
+    if (kStatus_Success != status)
+    {
+        return status;
+    }
+
+    config.requestSource = dmaResource->rxDmaRequest;
+    config.channel = dmaResource->rxDmaChannel;
+    status = DMAMGR_RequestChannel(rxHandle, &config);
+    if (kStatus_Success != status)
+    {
+        DMAMGR_ReleaseChannel(txHandle);
+        return status;
+    }
+
+    NVIC_SetPriority((IRQn_Type)(DMA0_IRQn + txHandle->channel), irqPriority);
+    NVIC_SetPriority((IRQn_Type)(DMA0_IRQn + rxHandle->channel), irqPriority);
+
+    return kStatus_Success;
+}
+
+static void SPI_DmaTeardown(dma_handle_t *txHandle, dma_handle_t *rxHandle)
+{
+    DMAMGR_ReleaseChannel(txHandle);
+    DMAMGR_ReleaseChannel(rxHandle);
+}
+#endif
+
+static const IRQn_Type s_spiIrqs[] = SPI_IRQS;
+extern uint32_t SPI_GetInstance(SPI_Type *base);
+
+static const ARM_DRIVER_VERSION s_spiDriverVersion = {ARM_SPI_API_VERSION, ARM_SPI_DRV_VERSION};
+
+static const ARM_SPI_CAPABILITIES s_spiDriverCapabilities = {
+    0, /* Simplex Mode (Master and Slave) */
+    0, /* TI Synchronous Serial Interface */
+    0, /* Microwire Interface */
+    1, /* Signal Mode Fault event: \\ref ARM_SPI_EVENT_MODE_FAULT */
+};
+
+static ARM_DRIVER_VERSION SPIx_GetVersion(void)
+{
+    return s_spiDriverVersion;
+}
+
+static ARM_SPI_CAPABILITIES SPIx_GetCapabilities(void)
+{
+    return s_spiDriverCapabilities;
+}
+
+/* Bytes in one data item, items are uint16_t in 16-bit mode. */
+static uint32_t SPI_GetBytesPerFrame(cmsis_spi_resource_t *resource)
+{
+    return (resource->base->C2 & SPI_C2_SPIMODE_MASK) ? 2U : 1U;
+}
+
+/* Decode the frame format, bit count and bit order shared by ARM_SPI_MODE_MASTER and ARM_SPI_MODE_SLAVE. */
+static int32_t SPI_GetFrameFormat(uint32_t control,
+                                  spi_clock_polarity_t *polarity,
+                                  spi_clock_phase_t *phase,
+                                  spi_data_bitcount_mode_t *dataMode,
+                                  spi_shift_direction_t *direction)
+{
+    switch (control & ARM_SPI_FRAME_FORMAT_Msk)
+    {
+        case ARM_SPI_CPOL0_CPHA0:
+            *polarity = kSPI_ClockPolarityActiveHigh;
+            *phase = kSPI_ClockPhaseFirstEdge;
+            break;
+        case ARM_SPI_CPOL0_CPHA1:
+            *polarity = kSPI_ClockPolarityActiveHigh;
+            *phase = kSPI_ClockPhaseSecondEdge;
+            break;
+        case ARM_SPI_CPOL1_CPHA0:
+            *polarity = kSPI_ClockPolarityActiveLow;
+            *phase = kSPI_ClockPhaseFirstEdge;
+            break;
+        case ARM_SPI_CPOL1_CPHA1:
+            *polarity = kSPI_ClockPolarityActiveLow;
+            *phase = kSPI_ClockPhaseSecondEdge;
+            break;
+        default:
+            return ARM_SPI_ERROR_FRAME_FORMAT;
+    }
+
+    switch (control & ARM_SPI_DATA_BITS_Msk)
+    {
+        case ARM_SPI_DATA_BITS(8):
+            *dataMode = kSPI_8BitMode;
+            break;
+        case ARM_SPI_DATA_BITS(16):
+            *dataMode = kSPI_16BitMode;
+            break;
+        default:
+            return ARM_SPI_ERROR_DATA_BITS;
+    }
+
+    *direction = ((control & ARM_SPI_BIT_ORDER_Msk) == ARM_SPI_LSB_MSB) ? kSPI_LsbFirst : kSPI_MsbFirst;
+
+    return ARM_DRIVER_OK;
+}
+
+/*
+ * Register-level controls shared by the interrupt and DMA variants. A mode change re-initializes
+ * the module, the caller creates the transfer handle for the new role afterwards.
+ */
+static int32_t SPI_CommonControl(
+    uint32_t control, uint32_t arg, cmsis_spi_resource_t *resource, uint8_t *txValue, uint8_t *flags)
+{
+    spi_master_config_t masterConfig;
+    spi_slave_config_t slaveConfig;
+    int32_t result;
+
+    if (!(*flags & kSPI_FlagPower))
+    {
+        return ARM_DRIVER_ERROR;
+    }
+
+    switch (control & ARM_SPI_CONTROL_Msk)
+    {
+        case ARM_SPI_MODE_INACTIVE:
+            if (*flags & kSPI_FlagConfigured)
+            {
+                SPI_Enable(resource->base, false);
+            }
+            *flags &= (uint8_t)~(kSPI_FlagConfigured | kSPI_FlagMaster);
+            return ARM_DRIVER_OK;
+
+        case ARM_SPI_MODE_MASTER:
+            SPI_MasterGetDefaultConfig(&masterConfig);
+            result = SPI_GetFrameFormat(control, &masterConfig.polarity, &masterConfig.phase, &masterConfig.dataMode,
+                                        &masterConfig.direction);
+            if (ARM_DRIVER_OK != result)
+            {
+                return result;
+            }
+            switch (control & ARM_SPI_SS_MASTER_MODE_Msk)
+            {
+                case ARM_SPI_SS_MASTER_UNUSED:
+                    masterConfig.outputMode = kSPI_SlaveSelectAsGpio;
+                    break;
+                case ARM_SPI_SS_MASTER_HW_OUTPUT:
+                    masterConfig.outputMode = kSPI_SlaveSelectAutomaticOutput;
+                    break;
+                case ARM_SPI_SS_MASTER_HW_INPUT:
+                    masterConfig.outputMode = kSPI_SlaveSelectFaultInput;
+                    break;
+                default:
+                    /* ARM_SPI_SS_MASTER_SW, there is no GPIO for ARM_SPI_CONTROL_SS to drive */
+                    return ARM_SPI_ERROR_SS_MODE;
+            }
+            masterConfig.baudRate_Bps = arg;
+            SPI_MasterInit(resource->base, &masterConfig, resource->GetFreq());
+            SPI_SetDummyData(resource->base, *txValue);
+            *flags |= (kSPI_FlagConfigured | kSPI_FlagMaster);
+            return ARM_DRIVER_OK;
+
+        case ARM_SPI_MODE_SLAVE:
+            SPI_SlaveGetDefaultConfig(&slaveConfig);
+            result = SPI_GetFrameFormat(control, &slaveConfig.polarity, &slaveConfig.phase, &slaveConfig.dataMode,
+                                        &slaveConfig.direction);
+            if (ARM_DRIVER_OK != result)
+            {
+                return result;
+            }
+            /* The slave select input is always hardware monitored */
+            if ((control & ARM_SPI_SS_SLAVE_MODE_Msk) != ARM_SPI_SS_SLAVE_HW)
+            {
+                return ARM_SPI_ERROR_SS_MODE;
+            }
+            SPI_SlaveInit(resource->base, &slaveConfig);
+            SPI_SetDummyData(resource->base, *txValue);
+            *flags = (uint8_t)((*flags | kSPI_FlagConfigured) & ~kSPI_FlagMaster);
+            return ARM_DRIVER_OK;
+
+        case ARM_SPI_SET_BUS_SPEED:
+            if (!(*flags & kSPI_FlagMaster))
+            {
+                return ARM_DRIVER_ERROR_UNSUPPORTED;
+            }
+            SPI_MasterSetBaudRate(resource->base, arg, resource->GetFreq());
+            return ARM_DRIVER_OK;
+
+        case ARM_SPI_GET_BUS_SPEED:
+            if (!(*flags & kSPI_FlagMaster))
+            {
+                return ARM_DRIVER_ERROR_UNSUPPORTED;
+            }
+            return (int32_t)SPI_MasterGetBaudRate(resource->base, resource->GetFreq());
+
+        case ARM_SPI_SET_DEFAULT_TX_VALUE:
+            /* Kept across mode changes, SPI_MasterInit and SPI_SlaveInit reset the dummy byte */
+            *txValue = (uint8_t)arg;
+            if (*flags & kSPI_FlagConfigured)
+            {
+                SPI_SetDummyData(resource->base, *txValue);
+            }
+            return ARM_DRIVER_OK;
+
+        default:
+            /* ARM_SPI_CONTROL_SS and the simplex, TI and Microwire modes */
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+}
+
+static void SPI_CommonPowerUp(cmsis_spi_resource_t *resource)
+{
+    /* The module clock is enabled by the mode change, SPI_MasterInit or SPI_SlaveInit */
+    NVIC_SetPriority(s_spiIrqs[SPI_GetInstance(resource->base)], resource->irqPriority);
+}
+
+static int32_t SPI_StatusToDriverError(status_t status)
+{
+    switch (status)
+    {
+        case kStatus_Success:
+            return ARM_DRIVER_OK;
+        case kStatus_SPI_Busy:
+            return ARM_DRIVER_ERROR_BUSY;
+        case kStatus_InvalidArgument:
+            return ARM_DRIVER_ERROR_PARAMETER;
+        default:
+            return ARM_DRIVER_ERROR;
+    }
+}
+
+#if ((RTE_SPI0 && RTE_SPI0_DMA_EN) || (RTE_SPI1 && RTE_SPI1_DMA_EN))
+
+#if (defined(FSL_FEATURE_SOC_DMA_COUNT) && FSL_FEATURE_SOC_DMA_COUNT)
+typedef struct _cmsis_spi_dma_driver_state
+{
+    cmsis_spi_resource_t *resource;        /*!< Basic SPI resource. */
+    cmsis_spi_dma_resource_t *dmaResource; /*!< SPI DMA resource. */
+    spi_dma_handle_t *handle;              /*!< SPI DMA transfer handle. */
+    dma_handle_t *txHandle;                /*!< DMA TX handle. */
+    dma_handle_t *rxHandle;                /*!< DMA RX handle. */
+    ARM_SPI_SignalEvent_t cb_event;        /*!< Callback function. */
+    uint32_t count;                        /*!< Bytes moved by the last finished or aborted transfer. */
+    uint8_t txValue;                       /*!< Frame sent when there is no TX data. */
+    uint8_t flags;                         /*!< Driver state flags. */
+} cmsis_spi_dma_driver_state_t;
+
+static void KSDK_SPI_DmaCallback(SPI_Type *base, spi_dma_handle_t *handle, status_t status, void *userData)
+{
+    cmsis_spi_dma_driver_state_t *spi = (cmsis_spi_dma_driver_state_t *)userData;
+
+    if (kStatus_Success != status)
+    {
+        return;
+    }
+
+    spi->count = handle->transferSize;
+
+    if (spi->cb_event)
+    {
+        spi->cb_event(ARM_SPI_EVENT_TRANSFER_COMPLETE);
+    }
+}
+
+static int32_t SPI_DmaInitialize(ARM_SPI_SignalEvent_t cb_event, cmsis_spi_dma_driver_state_t *spi)
+{
+    if (!(spi->flags & kSPI_FlagInit))
+    {
+        spi->cb_event = cb_event;
+        spi->txValue = SPI_DUMMYDATA;
+        spi->flags = kSPI_FlagInit;
+    }
+    return ARM_DRIVER_OK;
+}
+
+static int32_t SPI_DmaUninitialize(cmsis_spi_dma_driver_state_t *spi)
+{
+    spi->flags = 0U;
+    return ARM_DRIVER_OK;
+}
+
+static int32_t SPI_DmaTransfer(const void *data_out, void *data_in, uint32_t num, cmsis_spi_dma_driver_state_t *spi)
+{
+    spi_transfer_t xfer;
+
+    if (!(spi->flags & kSPI_FlagConfigured))
+    {
+        return ARM_DRIVER_ERROR;
+    }
+
+    xfer.txData = (uint8_t *)data_out;
+    xfer.rxData = (uint8_t *)data_in;
+    xfer.dataSize = num * SPI_GetBytesPerFrame(spi->resource);
+    xfer.flags = 0U;
+
+    if (spi->flags & kSPI_FlagMaster)
+    {
+        return SPI_StatusToDriverError(SPI_MasterTransferDMA(spi->resource->base, spi->handle, &xfer));
+    }
+    return SPI_StatusToDriverError(SPI_SlaveTransferDMA(spi->resource->base, spi->handle, &xfer));
+}
+
+static uint32_t SPI_DmaGetDataCount(cmsis_spi_dma_driver_state_t *spi)
+{
+    size_t cnt;
+
+    if (kStatus_Success != SPI_MasterTransferGetCountDMA(spi->resource->base, spi->handle, &cnt))
+    {
+        cnt = spi->count;
+    }
+    return (uint32_t)cnt / SPI_GetBytesPerFrame(spi->resource);
+}
+
+static int32_t SPI_DmaControl(uint32_t control, uint32_t arg, cmsis_spi_dma_driver_state_t *spi)
+{
+    size_t cnt;
+    int32_t result;
+
+    switch (control & ARM_SPI_CONTROL_Msk)
+    {
+        case ARM_SPI_ABORT_TRANSFER:
+            if (kStatus_Success == SPI_MasterTransferGetCountDMA(spi->resource->base, spi->handle, &cnt))
+            {
+                spi->count = cnt;
+                SPI_MasterTransferAbortDMA(spi->resource->base, spi->handle);
+            }
+            return ARM_DRIVER_OK;
+
+        case ARM_SPI_MODE_INACTIVE:
+        case ARM_SPI_MODE_MASTER:
+        case ARM_SPI_MODE_SLAVE:
+            if (spi->handle->state == SPI_TRANSFER_BUSY)
+            {
+                return ARM_DRIVER_ERROR_BUSY;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    result = SPI_CommonControl(control, arg, spi->resource, &spi->txValue, &spi->flags);
+
+    /* Both roles share one DMA handle layout, it only needs the new frame size */
+    if ((ARM_DRIVER_OK == result) && (spi->flags & kSPI_FlagConfigured) &&
+        (((control & ARM_SPI_CONTROL_Msk) == ARM_SPI_MODE_MASTER) ||
+         ((control & ARM_SPI_CONTROL_Msk) == ARM_SPI_MODE_SLAVE)))
+    {
+        SPI_MasterTransferCreateHandleDMA(spi->resource->base, spi->handle, KSDK_SPI_DmaCallback, spi, spi->txHandle,
+                                          spi->rxHandle);
+    }
+
+    return result;
+}
+
+static int32_t SPI_DmaPowerControl(ARM_POWER_STATE state, cmsis_spi_dma_driver_state_t *spi)
+{
+    switch (state)
+    {
+        /* Terminates any pending transfer, disables the SPI with its clock and the DMA routing */
+        case ARM_POWER_OFF:
+            if (spi->flags & kSPI_FlagPower)
+            {
+                if (spi->flags & kSPI_FlagConfigured)
+                {
+                    SPI_DmaControl(ARM_SPI_ABORT_TRANSFER, 0U, spi);
+                    SPI_Deinit(spi->resource->base);
+                }
+                SPI_DmaTeardown(spi->txHandle, spi->rxHandle);
+                spi->flags = kSPI_FlagInit;
+            }
+            return ARM_DRIVER_OK;
+
+        /* Not supported */
+        case ARM_POWER_LOW:
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+
+        case ARM_POWER_FULL:
+            if (!(spi->flags & kSPI_FlagInit))
+            {
+                return ARM_DRIVER_ERROR;
+            }
+            if (!(spi->flags & kSPI_FlagPower))
+            {
+                if (kStatus_Success !=
+                    SPI_DmaSetup(spi->dmaResource, spi->txHandle, spi->rxHandle, spi->resource->irqPriority))
+                {
+                    return ARM_DRIVER_ERROR;
+                }
+                SPI_CommonPowerUp(spi->resource);
+                spi->flags |= kSPI_FlagPower;
+            }
+            return ARM_DRIVER_OK;
+
+        default:
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+}
+
+static ARM_SPI_STATUS SPI_DmaGetStatus(cmsis_spi_dma_driver_state_t *spi)
+{
+    ARM_SPI_STATUS stat = {0};
+
+    /* Without the SPI interrupt a mode fault is not observed, mode_fault stays clear */
+    stat.busy = (spi->handle->state == SPI_TRANSFER_BUSY);
+
+    return stat;
+}
+#endif
+
+#endif
+
+#if ((RTE_SPI0 && !RTE_SPI0_DMA_EN) || (RTE_SPI1 && !RTE_SPI1_DMA_EN))
+
+typedef struct _cmsis_spi_interrupt_driver_state
+{
+    cmsis_spi_resource_t *resource; /*!< Basic SPI resource. */
+    spi_master_handle_t *handle;    /*!< Interrupt transfer handle, the slave handle has the same layout. */
+    ARM_SPI_SignalEvent_t cb_event; /*!< Callback function. */
+    uint32_t count;                 /*!< Bytes moved by the last finished or aborted transfer. */
+    volatile bool modeFault;        /*!< Mode fault since the transfer started. */
+    uint8_t txValue;                /*!< Frame sent when there is no TX data. */
+    uint8_t flags;                  /*!< Driver state flags. */
+} cmsis_spi_interrupt_driver_state_t;
+
+static void KSDK_SPI_InterruptCallback(SPI_Type *base, spi_master_handle_t *handle, status_t status, void *userData)
+{
+    cmsis_spi_interrupt_driver_state_t *spi = (cmsis_spi_interrupt_driver_state_t *)userData;
+    uint32_t event;
+
+    switch (status)
+    {
+        case kStatus_Success:
+        case kStatus_SPI_Idle:
+            spi->count = handle->transferSize;
+            event = ARM_SPI_EVENT_TRANSFER_COMPLETE;
+            break;
+
+        case kStatus_SPI_Error:
+            spi->count = handle->transferSize - handle->rxRemainingBytes;
+            spi->modeFault = true;
+            event = ARM_SPI_EVENT_MODE_FAULT;
+            break;
+
+        default:
+            return;
+    }
+
+    if (spi->cb_event)
+    {
+        spi->cb_event(event);
+    }
+}
+
+static int32_t SPI_InterruptInitialize(ARM_SPI_SignalEvent_t cb_event, cmsis_spi_interrupt_driver_state_t *spi)
+{
+    if (!(spi->flags & kSPI_FlagInit))
+    {
+        spi->cb_event = cb_event;
+        spi->txValue = SPI_DUMMYDATA;
+        spi->flags = kSPI_FlagInit;
+    }
+    return ARM_DRIVER_OK;
+}
+
+static int32_t SPI_InterruptUninitialize(cmsis_spi_interrupt_driver_state_t *spi)
+{
+    spi->flags = 0U;
+    return ARM_DRIVER_OK;
+}
+
+static int32_t SPI_InterruptTransfer(const void *data_out,
+                                     void *data_in,
+                                     uint32_t num,
+                                     cmsis_spi_interrupt_driver_state_t *spi)
+{
+    spi_transfer_t xfer;
+    status_t status;
+
+    if (!(spi->flags & kSPI_FlagConfigured))
+    {
+        return ARM_DRIVER_ERROR;
+    }
+
+    xfer.txData = (uint8_t *)data_out;
+    xfer.rxData = (uint8_t *)data_in;
+    xfer.dataSize = num * SPI_GetBytesPerFrame(spi->resource);
+    xfer.flags = 0U;
+
+    if (spi->flags & kSPI_FlagMaster)
+    {
+        status = SPI_MasterTransferNonBlocking(spi->resource->base, spi->handle, &xfer);
+    }
+    else
+    {
+        status = SPI_SlaveTransferNonBlocking(spi->resource->base, spi->handle, &xfer);
+    }
+
+    if (kStatus_Success == status)
+    {
+        spi->modeFault = false;
+    }
+
+    return SPI_StatusToDriverError(status);
+}
+
+static uint32_t SPI_InterruptGetDataCount(cmsis_spi_interrupt_driver_state_t *spi)
+{
+    size_t cnt;
+
+    if (kStatus_Success != SPI_MasterTransferGetCount(spi->resource->base, spi->handle, &cnt))
+    {
+        cnt = spi->count;
+    }
+    return (uint32_t)cnt / SPI_GetBytesPerFrame(spi->resource);
+}
+
+static int32_t SPI_InterruptControl(uint32_t control, uint32_t arg, cmsis_spi_interrupt_driver_state_t *spi)
+{
+    size_t cnt;
+    int32_t result;
+
+    switch (control & ARM_SPI_CONTROL_Msk)
+    {
+        case ARM_SPI_ABORT_TRANSFER:
+            if (kStatus_Success == SPI_MasterTransferGetCount(spi->resource->base, spi->handle, &cnt))
+            {
+                spi->count = cnt;
+                SPI_MasterTransferAbort(spi->resource->base, spi->handle);
+            }
+            return ARM_DRIVER_OK;
+
+        case ARM_SPI_MODE_INACTIVE:
+        case ARM_SPI_MODE_MASTER:
+        case ARM_SPI_MODE_SLAVE:
+            if (spi->handle->state == SPI_TRANSFER_BUSY)
+            {
+                return ARM_DRIVER_ERROR_BUSY;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    result = SPI_CommonControl(control, arg, spi->resource, &spi->txValue, &spi->flags);
+
+    /* The handle binds the interrupt handler of the new role */
+    if (ARM_DRIVER_OK == result)
+    {
+        switch (control & ARM_SPI_CONTROL_Msk)
+        {
+            case ARM_SPI_MODE_MASTER:
+                SPI_MasterTransferCreateHandle(spi->resource->base, spi->handle, KSDK_SPI_InterruptCallback, spi);
+                break;
+
+            case ARM_SPI_MODE_SLAVE:
+                SPI_SlaveTransferCreateHandle(spi->resource->base, spi->handle, KSDK_SPI_InterruptCallback, spi);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return result;
+}
+
+static int32_t SPI_InterruptPowerControl(ARM_POWER_STATE state, cmsis_spi_interrupt_driver_state_t *spi)
+{
+    switch (state)
+    {
+        /* Terminates any pending transfer, disables the SPI and its clock */
+        case ARM_POWER_OFF:
+            if (spi->flags & kSPI_FlagPower)
+            {
+                if (spi->flags & kSPI_FlagConfigured)
+                {
+                    SPI_InterruptControl(ARM_SPI_ABORT_TRANSFER, 0U, spi);
+                    SPI_Deinit(spi->resource->base);
+                }
+                spi->flags = kSPI_FlagInit;
+            }
+            return ARM_DRIVER_OK;
+
+        /* Not supported */
+        case ARM_POWER_LOW:
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+
+        case ARM_POWER_FULL:
+            if (!(spi->flags & kSPI_FlagInit))
+            {
+                return ARM_DRIVER_ERROR;
+            }
+            if (!(spi->flags & kSPI_FlagPower))
+            {
+                SPI_CommonPowerUp(spi->resource);
+                spi->flags |= kSPI_FlagPower;
+            }
+            return ARM_DRIVER_OK;
+
+        default:
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+}
+
+static ARM_SPI_STATUS SPI_InterruptGetStatus(cmsis_spi_interrupt_driver_state_t *spi)
+{
+    ARM_SPI_STATUS stat = {0};
+
+    stat.busy = (spi->handle->state == SPI_TRANSFER_BUSY);
+    stat.mode_fault = spi->modeFault;
+
+    return stat;
+}
+
+#endif
+
+#endif
+
+#if defined(SPI0) && RTE_SPI0
+/* User needs to provide the implementation for SPI0_GetFreq/InitPins/DeinitPins
+in the application for enabling according instance. */
+extern uint32_t SPI0_GetFreq(void);
+extern void SPI0_InitPins(void);
+extern void SPI0_DeinitPins(void);
+
+cmsis_spi_resource_t SPI0_Resource = {SPI0, SPI0_GetFreq, RTE_SPI0_IRQ_PRIORITY};
+
+#if RTE_SPI0_DMA_EN
+
+#if (defined(FSL_FEATURE_SOC_DMA_COUNT) && FSL_FEATURE_SOC_DMA_COUNT)
+
+cmsis_spi_dma_resource_t SPI0_DmaResource = {
+    RTE_SPI0_DMA_TX_DMA_BASE, RTE_SPI0_DMA_TX_CH, RTE_SPI0_DMA_TX_DMAMUX_BASE, RTE_SPI0_DMA_TX_PERI_SEL,
+    RTE_SPI0_DMA_RX_DMA_BASE, RTE_SPI0_DMA_RX_CH, RTE_SPI0_DMA_RX_DMAMUX_BASE, RTE_SPI0_DMA_RX_PERI_SEL,
+};
+
+spi_dma_handle_t SPI0_DmaHandle;
+dma_handle_t SPI0_DmaTxHandle;
+dma_handle_t SPI0_DmaRxHandle;
+
+#if defined(__CC_ARM)
+ARMCC_SECTION("spi0_dma_driver_state")
+cmsis_spi_dma_driver_state_t SPI0_DmaDriverState = {
+#else
+cmsis_spi_dma_driver_state_t SPI0_DmaDriverState = {
+#endif
+    &SPI0_Resource, &SPI0_DmaResource, &SPI0_DmaHandle, &SPI0_DmaTxHandle, &SPI0_DmaRxHandle,
+};
+
+static int32_t SPI0_DmaInitialize(ARM_SPI_SignalEvent_t cb_event)
+{
+    SPI0_InitPins();
+    return SPI_DmaInitialize(cb_event, &SPI0_DmaDriverState);
+}
+
+static int32_t SPI0_DmaUninitialize(void)
+{
+    SPI0_DeinitPins();
+    return SPI_DmaUninitialize(&SPI0_DmaDriverState);
+}
+
+static int32_t SPI0_DmaPowerControl(ARM_POWER_STATE state)
+{
+    return SPI_DmaPowerControl(state, &SPI0_DmaDriverState);
+}
+
+static int32_t SPI0_DmaSend(const void *data, uint32_t num)
+{
+    return SPI_DmaTransfer(data, NULL, num, &SPI0_DmaDriverState);
+}
+
+static int32_t SPI0_DmaReceive(void *data, uint32_t num)
+{
+    return SPI_DmaTransfer(NULL, data, num, &SPI0_DmaDriverState);
+}
+
+static int32_t SPI0_DmaTransfer(const void *data_out, void *data_in, uint32_t num)
+{
+    return SPI_DmaTransfer(data_out, data_in, num, &SPI0_DmaDriverState);
+}
+
+static uint32_t SPI0_DmaGetDataCount(void)
+{
+    return SPI_DmaGetDataCount(&SPI0_DmaDriverState);
+}
+
+static int32_t SPI0_DmaControl(uint32_t control, uint32_t arg)
+{
+    return SPI_DmaControl(control, arg, &SPI0_DmaDriverState);
+}
+
+static ARM_SPI_STATUS SPI0_DmaGetStatus(void)
+{
+    return SPI_DmaGetStatus(&SPI0_DmaDriverState);
+}
+
+#endif
+
+#else
+
+spi_master_handle_t SPI0_Handle;
+
+#if defined(__CC_ARM)
+ARMCC_SECTION("spi0_interrupt_driver_state")
+cmsis_spi_interrupt_driver_state_t SPI0_InterruptDriverState = {
+#else
+cmsis_spi_interrupt_driver_state_t SPI0_InterruptDriverState = {
+#endif
+    &SPI0_Resource, &SPI0_Handle,
+};
+
+static int32_t SPI0_InterruptInitialize(ARM_SPI_SignalEvent_t cb_event)
+{
+    SPI0_InitPins();
+    return SPI_InterruptInitialize(cb_event, &SPI0_InterruptDriverState);
+}
+
+static int32_t SPI0_InterruptUninitialize(void)
+{
+    SPI0_DeinitPins();
+    return SPI_InterruptUninitialize(&SPI0_InterruptDriverState);
+}
+
+static int32_t SPI0_InterruptPowerControl(ARM_POWER_STATE state)
+{
+    return SPI_InterruptPowerControl(state, &SPI0_InterruptDriverState);
+}
+
+static int32_t SPI0_InterruptSend(const void *data, uint32_t num)
+{
+    return SPI_InterruptTransfer(data, NULL, num, &SPI0_InterruptDriverState);
+}
+
+static int32_t SPI0_InterruptReceive(void *data, uint32_t num)
+{
+    return SPI_InterruptTransfer(NULL, data, num, &SPI0_InterruptDriverState);
+}
+
+static int32_t SPI0_InterruptTransfer(const void *data_out, void *data_in, uint32_t num)
+{
+    return SPI_InterruptTransfer(data_out, data_in, num, &SPI0_InterruptDriverState);
+}
+
+static uint32_t SPI0_InterruptGetDataCount(void)
+{
+    return SPI_InterruptGetDataCount(&SPI0_InterruptDriverState);
+}
+
+static int32_t SPI0_InterruptControl(uint32_t control, uint32_t arg)
+{
+    return SPI_InterruptControl(control, arg, &SPI0_InterruptDriverState);
+}
+
+static ARM_SPI_STATUS SPI0_InterruptGetStatus(void)
+{
+    return SPI_InterruptGetStatus(&SPI0_InterruptDriverState);
+}
+
+#endif
+
+ARM_DRIVER_SPI Driver_SPI0 = {SPIx_GetVersion, SPIx_GetCapabilities,
+#if RTE_SPI0_DMA_EN
+                               SPI0_DmaInitialize, SPI0_DmaUninitialize, SPI0_DmaPowerControl, SPI0_DmaSend,
+                               SPI0_DmaReceive, SPI0_DmaTransfer, SPI0_DmaGetDataCount, SPI0_DmaControl,
+                               SPI0_DmaGetStatus
+#else
+                               SPI0_InterruptInitialize, SPI0_InterruptUninitialize,
+                               SPI0_InterruptPowerControl, SPI0_InterruptSend, SPI0_InterruptReceive,
+                               SPI0_InterruptTransfer, SPI0_InterruptGetDataCount, SPI0_InterruptControl,
+                               SPI0_InterruptGetStatus
+#endif
+};
+
+#endif
+
+#if defined(SPI1) && RTE_SPI1
+/* User needs to provide the implementation for SPI1_GetFreq/InitPins/DeinitPins
+in the application for enabling according instance. */
+extern uint32_t SPI1_GetFreq(void);
+extern void SPI1_InitPins(void);
+extern void SPI1_DeinitPins(void);
+
+cmsis_spi_resource_t SPI1_Resource = {SPI1, SPI1_GetFreq, RTE_SPI1_IRQ_PRIORITY};
+
+#if RTE_SPI1_DMA_EN
+
+#if (defined(FSL_FEATURE_SOC_DMA_COUNT) && FSL_FEATURE_SOC_DMA_COUNT)
+
+cmsis_spi_dma_resource_t SPI1_DmaResource = {
+    RTE_SPI1_DMA_TX_DMA_BASE, RTE_SPI1_DMA_TX_CH, RTE_SPI1_DMA_TX_DMAMUX_BASE, RTE_SPI1_DMA_TX_PERI_SEL,
+    RTE_SPI1_DMA_RX_DMA_BASE, RTE_SPI1_DMA_RX_CH, RTE_SPI1_DMA_RX_DMAMUX_BASE, RTE_SPI1_DMA_RX_PERI_SEL,
+};
+
+spi_dma_handle_t SPI1_DmaHandle;
+dma_handle_t SPI1_DmaTxHandle;
+dma_handle_t SPI1_DmaRxHandle;
+
+#if defined(__CC_ARM)
+ARMCC_SECTION("spi1_dma_driver_state")
+cmsis_spi_dma_driver_state_t SPI1_DmaDriverState = {
+#else
+cmsis_spi_dma_driver_state_t SPI1_DmaDriverState = {
+#endif
+    &SPI1_Resource, &SPI1_DmaResource, &SPI1_DmaHandle, &SPI1_DmaTxHandle, &SPI1_DmaRxHandle,
+};
+
+static int32_t SPI1_DmaInitialize(ARM_SPI_SignalEvent_t cb_event)
+{
+    SPI1_InitPins();
+    return SPI_DmaInitialize(cb_event, &SPI1_DmaDriverState);
+}
+
+static int32_t SPI1_DmaUninitialize(void)
+{
+    SPI1_DeinitPins();
+    return SPI_DmaUninitialize(&SPI1_DmaDriverState);
+}
+
+static int32_t SPI1_DmaPowerControl(ARM_POWER_STATE state)
+{
+    return SPI_DmaPowerControl(state, &SPI1_DmaDriverState);
+}
+
+static int32_t SPI1_DmaSend(const void *data, uint32_t num)
+{
+    return SPI_DmaTransfer(data, NULL, num, &SPI1_DmaDriverState);
+}
+
+static int32_t SPI1_DmaReceive(void *data, uint32_t num)
+{
+    return SPI_DmaTransfer(NULL, data, num, &SPI1_DmaDriverState);
+}
+
+static int32_t SPI1_DmaTransfer(const void *data_out, void *data_in, uint32_t num)
+{
+    return SPI_DmaTransfer(data_out, data_in, num, &SPI1_DmaDriverState);
+}
+
+static uint32_t SPI1_DmaGetDataCount(void)
+{
+    return SPI_DmaGetDataCount(&SPI1_DmaDriverState);
+}
+
+static int32_t SPI1_DmaControl(uint32_t control, uint32_t arg)
+{
+    return SPI_DmaControl(control, arg, &SPI1_DmaDriverState);
+}
+
+static ARM_SPI_STATUS SPI1_DmaGetStatus(void)
+{
+    return SPI_DmaGetStatus(&SPI1_DmaDriverState);
+}
+
+#endif
+
+#else
+
+spi_master_handle_t SPI1_Handle;
+
+#if defined(__CC_ARM)
+ARMCC_SECTION("spi1_interrupt_driver_state")
+cmsis_spi_interrupt_driver_state_t SPI1_InterruptDriverState = {
+#else
+cmsis_spi_interrupt_driver_state_t SPI1_InterruptDriverState = {
+#endif
+    &SPI1_Resource, &SPI1_Handle,
+};
+
+static int32_t SPI1_InterruptInitialize(ARM_SPI_SignalEvent_t cb_event)
+{
+    SPI1_InitPins();
+    return SPI_InterruptInitialize(cb_event, &SPI1_InterruptDriverState);
+}
+
+static int32_t SPI1_InterruptUninitialize(void)
+{
+    SPI1_DeinitPins();
+    return SPI_InterruptUninitialize(&SPI1_InterruptDriverState);
+}
+
+static int32_t SPI1_InterruptPowerControl(ARM_POWER_STATE state)
+{
+    return SPI_InterruptPowerControl(state, &SPI1_InterruptDriverState);
+}
+
+static int32_t SPI1_InterruptSend(const void *data, uint32_t num)
+{
+    return SPI_InterruptTransfer(data, NULL, num, &SPI1_InterruptDriverState);
+}
+
+static int32_t SPI1_InterruptReceive(void *data, uint32_t num)
+{
+    return SPI_InterruptTransfer(NULL, data, num, &SPI1_InterruptDriverState);
+}
+
+static int32_t SPI1_InterruptTransfer(const void *data_out, void *data_in, uint32_t num)
+{
+    return SPI_InterruptTransfer(data_out, data_in, num, &SPI1_InterruptDriverState);
+}
+
+static uint32_t SPI1_InterruptGetDataCount(void)
+{
+    return SPI_InterruptGetDataCount(&SPI1_InterruptDriverState);
+}
+
+static int32_t SPI1_InterruptControl(uint32_t control, uint32_t arg)
+{
+    return SPI_InterruptControl(control, arg, &SPI1_InterruptDriverState);
+}
+
+static ARM_SPI_STATUS SPI1_InterruptGetStatus(void)
+{
+    return SPI_InterruptGetStatus(&SPI1_InterruptDriverState);
+}
+
+#endif
+
+ARM_DRIVER_SPI Driver_SPI1 = {SPIx_GetVersion, SPIx_GetCapabilities,
+#if RTE_SPI1_DMA_EN
+                               SPI1_DmaInitialize, SPI1_DmaUninitialize, SPI1_DmaPowerControl, SPI1_DmaSend,
+                               SPI1_DmaReceive, SPI1_DmaTransfer, SPI1_DmaGetDataCount, SPI1_DmaControl,
+                               SPI1_DmaGetStatus
+#else
+                               SPI1_InterruptInitialize, SPI1_InterruptUninitialize,
+                               SPI1_InterruptPowerControl, SPI1_InterruptSend, SPI1_InterruptReceive,
+                               SPI1_InterruptTransfer, SPI1_InterruptGetDataCount, SPI1_InterruptControl,
+                               SPI1_InterruptGetStatus
+#endif
+};
+
+#endif
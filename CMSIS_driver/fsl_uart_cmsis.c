@@ -0,0 +1,1841 @@
+/*
+ * Copyright (c) 2013-2016 ARM Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+
+ * Copyright (c) 2016, Freescale Semiconductor, Inc.
+ * Copyright 2016-2017 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fsl_uart_cmsis.h"
+
+#if ((RTE_USART0 && defined(UART0)) || (RTE_USART1 && defined(UART1)) || (RTE_USART2 && defined(UART2)))
+
+#define ARM_USART_DRV_VERSION ARM_DRIVER_VERSION_MAJOR_MINOR(2, 0)
+
+/*
+ * ARMCC does not support split the data section automatically, so the driver
+ * needs to split the data to separate sections explicitly, to reduce codesize.
+ */
+#if defined(__CC_ARM)
+#define ARMCC_SECTION(section_name) __attribute__((section(section_name)))
+#endif
+
+/* Driver state flags. */
+enum _usart_driver_flags
+{
+    kUSART_FlagInit = (1U << 0),       /*!< Initialize has been called. */
+    kUSART_FlagPower = (1U << 1),      /*!< Powered on by PowerControl. */
+    kUSART_FlagConfigured = (1U << 2), /*!< Frame format and baud rate set by Control. */
+};
+
+/* Busy states of the fsl_lpsci/fsl_uart handles and their DMA handles, the enums are private to the drivers. */
+enum _usart_transfer_states
+{
+    kUSART_TxBusy = 1U, /*!< TX busy. */
+    kUSART_RxBusy = 3U, /*!< RX busy. */
+};
+
+/* Receive errors reported by GetStatus until the next receive starts. */
+#define USART_RX_ERROR_EVENTS \
+    (ARM_USART_EVENT_RX_OVERFLOW | ARM_USART_EVENT_RX_FRAMING_ERROR | ARM_USART_EVENT_RX_PARITY_ERROR)
+
+#if (defined(FSL_FEATURE_SOC_DMA_COUNT) && FSL_FEATURE_SOC_DMA_COUNT) && \
+    ((RTE_USART0 && RTE_USART0_DMA_EN) || (RTE_USART1 && RTE_USART1_DMA_EN) || (RTE_USART2 && RTE_USART2_DMA_EN))
+typedef const struct _cmsis_usart_dma_resource
+{
+    DMA_Type *txDmaBase;       /*!< DMA peripheral base address for TX. */
+    uint32_t txDmaChannel;     /*!< DMA channel for TX. */
+    DMAMUX_Type *txDmamuxBase; /*!< DMAMUX peripheral base address for TX. */
+    uint16_t txDmaRequest;     /*!< TX DMA request source. */
+    DMA_Type *rxDmaBase;       /*!< DMA peripheral base address for RX. */
+    uint32_t rxDmaChannel;     /*!< DMA channel for RX. */
+    DMAMUX_Type *rxDmamuxBase; /*!< DMAMUX peripheral base address for RX. */
+    uint16_t rxDmaRequest;     /*!< RX DMA request source. */
+} cmsis_usart_dma_resource_t;
+
+/* Take both DMA channels from the DMA manager; their completion interrupts share the peripheral priority. */
+static status_t USART_DmaSetup(cmsis_usart_dma_resource_t *dmaResource,
+                             dma_handle_t *txHandle,
+                             dma_handle_t *rxHandle,
+                             uint32_t irqPriority)
+{
+    dmamgr_channel_config_t config;
+    status_t status;
+
+    DMAMGR_GetDefaultChannelConfig(&config);
+    /* A late UART byte only costs latency, the lower channels win arbitration and go to the slaves */
+    config.priority = kDMAMGR_PriorityLow;
+
+    config.requestSource = dmaResource->txDmaRequest;
+    config.channel = dmaResource->txDmaChannel;
+    status = DMAMGR_RequestChannel(txHandle, &config);
+    if (kStatus_Success != status)
+    {
+        return status;
+    }
+
+    config.requestSource = dmaResource->rxDmaRequest;
+    config.channel = dmaResource->rxDmaChannel;
+    status = DMAMGR_RequestChannel(rxHandle, &config);
+    if (kStatus_Success != status)
+    {
+        DMAMGR_ReleaseChannel(txHandle);
+        return status;
+    }
+
+    NVIC_SetPriority((IRQn_Type)(DMA0_IRQn + txHandle->channel), irqPriority);
+    NVIC_SetPriority((IRQn_Type)(DMA0_IRQn + rxHandle->channel), irqPriority);
+
+    return kStatus_Success;
+}
+
+static void USART_DmaTeardown(dma_handle_t *txHandle, dma_handle_t *rxHandle)
+{
+    DMAMGR_ReleaseChannel(txHandle);
+    DMAMGR_ReleaseChannel(rxHandle);
+}
+#endif
+
+static const ARM_DRIVER_VERSION s_usartDriverVersion = {ARM_USART_API_VERSION, ARM_USART_DRV_VERSION};
+
+static const ARM_USART_CAPABILITIES s_usartDriverCapabilities = {
+    1, /* supports UART (Asynchronous) mode */
+    0, /* supports Synchronous Master mode */
+    0, /* supports Synchronous Slave mode */
+    0, /* supports UART Single-wire mode */
+    0, /* supports UART IrDA mode */
+    0, /* supports UART Smart Card mode */
+    0, /* Smart Card Clock generator */
+    1, /* RTS Flow Control available, interrupt variant with RTE_USARTn_RX_BUFFER_ENABLE and RTE_USARTn_RTS_HOOK */
+    0, /* CTS Flow Control available */
+    0, /* Transmit completed event available */
+    0, /* Signal receive character timeout event */
+    1, /* RTS Line available, through RTE_USARTn_RTS_HOOK */
+    0, /* CTS Line available */
+    0, /* DTR Line available */
+    0, /* DSR Line available */
+    0, /* DCD Line available */
+    0, /* RI Line available */
+    0, /* Signal CTS change event */
+    0, /* Signal DSR change event */
+    0, /* Signal DCD change event */
+    0, /* Signal RI change event */
+};
+
+static ARM_DRIVER_VERSION USARTx_GetVersion(void)
+{
+    return s_usartDriverVersion;
+}
+
+static ARM_USART_CAPABILITIES USARTx_GetCapabilities(void)
+{
+    return s_usartDriverCapabilities;
+}
+
+/* Only the asynchronous mode is supported, there is no combined transfer. */
+static int32_t USARTx_Transfer(const void *data_out, void *data_in, uint32_t num)
+{
+    return ARM_DRIVER_ERROR_UNSUPPORTED;
+}
+
+static ARM_USART_MODEM_STATUS USARTx_GetModemStatus(void)
+{
+    ARM_USART_MODEM_STATUS modem_status = {0};
+
+    return modem_status;
+}
+
+/* Drive the RTS hook by hand, refused while automatic RTS flow control owns the line. */
+static int32_t USART_SetModemControl(void (*setRts)(bool active), bool autoRts, ARM_USART_MODEM_CONTROL control)
+{
+    if (((control != ARM_USART_RTS_CLEAR) && (control != ARM_USART_RTS_SET)) || (!setRts))
+    {
+        return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+    if (autoRts)
+    {
+        return ARM_DRIVER_ERROR;
+    }
+
+    setRts(control == ARM_USART_RTS_SET);
+    return ARM_DRIVER_OK;
+}
+
+/* Decode the frame format of an ARM_USART_MODE_ASYNCHRONOUS control word into the fsl_uart
+ * encodings, which fsl_lpsci shares. Flow control is checked by the caller. */
+static int32_t USART_GetFrameFormat(uint32_t control, uint8_t *parityMode, uint8_t *stopBitCount)
+{
+    if ((control & ARM_USART_DATA_BITS_Msk) != ARM_USART_DATA_BITS_8)
+    {
+        return ARM_USART_ERROR_DATA_BITS;
+    }
+
+    switch (control & ARM_USART_PARITY_Msk)
+    {
+        case ARM_USART_PARITY_NONE:
+            *parityMode = kUART_ParityDisabled;
+            break;
+        case ARM_USART_PARITY_EVEN:
+            *parityMode = kUART_ParityEven;
+            break;
+        case ARM_USART_PARITY_ODD:
+            *parityMode = kUART_ParityOdd;
+            break;
+        default:
+            return ARM_USART_ERROR_PARITY;
+    }
+
+    switch (control & ARM_USART_STOP_BITS_Msk)
+    {
+        case ARM_USART_STOP_BITS_1:
+            *stopBitCount = kUART_OneStopBit;
+            break;
+        case ARM_USART_STOP_BITS_2:
+            *stopBitCount = kUART_TwoStopBit;
+            break;
+        default:
+            return ARM_USART_ERROR_STOP_BITS;
+    }
+
+    return ARM_DRIVER_OK;
+}
+
+#endif
+
+#if ((RTE_USART0 && defined(UART0)) && (defined(FSL_FEATURE_SOC_LPSCI_COUNT) && FSL_FEATURE_SOC_LPSCI_COUNT))
+
+typedef const struct _cmsis_lpsci_resource
+{
+    UART0_Type *base;            /*!< LPSCI peripheral base address. */
+    uint32_t (*GetFreq)(void);   /*!< Function to get the clock frequency. */
+    uint32_t irqPriority;        /*!< NVIC priority of the LPSCI and DMA interrupts. */
+    void (*SetRts)(bool active); /*!< RTS line driver, NULL if the instance has none. */
+} cmsis_lpsci_resource_t;
+
+static const IRQn_Type s_lpsciIrqs[] = UART0_RX_TX_IRQS;
+extern uint32_t LPSCI_GetInstance(UART0_Type *base);
+
+/* Register-level controls shared by the interrupt and DMA variants. */
+static int32_t LPSCI_CommonControl(uint32_t control, uint32_t arg, cmsis_lpsci_resource_t *resource, uint8_t *flags)
+{
+    lpsci_config_t config;
+    uint8_t parityMode;
+    uint8_t stopBitCount;
+    int32_t result;
+
+    switch (control & ARM_USART_CONTROL_Msk)
+    {
+        case ARM_USART_MODE_ASYNCHRONOUS:
+            result = USART_GetFrameFormat(control, &parityMode, &stopBitCount);
+            if (ARM_DRIVER_OK != result)
+            {
+                return result;
+            }
+            if ((control & ARM_USART_FLOW_CONTROL_Msk) != ARM_USART_FLOW_CONTROL_NONE)
+            {
+                return ARM_USART_ERROR_FLOW_CONTROL;
+            }
+
+            LPSCI_GetDefaultConfig(&config);
+            config.baudRate_Bps = arg;
+            config.parityMode = (lpsci_parity_mode_t)parityMode;
+            config.stopBitCount = (lpsci_stop_bit_count_t)stopBitCount;
+            /* Keep the transmitter and receiver as ARM_USART_CONTROL_TX/RX left them. */
+            config.enableTx = !(!(resource->base->C2 & UART0_C2_TE_MASK));
+            config.enableRx = !(!(resource->base->C2 & UART0_C2_RE_MASK));
+            if (kStatus_Success != LPSCI_Init(resource->base, &config, resource->GetFreq()))
+            {
+                return ARM_USART_ERROR_BAUDRATE;
+            }
+            *flags |= kUSART_FlagConfigured;
+            return ARM_DRIVER_OK;
+
+        case ARM_USART_CONTROL_TX:
+            LPSCI_EnableTx(resource->base, arg != 0U);
+            return ARM_DRIVER_OK;
+
+        case ARM_USART_CONTROL_RX:
+            LPSCI_EnableRx(resource->base, arg != 0U);
+            return ARM_DRIVER_OK;
+
+        default:
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+}
+
+/* Power up with the default frame format and the transmitter and receiver off. */
+static void LPSCI_CommonPowerUp(cmsis_lpsci_resource_t *resource)
+{
+    lpsci_config_t config;
+
+    LPSCI_GetDefaultConfig(&config);
+    config.enableTx = false;
+    config.enableRx = false;
+    (void)LPSCI_Init(resource->base, &config, resource->GetFreq());
+    NVIC_SetPriority(s_lpsciIrqs[LPSCI_GetInstance(resource->base)], resource->irqPriority);
+}
+
+static int32_t LPSCI_StatusToDriverError(status_t status)
+{
+    switch (status)
+    {
+        case kStatus_Success:
+            return ARM_DRIVER_OK;
+        case kStatus_LPSCI_TxBusy:
+        case kStatus_LPSCI_RxBusy:
+            return ARM_DRIVER_ERROR_BUSY;
+        case kStatus_InvalidArgument:
+            return ARM_DRIVER_ERROR_PARAMETER;
+        default:
+            return ARM_DRIVER_ERROR;
+    }
+}
+
+#if (RTE_USART0_DMA_EN)
+
+#if (defined(FSL_FEATURE_SOC_DMA_COUNT) && FSL_FEATURE_SOC_DMA_COUNT)
+typedef struct _cmsis_lpsci_dma_driver_state
+{
+    cmsis_lpsci_resource_t *resource;        /*!< Basic LPSCI resource. */
+    cmsis_usart_dma_resource_t *dmaResource; /*!< LPSCI DMA resource. */
+    lpsci_dma_handle_t *handle;              /*!< LPSCI DMA transfer handle. */
+    dma_handle_t *txHandle;                  /*!< DMA TX handle. */
+    dma_handle_t *rxHandle;                  /*!< DMA RX handle. */
+    ARM_USART_SignalEvent_t cb_event;        /*!< Callback function. */
+    uint32_t txCount;                        /*!< Bytes sent by the last finished or aborted send. */
+    uint32_t rxCount;                        /*!< Bytes received by the last finished or aborted receive. */
+    uint8_t flags;                           /*!< Driver state flags. */
+} cmsis_lpsci_dma_driver_state_t;
+
+static void KSDK_LPSCI_DmaCallback(UART0_Type *base, lpsci_dma_handle_t *handle, status_t status, void *userData)
+{
+    cmsis_lpsci_dma_driver_state_t *lpsci = (cmsis_lpsci_dma_driver_state_t *)userData;
+    uint32_t event;
+
+    switch (status)
+    {
+        case kStatus_LPSCI_TxIdle:
+            lpsci->txCount = handle->txDataSizeAll;
+            event = ARM_USART_EVENT_SEND_COMPLETE;
+            break;
+
+        case kStatus_LPSCI_RxIdle:
+            lpsci->rxCount = handle->rxDataSizeAll;
+            event = ARM_USART_EVENT_RECEIVE_COMPLETE;
+            break;
+
+        default:
+            return;
+    }
+
+    if (lpsci->cb_event)
+    {
+        lpsci->cb_event(event);
+    }
+}
+
+static int32_t LPSCI_DmaInitialize(ARM_USART_SignalEvent_t cb_event, cmsis_lpsci_dma_driver_state_t *lpsci)
+{
+    if (!(lpsci->flags & kUSART_FlagInit))
+    {
+        lpsci->cb_event = cb_event;
+        lpsci->flags = kUSART_FlagInit;
+    }
+    return ARM_DRIVER_OK;
+}
+
+static int32_t LPSCI_DmaUninitialize(cmsis_lpsci_dma_driver_state_t *lpsci)
+{
+    lpsci->flags = 0U;
+    return ARM_DRIVER_OK;
+}
+
+static int32_t LPSCI_DmaSend(const void *data, uint32_t num, cmsis_lpsci_dma_driver_state_t *lpsci)
+{
+    lpsci_transfer_t xfer;
+
+    xfer.data = (uint8_t *)data;
+    xfer.dataSize = num;
+
+    return LPSCI_StatusToDriverError(LPSCI_TransferSendDMA(lpsci->resource->base, lpsci->handle, &xfer));
+}
+
+static int32_t LPSCI_DmaReceive(void *data, uint32_t num, cmsis_lpsci_dma_driver_state_t *lpsci)
+{
+    lpsci_transfer_t xfer;
+
+    xfer.data = (uint8_t *)data;
+    xfer.dataSize = num;
+
+    return LPSCI_StatusToDriverError(LPSCI_TransferReceiveDMA(lpsci->resource->base, lpsci->handle, &xfer));
+}
+
+static uint32_t LPSCI_DmaGetTxCount(cmsis_lpsci_dma_driver_state_t *lpsci)
+{
+    uint32_t cnt;
+
+    if (kStatus_Success != LPSCI_TransferGetSendCountDMA(lpsci->resource->base, lpsci->handle, &cnt))
+    {
+        cnt = lpsci->txCount;
+    }
+    return cnt;
+}
+
+static uint32_t LPSCI_DmaGetRxCount(cmsis_lpsci_dma_driver_state_t *lpsci)
+{
+    uint32_t cnt;
+
+    if (kStatus_Success != LPSCI_TransferGetReceiveCountDMA(lpsci->resource->base, lpsci->handle, &cnt))
+    {
+        cnt = lpsci->rxCount;
+    }
+    return cnt;
+}
+
+static int32_t LPSCI_DmaControl(uint32_t control, uint32_t arg, cmsis_lpsci_dma_driver_state_t *lpsci)
+{
+    uint32_t cnt;
+
+    switch (control & ARM_USART_CONTROL_Msk)
+    {
+        case ARM_USART_ABORT_SEND:
+            if (kStatus_Success == LPSCI_TransferGetSendCountDMA(lpsci->resource->base, lpsci->handle, &cnt))
+            {
+                lpsci->txCount = cnt;
+                LPSCI_TransferAbortSendDMA(lpsci->resource->base, lpsci->handle);
+            }
+            return ARM_DRIVER_OK;
+
+        case ARM_USART_ABORT_RECEIVE:
+            if (kStatus_Success == LPSCI_TransferGetReceiveCountDMA(lpsci->resource->base, lpsci->handle, &cnt))
+            {
+                lpsci->rxCount = cnt;
+                LPSCI_TransferAbortReceiveDMA(lpsci->resource->base, lpsci->handle);
+            }
+            return ARM_DRIVER_OK;
+
+        case ARM_USART_MODE_ASYNCHRONOUS:
+            if ((lpsci->handle->txState == kUSART_TxBusy) || (lpsci->handle->rxState == kUSART_RxBusy))
+            {
+                return ARM_DRIVER_ERROR_BUSY;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return LPSCI_CommonControl(control, arg, lpsci->resource, &lpsci->flags);
+}
+
+static int32_t LPSCI_DmaPowerControl(ARM_POWER_STATE state, cmsis_lpsci_dma_driver_state_t *lpsci)
+{
+    switch (state)
+    {
+        /* Terminates any pending transfers, disables the LPSCI with its clock and the DMA routing */
+        case ARM_POWER_OFF:
+            if (lpsci->flags & kUSART_FlagPower)
+            {
+                LPSCI_DmaControl(ARM_USART_ABORT_SEND, 0U, lpsci);
+                LPSCI_DmaControl(ARM_USART_ABORT_RECEIVE, 0U, lpsci);
+                LPSCI_Deinit(lpsci->resource->base);
+                USART_DmaTeardown(lpsci->txHandle, lpsci->rxHandle);
+                lpsci->flags = kUSART_FlagInit;
+            }
+            return ARM_DRIVER_OK;
+
+        /* Not supported */
+        case ARM_POWER_LOW:
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+
+        case ARM_POWER_FULL:
+            if (!(lpsci->flags & kUSART_FlagInit))
+            {
+                return ARM_DRIVER_ERROR;
+            }
+            if (!(lpsci->flags & kUSART_FlagPower))
+            {
+                if (kStatus_Success !=
+                    USART_DmaSetup(lpsci->dmaResource, lpsci->txHandle, lpsci->rxHandle, lpsci->resource->irqPriority))
+                {
+                    return ARM_DRIVER_ERROR;
+                }
+                LPSCI_CommonPowerUp(lpsci->resource);
+                LPSCI_TransferCreateHandleDMA(lpsci->resource->base, lpsci->handle, KSDK_LPSCI_DmaCallback, lpsci,
+                                            lpsci->txHandle, lpsci->rxHandle);
+                lpsci->flags |= kUSART_FlagPower;
+            }
+            return ARM_DRIVER_OK;
+
+        default:
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+}
+
+static ARM_USART_STATUS LPSCI_DmaGetStatus(cmsis_lpsci_dma_driver_state_t *lpsci)
+{
+    ARM_USART_STATUS stat = {0};
+
+    stat.tx_busy = (lpsci->handle->txState == kUSART_TxBusy);
+    stat.rx_busy = (lpsci->handle->rxState == kUSART_RxBusy);
+
+    return stat;
+}
+#endif
+
+#endif
+
+#if (!RTE_USART0_DMA_EN)
+
+typedef struct _cmsis_lpsci_interrupt_driver_state
+{
+    cmsis_lpsci_resource_t *resource; /*!< Basic LPSCI resource. */
+    lpsci_handle_t *handle;           /*!< Interrupt transfer handle. */
+    uint8_t *rxRingBuffer;            /*!< RX ring buffer, NULL if RTE_USARTn_RX_BUFFER_ENABLE is 0. */
+    size_t rxRingBufferSize;          /*!< Size of the RX ring buffer. */
+    ARM_USART_SignalEvent_t cb_event; /*!< Callback function. */
+    uint32_t txCount;                 /*!< Bytes sent by the last finished or aborted send. */
+    uint32_t rxSize;                  /*!< Size of the current receive. */
+    uint32_t rxCount;                 /*!< Bytes received by the last finished or aborted receive. */
+    uint32_t rxCopied;                /*!< Bytes taken from the ring buffer when the receive started. */
+    volatile uint32_t rxEvents;       /*!< Receive errors since the receive started. */
+    uint8_t flags;                    /*!< Driver state flags. */
+} cmsis_lpsci_interrupt_driver_state_t;
+
+static void KSDK_LPSCI_InterruptCallback(UART0_Type *base, lpsci_handle_t *handle, status_t status, void *userData)
+{
+    cmsis_lpsci_interrupt_driver_state_t *lpsci = (cmsis_lpsci_interrupt_driver_state_t *)userData;
+    uint32_t event;
+
+    switch (status)
+    {
+        case kStatus_LPSCI_TxIdle:
+            lpsci->txCount = handle->txDataSizeAll;
+            event = ARM_USART_EVENT_SEND_COMPLETE;
+            break;
+
+        case kStatus_LPSCI_RxIdle:
+            lpsci->rxCount = lpsci->rxSize;
+            event = ARM_USART_EVENT_RECEIVE_COMPLETE;
+            break;
+
+        case kStatus_LPSCI_RxHardwareOverrun:
+        case kStatus_LPSCI_RxRingBufferOverrun:
+            event = ARM_USART_EVENT_RX_OVERFLOW;
+            break;
+
+        case kStatus_LPSCI_FramingError:
+            event = ARM_USART_EVENT_RX_FRAMING_ERROR;
+            break;
+
+        case kStatus_LPSCI_ParityError:
+            event = ARM_USART_EVENT_RX_PARITY_ERROR;
+            break;
+
+        default:
+            return;
+    }
+
+    lpsci->rxEvents |= (event & USART_RX_ERROR_EVENTS);
+
+    if (lpsci->cb_event)
+    {
+        lpsci->cb_event(event);
+    }
+}
+
+static int32_t LPSCI_InterruptInitialize(ARM_USART_SignalEvent_t cb_event, cmsis_lpsci_interrupt_driver_state_t *lpsci)
+{
+    if (!(lpsci->flags & kUSART_FlagInit))
+    {
+        lpsci->cb_event = cb_event;
+        lpsci->flags = kUSART_FlagInit;
+    }
+    return ARM_DRIVER_OK;
+}
+
+static int32_t LPSCI_InterruptUninitialize(cmsis_lpsci_interrupt_driver_state_t *lpsci)
+{
+    lpsci->flags = 0U;
+    return ARM_DRIVER_OK;
+}
+
+static int32_t LPSCI_InterruptSend(const void *data, uint32_t num, cmsis_lpsci_interrupt_driver_state_t *lpsci)
+{
+    lpsci_transfer_t xfer;
+
+    xfer.data = (uint8_t *)data;
+    xfer.dataSize = num;
+
+    return LPSCI_StatusToDriverError(LPSCI_TransferSendNonBlocking(lpsci->resource->base, lpsci->handle, &xfer));
+}
+
+static int32_t LPSCI_InterruptReceive(void *data, uint32_t num, cmsis_lpsci_interrupt_driver_state_t *lpsci)
+{
+    lpsci_transfer_t xfer;
+    size_t received = 0U;
+    status_t status;
+
+    /* The counters belong to the receive in progress, leave them alone while it runs. */
+    if (lpsci->handle->rxState == kUSART_RxBusy)
+    {
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+
+    xfer.data = (uint8_t *)data;
+    xfer.dataSize = num;
+    lpsci->rxSize = num;
+    lpsci->rxCopied = 0U;
+    lpsci->rxCount = 0U;
+    lpsci->rxEvents = 0U;
+
+    /* With the ring buffer part or all of the data may be copied out right away. */
+    status = LPSCI_TransferReceiveNonBlocking(lpsci->resource->base, lpsci->handle, &xfer, &received);
+    lpsci->rxCopied = received;
+
+    return LPSCI_StatusToDriverError(status);
+}
+
+static uint32_t LPSCI_InterruptGetTxCount(cmsis_lpsci_interrupt_driver_state_t *lpsci)
+{
+    uint32_t cnt;
+
+    if (kStatus_Success != LPSCI_TransferGetSendCount(lpsci->resource->base, lpsci->handle, &cnt))
+    {
+        cnt = lpsci->txCount;
+    }
+    return cnt;
+}
+
+static uint32_t LPSCI_InterruptGetRxCount(cmsis_lpsci_interrupt_driver_state_t *lpsci)
+{
+    uint32_t cnt;
+
+    if (lpsci->handle->rxState != kUSART_RxBusy)
+    {
+        return lpsci->rxCount;
+    }
+    (void)LPSCI_TransferGetReceiveCount(lpsci->resource->base, lpsci->handle, &cnt);
+    return lpsci->rxCopied + cnt;
+}
+
+static int32_t LPSCI_InterruptControl(uint32_t control, uint32_t arg, cmsis_lpsci_interrupt_driver_state_t *lpsci)
+{
+    uint32_t cnt;
+
+    switch (control & ARM_USART_CONTROL_Msk)
+    {
+        case ARM_USART_ABORT_SEND:
+            if (kStatus_Success == LPSCI_TransferGetSendCount(lpsci->resource->base, lpsci->handle, &cnt))
+            {
+                lpsci->txCount = cnt;
+                LPSCI_TransferAbortSend(lpsci->resource->base, lpsci->handle);
+            }
+            return ARM_DRIVER_OK;
+
+        case ARM_USART_ABORT_RECEIVE:
+            if (lpsci->handle->rxState == kUSART_RxBusy)
+            {
+                lpsci->rxCount = LPSCI_InterruptGetRxCount(lpsci);
+                LPSCI_TransferAbortReceive(lpsci->resource->base, lpsci->handle);
+            }
+            return ARM_DRIVER_OK;
+
+        case ARM_USART_MODE_ASYNCHRONOUS:
+            if ((lpsci->handle->txState == kUSART_TxBusy) || (lpsci->handle->rxState == kUSART_RxBusy))
+            {
+                return ARM_DRIVER_ERROR_BUSY;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return LPSCI_CommonControl(control, arg, lpsci->resource, &lpsci->flags);
+}
+
+static int32_t LPSCI_InterruptPowerControl(ARM_POWER_STATE state, cmsis_lpsci_interrupt_driver_state_t *lpsci)
+{
+    switch (state)
+    {
+        /* Terminates any pending transfers, disables the LPSCI and its clock */
+        case ARM_POWER_OFF:
+            if (lpsci->flags & kUSART_FlagPower)
+            {
+                LPSCI_InterruptControl(ARM_USART_ABORT_SEND, 0U, lpsci);
+                LPSCI_InterruptControl(ARM_USART_ABORT_RECEIVE, 0U, lpsci);
+                if (lpsci->rxRingBuffer)
+                {
+                    LPSCI_TransferStopRingBuffer(lpsci->resource->base, lpsci->handle);
+                }
+                LPSCI_Deinit(lpsci->resource->base);
+                lpsci->flags = kUSART_FlagInit;
+            }
+            return ARM_DRIVER_OK;
+
+        /* Not supported */
+        case ARM_POWER_LOW:
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+
+        case ARM_POWER_FULL:
+            if (!(lpsci->flags & kUSART_FlagInit))
+            {
+                return ARM_DRIVER_ERROR;
+            }
+            if (!(lpsci->flags & kUSART_FlagPower))
+            {
+                LPSCI_CommonPowerUp(lpsci->resource);
+                LPSCI_TransferCreateHandle(lpsci->resource->base, lpsci->handle, KSDK_LPSCI_InterruptCallback, lpsci);
+                if (lpsci->rxRingBuffer)
+                {
+                    LPSCI_TransferStartRingBuffer(lpsci->resource->base, lpsci->handle, lpsci->rxRingBuffer,
+                                                lpsci->rxRingBufferSize);
+                }
+                lpsci->flags |= kUSART_FlagPower;
+            }
+            return ARM_DRIVER_OK;
+
+        default:
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+}
+
+static ARM_USART_STATUS LPSCI_InterruptGetStatus(cmsis_lpsci_interrupt_driver_state_t *lpsci)
+{
+    ARM_USART_STATUS stat = {0};
+    uint32_t rxEvents = lpsci->rxEvents;
+
+    stat.tx_busy = (lpsci->handle->txState == kUSART_TxBusy);
+    stat.rx_busy = (lpsci->handle->rxState == kUSART_RxBusy);
+    stat.rx_overflow = !(!(rxEvents & ARM_USART_EVENT_RX_OVERFLOW));
+    stat.rx_framing_error = !(!(rxEvents & ARM_USART_EVENT_RX_FRAMING_ERROR));
+    stat.rx_parity_error = !(!(rxEvents & ARM_USART_EVENT_RX_PARITY_ERROR));
+
+    return stat;
+}
+
+#endif
+
+#endif
+
+#if ((RTE_USART1 && defined(UART1)) || (RTE_USART2 && defined(UART2)))
+
+typedef const struct _cmsis_uart_resource
+{
+    UART_Type *base;             /*!< UART peripheral base address. */
+    uint32_t (*GetFreq)(void);   /*!< Function to get the clock frequency. */
+    uint32_t irqPriority;        /*!< NVIC priority of the UART and DMA interrupts. */
+    void (*SetRts)(bool active); /*!< RTS line driver, NULL if the instance has none. */
+} cmsis_uart_resource_t;
+
+static const IRQn_Type s_uartIrqs[] = UART_RX_TX_IRQS;
+extern uint32_t UART_GetInstance(UART_Type *base);
+
+/* Register-level controls shared by the interrupt and DMA variants. */
+static int32_t UART_CommonControl(uint32_t control, uint32_t arg, cmsis_uart_resource_t *resource, uint8_t *flags)
+{
+    uart_config_t config;
+    uint8_t parityMode;
+    uint8_t stopBitCount;
+    int32_t result;
+
+    switch (control & ARM_USART_CONTROL_Msk)
+    {
+        case ARM_USART_MODE_ASYNCHRONOUS:
+            result = USART_GetFrameFormat(control, &parityMode, &stopBitCount);
+            if (ARM_DRIVER_OK != result)
+            {
+                return result;
+            }
+            if ((control & ARM_USART_FLOW_CONTROL_Msk) != ARM_USART_FLOW_CONTROL_NONE)
+            {
+                return ARM_USART_ERROR_FLOW_CONTROL;
+            }
+
+            UART_GetDefaultConfig(&config);
+            config.baudRate_Bps = arg;
+            config.parityMode = (uart_parity_mode_t)parityMode;
+            config.stopBitCount = (uart_stop_bit_count_t)stopBitCount;
+            /* Keep the transmitter and receiver as ARM_USART_CONTROL_TX/RX left them. */
+            config.enableTx = !(!(resource->base->C2 & UART_C2_TE_MASK));
+            config.enableRx = !(!(resource->base->C2 & UART_C2_RE_MASK));
+            if (kStatus_Success != UART_Init(resource->base, &config, resource->GetFreq()))
+            {
+                return ARM_USART_ERROR_BAUDRATE;
+            }
+            *flags |= kUSART_FlagConfigured;
+            return ARM_DRIVER_OK;
+
+        case ARM_USART_CONTROL_TX:
+            UART_EnableTx(resource->base, arg != 0U);
+            return ARM_DRIVER_OK;
+
+        case ARM_USART_CONTROL_RX:
+            UART_EnableRx(resource->base, arg != 0U);
+            return ARM_DRIVER_OK;
+
+        default:
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+}
+
+/* Power up with the default frame format and the transmitter and receiver off. */
+static void UART_CommonPowerUp(cmsis_uart_resource_t *resource)
+{
+    uart_config_t config;
+
+    UART_GetDefaultConfig(&config);
+    config.enableTx = false;
+    config.enableRx = false;
+    (void)UART_Init(resource->base, &config, resource->GetFreq());
+    NVIC_SetPriority(s_uartIrqs[UART_GetInstance(resource->base)], resource->irqPriority);
+}
+
+static int32_t UART_StatusToDriverError(status_t status)
+{
+    switch (status)
+    {
+        case kStatus_Success:
+            return ARM_DRIVER_OK;
+        case kStatus_UART_TxBusy:
+        case kStatus_UART_RxBusy:
+            return ARM_DRIVER_ERROR_BUSY;
+        case kStatus_InvalidArgument:
+            return ARM_DRIVER_ERROR_PARAMETER;
+        default:
+            return ARM_DRIVER_ERROR;
+    }
+}
+
+#if ((RTE_USART1 && RTE_USART1_DMA_EN) || (RTE_USART2 && RTE_USART2_DMA_EN))
+
+#if (defined(FSL_FEATURE_SOC_DMA_COUNT) && FSL_FEATURE_SOC_DMA_COUNT)
+typedef struct _cmsis_uart_dma_driver_state
+{
+    cmsis_uart_resource_t *resource;         /*!< Basic UART resource. */
+    cmsis_usart_dma_resource_t *dmaResource; /*!< UART DMA resource. */
+    uart_dma_handle_t *handle;               /*!< UART DMA transfer handle. */
+    dma_handle_t *txHandle;                  /*!< DMA TX handle. */
+    dma_handle_t *rxHandle;                  /*!< DMA RX handle. */
+    ARM_USART_SignalEvent_t cb_event;        /*!< Callback function. */
+    uint32_t txCount;                        /*!< Bytes sent by the last finished or aborted send. */
+    uint32_t rxCount;                        /*!< Bytes received by the last finished or aborted receive. */
+    uint8_t flags;                           /*!< Driver state flags. */
+} cmsis_uart_dma_driver_state_t;
+
+static void KSDK_UART_DmaCallback(UART_Type *base, uart_dma_handle_t *handle, status_t status, void *userData)
+{
+    cmsis_uart_dma_driver_state_t *uart = (cmsis_uart_dma_driver_state_t *)userData;
+    uint32_t event;
+
+    switch (status)
+    {
+        case kStatus_UART_TxIdle:
+            uart->txCount = handle->txDataSizeAll;
+            event = ARM_USART_EVENT_SEND_COMPLETE;
+            break;
+
+        case kStatus_UART_RxIdle:
+            uart->rxCount = handle->rxDataSizeAll;
+            event = ARM_USART_EVENT_RECEIVE_COMPLETE;
+            break;
+
+        default:
+            return;
+    }
+
+    if (uart->cb_event)
+    {
+        uart->cb_event(event);
+    }
+}
+
+static int32_t UART_DmaInitialize(ARM_USART_SignalEvent_t cb_event, cmsis_uart_dma_driver_state_t *uart)
+{
+    if (!(uart->flags & kUSART_FlagInit))
+    {
+        uart->cb_event = cb_event;
+        uart->flags = kUSART_FlagInit;
+    }
+    return ARM_DRIVER_OK;
+}
+
+static int32_t UART_DmaUninitialize(cmsis_uart_dma_driver_state_t *uart)
+{
+    uart->flags = 0U;
+    return ARM_DRIVER_OK;
+}
+
+static int32_t UART_DmaSend(const void *data, uint32_t num, cmsis_uart_dma_driver_state_t *uart)
+{
+    uart_transfer_t xfer;
+
+    xfer.data = (uint8_t *)data;
+    xfer.dataSize = num;
+
+    return UART_StatusToDriverError(UART_TransferSendDMA(uart->resource->base, uart->handle, &xfer));
+}
+
+static int32_t UART_DmaReceive(void *data, uint32_t num, cmsis_uart_dma_driver_state_t *uart)
+{
+    uart_transfer_t xfer;
+
+    xfer.data = (uint8_t *)data;
+    xfer.dataSize = num;
+
+    return UART_StatusToDriverError(UART_TransferReceiveDMA(uart->resource->base, uart->handle, &xfer));
+}
+
+static uint32_t UART_DmaGetTxCount(cmsis_uart_dma_driver_state_t *uart)
+{
+    uint32_t cnt;
+
+    if (kStatus_Success != UART_TransferGetSendCountDMA(uart->resource->base, uart->handle, &cnt))
+    {
+        cnt = uart->txCount;
+    }
+    return cnt;
+}
+
+static uint32_t UART_DmaGetRxCount(cmsis_uart_dma_driver_state_t *uart)
+{
+    uint32_t cnt;
+
+    if (kStatus_Success != UART_TransferGetReceiveCountDMA(uart->resource->base, uart->handle, &cnt))
+    {
+        cnt = uart->rxCount;
+    }
+    return cnt;
+}
+
+static int32_t UART_DmaControl(uint32_t control, uint32_t arg, cmsis_uart_dma_driver_state_t *uart)
+{
+    uint32_t cnt;
+
+    switch (control & ARM_USART_CONTROL_Msk)
+    {
+        case ARM_USART_ABORT_SEND:
+            if (kStatus_Success == UART_TransferGetSendCountDMA(uart->resource->base, uart->handle, &cnt))
+            {
+                uart->txCount = cnt;
+                UART_TransferAbortSendDMA(uart->resource->base, uart->handle);
+            }
+            return ARM_DRIVER_OK;
+
+        case ARM_USART_ABORT_RECEIVE:
+            if (kStatus_Success == UART_TransferGetReceiveCountDMA(uart->resource->base, uart->handle, &cnt))
+            {
+                uart->rxCount = cnt;
+                UART_TransferAbortReceiveDMA(uart->resource->base, uart->handle);
+            }
+            return ARM_DRIVER_OK;
+
+        case ARM_USART_MODE_ASYNCHRONOUS:
+            if ((uart->handle->txState == kUSART_TxBusy) || (uart->handle->rxState == kUSART_RxBusy))
+            {
+                return ARM_DRIVER_ERROR_BUSY;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return UART_CommonControl(control, arg, uart->resource, &uart->flags);
+}
+
+static int32_t UART_DmaPowerControl(ARM_POWER_STATE state, cmsis_uart_dma_driver_state_t *uart)
+{
+    switch (state)
+    {
+        /* Terminates any pending transfers, disables the UART with its clock and the DMA routing */
+        case ARM_POWER_OFF:
+            if (uart->flags & kUSART_FlagPower)
+            {
+                UART_DmaControl(ARM_USART_ABORT_SEND, 0U, uart);
+                UART_DmaControl(ARM_USART_ABORT_RECEIVE, 0U, uart);
+                UART_Deinit(uart->resource->base);
+                USART_DmaTeardown(uart->txHandle, uart->rxHandle);
+                uart->flags = kUSART_FlagInit;
+            }
+            return ARM_DRIVER_OK;
+
+        /* Not supported */
+        case ARM_POWER_LOW:
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+
+        case ARM_POWER_FULL:
+            if (!(uart->flags & kUSART_FlagInit))
+            {
+                return ARM_DRIVER_ERROR;
+            }
+            if (!(uart->flags & kUSART_FlagPower))
+            {
+                if (kStatus_Success !=
+                    USART_DmaSetup(uart->dmaResource, uart->txHandle, uart->rxHandle, uart->resource->irqPriority))
+                {
+                    return ARM_DRIVER_ERROR;
+                }
+                UART_CommonPowerUp(uart->resource);
+                UART_TransferCreateHandleDMA(uart->resource->base, uart->handle, KSDK_UART_DmaCallback, uart,
+                                            uart->txHandle, uart->rxHandle);
+                uart->flags |= kUSART_FlagPower;
+            }
+            return ARM_DRIVER_OK;
+
+        default:
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+}
+
+static ARM_USART_STATUS UART_DmaGetStatus(cmsis_uart_dma_driver_state_t *uart)
+{
+    ARM_USART_STATUS stat = {0};
+
+    stat.tx_busy = (uart->handle->txState == kUSART_TxBusy);
+    stat.rx_busy = (uart->handle->rxState == kUSART_RxBusy);
+
+    return stat;
+}
+#endif
+
+#endif
+
+#if ((RTE_USART1 && !RTE_USART1_DMA_EN) || (RTE_USART2 && !RTE_USART2_DMA_EN))
+
+typedef struct _cmsis_uart_interrupt_driver_state
+{
+    cmsis_uart_resource_t *resource;  /*!< Basic UART resource. */
+    uart_handle_t *handle;            /*!< Interrupt transfer handle. */
+    uint8_t *rxRingBuffer;            /*!< RX ring buffer, NULL if RTE_USARTn_RX_BUFFER_ENABLE is 0. */
+    size_t rxRingBufferSize;          /*!< Size of the RX ring buffer. */
+    ARM_USART_SignalEvent_t cb_event; /*!< Callback function. */
+    uint32_t txCount;                 /*!< Bytes sent by the last finished or aborted send. */
+    uint32_t rxSize;                  /*!< Size of the current receive. */
+    uint32_t rxCount;                 /*!< Bytes received by the last finished or aborted receive. */
+    uint32_t rxCopied;                /*!< Bytes taken from the ring buffer when the receive started. */
+    volatile uint32_t rxEvents;       /*!< Receive errors since the receive started. */
+    bool autoRts;                     /*!< RTS hook driven by the ring buffer fill level. */
+    uint8_t flags;                    /*!< Driver state flags. */
+} cmsis_uart_interrupt_driver_state_t;
+
+static void KSDK_UART_InterruptCallback(UART_Type *base, uart_handle_t *handle, status_t status, void *userData)
+{
+    cmsis_uart_interrupt_driver_state_t *uart = (cmsis_uart_interrupt_driver_state_t *)userData;
+    uint32_t event;
+
+    switch (status)
+    {
+        case kStatus_UART_TxIdle:
+            uart->txCount = handle->txDataSizeAll;
+            event = ARM_USART_EVENT_SEND_COMPLETE;
+            break;
+
+        case kStatus_UART_RxIdle:
+            uart->rxCount = uart->rxSize;
+            event = ARM_USART_EVENT_RECEIVE_COMPLETE;
+            break;
+
+        case kStatus_UART_RxHardwareOverrun:
+        case kStatus_UART_RxRingBufferOverrun:
+            event = ARM_USART_EVENT_RX_OVERFLOW;
+            break;
+
+        case kStatus_UART_FramingError:
+            event = ARM_USART_EVENT_RX_FRAMING_ERROR;
+            break;
+
+        case kStatus_UART_ParityError:
+            event = ARM_USART_EVENT_RX_PARITY_ERROR;
+            break;
+
+        default:
+            return;
+    }
+
+    uart->rxEvents |= (event & USART_RX_ERROR_EVENTS);
+
+    if (uart->cb_event)
+    {
+        uart->cb_event(event);
+    }
+}
+
+static int32_t UART_InterruptInitialize(ARM_USART_SignalEvent_t cb_event, cmsis_uart_interrupt_driver_state_t *uart)
+{
+    if (!(uart->flags & kUSART_FlagInit))
+    {
+        uart->cb_event = cb_event;
+        uart->flags = kUSART_FlagInit;
+    }
+    return ARM_DRIVER_OK;
+}
+
+static int32_t UART_InterruptUninitialize(cmsis_uart_interrupt_driver_state_t *uart)
+{
+    uart->flags = 0U;
+    return ARM_DRIVER_OK;
+}
+
+static int32_t UART_InterruptSend(const void *data, uint32_t num, cmsis_uart_interrupt_driver_state_t *uart)
+{
+    uart_transfer_t xfer;
+
+    xfer.data = (uint8_t *)data;
+    xfer.dataSize = num;
+
+    return UART_StatusToDriverError(UART_TransferSendNonBlocking(uart->resource->base, uart->handle, &xfer));
+}
+
+static int32_t UART_InterruptReceive(void *data, uint32_t num, cmsis_uart_interrupt_driver_state_t *uart)
+{
+    uart_transfer_t xfer;
+    size_t received = 0U;
+    status_t status;
+
+    /* The counters belong to the receive in progress, leave them alone while it runs. */
+    if (uart->handle->rxState == kUSART_RxBusy)
+    {
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+
+    xfer.data = (uint8_t *)data;
+    xfer.dataSize = num;
+    uart->rxSize = num;
+    uart->rxCopied = 0U;
+    uart->rxCount = 0U;
+    uart->rxEvents = 0U;
+
+    /* With the ring buffer part or all of the data may be copied out right away. */
+    status = UART_TransferReceiveNonBlocking(uart->resource->base, uart->handle, &xfer, &received);
+    uart->rxCopied = received;
+
+    return UART_StatusToDriverError(status);
+}
+
+static uint32_t UART_InterruptGetTxCount(cmsis_uart_interrupt_driver_state_t *uart)
+{
+    uint32_t cnt;
+
+    if (kStatus_Success != UART_TransferGetSendCount(uart->resource->base, uart->handle, &cnt))
+    {
+        cnt = uart->txCount;
+    }
+    return cnt;
+}
+
+static uint32_t UART_InterruptGetRxCount(cmsis_uart_interrupt_driver_state_t *uart)
+{
+    uint32_t cnt;
+
+    if (uart->handle->rxState != kUSART_RxBusy)
+    {
+        return uart->rxCount;
+    }
+    (void)UART_TransferGetReceiveCount(uart->resource->base, uart->handle, &cnt);
+    return uart->rxCopied + cnt;
+}
+
+/* RTS flow control runs from the ring buffer: the receive interrupt drops the line at 3/4 full and
+ * the reads raise it again at 1/4. */
+static void KSDK_UART_RtsCallback(UART_Type *base, uart_handle_t *handle, bool ready)
+{
+    ((cmsis_uart_interrupt_driver_state_t *)handle->userData)->resource->SetRts(ready);
+}
+
+static int32_t UART_InterruptSetMode(uint32_t control, uint32_t arg, cmsis_uart_interrupt_driver_state_t *uart)
+{
+    uart_rx_ring_config_t ringConfig;
+    uint32_t flowControl = control & ARM_USART_FLOW_CONTROL_Msk;
+    int32_t result;
+
+    if ((flowControl != ARM_USART_FLOW_CONTROL_NONE) &&
+        ((flowControl != ARM_USART_FLOW_CONTROL_RTS) || (!uart->rxRingBuffer) || (!uart->resource->SetRts)))
+    {
+        return ARM_USART_ERROR_FLOW_CONTROL;
+    }
+
+    result = UART_CommonControl(control & ~ARM_USART_FLOW_CONTROL_Msk, arg, uart->resource, &uart->flags);
+    if ((ARM_DRIVER_OK != result) || (!uart->rxRingBuffer))
+    {
+        return result;
+    }
+
+    ringConfig.policy =
+        (flowControl == ARM_USART_FLOW_CONTROL_RTS) ? kUART_RxRingFlowControlRts : kUART_RxRingOverwriteOldest;
+    ringConfig.highWatermark = (uart->rxRingBufferSize * 3U) / 4U;
+    ringConfig.lowWatermark = uart->rxRingBufferSize / 4U;
+    ringConfig.rtsCallback = KSDK_UART_RtsCallback;
+    if (kStatus_Success != UART_TransferSetRxRingPolicy(uart->resource->base, uart->handle, &ringConfig))
+    {
+        return ARM_USART_ERROR_FLOW_CONTROL;
+    }
+    uart->autoRts = (flowControl == ARM_USART_FLOW_CONTROL_RTS);
+
+    return ARM_DRIVER_OK;
+}
+
+static int32_t UART_InterruptControl(uint32_t control, uint32_t arg, cmsis_uart_interrupt_driver_state_t *uart)
+{
+    uint32_t cnt;
+
+    switch (control & ARM_USART_CONTROL_Msk)
+    {
+        case ARM_USART_ABORT_SEND:
+            if (kStatus_Success == UART_TransferGetSendCount(uart->resource->base, uart->handle, &cnt))
+            {
+                uart->txCount = cnt;
+                UART_TransferAbortSend(uart->resource->base, uart->handle);
+            }
+            return ARM_DRIVER_OK;
+
+        case ARM_USART_ABORT_RECEIVE:
+            if (uart->handle->rxState == kUSART_RxBusy)
+            {
+                uart->rxCount = UART_InterruptGetRxCount(uart);
+                UART_TransferAbortReceive(uart->resource->base, uart->handle);
+            }
+            return ARM_DRIVER_OK;
+
+        case ARM_USART_MODE_ASYNCHRONOUS:
+            if ((uart->handle->txState == kUSART_TxBusy) || (uart->handle->rxState == kUSART_RxBusy))
+            {
+                return ARM_DRIVER_ERROR_BUSY;
+            }
+            return UART_InterruptSetMode(control, arg, uart);
+
+        default:
+            break;
+    }
+
+    return UART_CommonControl(control, arg, uart->resource, &uart->flags);
+}
+
+static int32_t UART_InterruptPowerControl(ARM_POWER_STATE state, cmsis_uart_interrupt_driver_state_t *uart)
+{
+    switch (state)
+    {
+        /* Terminates any pending transfers, disables the UART and its clock */
+        case ARM_POWER_OFF:
+            if (uart->flags & kUSART_FlagPower)
+            {
+                UART_InterruptControl(ARM_USART_ABORT_SEND, 0U, uart);
+                UART_InterruptControl(ARM_USART_ABORT_RECEIVE, 0U, uart);
+                if (uart->rxRingBuffer)
+                {
+                    UART_TransferStopRingBuffer(uart->resource->base, uart->handle);
+                }
+                UART_Deinit(uart->resource->base);
+                uart->flags = kUSART_FlagInit;
+            }
+            return ARM_DRIVER_OK;
+
+        /* Not supported */
+        case ARM_POWER_LOW:
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+
+        case ARM_POWER_FULL:
+            if (!(uart->flags & kUSART_FlagInit))
+            {
+                return ARM_DRIVER_ERROR;
+            }
+            if (!(uart->flags & kUSART_FlagPower))
+            {
+                UART_CommonPowerUp(uart->resource);
+                UART_TransferCreateHandle(uart->resource->base, uart->handle, KSDK_UART_InterruptCallback, uart);
+                uart->autoRts = false;
+                if (uart->rxRingBuffer)
+                {
+                    UART_TransferStartRingBuffer(uart->resource->base, uart->handle, uart->rxRingBuffer,
+                                                uart->rxRingBufferSize);
+                }
+                uart->flags |= kUSART_FlagPower;
+            }
+            return ARM_DRIVER_OK;
+
+        default:
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+}
+
+static ARM_USART_STATUS UART_InterruptGetStatus(cmsis_uart_interrupt_driver_state_t *uart)
+{
+    ARM_USART_STATUS stat = {0};
+    uint32_t rxEvents = uart->rxEvents;
+
+    stat.tx_busy = (uart->handle->txState == kUSART_TxBusy);
+    stat.rx_busy = (uart->handle->rxState == kUSART_RxBusy);
+    stat.rx_overflow = !(!(rxEvents & ARM_USART_EVENT_RX_OVERFLOW));
+    stat.rx_framing_error = !(!(rxEvents & ARM_USART_EVENT_RX_FRAMING_ERROR));
+    stat.rx_parity_error = !(!(rxEvents & ARM_USART_EVENT_RX_PARITY_ERROR));
+
+    return stat;
+}
+
+#endif
+
+#endif
+
+#if defined(UART0) && RTE_USART0
+/* User needs to provide the implementation for UART0_GetFreq/InitPins/DeinitPins
+in the application for enabling according instance. */
+extern uint32_t UART0_GetFreq(void);
+extern void UART0_InitPins(void);
+extern void UART0_DeinitPins(void);
+
+cmsis_lpsci_resource_t USART0_Resource = {UART0, UART0_GetFreq, RTE_USART0_IRQ_PRIORITY, RTE_USART0_RTS_HOOK};
+
+#if RTE_USART0_DMA_EN
+
+#if (defined(FSL_FEATURE_SOC_DMA_COUNT) && FSL_FEATURE_SOC_DMA_COUNT)
+
+cmsis_usart_dma_resource_t USART0_DmaResource = {
+    RTE_USART0_DMA_TX_DMA_BASE, RTE_USART0_DMA_TX_CH, RTE_USART0_DMA_TX_DMAMUX_BASE, RTE_USART0_DMA_TX_PERI_SEL,
+    RTE_USART0_DMA_RX_DMA_BASE, RTE_USART0_DMA_RX_CH, RTE_USART0_DMA_RX_DMAMUX_BASE, RTE_USART0_DMA_RX_PERI_SEL,
+};
+
+lpsci_dma_handle_t USART0_DmaHandle;
+dma_handle_t USART0_DmaTxHandle;
+dma_handle_t USART0_DmaRxHandle;
+
+#if defined(__CC_ARM)
+ARMCC_SECTION("usart0_dma_driver_state")
+cmsis_lpsci_dma_driver_state_t USART0_DmaDriverState = {
+#else
+cmsis_lpsci_dma_driver_state_t USART0_DmaDriverState = {
+#endif
+    &USART0_Resource, &USART0_DmaResource, &USART0_DmaHandle, &USART0_DmaTxHandle, &USART0_DmaRxHandle,
+};
+
+static int32_t USART0_DmaInitialize(ARM_USART_SignalEvent_t cb_event)
+{
+    UART0_InitPins();
+    return LPSCI_DmaInitialize(cb_event, &USART0_DmaDriverState);
+}
+
+static int32_t USART0_DmaUninitialize(void)
+{
+    UART0_DeinitPins();
+    return LPSCI_DmaUninitialize(&USART0_DmaDriverState);
+}
+
+static int32_t USART0_DmaPowerControl(ARM_POWER_STATE state)
+{
+    return LPSCI_DmaPowerControl(state, &USART0_DmaDriverState);
+}
+
+static int32_t USART0_DmaSend(const void *data, uint32_t num)
+{
+    return LPSCI_DmaSend(data, num, &USART0_DmaDriverState);
+}
+
+static int32_t USART0_DmaReceive(void *data, uint32_t num)
+{
+    return LPSCI_DmaReceive(data, num, &USART0_DmaDriverState);
+}
+
+static uint32_t USART0_DmaGetTxCount(void)
+{
+    return LPSCI_DmaGetTxCount(&USART0_DmaDriverState);
+}
+
+static uint32_t USART0_DmaGetRxCount(void)
+{
+    return LPSCI_DmaGetRxCount(&USART0_DmaDriverState);
+}
+
+static int32_t USART0_DmaControl(uint32_t control, uint32_t arg)
+{
+    return LPSCI_DmaControl(control, arg, &USART0_DmaDriverState);
+}
+
+static ARM_USART_STATUS USART0_DmaGetStatus(void)
+{
+    return LPSCI_DmaGetStatus(&USART0_DmaDriverState);
+}
+
+static int32_t USART0_DmaSetModemControl(ARM_USART_MODEM_CONTROL control)
+{
+    return USART_SetModemControl(USART0_Resource.SetRts, false, control);
+}
+
+#endif
+
+#else
+
+lpsci_handle_t USART0_Handle;
+#if RTE_USART0_RX_BUFFER_ENABLE
+static uint8_t usart0_rxRingBuffer[RTE_USART0_RX_BUFFER_SIZE];
+#endif
+
+#if defined(__CC_ARM)
+ARMCC_SECTION("usart0_interrupt_driver_state")
+cmsis_lpsci_interrupt_driver_state_t USART0_InterruptDriverState = {
+#else
+cmsis_lpsci_interrupt_driver_state_t USART0_InterruptDriverState = {
+#endif
+    &USART0_Resource, &USART0_Handle,
+#if RTE_USART0_RX_BUFFER_ENABLE
+    usart0_rxRingBuffer, RTE_USART0_RX_BUFFER_SIZE,
+#endif
+};
+
+static int32_t USART0_InterruptInitialize(ARM_USART_SignalEvent_t cb_event)
+{
+    UART0_InitPins();
+    return LPSCI_InterruptInitialize(cb_event, &USART0_InterruptDriverState);
+}
+
+static int32_t USART0_InterruptUninitialize(void)
+{
+    UART0_DeinitPins();
+    return LPSCI_InterruptUninitialize(&USART0_InterruptDriverState);
+}
+
+static int32_t USART0_InterruptPowerControl(ARM_POWER_STATE state)
+{
+    return LPSCI_InterruptPowerControl(state, &USART0_InterruptDriverState);
+}
+
+static int32_t USART0_InterruptSend(const void *data, uint32_t num)
+{
+    return LPSCI_InterruptSend(data, num, &USART0_InterruptDriverState);
+}
+
+static int32_t USART0_InterruptReceive(void *data, uint32_t num)
+{
+    return LPSCI_InterruptReceive(data, num, &USART0_InterruptDriverState);
+}
+
+static uint32_t USART0_InterruptGetTxCount(void)
+{
+    return LPSCI_InterruptGetTxCount(&USART0_InterruptDriverState);
+}
+
+static uint32_t USART0_InterruptGetRxCount(void)
+{
+    return LPSCI_InterruptGetRxCount(&USART0_InterruptDriverState);
+}
+
+static int32_t USART0_InterruptControl(uint32_t control, uint32_t arg)
+{
+    return LPSCI_InterruptControl(control, arg, &USART0_InterruptDriverState);
+}
+
+static ARM_USART_STATUS USART0_InterruptGetStatus(void)
+{
+    return LPSCI_InterruptGetStatus(&USART0_InterruptDriverState);
+}
+
+static int32_t USART0_InterruptSetModemControl(ARM_USART_MODEM_CONTROL control)
+{
+    return USART_SetModemControl(USART0_Resource.SetRts, false, control);
+}
+
+#endif
+
+ARM_DRIVER_USART Driver_USART0 = {USARTx_GetVersion, USARTx_GetCapabilities,
+#if RTE_USART0_DMA_EN
+                                   USART0_DmaInitialize, USART0_DmaUninitialize, USART0_DmaPowerControl,
+                                   USART0_DmaSend, USART0_DmaReceive, USARTx_Transfer, USART0_DmaGetTxCount,
+                                   USART0_DmaGetRxCount, USART0_DmaControl, USART0_DmaGetStatus,
+                                   USART0_DmaSetModemControl, USARTx_GetModemStatus
+#else
+                                   USART0_InterruptInitialize, USART0_InterruptUninitialize,
+                                   USART0_InterruptPowerControl, USART0_InterruptSend, USART0_InterruptReceive,
+                                   USARTx_Transfer, USART0_InterruptGetTxCount, USART0_InterruptGetRxCount,
+                                   USART0_InterruptControl, USART0_InterruptGetStatus,
+                                   USART0_InterruptSetModemControl, USARTx_GetModemStatus
+#endif
+};
+
+#endif
+
+#if defined(UART1) && RTE_USART1
+/* User needs to provide the implementation for UART1_GetFreq/InitPins/DeinitPins
+in the application for enabling according instance. */
+extern uint32_t UART1_GetFreq(void);
+extern void UART1_InitPins(void);
+extern void UART1_DeinitPins(void);
+
+cmsis_uart_resource_t USART1_Resource = {UART1, UART1_GetFreq, RTE_USART1_IRQ_PRIORITY, RTE_USART1_RTS_HOOK};
+
+#if RTE_USART1_DMA_EN
+
+#if (defined(FSL_FEATURE_SOC_DMA_COUNT) && FSL_FEATURE_SOC_DMA_COUNT)
+
+cmsis_usart_dma_resource_t USART1_DmaResource = {
+    RTE_USART1_DMA_TX_DMA_BASE, RTE_USART1_DMA_TX_CH, RTE_USART1_DMA_TX_DMAMUX_BASE, RTE_USART1_DMA_TX_PERI_SEL,
+    RTE_USART1_DMA_RX_DMA_BASE, RTE_USART1_DMA_RX_CH, RTE_USART1_DMA_RX_DMAMUX_BASE, RTE_USART1_DMA_RX_PERI_SEL,
+};
+
+uart_dma_handle_t USART1_DmaHandle;
+dma_handle_t USART1_DmaTxHandle;
+dma_handle_t USART1_DmaRxHandle;
+
+#if defined(__CC_ARM)
+ARMCC_SECTION("usart1_dma_driver_state")
+cmsis_uart_dma_driver_state_t USART1_DmaDriverState = {
+#else
+cmsis_uart_dma_driver_state_t USART1_DmaDriverState = {
+#endif
+    &USART1_Resource, &USART1_DmaResource, &USART1_DmaHandle, &USART1_DmaTxHandle, &USART1_DmaRxHandle,
+};
+
+static int32_t USART1_DmaInitialize(ARM_USART_SignalEvent_t cb_event)
+{
+    UART1_InitPins();
+    return UART_DmaInitialize(cb_event, &USART1_DmaDriverState);
+}
+
+static int32_t USART1_DmaUninitialize(void)
+{
+    UART1_DeinitPins();
+    return UART_DmaUninitialize(&USART1_DmaDriverState);
+}
+
+static int32_t USART1_DmaPowerControl(ARM_POWER_STATE state)
+{
+    return UART_DmaPowerControl(state, &USART1_DmaDriverState);
+}
+
+static int32_t USART1_DmaSend(const void *data, uint32_t num)
+{
+    return UART_DmaSend(data, num, &USART1_DmaDriverState);
+}
+
+static int32_t USART1_DmaReceive(void *data, uint32_t num)
+{
+    return UART_DmaReceive(data, num, &USART1_DmaDriverState);
+}
+
+static uint32_t USART1_DmaGetTxCount(void)
+{
+    return UART_DmaGetTxCount(&USART1_DmaDriverState);
+}
+
+static uint32_t USART1_DmaGetRxCount(void)
+{
+    return UART_DmaGetRxCount(&USART1_DmaDriverState);
+}
+
+static int32_t USART1_DmaControl(uint32_t control, uint32_t arg)
+{
+    return UART_DmaControl(control, arg, &USART1_DmaDriverState);
+}
+
+static ARM_USART_STATUS USART1_DmaGetStatus(void)
+{
+    return UART_DmaGetStatus(&USART1_DmaDriverState);
+}
+
+static int32_t USART1_DmaSetModemControl(ARM_USART_MODEM_CONTROL control)
+{
+    return USART_SetModemControl(USART1_Resource.SetRts, false, control);
+}
+
+#endif
+
+#else
+
+uart_handle_t USART1_Handle;
+#if RTE_USART1_RX_BUFFER_ENABLE
+static uint8_t usart1_rxRingBuffer[RTE_USART1_RX_BUFFER_SIZE];
+#endif
+
+#if defined(__CC_ARM)
+ARMCC_SECTION("usart1_interrupt_driver_state")
+cmsis_uart_interrupt_driver_state_t USART1_InterruptDriverState = {
+#else
+cmsis_uart_interrupt_driver_state_t USART1_InterruptDriverState = {
+#endif
+    &USART1_Resource, &USART1_Handle,
+#if RTE_USART1_RX_BUFFER_ENABLE
+    usart1_rxRingBuffer, RTE_USART1_RX_BUFFER_SIZE,
+#endif
+};
+
+static int32_t USART1_InterruptInitialize(ARM_USART_SignalEvent_t cb_event)
+{
+    UART1_InitPins();
+    return UART_InterruptInitialize(cb_event, &USART1_InterruptDriverState);
+}
+
+static int32_t USART1_InterruptUninitialize(void)
+{
+    UART1_DeinitPins();
+    return UART_InterruptUninitialize(&USART1_InterruptDriverState);
+}
+
+static int32_t USART1_InterruptPowerControl(ARM_POWER_STATE state)
+{
+    return UART_InterruptPowerControl(state, &USART1_InterruptDriverState);
+}
+
+static int32_t USART1_InterruptSend(const void *data, uint32_t num)
+{
+    return UART_InterruptSend(data, num, &USART1_InterruptDriverState);
+}
+
+static int32_t USART1_InterruptReceive(void *data, uint32_t num)
+{
+    return UART_InterruptReceive(data, num, &USART1_InterruptDriverState);
+}
+
+static uint32_t USART1_InterruptGetTxCount(void)
+{
+    return UART_InterruptGetTxCount(&USART1_InterruptDriverState);
+}
+
+static uint32_t USART1_InterruptGetRxCount(void)
+{
+    return UART_InterruptGetRxCount(&USART1_InterruptDriverState);
+}
+
+static int32_t USART1_InterruptControl(uint32_t control, uint32_t arg)
+{
+    return UART_InterruptControl(control, arg, &USART1_InterruptDriverState);
+}
+
+static ARM_USART_STATUS USART1_InterruptGetStatus(void)
+{
+    return UART_InterruptGetStatus(&USART1_InterruptDriverState);
+}
+
+static int32_t USART1_InterruptSetModemControl(ARM_USART_MODEM_CONTROL control)
+{
+    return USART_SetModemControl(USART1_Resource.SetRts, USART1_InterruptDriverState.autoRts, control);
+}
+
+#endif
+
+ARM_DRIVER_USART Driver_USART1 = {USARTx_GetVersion, USARTx_GetCapabilities,
+#if RTE_USART1_DMA_EN
+                                   USART1_DmaInitialize, USART1_DmaUninitialize, USART1_DmaPowerControl,
+                                   USART1_DmaSend, USART1_DmaReceive, USARTx_Transfer, USART1_DmaGetTxCount,
+                                   USART1_DmaGetRxCount, USART1_DmaControl, USART1_DmaGetStatus,
+                                   USART1_DmaSetModemControl, USARTx_GetModemStatus
+#else
+                                   USART1_InterruptInitialize, USART1_InterruptUninitialize,
+                                   USART1_InterruptPowerControl, USART1_InterruptSend, USART1_InterruptReceive,
+                                   USARTx_Transfer, USART1_InterruptGetTxCount, USART1_InterruptGetRxCount,
+                                   USART1_InterruptControl, USART1_InterruptGetStatus,
+                                   USART1_InterruptSetModemControl, USARTx_GetModemStatus
+#endif
+};
+
+#endif
+
+#if defined(UART2) && RTE_USART2
+/* User needs to provide the implementation for UART2_GetFreq/InitPins/DeinitPins
+in the application for enabling according instance. */
+extern uint32_t UART2_GetFreq(void);
+extern void UART2_InitPins(void);
+extern void UART2_DeinitPins(void);
+
+cmsis_uart_resource_t USART2_Resource = {UART2, UART2_GetFreq, RTE_USART2_IRQ_PRIORITY, RTE_USART2_RTS_HOOK};
+
+#if RTE_USART2_DMA_EN
+
+#if (defined(FSL_FEATURE_SOC_DMA_COUNT) && FSL_FEATURE_SOC_DMA_COUNT)
+
+cmsis_usart_dma_resource_t USART2_DmaResource = {
+    RTE_USART2_DMA_TX_DMA_BASE, RTE_USART2_DMA_TX_CH, RTE_USART2_DMA_TX_DMAMUX_BASE, RTE_USART2_DMA_TX_PERI_SEL,
+    RTE_USART2_DMA_RX_DMA_BASE, RTE_USART2_DMA_RX_CH, RTE_USART2_DMA_RX_DMAMUX_BASE, RTE_USART2_DMA_RX_PERI_SEL,
+};
+
+uart_dma_handle_t USART2_DmaHandle;
+dma_handle_t USART2_DmaTxHandle;
+dma_handle_t USART2_DmaRxHandle;
+
+#if defined(__CC_ARM)
+ARMCC_SECTION("usart2_dma_driver_state")
+cmsis_uart_dma_driver_state_t USART2_DmaDriverState = {
+#else
+cmsis_uart_dma_driver_state_t USART2_DmaDriverState = {
+#endif
+    &USART2_Resource, &USART2_DmaResource, &USART2_DmaHandle, &USART2_DmaTxHandle, &USART2_DmaRxHandle,
+};
+
+static int32_t USART2_DmaInitialize(ARM_USART_SignalEvent_t cb_event)
+{
+    UART2_InitPins();
+    return UART_DmaInitialize(cb_event, &USART2_DmaDriverState);
+}
+
+static int32_t USART2_DmaUninitialize(void)
+{
+    UART2_DeinitPins();
+    return UART_DmaUninitialize(&USART2_DmaDriverState);
+}
+
+static int32_t USART2_DmaPowerControl(ARM_POWER_STATE state)
+{
+    return UART_DmaPowerControl(state, &USART2_DmaDriverState);
+}
+
+static int32_t USART2_DmaSend(const void *data, uint32_t num)
+{
+    return UART_DmaSend(data, num, &USART2_DmaDriverState);
+}
+
+static int32_t USART2_DmaReceive(void *data, uint32_t num)
+{
+    return UART_DmaReceive(data, num, &USART2_DmaDriverState);
+}
+
+static uint32_t USART2_DmaGetTxCount(void)
+{
+    return UART_DmaGetTxCount(&USART2_DmaDriverState);
+}
+
+static uint32_t USART2_DmaGetRxCount(void)
+{
+    return UART_DmaGetRxCount(&USART2_DmaDriverState);
+}
+
+static int32_t USART2_DmaControl(uint32_t control, uint32_t arg)
+{
+    return UART_DmaControl(control, arg, &USART2_DmaDriverState);
+}
+
+static ARM_USART_STATUS USART2_DmaGetStatus(void)
+{
+    return UART_DmaGetStatus(&USART2_DmaDriverState);
+}
+
+static int32_t USART2_DmaSetModemControl(ARM_USART_MODEM_CONTROL control)
+{
+    return USART_SetModemControl(USART2_Resource.SetRts, false, control);
+}
+
+#endif
+
+#else
+
+uart_handle_t USART2_Handle;
+#if RTE_USART2_RX_BUFFER_ENABLE
+static uint8_t usart2_rxRingBuffer[RTE_USART2_RX_BUFFER_SIZE];
+#endif
+
+#if defined(__CC_ARM)
+ARMCC_SECTION("usart2_interrupt_driver_state")
+cmsis_uart_interrupt_driver_state_t USART2_InterruptDriverState = {
+#else
+cmsis_uart_interrupt_driver_state_t USART2_InterruptDriverState = {
+#endif
+    &USART2_Resource, &USART2_Handle,
+#if RTE_USART2_RX_BUFFER_ENABLE
+    usart2_rxRingBuffer, RTE_USART2_RX_BUFFER_SIZE,
+#endif
+};
+
+static int32_t USART2_InterruptInitialize(ARM_USART_SignalEvent_t cb_event)
+{
+    UART2_InitPins();
+    return UART_InterruptInitialize(cb_event, &USART2_InterruptDriverState);
+}
+
+static int32_t USART2_InterruptUninitialize(void)
+{
+    UART2_DeinitPins();
+    return UART_InterruptUninitialize(&USART2_InterruptDriverState);
+}
+
+static int32_t USART2_InterruptPowerControl(ARM_POWER_STATE state)
+{
+    return UART_InterruptPowerControl(state, &USART2_InterruptDriverState);
+}
+
+static int32_t USART2_InterruptSend(const void *data, uint32_t num)
+{
+    return UART_InterruptSend(data, num, &USART2_InterruptDriverState);
+}
+
+static int32_t USART2_InterruptReceive(void *data, uint32_t num)
+{
+    return UART_InterruptReceive(data, num, &USART2_InterruptDriverState);
+}
+
+static uint32_t USART2_InterruptGetTxCount(void)
+{
+    return UART_InterruptGetTxCount(&USART2_InterruptDriverState);
+}
+
+static uint32_t USART2_InterruptGetRxCount(void)
+{
+    return UART_InterruptGetRxCount(&USART2_InterruptDriverState);
+}
+
+static int32_t USART2_InterruptControl(uint32_t control, uint32_t arg)
+{
+    return UART_InterruptControl(control, arg, &USART2_InterruptDriverState);
+}
+
+static ARM_USART_STATUS USART2_InterruptGetStatus(void)
+{
+    return UART_InterruptGetStatus(&USART2_InterruptDriverState);
+}
+
+static int32_t USART2_InterruptSetModemControl(ARM_USART_MODEM_CONTROL control)
+{
+    return USART_SetModemControl(USART2_Resource.SetRts, USART2_InterruptDriverState.autoRts, control);
+}
+
+#endif
+
+ARM_DRIVER_USART Driver_USART2 = {USARTx_GetVersion, USARTx_GetCapabilities,
+#if RTE_USART2_DMA_EN
+                                   USART2_DmaInitialize, USART2_DmaUninitialize, USART2_DmaPowerControl,
+                                   USART2_DmaSend, USART2_DmaReceive, USARTx_Transfer, USART2_DmaGetTxCount,
+                                   USART2_DmaGetRxCount, USART2_DmaControl, USART2_DmaGetStatus,
+                                   USART2_DmaSetModemControl, USARTx_GetModemStatus
+#else
+                                   USART2_InterruptInitialize, USART2_InterruptUninitialize,
+                                   USART2_InterruptPowerControl, USART2_InterruptSend, USART2_InterruptReceive,
+                                   USARTx_Transfer, USART2_InterruptGetTxCount, USART2_InterruptGetRxCount,
+                                   USART2_InterruptControl, USART2_InterruptGetStatus,
+                                   USART2_InterruptSetModemControl, USARTx_GetModemStatus
+#endif
+};
+
+#endif
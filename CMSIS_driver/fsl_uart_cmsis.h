@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2013-2016 ARM Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+
+ * Copyright (c) 2016, Freescale Semiconductor, Inc.
+ * Copyright 2016-2017 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _FSL_UART_CMSIS_H_
+#define _FSL_UART_CMSIS_H_
+#include "fsl_common.h"
+#include "Driver_USART.h"
+#include "RTE_Device.h"
+#if (defined(FSL_FEATURE_SOC_LPSCI_COUNT) && FSL_FEATURE_SOC_LPSCI_COUNT)
+#include "fsl_lpsci.h"
+#endif
+#include "fsl_uart.h"
+#if (defined(FSL_FEATURE_SOC_DMAMUX_COUNT) && FSL_FEATURE_SOC_DMAMUX_COUNT)
+#include "fsl_dmamux.h"
+#endif
+#if (defined(FSL_FEATURE_SOC_DMA_COUNT) && FSL_FEATURE_SOC_DMA_COUNT)
+#include "fsl_dma_manager.h"
+#if (defined(FSL_FEATURE_SOC_LPSCI_COUNT) && FSL_FEATURE_SOC_LPSCI_COUNT)
+#include "fsl_lpsci_dma.h"
+#endif
+#include "fsl_uart_dma.h"
+#endif
+
+/* Instances left out of RTE_Device.h are disabled. */
+#ifndef RTE_USART0
+#define RTE_USART0 0
+#endif
+#ifndef RTE_USART0_DMA_EN
+#define RTE_USART0_DMA_EN 0
+#endif
+#ifndef RTE_USART1
+#define RTE_USART1 0
+#endif
+#ifndef RTE_USART1_DMA_EN
+#define RTE_USART1_DMA_EN 0
+#endif
+#ifndef RTE_USART2
+#define RTE_USART2 0
+#endif
+#ifndef RTE_USART2_DMA_EN
+#define RTE_USART2_DMA_EN 0
+#endif
+
+/* Default interrupt priorities when RTE_Device.h does not rank the instances. */
+#ifndef RTE_USART0_IRQ_PRIORITY
+#define RTE_USART0_IRQ_PRIORITY 0
+#endif
+#ifndef RTE_USART1_IRQ_PRIORITY
+#define RTE_USART1_IRQ_PRIORITY 0
+#endif
+#ifndef RTE_USART2_IRQ_PRIORITY
+#define RTE_USART2_IRQ_PRIORITY 0
+#endif
+
+/* Interrupt variants receive through a ring buffer of this size when it is enabled. Automatic
+ * RTS flow control needs the ring buffer, the sender is paused when it is 3/4 full. */
+#ifndef RTE_USART0_RX_BUFFER_ENABLE
+#define RTE_USART0_RX_BUFFER_ENABLE 0
+#endif
+#ifndef RTE_USART0_RX_BUFFER_SIZE
+#define RTE_USART0_RX_BUFFER_SIZE 64
+#endif
+#ifndef RTE_USART1_RX_BUFFER_ENABLE
+#define RTE_USART1_RX_BUFFER_ENABLE 0
+#endif
+#ifndef RTE_USART1_RX_BUFFER_SIZE
+#define RTE_USART1_RX_BUFFER_SIZE 64
+#endif
+#ifndef RTE_USART2_RX_BUFFER_ENABLE
+#define RTE_USART2_RX_BUFFER_ENABLE 0
+#endif
+#ifndef RTE_USART2_RX_BUFFER_SIZE
+#define RTE_USART2_RX_BUFFER_SIZE 64
+#endif
+
+/* The UARTs of this family have no RTS pin. An instance gets an RTS line by naming a
+ * void f(bool active) function that drives a GPIO, active meaning ready to receive. */
+#ifndef RTE_USART0_RTS_HOOK
+#define RTE_USART0_RTS_HOOK NULL
+#endif
+#ifndef RTE_USART1_RTS_HOOK
+#define RTE_USART1_RTS_HOOK NULL
+#endif
+#ifndef RTE_USART2_RTS_HOOK
+#define RTE_USART2_RTS_HOOK NULL
+#endif
+
+#if defined(UART0) && RTE_USART0
+extern ARM_DRIVER_USART Driver_USART0;
+#endif
+
+#if defined(UART1) && RTE_USART1
+extern ARM_DRIVER_USART Driver_USART1;
+#endif
+
+#if defined(UART2) && RTE_USART2
+extern ARM_DRIVER_USART Driver_USART2;
+#endif
+
+#endif
@@ -36,15 +36,106 @@
 #define RTE_I2C1 1
 #define RTE_I2C1_DMA_EN 0
 
-/*I2C configuration*/
+/*I2C configuration (DMA channels come from the DMA manager, DMAMGR_DYNAMIC_ALLOCATE or a fixed number)*/
 #define RTE_I2C0_Master_DMA_BASE DMA0
-#define RTE_I2C0_Master_DMA_CH 0
+#define RTE_I2C0_Master_DMA_CH DMAMGR_DYNAMIC_ALLOCATE
 #define RTE_I2C0_Master_DMAMUX_BASE DMAMUX0
 #define RTE_I2C0_Master_PERI_SEL kDmaRequestMux0I2C0
 
 #define RTE_I2C1_Master_DMA_BASE DMA0
-#define RTE_I2C1_Master_DMA_CH 1
+#define RTE_I2C1_Master_DMA_CH DMAMGR_DYNAMIC_ALLOCATE
 #define RTE_I2C1_Master_DMAMUX_BASE DMAMUX0
 #define RTE_I2C1_Master_PERI_SEL kDmaRequestMux0I2C1
 
+/*USART driver name mapping
+ *  USART0 is the LPSCI (UART0), owned by the debug console unless that is moved off it
+ *  USART1/USART2 are the plain UARTs, free on this board
+ */
+#define RTE_USART0 0
+#define RTE_USART0_DMA_EN 0
+#define RTE_USART1 0
+#define RTE_USART1_DMA_EN 0
+#define RTE_USART2 0
+#define RTE_USART2_DMA_EN 0
+
+/*USART configuration*/
+#define RTE_USART0_DMA_TX_CH DMAMGR_DYNAMIC_ALLOCATE
+#define RTE_USART0_DMA_TX_PERI_SEL kDmaRequestMux0LPSCI0Tx
+#define RTE_USART0_DMA_TX_DMAMUX_BASE DMAMUX0
+#define RTE_USART0_DMA_TX_DMA_BASE DMA0
+#define RTE_USART0_DMA_RX_CH DMAMGR_DYNAMIC_ALLOCATE
+#define RTE_USART0_DMA_RX_PERI_SEL kDmaRequestMux0LPSCI0Rx
+#define RTE_USART0_DMA_RX_DMAMUX_BASE DMAMUX0
+#define RTE_USART0_DMA_RX_DMA_BASE DMA0
+
+#define RTE_USART1_DMA_TX_CH DMAMGR_DYNAMIC_ALLOCATE
+#define RTE_USART1_DMA_TX_PERI_SEL kDmaRequestMux0UART1Tx
+#define RTE_USART1_DMA_TX_DMAMUX_BASE DMAMUX0
+#define RTE_USART1_DMA_TX_DMA_BASE DMA0
+#define RTE_USART1_DMA_RX_CH DMAMGR_DYNAMIC_ALLOCATE
+#define RTE_USART1_DMA_RX_PERI_SEL kDmaRequestMux0UART1Rx
+#define RTE_USART1_DMA_RX_DMAMUX_BASE DMAMUX0
+#define RTE_USART1_DMA_RX_DMA_BASE DMA0
+
+#define RTE_USART2_DMA_TX_CH DMAMGR_DYNAMIC_ALLOCATE
+#define RTE_USART2_DMA_TX_PERI_SEL kDmaRequestMux0UART2Tx
+#define RTE_USART2_DMA_TX_DMAMUX_BASE DMAMUX0
+#define RTE_USART2_DMA_TX_DMA_BASE DMA0
+#define RTE_USART2_DMA_RX_CH DMAMGR_DYNAMIC_ALLOCATE
+#define RTE_USART2_DMA_RX_PERI_SEL kDmaRequestMux0UART2Rx
+#define RTE_USART2_DMA_RX_DMAMUX_BASE DMAMUX0
+#define RTE_USART2_DMA_RX_DMA_BASE DMA0
+
+/*SPI driver name mapping
+ *  SPI0 is the optional high-speed slave link to the master (PTD0-PTD3), built with APP_SPI_LINK_ENABLE
+ */
+#if defined(APP_SPI_LINK_ENABLE) && APP_SPI_LINK_ENABLE
+#define RTE_SPI0 1
+#else
+#define RTE_SPI0 0
+#endif
+#define RTE_SPI0_DMA_EN 1
+#define RTE_SPI1 0
+#define RTE_SPI1_DMA_EN 0
+
+/*SPI configuration*/
+#define RTE_SPI0_DMA_TX_CH DMAMGR_DYNAMIC_ALLOCATE
+#define RTE_SPI0_DMA_TX_PERI_SEL kDmaRequestMux0SPI0Tx
+#define RTE_SPI0_DMA_TX_DMAMUX_BASE DMAMUX0
+#define RTE_SPI0_DMA_TX_DMA_BASE DMA0
+#define RTE_SPI0_DMA_RX_CH DMAMGR_DYNAMIC_ALLOCATE
+#define RTE_SPI0_DMA_RX_PERI_SEL kDmaRequestMux0SPI0Rx
+#define RTE_SPI0_DMA_RX_DMAMUX_BASE DMAMUX0
+#define RTE_SPI0_DMA_RX_DMA_BASE DMA0
+
+#define RTE_SPI1_DMA_TX_CH DMAMGR_DYNAMIC_ALLOCATE
+#define RTE_SPI1_DMA_TX_PERI_SEL kDmaRequestMux0SPI1Tx
+#define RTE_SPI1_DMA_TX_DMAMUX_BASE DMAMUX0
+#define RTE_SPI1_DMA_TX_DMA_BASE DMA0
+#define RTE_SPI1_DMA_RX_CH DMAMGR_DYNAMIC_ALLOCATE
+#define RTE_SPI1_DMA_RX_PERI_SEL kDmaRequestMux0SPI1Rx
+#define RTE_SPI1_DMA_RX_DMAMUX_BASE DMAMUX0
+#define RTE_SPI1_DMA_RX_DMA_BASE DMA0
+
+/*Interrupt priorities (Cortex-M0+ has 4 levels, 0 is the most urgent)
+ *  0: I2C1 slave - must ack every byte before the master's clock stretch limit
+ *     SPI0 slave without DMA - the master does not wait, a late byte is lost
+ *  1: I2C0 master - paced by this device, tolerates latency
+ *     SPI0 slave on DMA - the bytes move without the CPU, only the frame end interrupts;
+ *     at 0 its two completions would hold the I2C1 byte past one byte time
+ *  2: debug console UART (BOARD_UART_IRQ_PRIORITY in board.h)
+ *  3: everything else, SysTick and the idle loop
+ */
+#define RTE_I2C0_IRQ_PRIORITY 1
+#define RTE_I2C1_IRQ_PRIORITY 0
+#define RTE_USART0_IRQ_PRIORITY 2
+#define RTE_USART1_IRQ_PRIORITY 2
+#define RTE_USART2_IRQ_PRIORITY 2
+#if RTE_SPI0_DMA_EN
+#define RTE_SPI0_IRQ_PRIORITY 1
+#else
+#define RTE_SPI0_IRQ_PRIORITY 0
+#endif
+#define RTE_SPI1_IRQ_PRIORITY 1
+
 #endif /* __RTE_DEVICE_H */
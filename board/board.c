@@ -54,4 +54,11 @@ void BOARD_InitDebugConsole(void)
 
     uartClkSrcFreq = BOARD_DEBUG_UART_CLK_FREQ;
     DbgConsole_Init(BOARD_DEBUG_UART_BASEADDR, BOARD_DEBUG_UART_BAUDRATE, BOARD_DEBUG_UART_TYPE, uartClkSrcFreq);
+    NVIC_SetPriority(BOARD_UART_IRQ, BOARD_UART_IRQ_PRIORITY);
+
+#if BOARD_DEBUG_UART_TX_DMA && (!SDK_DEBUGCONSOLE) && (defined(SDK_DEBUGCONSOLE_UART)) && \
+    DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE
+    /* Without a free DMA channel the console stays on the LPSCI transmit interrupt */
+    (void)DbgConsole_EnableTxDMA(BOARD_DEBUG_UART_DMA_CHANNEL, BOARD_DEBUG_UART_DMA_REQUEST);
+#endif
 }
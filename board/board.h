@@ -48,6 +48,15 @@
 #define BOARD_DEBUG_UART_CLK_FREQ CLOCK_GetCoreSysClkFreq()
 #define BOARD_UART_IRQ UART0_IRQn
 #define BOARD_UART_IRQ_HANDLER UART0_IRQHandler
+/* Console output may wait; it ranks below the I2C interrupts (see RTE_Device.h). */
+#define BOARD_UART_IRQ_PRIORITY 2U
+
+/* Console output is sent by DMA, on a channel from the DMA manager (fsl_dma_manager.h). */
+#ifndef BOARD_DEBUG_UART_TX_DMA
+#define BOARD_DEBUG_UART_TX_DMA 1
+#endif /* BOARD_DEBUG_UART_TX_DMA */
+#define BOARD_DEBUG_UART_DMA_CHANNEL DMAMGR_DYNAMIC_ALLOCATE
+#define BOARD_DEBUG_UART_DMA_REQUEST kDmaRequestMux0LPSCI0Tx
 
 #ifndef BOARD_DEBUG_UART_BAUDRATE
 #define BOARD_DEBUG_UART_BAUDRATE 115200
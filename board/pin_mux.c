@@ -242,6 +242,81 @@ void I2C1_DeinitPins(void)
     /* PORTE1 (pin 2) is disabled */
     PORT_SetPinMux(PORTE, 1U, kPORT_PinDisabledOrAnalog);
 }
+/* clang-format off */
+/*
+ * TEXT BELOW IS USED AS SETTING FOR TOOLS *************************************
+SPI0_InitPins:
+- options: {coreID: core0, enableClock: 'true'}
+- pin_list:
+  - {pin_num: '57', peripheral: SPI0, signal: PCS0_SS, pin_signal: PTD0/SPI0_PCS0/TPM0_CH0}
+  - {pin_num: '58', peripheral: SPI0, signal: SCK, pin_signal: ADC0_SE5b/PTD1/SPI0_SCK/TPM0_CH1}
+  - {pin_num: '59', peripheral: SPI0, signal: MOSI, pin_signal: PTD2/SPI0_MOSI/UART2_RX/TPM0_CH2/SPI0_MISO}
+  - {pin_num: '60', peripheral: SPI0, signal: MISO, pin_signal: PTD3/SPI0_MISO/UART2_TX/TPM0_CH3/SPI0_MOSI}
+ * BE CAREFUL MODIFYING THIS COMMENT - IT IS YAML SETTINGS FOR TOOLS ***********
+ */
+/* clang-format on */
+
+/* FUNCTION ************************************************************************************************************
+ *
+ * Function Name : SPI0_InitPins
+ * Description   : Configures pin routing and optionally pin electrical features.
+ *
+ * END ****************************************************************************************************************/
+void SPI0_InitPins(void)
+{
+    /* Port D Clock Gate Control: Clock enabled */
+    CLOCK_EnableClock(kCLOCK_PortD);
+
+    /* PORTD0 (pin 57) is configured as SPI0_PCS0 */
+    PORT_SetPinMux(PORTD, 0U, kPORT_MuxAlt2);
+
+    /* PORTD1 (pin 58) is configured as SPI0_SCK */
+    PORT_SetPinMux(PORTD, 1U, kPORT_MuxAlt2);
+
+    /* PORTD2 (pin 59) is configured as SPI0_MOSI */
+    PORT_SetPinMux(PORTD, 2U, kPORT_MuxAlt2);
+
+    /* PORTD3 (pin 60) is configured as SPI0_MISO */
+    PORT_SetPinMux(PORTD, 3U, kPORT_MuxAlt2);
+}
+
+/* clang-format off */
+/*
+ * TEXT BELOW IS USED AS SETTING FOR TOOLS *************************************
+SPI0_DeinitPins:
+- options: {coreID: core0, enableClock: 'true'}
+- pin_list:
+  - {pin_num: '57', peripheral: n/a, signal: disabled, pin_signal: PTD0/SPI0_PCS0/TPM0_CH0}
+  - {pin_num: '58', peripheral: n/a, signal: disabled, pin_signal: ADC0_SE5b/PTD1/SPI0_SCK/TPM0_CH1}
+  - {pin_num: '59', peripheral: n/a, signal: disabled, pin_signal: PTD2/SPI0_MOSI/UART2_RX/TPM0_CH2/SPI0_MISO}
+  - {pin_num: '60', peripheral: n/a, signal: disabled, pin_signal: PTD3/SPI0_MISO/UART2_TX/TPM0_CH3/SPI0_MOSI}
+ * BE CAREFUL MODIFYING THIS COMMENT - IT IS YAML SETTINGS FOR TOOLS ***********
+ */
+/* clang-format on */
+
+/* FUNCTION ************************************************************************************************************
+ *
+ * Function Name : SPI0_DeinitPins
+ * Description   : Configures pin routing and optionally pin electrical features.
+ *
+ * END ****************************************************************************************************************/
+void SPI0_DeinitPins(void)
+{
+    /* Port D Clock Gate Control: Clock enabled */
+    CLOCK_EnableClock(kCLOCK_PortD);
+
+    /* PORTD0 (pin 57) is disabled */
+    PORT_SetPinMux(PORTD, 0U, kPORT_PinDisabledOrAnalog);
+
+    /* PORTD1 (pin 58) is disabled */
+    PORT_SetPinMux(PORTD, 1U, kPORT_PinDisabledOrAnalog);
+
+    /* PORTD2 (pin 59) is disabled */
+    PORT_SetPinMux(PORTD, 2U, kPORT_PinDisabledOrAnalog);
+
+    /* PORTD3 (pin 60) is disabled */
+    PORT_SetPinMux(PORTD, 3U, kPORT_PinDisabledOrAnalog);
+}
 /***********************************************************************************************************************
  * EOF
  **********************************************************************************************************************/
@@ -76,6 +76,18 @@ void I2C1_InitPins(void);
  */
 void I2C1_DeinitPins(void);
 
+/*!
+ * @brief Configures pin routing and optionally pin electrical features.
+ *
+ */
+void SPI0_InitPins(void);
+
+/*!
+ * @brief Configures pin routing and optionally pin electrical features.
+ *
+ */
+void SPI0_DeinitPins(void);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -180,6 +180,26 @@ void DMA_CreateHandle(dma_handle_t *handle, DMA_Type *base, uint32_t channel)
     EnableIRQ(s_dmaIRQNumber[dmaInstance][channelIndex]);
 }
 
+void DMA_ReleaseHandle(dma_handle_t *handle)
+{
+    assert(handle != NULL);
+
+    uint32_t dmaInstance;
+    uint32_t channelIndex;
+
+    dmaInstance = DMA_GetInstance(handle->base);
+    channelIndex = (dmaInstance * FSL_FEATURE_DMA_MODULE_CHANNEL) + handle->channel;
+    /* Clear the done flag first, it holds the interrupt request asserted */
+    handle->base->DMA[handle->channel].DSR_BCR |= DMA_DSR_BCR_DONE(true);
+    DisableIRQ(s_dmaIRQNumber[dmaInstance][channelIndex]);
+    NVIC_ClearPendingIRQ(s_dmaIRQNumber[dmaInstance][channelIndex]);
+    /* Remove handle */
+    if (s_DMAHandle[channelIndex] == handle)
+    {
+        s_DMAHandle[channelIndex] = NULL;
+    }
+}
+
 void DMA_PrepareTransfer(dma_transfer_config_t *config,
                          void *srcAddr,
                          uint32_t srcWidth,
@@ -262,6 +282,8 @@ status_t DMA_SubmitTransfer(dma_handle_t *handle, const dma_transfer_config_t *c
     {
         return kStatus_DMA_Busy;
     }
+    handle->sgCount = 0U;
+    handle->sgRemainingBytes = 0U;
     DMA_ResetChannel(handle->base, handle->channel);
     DMA_SetTransferConfig(handle->base, handle->channel, config);
     if (options & kDMA_EnableInterrupt)
@@ -271,6 +293,58 @@ status_t DMA_SubmitTransfer(dma_handle_t *handle, const dma_transfer_config_t *c
     return kStatus_Success;
 }
 
+status_t DMA_SubmitScatterGather(dma_handle_t *handle,
+                                 const dma_transfer_config_t *config,
+                                 const dma_sg_segment_t *segments,
+                                 uint32_t segmentCount)
+{
+    assert(config != NULL);
+    assert(segments != NULL);
+
+    dma_transfer_config_t segmentConfig = *config;
+    status_t status;
+    uint32_t i;
+
+    /* Skip empty segments, a zero byte count would never complete */
+    while ((segmentCount != 0U) && (segments->dataSize == 0U))
+    {
+        segments++;
+        segmentCount--;
+    }
+    if (segmentCount == 0U)
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    /* The first non-empty segment supplies the memory side of the first block */
+    if (config->enableSrcIncrement)
+    {
+        segmentConfig.srcAddr = (uint32_t)segments->data;
+    }
+    else
+    {
+        segmentConfig.destAddr = (uint32_t)segments->data;
+    }
+    segmentConfig.transferSize = segments->dataSize;
+
+    /* Every segment needs the interrupt, it loads the next one */
+    status = DMA_SubmitTransfer(handle, &segmentConfig, kDMA_EnableInterrupt);
+    if (status != kStatus_Success)
+    {
+        return status;
+    }
+
+    handle->sgGather = config->enableSrcIncrement;
+    handle->sgNext = &segments[1];
+    for (i = 1U; i < segmentCount; i++)
+    {
+        handle->sgRemainingBytes += segments[i].dataSize;
+    }
+    handle->sgCount = segmentCount - 1U;
+
+    return kStatus_Success;
+}
+
 void DMA_AbortTransfer(dma_handle_t *handle)
 {
     assert(handle != NULL);
@@ -278,14 +352,54 @@ void DMA_AbortTransfer(dma_handle_t *handle)
     handle->base->DMA[handle->channel].DCR &= ~DMA_DCR_ERQ_MASK;
     /* clear all status bit */
     handle->base->DMA[handle->channel].DSR_BCR |= DMA_DSR_BCR_DONE(true);
+    /* drop the segments not started yet */
+    handle->sgCount = 0U;
+    handle->sgRemainingBytes = 0U;
 }
 
 void DMA_HandleIRQ(dma_handle_t *handle)
 {
     assert(handle != NULL);
 
+    /* Keep the error flags for the callback, clearing DONE clears them too */
+    handle->status = DMA_GetChannelStatusFlags(handle->base, handle->channel);
     /* Clear interrupt pending bit */
     DMA_ClearChannelStatusFlags(handle->base, handle->channel, kDMA_TransactionsDoneFlag);
+
+    /* A segment that ended on an error ends the chain, the callback sees the flags */
+    if (handle->status & (kDMA_ConfigurationErrorFlag | kDMA_BusErrorOnSourceFlag | kDMA_BusErrorOnDestinationFlag))
+    {
+        handle->sgCount = 0U;
+        handle->sgRemainingBytes = 0U;
+    }
+
+    /* Scatter-gather: the channel request was auto-disabled, load the next segment and re-enable it */
+    while (handle->sgCount && (handle->sgNext->dataSize == 0U))
+    {
+        handle->sgNext++;
+        handle->sgCount--;
+    }
+    if (handle->sgCount)
+    {
+        const dma_sg_segment_t *segment = handle->sgNext;
+        uint32_t channel = handle->channel;
+
+        handle->sgNext++;
+        handle->sgCount--;
+        handle->sgRemainingBytes -= segment->dataSize;
+        if (handle->sgGather)
+        {
+            handle->base->DMA[channel].SAR = (uint32_t)segment->data;
+        }
+        else
+        {
+            handle->base->DMA[channel].DAR = (uint32_t)segment->data;
+        }
+        handle->base->DMA[channel].DSR_BCR = DMA_DSR_BCR_BCR(segment->dataSize);
+        handle->base->DMA[channel].DCR |= DMA_DCR_ERQ_MASK;
+        return;
+    }
+
     if (handle->callback)
     {
         (handle->callback)(handle, handle->userData);
@@ -45,8 +45,8 @@
 
 /*! @name Driver version */
 /*@{*/
-/*! @brief DMA driver version 2.0.1. */
-#define FSL_DMA_DRIVER_VERSION (MAKE_VERSION(2, 0, 1))
+/*! @brief DMA driver version 2.1.0. */
+#define FSL_DMA_DRIVER_VERSION (MAKE_VERSION(2, 1, 0))
 /*@}*/
 
 /*! @brief status flag for the DMA driver. */
@@ -142,6 +142,13 @@ typedef struct _dma_channel_link_config
     uint32_t channel2;                /*!< The index of channel 2. */
 } dma_channel_link_config_t;
 
+/*! @brief One memory block of a scatter-gather transfer */
+typedef struct _dma_sg_segment
+{
+    void *data;        /*!< Memory address of the segment. */
+    uint32_t dataSize; /*!< Segment length in bytes, a multiple of the memory side transfer size. */
+} dma_sg_segment_t;
+
 struct _dma_handle;
 /*! @brief Callback function prototype for the DMA driver. */
 typedef void (*dma_callback)(struct _dma_handle *handle, void *userData);
@@ -153,6 +160,13 @@ typedef struct _dma_handle
     uint8_t channel;       /*!< DMA channel used. */
     dma_callback callback; /*!< DMA callback function.*/
     void *userData;        /*!< Callback parameter. */
+
+    const dma_sg_segment_t *sgNext; /*!< Next segment of a scatter-gather transfer. */
+    uint32_t sgCount;               /*!< Segments left after the running one. */
+    uint32_t sgRemainingBytes;      /*!< Bytes in the segments left after the running one. */
+    bool sgGather;                  /*!< Segments replace the source address, else the destination. */
+    uint32_t status;                /*!< Channel status flags that raised the last interrupt, see
+                                         _dma_channel_status_flags. */
 } dma_handle_t;
 
 /*******************************************************************************
@@ -497,6 +511,18 @@ static inline void DMA_ClearChannelStatusFlags(DMA_Type *base, uint32_t channel,
  */
 void DMA_CreateHandle(dma_handle_t *handle, DMA_Type *base, uint32_t channel);
 
+/*!
+ * @brief Detaches the DMA handle from its channel.
+ *
+ * This function clears the channel done flag and any channel interrupt still pending in the
+ * NVIC, disables the channel interrupt and removes the handle from the interrupt routing, so a
+ * late completion cannot call into the handle. Abort the transfer first, and call this function
+ * with interrupts masked when the channel interrupt may run meanwhile.
+ *
+ * @param handle DMA handle pointer.
+ */
+void DMA_ReleaseHandle(dma_handle_t *handle);
+
 /*!
  * @brief Sets the DMA callback function.
  *
@@ -545,6 +571,48 @@ void DMA_PrepareTransfer(dma_transfer_config_t *config,
  */
 status_t DMA_SubmitTransfer(dma_handle_t *handle, const dma_transfer_config_t *config, uint32_t options);
 
+/*!
+ * @brief Submits a transfer made of several memory segments.
+ *
+ * The configuration is prepared by DMA_PrepareTransfer as for a single block. The segments
+ * supply the source address when the source increments (gather, memory to peripheral or
+ * memory), otherwise the destination address (scatter, peripheral to memory), and the byte
+ * count; the configuration's address and size on that side are replaced by the first non-empty
+ * segment. The other side goes on where the previous segment ended, or stays on the peripheral
+ * data register. Empty segments are skipped.
+ *
+ * The channel interrupt loads each next segment and re-enables the channel request, the callback
+ * runs once after the last segment, or after the first segment that ends with a configuration or
+ * bus error, with the error flags in the handle status. Between segments the peripheral waits for one interrupt
+ * latency, a receiving peripheral must buffer that long. Start the transfer with
+ * DMA_StartTransfer; a memory to memory transfer needs an always-on request source.
+ *
+ * @param handle DMA handle pointer.
+ * @param config Transfer configuration of the first segment.
+ * @param segments Segments of the transfer, kept by the caller until the transfer completes.
+ * @param segmentCount Number of segments.
+ * @retval kStatus_Success It indicates that the DMA submit transfer request succeeded.
+ * @retval kStatus_DMA_Busy It indicates that the DMA is busy. Submit transfer request is not allowed.
+ * @retval kStatus_InvalidArgument The segments hold no data.
+ */
+status_t DMA_SubmitScatterGather(dma_handle_t *handle,
+                                 const dma_transfer_config_t *config,
+                                 const dma_sg_segment_t *segments,
+                                 uint32_t segmentCount);
+
+/*!
+ * @brief Gets the bytes not transferred yet of the handle's transfer, all segments included.
+ *
+ * @param handle DMA handle pointer.
+ * @return The number of bytes which have not been transferred yet.
+ */
+static inline uint32_t DMA_GetTransferRemainingBytes(dma_handle_t *handle)
+{
+    assert(handle != NULL);
+
+    return DMA_GetRemainingBytes(handle->base, handle->channel) + handle->sgRemainingBytes;
+}
+
 /*!
  * @brief DMA starts a transfer.
  *
@@ -591,7 +659,8 @@ void DMA_AbortTransfer(dma_handle_t *handle);
  * @brief DMA IRQ handler for current transfer complete.
  *
  * This function clears the channel interrupt flag and calls
- * the callback function if it is not NULL.
+ * the callback function if it is not NULL. In a scatter-gather
+ * transfer it loads the next segment instead, until the last one.
  *
  * @param handle DMA handle pointer.
  */
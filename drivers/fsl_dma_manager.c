@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2015-2016, Freescale Semiconductor, Inc.
+ * Copyright 2016-2017 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fsl_dma_manager.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Ownership of one DMA0 channel. */
+typedef struct _dmamgr_channel_state
+{
+    dma_handle_t *volatile owner; /*!< Handle the channel was requested with, NULL if free */
+    dma_callback callback;        /*!< Owner callback of a channel released on completion */
+    void *userData;               /*!< Owner callback parameter */
+} dmamgr_channel_state_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*!
+ * @brief Find a free channel, searching from channel 0 for high priority requests.
+ *
+ * @return Channel number, DMAMGR_DYNAMIC_ALLOCATE if all are owned.
+ */
+static uint32_t DMAMGR_FindFreeChannel(dmamgr_channel_priority_t priority);
+
+/*!
+ * @brief Channel callback of a request with releaseOnCompletion.
+ *
+ * @param handle DMA handle of the completed transfer.
+ * @param userData Channel state.
+ */
+static void DMAMGR_CompletionCallback(dma_handle_t *handle, void *userData);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! @brief Owners of the DMA0 channels. */
+static dmamgr_channel_state_t s_dmamgrChannels[FSL_FEATURE_DMA_MODULE_CHANNEL];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static uint32_t DMAMGR_FindFreeChannel(dmamgr_channel_priority_t priority)
+{
+    uint32_t i;
+    uint32_t channel;
+
+    for (i = 0U; i < FSL_FEATURE_DMA_MODULE_CHANNEL; i++)
+    {
+        channel = (priority == kDMAMGR_PriorityHigh) ? i : (FSL_FEATURE_DMA_MODULE_CHANNEL - 1U - i);
+        if (s_dmamgrChannels[channel].owner == NULL)
+        {
+            return channel;
+        }
+    }
+
+    return DMAMGR_DYNAMIC_ALLOCATE;
+}
+
+static void DMAMGR_CompletionCallback(dma_handle_t *handle, void *userData)
+{
+    dmamgr_channel_state_t *state = (dmamgr_channel_state_t *)userData;
+    dma_callback callback = state->callback;
+    void *callbackData = state->userData;
+
+    /* Free the channel first, the owner may request one again from its callback */
+    DMAMGR_ReleaseChannel(handle);
+
+    if (callback)
+    {
+        callback(handle, callbackData);
+    }
+}
+
+void DMAMGR_GetDefaultChannelConfig(dmamgr_channel_config_t *config)
+{
+    assert(config);
+
+    config->requestSource = (uint32_t)kDmaRequestMux0AlwaysOn60;
+    config->channel = DMAMGR_DYNAMIC_ALLOCATE;
+    config->priority = kDMAMGR_PriorityLow;
+    config->releaseOnCompletion = false;
+    config->callback = NULL;
+    config->userData = NULL;
+}
+
+status_t DMAMGR_RequestChannel(dma_handle_t *handle, const dmamgr_channel_config_t *config)
+{
+    assert(handle && config);
+
+    dmamgr_channel_state_t *state;
+    uint32_t channel = config->channel;
+    uint32_t primask;
+
+    if ((channel != DMAMGR_DYNAMIC_ALLOCATE) && (channel >= FSL_FEATURE_DMA_MODULE_CHANNEL))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    /* Claim the channel atomically, owners request and release from interrupts too */
+    primask = DisableGlobalIRQ();
+    if (channel == DMAMGR_DYNAMIC_ALLOCATE)
+    {
+        channel = DMAMGR_FindFreeChannel(config->priority);
+        if (channel == DMAMGR_DYNAMIC_ALLOCATE)
+        {
+            EnableGlobalIRQ(primask);
+            return kStatus_DMAMGR_NoFreeChannel;
+        }
+    }
+    else if (s_dmamgrChannels[channel].owner != NULL)
+    {
+        EnableGlobalIRQ(primask);
+        return kStatus_DMAMGR_ChannelOccupied;
+    }
+    state = &s_dmamgrChannels[channel];
+    state->owner = handle;
+    EnableGlobalIRQ(primask);
+
+    DMAMUX_Init(DMAMUX0);
+    DMA_Init(DMA0);
+
+    /* The source can only be changed while the DMAMUX channel is disabled */
+    DMAMUX_DisableChannel(DMAMUX0, channel);
+    DMAMUX_SetSource(DMAMUX0, channel, config->requestSource);
+    DMAMUX_EnableChannel(DMAMUX0, channel);
+
+    /* Routes the channel interrupt to this handle */
+    DMA_CreateHandle(handle, DMA0, channel);
+
+    if (config->releaseOnCompletion)
+    {
+        state->callback = config->callback;
+        state->userData = config->userData;
+        DMA_SetCallback(handle, DMAMGR_CompletionCallback, state);
+    }
+    else
+    {
+        DMA_SetCallback(handle, config->callback, config->userData);
+    }
+
+    return kStatus_Success;
+}
+
+status_t DMAMGR_ReleaseChannel(dma_handle_t *handle)
+{
+    assert(handle);
+
+    uint32_t channel = handle->channel;
+    uint32_t primask;
+
+    primask = DisableGlobalIRQ();
+    if ((channel >= FSL_FEATURE_DMA_MODULE_CHANNEL) || (s_dmamgrChannels[channel].owner != handle))
+    {
+        EnableGlobalIRQ(primask);
+        return kStatus_DMAMGR_ChannelNotUsed;
+    }
+
+    /* Stop the transfer and its interrupt, a stale completion must not reach the next owner */
+    DMA_AbortTransfer(handle);
+    DMA_ResetChannel(handle->base, channel);
+    DMA_ReleaseHandle(handle);
+    DMAMUX_DisableChannel(DMAMUX0, channel);
+
+    s_dmamgrChannels[channel].owner = NULL;
+    EnableGlobalIRQ(primask);
+
+    return kStatus_Success;
+}
+
+bool DMAMGR_IsChannelOccupied(uint32_t channel)
+{
+    if (channel >= FSL_FEATURE_DMA_MODULE_CHANNEL)
+    {
+        return true;
+    }
+
+    return (s_dmamgrChannels[channel].owner != NULL);
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2015-2016, Freescale Semiconductor, Inc.
+ * Copyright 2016-2017 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _FSL_DMA_MANAGER_H_
+#define _FSL_DMA_MANAGER_H_
+
+#include "fsl_common.h"
+#include "fsl_dma.h"
+#include "fsl_dmamux.h"
+
+/*!
+ * @addtogroup dma_manager
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @name Driver version */
+/*@{*/
+/*! @brief DMA manager driver version 2.0.0. */
+#define FSL_DMA_MANAGER_DRIVER_VERSION (MAKE_VERSION(2, 0, 0))
+/*@}*/
+
+/*! @brief Channel number that lets the manager pick any free channel. */
+#define DMAMGR_DYNAMIC_ALLOCATE 0xFFU
+
+/*! @brief DMA manager status */
+enum _dma_manager_status
+{
+    kStatus_DMAMGR_ChannelOccupied = MAKE_STATUS(kStatusGroup_DMAMGR, 0), /*!< Requested channel is owned */
+    kStatus_DMAMGR_ChannelNotUsed = MAKE_STATUS(kStatusGroup_DMAMGR, 1),  /*!< Released channel was not owned */
+    kStatus_DMAMGR_NoFreeChannel = MAKE_STATUS(kStatusGroup_DMAMGR, 2),   /*!< All channels are owned */
+};
+
+/*!
+ * @brief Priority of a dynamically allocated channel
+ *
+ * The DMA arbitrates its channels by fixed priority, channel 0 first. A high priority request takes
+ * the lowest free channel, a low priority one the highest, so requests that cannot be stalled (an SPI
+ * or I2C slave) are served before ones that only cost latency (console output, memory copies).
+ */
+typedef enum _dmamgr_channel_priority
+{
+    kDMAMGR_PriorityLow = 0U, /*!< Take the highest-numbered free channel */
+    kDMAMGR_PriorityHigh,     /*!< Take the lowest-numbered free channel */
+} dmamgr_channel_priority_t;
+
+/*! @brief DMA channel request configuration */
+typedef struct _dmamgr_channel_config
+{
+    uint32_t requestSource;             /*!< DMAMUX request source, an always-on source for memory to memory */
+    uint32_t channel;                   /*!< Channel to take, or DMAMGR_DYNAMIC_ALLOCATE */
+    dmamgr_channel_priority_t priority; /*!< Search order of a dynamic allocation */
+    bool releaseOnCompletion;           /*!< Give the channel back when the first transfer completes */
+    dma_callback callback;              /*!< Completion callback, NULL if the owner installs its own */
+    void *userData;                     /*!< Callback parameter */
+} dmamgr_channel_config_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @name DMA channel allocation
+ * @{
+ */
+
+/*!
+ * @brief Gets the default channel request configuration.
+ *
+ * The default values are:
+ * @code
+ *   config->requestSource = kDmaRequestMux0AlwaysOn60;
+ *   config->channel = DMAMGR_DYNAMIC_ALLOCATE;
+ *   config->priority = kDMAMGR_PriorityLow;
+ *   config->releaseOnCompletion = false;
+ *   config->callback = NULL;
+ *   config->userData = NULL;
+ * @endcode
+ *
+ * @param config Pointer to the configuration structure.
+ */
+void DMAMGR_GetDefaultChannelConfig(dmamgr_channel_config_t *config);
+
+/*!
+ * @brief Takes a DMA0 channel and routes a DMAMUX0 request source to it.
+ *
+ * The DMA and DMAMUX are ungated and the handle is created for the channel, so the channel
+ * interrupt calls this handle's callback until the channel is released. The channel number is
+ * in handle->channel. Can be called from an interrupt.
+ *
+ * With releaseOnCompletion the manager gives the channel back when the first transfer completes,
+ * just before config->callback runs, so the callback may request a channel again. The owner must
+ * then not replace the handle callback with DMA_SetCallback.
+ *
+ * @param handle DMA handle for the channel, static allocated by the owner.
+ * @param config Request configuration.
+ * @retval kStatus_Success                 The channel is owned by the handle.
+ * @retval kStatus_DMAMGR_ChannelOccupied  The requested channel is owned by another handle.
+ * @retval kStatus_DMAMGR_NoFreeChannel    No channel is free for a dynamic request.
+ * @retval kStatus_InvalidArgument         The channel does not exist.
+ */
+status_t DMAMGR_RequestChannel(dma_handle_t *handle, const dmamgr_channel_config_t *config);
+
+/*!
+ * @brief Gives a channel back to the manager.
+ *
+ * A transfer still running is aborted, the channel interrupt is disabled with any pending
+ * request cleared, the handle is detached from the channel and the DMAMUX routing removed.
+ * Can be called from an interrupt.
+ *
+ * @param handle DMA handle the channel was requested with.
+ * @retval kStatus_Success                 The channel is free.
+ * @retval kStatus_DMAMGR_ChannelNotUsed   The handle does not own a channel.
+ */
+status_t DMAMGR_ReleaseChannel(dma_handle_t *handle);
+
+/*!
+ * @brief Checks whether a channel is owned.
+ *
+ * @param channel DMA channel number.
+ * @return true if the channel is owned or does not exist.
+ */
+bool DMAMGR_IsChannelOccupied(uint32_t channel);
+
+/*! @} */
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+/*! @} */
+
+#endif /* _FSL_DMA_MANAGER_H_ */
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2015-2016, Freescale Semiconductor, Inc.
+ * Copyright 2016-2017 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+
+#include "fsl_dma_memory.h"
+#include "fsl_dma_manager.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Largest block, the byte count register is 20 bits wide. */
+#define DMAMEM_MAX_SIZE 0xFFFFFU
+
+/*! @brief State of one memory operation in flight. */
+typedef struct _dmamem_slot
+{
+    dma_handle_t dmaHandle;     /*!< Handle of the channel moving the block */
+    dmamem_callback_t callback; /*!< Operation completion callback */
+    void *userData;             /*!< Callback parameter */
+    uint32_t pattern;           /*!< Fixed source word of a fill */
+    volatile bool busy;         /*!< The slot holds an operation in flight */
+} dmamem_slot_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*!
+ * @brief Channel completion callback, frees the slot and calls the operation callback.
+ *
+ * @param handle DMA handle of the completed transfer.
+ * @param userData Slot of the operation.
+ */
+static void DMAMEM_Callback(dma_handle_t *handle, void *userData);
+
+/*!
+ * @brief Start a block move on a DMA channel.
+ *
+ * @param dst Destination address.
+ * @param src Source address, NULL to fill with the pattern.
+ * @param pattern Fill word, used when src is NULL.
+ * @param size Number of bytes.
+ * @return true if the DMA owns the operation, false if no slot or channel is free.
+ */
+static bool DMAMEM_Start(
+    void *dst, const void *src, uint32_t pattern, size_t size, dmamem_callback_t callback, void *userData);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! @brief One slot per DMA channel, the manager never grants more operations. */
+static dmamem_slot_t s_dmamemSlots[FSL_FEATURE_DMA_MODULE_CHANNEL];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static void DMAMEM_Callback(dma_handle_t *handle, void *userData)
+{
+    dmamem_slot_t *slot = (dmamem_slot_t *)userData;
+    dmamem_callback_t callback = slot->callback;
+    void *callbackData = slot->userData;
+
+    /* The manager already released the channel, free the slot so the callback can start another operation */
+    slot->busy = false;
+
+    if (callback)
+    {
+        callback(callbackData);
+    }
+}
+
+static bool DMAMEM_Start(
+    void *dst, const void *src, uint32_t pattern, size_t size, dmamem_callback_t callback, void *userData)
+{
+    dmamgr_channel_config_t channelConfig;
+    dma_transfer_config_t xferConfig;
+    dmamem_slot_t *slot = NULL;
+    uint32_t alignment;
+    uint32_t width;
+    uint32_t primask;
+    uint32_t i;
+
+    /* Claim a slot atomically, operations can be started from interrupts */
+    primask = DisableGlobalIRQ();
+    for (i = 0U; i < FSL_FEATURE_DMA_MODULE_CHANNEL; i++)
+    {
+        if (!s_dmamemSlots[i].busy)
+        {
+            slot = &s_dmamemSlots[i];
+            slot->busy = true;
+            break;
+        }
+    }
+    EnableGlobalIRQ(primask);
+
+    if (slot == NULL)
+    {
+        return false;
+    }
+
+    slot->callback = callback;
+    slot->userData = userData;
+    slot->pattern = pattern;
+
+    DMAMGR_GetDefaultChannelConfig(&channelConfig);
+    channelConfig.releaseOnCompletion = true;
+    channelConfig.callback = DMAMEM_Callback;
+    channelConfig.userData = slot;
+    if (DMAMGR_RequestChannel(&slot->dmaHandle, &channelConfig) != kStatus_Success)
+    {
+        slot->busy = false;
+        return false;
+    }
+
+    /* A memory move only costs latency, never preempt the peripheral owners */
+    NVIC_SetPriority((IRQn_Type)(DMA0_IRQn + slot->dmaHandle.channel), (1U << __NVIC_PRIO_BITS) - 1U);
+
+    /* Widest unit both addresses and the size are aligned to */
+    alignment = (uint32_t)dst | (uint32_t)size | ((src != NULL) ? (uint32_t)src : 0U);
+    width = ((alignment & 3U) == 0U) ? 4U : (((alignment & 1U) == 0U) ? 2U : 1U);
+
+    DMA_PrepareTransfer(&xferConfig, (src != NULL) ? (void *)src : (void *)&slot->pattern, width, dst, width, size,
+                        kDMA_MemoryToMemory);
+    xferConfig.enableSrcIncrement = (src != NULL);
+
+    /* The always-on request and cycle steal mode move one unit per arbitration, sharing the bus with the CPU */
+    DMA_SubmitTransfer(&slot->dmaHandle, &xferConfig, kDMA_EnableInterrupt);
+    DMA_StartTransfer(&slot->dmaHandle);
+
+    return true;
+}
+
+void DMAMEM_Copy(void *dst, const void *src, size_t size, dmamem_callback_t callback, void *userData)
+{
+    assert(dst && src);
+    assert(size <= DMAMEM_MAX_SIZE);
+
+    uint8_t *d = (uint8_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+    uint32_t head;
+    uint32_t tail;
+
+    if (size >= DMAMEM_CPU_THRESHOLD)
+    {
+        /* Same word alignment: copy the partial words by CPU so the DMA moves 32-bit units */
+        if ((((uint32_t)d ^ (uint32_t)s) & 3U) == 0U)
+        {
+            head = (0U - (uint32_t)d) & 3U;
+            tail = (size - head) & 3U;
+            memcpy(d, s, head);
+            memcpy(d + size - tail, s + size - tail, tail);
+            d += head;
+            s += head;
+            size -= head + tail;
+        }
+
+        if (DMAMEM_Start(d, s, 0U, size, callback, userData))
+        {
+            return;
+        }
+    }
+
+    memcpy(d, s, size);
+    if (callback)
+    {
+        callback(userData);
+    }
+}
+
+void DMAMEM_Set(void *dst, uint8_t value, size_t size, dmamem_callback_t callback, void *userData)
+{
+    assert(dst);
+    assert(size <= DMAMEM_MAX_SIZE);
+
+    uint8_t *d = (uint8_t *)dst;
+    uint32_t head;
+    uint32_t tail;
+
+    if (size >= DMAMEM_CPU_THRESHOLD)
+    {
+        head = (0U - (uint32_t)d) & 3U;
+        tail = (size - head) & 3U;
+        memset(d, value, head);
+        memset(d + size - tail, value, tail);
+        d += head;
+        size -= head + tail;
+
+        if (DMAMEM_Start(d, NULL, value * 0x01010101U, size, callback, userData))
+        {
+            return;
+        }
+    }
+
+    memset(d, value, size);
+    if (callback)
+    {
+        callback(userData);
+    }
+}
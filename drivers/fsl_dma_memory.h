@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2015-2016, Freescale Semiconductor, Inc.
+ * Copyright 2016-2017 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _FSL_DMA_MEMORY_H_
+#define _FSL_DMA_MEMORY_H_
+
+#include "fsl_common.h"
+
+/*!
+ * @addtogroup dma_memory
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @name Driver version */
+/*@{*/
+/*! @brief DMA memory service driver version 2.0.0. */
+#define FSL_DMA_MEMORY_DRIVER_VERSION (MAKE_VERSION(2, 0, 0))
+/*@}*/
+
+/*!
+ * @brief Smallest operation moved by the DMA, in bytes.
+ *
+ * Requesting a channel, programming it and taking the completion interrupt cost a few hundred
+ * cycles. The CPU moves a word every two cycles, so it finishes shorter operations sooner.
+ */
+#ifndef DMAMEM_CPU_THRESHOLD
+#define DMAMEM_CPU_THRESHOLD 256U
+#endif
+
+/*!
+ * @brief Memory operation completion callback.
+ *
+ * @param userData Parameter passed with the operation.
+ */
+typedef void (*dmamem_callback_t)(void *userData);
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @name Memory operations
+ * @{
+ */
+
+/*!
+ * @brief Copies a block of memory with a DMA channel.
+ *
+ * The copy runs on a low priority channel from the DMA manager in cycle-steal mode, so the
+ * CPU keeps the bus between DMA transfers. The middle of the block moves in 32-bit units when
+ * the source and destination have the same word alignment; the unaligned head and tail bytes
+ * are copied by the CPU before the channel starts.
+ *
+ * Blocks shorter than DMAMEM_CPU_THRESHOLD, and any block when no channel is free, are copied
+ * by the CPU. The callback is then called before this function returns.
+ *
+ * @note The blocks must not overlap and must stay valid until the callback is called. The
+ *       callback runs in the DMA interrupt and may start another operation.
+ *
+ * @param dst Destination address.
+ * @param src Source address, RAM or flash.
+ * @param size Number of bytes to copy, at most 0xFFFFF.
+ * @param callback Called when the copy is complete, may be NULL.
+ * @param userData Parameter of the callback.
+ */
+void DMAMEM_Copy(void *dst, const void *src, size_t size, dmamem_callback_t callback, void *userData);
+
+/*!
+ * @brief Fills a block of memory with a byte value with a DMA channel.
+ *
+ * Works as DMAMEM_Copy(), with a 32-bit pattern of the value as a fixed source.
+ *
+ * @param dst Destination address.
+ * @param value Byte value to store.
+ * @param size Number of bytes to fill, at most 0xFFFFF.
+ * @param callback Called when the fill is complete, may be NULL.
+ * @param userData Parameter of the callback.
+ */
+void DMAMEM_Set(void *dst, uint8_t value, size_t size, dmamem_callback_t callback, void *userData);
+
+/*! @} */
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+/*! @} */
+
+#endif /* _FSL_DMA_MEMORY_H_ */
@@ -1645,8 +1645,12 @@ void I2C_SlaveTransferHandleIRQ(I2C_Type *base, void *i2cHandle)
                     handle->callback(base, xfer, handle->userData);
                 }
 
-                /* Clear the transferred count now that we have a new buffer. */
-                xfer->transferredCount = 0;
+                /* Clear the transferred count only if the callback supplied a new buffer, so an
+                 * oversized write does not wipe the count of bytes already stored. */
+                if (xfer->dataSize)
+                {
+                    xfer->transferredCount = 0;
+                }
             }
 
             /* Slave receive, master writing to slave. */
@@ -1694,8 +1698,11 @@ void I2C_SlaveTransferHandleIRQ(I2C_Type *base, void *i2cHandle)
                 handle->callback(base, xfer, handle->userData);
             }
 
-            /* Clear the transferred count now that we have a new buffer. */
-            xfer->transferredCount = 0;
+            /* Clear the transferred count only if the callback supplied a new buffer. */
+            if (xfer->dataSize)
+            {
+                xfer->transferredCount = 0;
+            }
         }
 
         if (handle->transfer.dataSize)
@@ -45,9 +45,6 @@ enum _lpsci_tansfer_state
     kLPSCI_RxParityError   /* Rx parity error */
 };
 
-/* Typedef for interrupt handler. */
-typedef void (*lpsci_isr_t)(UART0_Type *base, lpsci_handle_t *handle);
-
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -60,14 +57,6 @@ typedef void (*lpsci_isr_t)(UART0_Type *base, lpsci_handle_t *handle);
  */
 uint32_t LPSCI_GetInstance(UART0_Type *base);
 
-/*!
- * @brief Get the length of received data in RX ring buffer.
- *
- * @userData handle LPSCI handle pointer.
- * @return Length of received data in RX ring buffer.
- */
-static size_t LPSCI_TransferGetRxRingBufferLength(lpsci_handle_t *handle);
-
 /*!
  * @brief Check whether the RX ring buffer is full.
  *
@@ -121,8 +110,8 @@ static const IRQn_Type s_lpsciIRQ[] = UART0_RX_TX_IRQS;
 static const clock_ip_name_t s_lpsciClock[] = UART0_CLOCKS;
 #endif /* FSL_SDK_DISABLE_DRIVER_CLOCK_CONTROL */
 
-/* LPSCI ISR for transactional APIs. */
-static lpsci_isr_t s_lpsciIsr;
+/* LPSCI ISR for transactional APIs, per instance, see LPSCI_TransferInstallHandler. */
+static lpsci_isr_t s_lpsciIsr[FSL_FEATURE_SOC_LPSCI_COUNT];
 
 /*******************************************************************************
  * Code
@@ -146,7 +135,7 @@ uint32_t LPSCI_GetInstance(UART0_Type *base)
     return instance;
 }
 
-static size_t LPSCI_TransferGetRxRingBufferLength(lpsci_handle_t *handle)
+size_t LPSCI_TransferGetRxRingBufferLength(lpsci_handle_t *handle)
 {
     assert(handle);
 
@@ -599,12 +588,27 @@ void LPSCI_TransferCreateHandle(UART0_Type *base,
     /* Save the handle in global variables to support the double weak mechanism. */
     s_lpsciHandle[instance] = handle;
 
-    s_lpsciIsr = LPSCI_TransferHandleIRQ;
+    s_lpsciIsr[instance] = LPSCI_TransferHandleIRQ;
 
     /* Enable interrupt in NVIC. */
     EnableIRQ(s_lpsciIRQ[instance]);
 }
 
+lpsci_isr_t LPSCI_TransferInstallHandler(UART0_Type *base, lpsci_isr_t isr)
+{
+    uint32_t instance = LPSCI_GetInstance(base);
+    lpsci_isr_t previous;
+    uint32_t regPrimask;
+
+    /* Swap atomically, the interrupt may be taken in between. */
+    regPrimask = DisableGlobalIRQ();
+    previous = s_lpsciIsr[instance];
+    s_lpsciIsr[instance] = isr;
+    EnableGlobalIRQ(regPrimask);
+
+    return previous;
+}
+
 void LPSCI_TransferStartRingBuffer(UART0_Type *base, lpsci_handle_t *handle, uint8_t *ringBuffer, size_t ringBufferSize)
 {
     assert(handle);
@@ -648,6 +652,50 @@ void LPSCI_TransferStopRingBuffer(UART0_Type *base, lpsci_handle_t *handle)
     handle->rxRingBufferTail = 0U;
 }
 
+size_t LPSCI_TransferPeekRxRingBuffer(UART0_Type *base, lpsci_handle_t *handle, lpsci_transfer_t spans[2])
+{
+    assert(handle);
+    assert(handle->rxRingBuffer);
+    assert(spans);
+
+    /* Sample the head once, bytes stored after this are seen by the next peek. */
+    uint16_t head = handle->rxRingBufferHead;
+    uint16_t tail = handle->rxRingBufferTail;
+
+    spans[0].data = &handle->rxRingBuffer[tail];
+    spans[1].data = handle->rxRingBuffer;
+    if (head >= tail)
+    {
+        spans[0].dataSize = (size_t)(head - tail);
+        spans[1].dataSize = 0U;
+    }
+    else
+    {
+        spans[0].dataSize = handle->rxRingBufferSize - tail;
+        spans[1].dataSize = head;
+    }
+
+    return spans[0].dataSize + spans[1].dataSize;
+}
+
+void LPSCI_TransferCommitRxRingBuffer(UART0_Type *base, lpsci_handle_t *handle, size_t count)
+{
+    assert(handle);
+    assert(handle->rxRingBuffer);
+
+    size_t tail;
+
+    /* Disable LPSCI RX IRQ, the overrun path in the handler also moves the tail. */
+    LPSCI_DisableInterrupts(base, kLPSCI_RxDataRegFullInterruptEnable);
+
+    /* Data dropped by an overrun since the peek is not consumed twice. */
+    count = MIN(count, LPSCI_TransferGetRxRingBufferLength(handle));
+    tail = handle->rxRingBufferTail + count;
+    handle->rxRingBufferTail = (tail >= handle->rxRingBufferSize) ? (tail - handle->rxRingBufferSize) : tail;
+
+    LPSCI_EnableInterrupts(base, kLPSCI_RxDataRegFullInterruptEnable);
+}
+
 status_t LPSCI_TransferSendNonBlocking(UART0_Type *base, lpsci_handle_t *handle, lpsci_transfer_t *xfer)
 {
     assert(handle);
@@ -756,21 +804,15 @@ status_t LPSCI_TransferReceiveNonBlocking(UART0_Type *base,
 
                 bytesToReceive -= bytesToCopy;
 
-                /* Copy data from ring buffer to user memory. */
-                for (i = 0U; i < bytesToCopy; i++)
-                {
-                    xfer->data[bytesCurrentReceived++] = handle->rxRingBuffer[handle->rxRingBufferTail];
+                /* Copy data from ring buffer to user memory, at most two contiguous runs. */
+                i = MIN(bytesToCopy, handle->rxRingBufferSize - handle->rxRingBufferTail);
+                memcpy(xfer->data, &handle->rxRingBuffer[handle->rxRingBufferTail], i);
+                memcpy(xfer->data + i, handle->rxRingBuffer, bytesToCopy - i);
+                bytesCurrentReceived = bytesToCopy;
 
-                    /* Wrap to 0. Not use modulo (%) because it might be large and slow. */
-                    if (handle->rxRingBufferTail + 1U == handle->rxRingBufferSize)
-                    {
-                        handle->rxRingBufferTail = 0U;
-                    }
-                    else
-                    {
-                        handle->rxRingBufferTail++;
-                    }
-                }
+                /* Wrap to 0. Not use modulo (%) because it might be large and slow. */
+                i = handle->rxRingBufferTail + bytesToCopy;
+                handle->rxRingBufferTail = (i >= handle->rxRingBufferSize) ? (i - handle->rxRingBufferSize) : i;
             }
 
             /* If ring buffer does not have enough data, still need to read more data. */
@@ -834,7 +876,7 @@ void LPSCI_TransferAbortReceive(UART0_Type *base, lpsci_handle_t *handle)
     {
         /* Disable RX interrupt. */
         LPSCI_DisableInterrupts(base, kLPSCI_RxDataRegFullInterruptEnable | kLPSCI_RxOverrunInterruptEnable |
-                                          kLPSCI_FramingErrorInterruptEnable);
+                                          kLPSCI_FramingErrorInterruptEnable | kLPSCI_IdleLineInterruptEnable);
         /* Disable parity error interrupt when parity mode is enable*/
         if (UART0_C1_PE_MASK & base->C1)
         {
@@ -843,9 +885,50 @@ void LPSCI_TransferAbortReceive(UART0_Type *base, lpsci_handle_t *handle)
     }
 
     handle->rxDataSize = 0U;
+    handle->rxUntilIdle = false;
     handle->rxState = kLPSCI_RxIdle;
 }
 
+status_t LPSCI_TransferReceiveUntilIdleNonBlocking(UART0_Type *base, lpsci_handle_t *handle, lpsci_transfer_t *xfer)
+{
+    assert(handle);
+    assert(xfer);
+    assert(xfer->data);
+    assert(xfer->dataSize);
+
+    /* Received bytes go to the ring buffer instead of xfer->data when it is installed. */
+    if ((0U == xfer->dataSize) || (NULL == xfer->data) || (handle->rxRingBuffer))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    if (kLPSCI_RxBusy == handle->rxState)
+    {
+        return kStatus_LPSCI_RxBusy;
+    }
+
+    handle->rxData = xfer->data;
+    handle->rxDataSize = xfer->dataSize;
+    handle->rxDataSizeAll = xfer->dataSize;
+    handle->rxIdleFrameSize = 0U;
+    handle->rxUntilIdle = true;
+    handle->rxState = kLPSCI_RxBusy;
+
+    /* Drop an idle flag left from before this transfer. */
+    LPSCI_ClearStatusFlags(base, kLPSCI_IdleLineFlag);
+
+    /* Enable RX/Rx overrun/framing error/idle line interrupt. */
+    LPSCI_EnableInterrupts(base, kLPSCI_RxDataRegFullInterruptEnable | kLPSCI_RxOverrunInterruptEnable |
+                                     kLPSCI_FramingErrorInterruptEnable | kLPSCI_IdleLineInterruptEnable);
+    /* Enable parity error interrupt when parity mode is enable*/
+    if (UART0_C1_PE_MASK & base->C1)
+    {
+        LPSCI_EnableInterrupts(base, kLPSCI_ParityErrorInterruptEnable);
+    }
+
+    return kStatus_Success;
+}
+
 status_t LPSCI_TransferGetReceiveCount(UART0_Type *base, lpsci_handle_t *handle, uint32_t *count)
 {
     assert(handle);
@@ -867,11 +950,16 @@ void LPSCI_TransferHandleIRQ(UART0_Type *base, lpsci_handle_t *handle)
 
     uint8_t count;
     uint8_t tempCount;
+    /* While a DMA receive runs the data register belongs to the DMA, errors are only reported. */
+    bool rxDma = (bool)(base->C5 & UART0_C5_RDMAE_MASK);
 
     /* If RX parity error */
     if (UART0_S1_PF_MASK & base->S1)
     {
-        handle->rxState = kLPSCI_RxParityError;
+        if (!rxDma)
+        {
+            handle->rxState = kLPSCI_RxParityError;
+        }
 
         LPSCI_ClearStatusFlags(base, kLPSCI_ParityErrorFlag);
         /* Trigger callback. */
@@ -884,7 +972,10 @@ void LPSCI_TransferHandleIRQ(UART0_Type *base, lpsci_handle_t *handle)
     /* If RX framing error */
     if (UART0_S1_FE_MASK & base->S1)
     {
-        handle->rxState = kLPSCI_RxFramingError;
+        if (!rxDma)
+        {
+            handle->rxState = kLPSCI_RxFramingError;
+        }
 
         LPSCI_ClearStatusFlags(base, kLPSCI_FramingErrorFlag);
         /* Trigger callback. */
@@ -896,7 +987,8 @@ void LPSCI_TransferHandleIRQ(UART0_Type *base, lpsci_handle_t *handle)
     /* If RX overrun. */
     if (UART0_S1_OR_MASK & base->S1)
     {
-        while (UART0_S1_RDRF_MASK & base->S1)
+        /* The byte still held is the DMA's to read. */
+        while ((!rxDma) && (UART0_S1_RDRF_MASK & base->S1))
         {
             (void)base->D;
         }
@@ -909,8 +1001,8 @@ void LPSCI_TransferHandleIRQ(UART0_Type *base, lpsci_handle_t *handle)
         }
     }
 
-    /* Receive data register full */
-    if ((UART0_S1_RDRF_MASK & base->S1) && (UART0_C2_RIE_MASK & base->C2))
+    /* Receive data register full, and the DMA is not the one receiving */
+    if ((UART0_S1_RDRF_MASK & base->S1) && (UART0_C2_RIE_MASK & base->C2) && (!rxDma))
     {
 /* Get the size that can be stored into buffer for this interrupt. */
 #if defined(FSL_FEATURE_LPSCI_HAS_FIFO) && FSL_FEATURE_LPSCI_HAS_FIFO
@@ -938,6 +1030,7 @@ void LPSCI_TransferHandleIRQ(UART0_Type *base, lpsci_handle_t *handle)
             if (!handle->rxDataSize)
             {
                 handle->rxState = kLPSCI_RxIdle;
+                handle->rxUntilIdle = false;
 
                 if (handle->callback)
                 {
@@ -992,7 +1085,7 @@ void LPSCI_TransferHandleIRQ(UART0_Type *base, lpsci_handle_t *handle)
         else if (!handle->rxDataSize)
         {
             LPSCI_DisableInterrupts(base, kLPSCI_RxDataRegFullInterruptEnable | kLPSCI_RxOverrunInterruptEnable |
-                                              kLPSCI_FramingErrorInterruptEnable);
+                                              kLPSCI_FramingErrorInterruptEnable | kLPSCI_IdleLineInterruptEnable);
 
             /* Disable parity error interrupt when parity mode is enable*/
             if (UART0_C1_PE_MASK & base->C1)
@@ -1004,12 +1097,38 @@ void LPSCI_TransferHandleIRQ(UART0_Type *base, lpsci_handle_t *handle)
         {
         }
     }
+    /* Line went idle after a frame, complete a receive-until-idle transfer with what has arrived. */
+    if ((UART0_S1_IDLE_MASK & base->S1) && (UART0_C2_ILIE_MASK & base->C2))
+    {
+        LPSCI_ClearStatusFlags(base, kLPSCI_IdleLineFlag);
+
+        if ((handle->rxUntilIdle) && (handle->rxDataSize != handle->rxDataSizeAll))
+        {
+            handle->rxIdleFrameSize = handle->rxDataSizeAll - handle->rxDataSize;
+            handle->rxDataSize = 0U;
+            handle->rxUntilIdle = false;
+            handle->rxState = kLPSCI_RxIdle;
+
+            LPSCI_DisableInterrupts(base, kLPSCI_RxDataRegFullInterruptEnable | kLPSCI_RxOverrunInterruptEnable |
+                                              kLPSCI_FramingErrorInterruptEnable | kLPSCI_IdleLineInterruptEnable);
+            if (UART0_C1_PE_MASK & base->C1)
+            {
+                LPSCI_DisableInterrupts(base, kLPSCI_ParityErrorInterruptEnable);
+            }
+
+            if (handle->callback)
+            {
+                handle->callback(base, handle, kStatus_LPSCI_IdleLineDetected, handle->userData);
+            }
+        }
+    }
     /* If framing error or parity error happened, stop the RX interrupt when ues no ring buffer */
     if (((handle->rxState == kLPSCI_RxFramingError) || (handle->rxState == kLPSCI_RxParityError)) &&
         (!handle->rxRingBuffer))
     {
+        handle->rxUntilIdle = false;
         LPSCI_DisableInterrupts(base, kLPSCI_RxDataRegFullInterruptEnable | kLPSCI_RxOverrunInterruptEnable |
-                                          kLPSCI_FramingErrorInterruptEnable);
+                                          kLPSCI_FramingErrorInterruptEnable | kLPSCI_IdleLineInterruptEnable);
 
         /* Disable parity error interrupt when parity mode is enable*/
         if (UART0_C1_PE_MASK & base->C1)
@@ -1068,7 +1187,7 @@ void LPSCI_TransferHandleErrorIRQ(UART0_Type *base, lpsci_handle_t *handle)
 #if defined(UART0)
 void UART0_DriverIRQHandler(void)
 {
-    s_lpsciIsr(UART0, s_lpsciHandle[0]);
+    s_lpsciIsr[0](UART0, s_lpsciHandle[0]);
 }
 
 #endif
@@ -65,6 +65,7 @@ enum _lpsci_status
     kStatus_LPSCI_NoiseError = MAKE_STATUS(kStatusGroup_LPSCI, 9),        /*!< LPSCI noise error. */
     kStatus_LPSCI_FramingError = MAKE_STATUS(kStatusGroup_LPSCI, 10),     /*!< LPSCI framing error. */
     kStatus_LPSCI_ParityError = MAKE_STATUS(kStatusGroup_LPSCI, 11),      /*!< LPSCI parity error. */
+    kStatus_LPSCI_IdleLineDetected = MAKE_STATUS(kStatusGroup_LPSCI, 12), /*!< Receive-until-idle frame complete. */
 };
 
 /*! @brief LPSCI parity mode.*/
@@ -175,6 +176,9 @@ typedef struct _lpsci_handle lpsci_handle_t;
 /*! @brief LPSCI transfer callback function. */
 typedef void (*lpsci_transfer_callback_t)(UART0_Type *base, lpsci_handle_t *handle, status_t status, void *userData);
 
+/*! @brief LPSCI interrupt handler of the transactional APIs, see LPSCI_TransferInstallHandler(). */
+typedef void (*lpsci_isr_t)(UART0_Type *base, lpsci_handle_t *handle);
+
 /*<! @brief LPSCI handle used for storing the state among transactional APIs' calling. This structure is only used for
  * transactional APIs. */
 struct _lpsci_handle
@@ -196,6 +200,9 @@ struct _lpsci_handle
 
     volatile uint8_t txState; /*!< TX transfer state. */
     volatile uint8_t rxState; /*!< RX transfer state */
+
+    volatile bool rxUntilIdle; /*!< The pending receive completes on an idle line. */
+    size_t rxIdleFrameSize;    /*!< Length of the last frame completed by an idle line. */
 };
 
 /*******************************************************************************
@@ -603,6 +610,14 @@ void LPSCI_TransferStartRingBuffer(UART0_Type *base,
                                    uint8_t *ringBuffer,
                                    size_t ringBufferSize);
 
+/*!
+ * @brief Gets the number of received bytes waiting in the RX ring buffer.
+ *
+ * @param handle LPSCI handle pointer.
+ * @return Length of received data in RX ring buffer.
+ */
+size_t LPSCI_TransferGetRxRingBufferLength(lpsci_handle_t *handle);
+
 /*!
  * @brief Aborts the background transfer and uninstalls the ring buffer.
  *
@@ -613,6 +628,32 @@ void LPSCI_TransferStartRingBuffer(UART0_Type *base,
  */
 void LPSCI_TransferStopRingBuffer(UART0_Type *base, lpsci_handle_t *handle);
 
+/*!
+ * @brief Gets the received data in the RX ring buffer without copying it.
+ *
+ * Pending data is described by up to two contiguous spans: spans[0] from the tail onwards and
+ * spans[1] from the start of the ring when the data wraps. Parse the data in place, then call
+ * LPSCI_TransferCommitRxRingBuffer() to release the bytes consumed.
+ *
+ * @note The ring keeps filling in the background, but bytes already peeked stay valid until
+ * they are committed unless the ring overruns.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle LPSCI handle pointer.
+ * @param spans Filled with the two spans, unused spans have dataSize 0.
+ * @return Total number of bytes in both spans.
+ */
+size_t LPSCI_TransferPeekRxRingBuffer(UART0_Type *base, lpsci_handle_t *handle, lpsci_transfer_t spans[2]);
+
+/*!
+ * @brief Releases bytes returned by LPSCI_TransferPeekRxRingBuffer() back to the RX ring buffer.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle LPSCI handle pointer.
+ * @param count Bytes consumed from the start of spans[0], continuing into spans[1].
+ */
+void LPSCI_TransferCommitRxRingBuffer(UART0_Type *base, lpsci_handle_t *handle, size_t count);
+
 /*!
  * @brief Transmits a buffer of data using the interrupt method.
  *
@@ -696,6 +737,25 @@ status_t LPSCI_TransferReceiveNonBlocking(UART0_Type *base,
  */
 void LPSCI_TransferAbortReceive(UART0_Type *base, lpsci_handle_t *handle);
 
+/*!
+ * @brief Receives a variable-length frame using the interrupt method.
+ *
+ * This function receives into xfer->data like LPSCI_TransferReceiveNonBlocking, but the
+ * transfer also completes when the line goes idle after at least one byte has arrived.
+ * The callback is then called with @ref kStatus_LPSCI_IdleLineDetected and the frame
+ * length is in the rxIdleFrameSize member of the handle. A frame that fills xfer->dataSize
+ * completes with @ref kStatus_LPSCI_RxIdle as usual.
+ *
+ * Only usable when the RX ring buffer is not installed.
+ *
+ * @param handle LPSCI handle pointer.
+ * @param xfer lpsci transfer structure. See #lpsci_transfer_t.
+ * @retval kStatus_Success Successfully started the receive.
+ * @retval kStatus_LPSCI_RxBusy Previous receive request is not finished.
+ * @retval kStatus_InvalidArgument Invalid argument or the RX ring buffer is in use.
+ */
+status_t LPSCI_TransferReceiveUntilIdleNonBlocking(UART0_Type *base, lpsci_handle_t *handle, lpsci_transfer_t *xfer);
+
 /*!
  * @brief Get the number of bytes that have been received.
  *
@@ -719,6 +779,22 @@ status_t LPSCI_TransferGetReceiveCount(UART0_Type *base, lpsci_handle_t *handle,
  */
 void LPSCI_TransferHandleIRQ(UART0_Type *base, lpsci_handle_t *handle);
 
+/*!
+ * @brief Routes the interrupt of an LPSCI instance to another handler.
+ *
+ * LPSCI_TransferCreateHandle() installs LPSCI_TransferHandleIRQ(). A driver that needs the
+ * interrupt for a while, as the LPSCI DMA driver does for idle line detection, installs its own
+ * handler and puts the returned one back when done. The handler gets the handle created with
+ * LPSCI_TransferCreateHandle(), or NULL, and passes the interrupt on to LPSCI_TransferHandleIRQ().
+ * While the RX DMA request is enabled, LPSCI_TransferHandleIRQ() leaves the data register to the
+ * DMA and only serves transmit and receive errors.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param isr Interrupt handler to install.
+ * @return The handler replaced, NULL if there was none.
+ */
+lpsci_isr_t LPSCI_TransferInstallHandler(UART0_Type *base, lpsci_isr_t isr);
+
 /*!
  * @brief LPSCI Error IRQ handle function.
  *
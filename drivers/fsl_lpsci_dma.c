@@ -40,6 +40,7 @@ typedef struct _lpsci_dma_private_handle
 {
     UART0_Type *base;
     lpsci_dma_handle_t *handle;
+    lpsci_isr_t isr; /* Interrupt handler replaced while waiting for an idle line. */
 } lpsci_dma_private_handle_t;
 
 /* LPSCI DMA transfer handle. */
@@ -58,6 +59,9 @@ enum _lpsci_dma_tansfer_states
 /*<! Private handle only used for internally. */
 static lpsci_dma_private_handle_t s_dmaPrivateHandle[FSL_FEATURE_SOC_LPSCI_COUNT];
 
+/* Array of LPSCI IRQ number. */
+static const IRQn_Type s_lpsciIRQ[] = UART0_RX_TX_IRQS;
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -84,6 +88,40 @@ static void LPSCI_TransferSendDMACallback(dma_handle_t *handle, void *param);
  */
 static void LPSCI_TransferReceiveDMACallback(dma_handle_t *handle, void *param);
 
+/*!
+ * @brief Reloads the byte count of the continuous receive once it has run out.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle LPSCI handle pointer.
+ * @param dmaStatus Channel status flags seen before DONE was cleared.
+ */
+static void LPSCI_TransferReloadRingDMA(UART0_Type *base, lpsci_dma_handle_t *handle, uint32_t dmaStatus);
+
+/*!
+ * @brief Gets the total number of bytes the continuous receive has stored.
+ *
+ * Wraps at 2^32; differences between two readings are still exact.
+ *
+ * @param handle LPSCI handle pointer.
+ */
+static uint32_t LPSCI_TransferGetRingReceivedDMA(lpsci_dma_handle_t *handle);
+
+/*!
+ * @brief Stops waiting for an idle line and gives the interrupt back to its previous handler.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle LPSCI DMA handle pointer.
+ */
+static void LPSCI_TransferStopIdleLineDMA(UART0_Type *base, lpsci_dma_handle_t *handle);
+
+/*!
+ * @brief LPSCI IRQ handler used while a DMA receive waits for an idle line.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param irqHandle Interrupt transfer handle of this instance, NULL if none was created.
+ */
+static void LPSCI_TransferHandleIdleLineDMA(UART0_Type *base, lpsci_handle_t *irqHandle);
+
 /*!
  * @brief Get the LPSCI instance from peripheral base address.
  *
@@ -123,6 +161,17 @@ static void LPSCI_TransferReceiveDMACallback(dma_handle_t *handle, void *param)
     assert(param);
 
     lpsci_dma_private_handle_t *lpsciPrivateHandle = (lpsci_dma_private_handle_t *)param;
+    lpsci_dma_handle_t *lpsciHandle = lpsciPrivateHandle->handle;
+
+    /* Continuous receive: the destination already wrapped back to the ring start, reload the count. */
+    if (lpsciHandle->rxRingBuffer)
+    {
+        LPSCI_TransferReloadRingDMA(lpsciPrivateHandle->base, lpsciHandle, handle->status);
+        return;
+    }
+
+    /* Buffer filled before the line went idle. */
+    LPSCI_TransferStopIdleLineDMA(lpsciPrivateHandle->base, lpsciHandle);
 
     /* Disable LPSCI RX DMA. */
     LPSCI_EnableRxDMA(lpsciPrivateHandle->base, false);
@@ -139,6 +188,43 @@ static void LPSCI_TransferReceiveDMACallback(dma_handle_t *handle, void *param)
     }
 }
 
+static void LPSCI_TransferReloadRingDMA(UART0_Type *base, lpsci_dma_handle_t *handle, uint32_t dmaStatus)
+{
+    dma_handle_t *dmaHandle = handle->rxDmaHandle;
+
+    /* Reached from both the interrupt and the poll, reload only a count that ran out. */
+    if (DMA_GetRemainingBytes(dmaHandle->base, dmaHandle->channel) != 0U)
+    {
+        return;
+    }
+
+    handle->rxRingReloaded += handle->rxRingTransferSize;
+    DMA_SetTransferSize(dmaHandle->base, dmaHandle->channel, handle->rxRingTransferSize);
+
+    /* A request found the count at zero and stopped the channel; the receiver holds no more
+       data while its overrun flag is set, clear it so the reloaded channel gets bytes again. */
+    if ((dmaStatus & kDMA_ConfigurationErrorFlag) && (LPSCI_GetStatusFlags(base) & kLPSCI_RxOverrunFlag))
+    {
+        LPSCI_ClearStatusFlags(base, kLPSCI_RxOverrunFlag);
+        handle->rxRingStallCount++;
+    }
+}
+
+static uint32_t LPSCI_TransferGetRingReceivedDMA(lpsci_dma_handle_t *handle)
+{
+    uint32_t reloaded;
+    uint32_t remaining;
+
+    /* Retry if the reload interrupt ran between the two reads. */
+    do
+    {
+        reloaded = handle->rxRingReloaded;
+        remaining = DMA_GetRemainingBytes(handle->rxDmaHandle->base, handle->rxDmaHandle->channel);
+    } while (reloaded != handle->rxRingReloaded);
+
+    return reloaded + handle->rxRingTransferSize - remaining;
+}
+
 void LPSCI_TransferCreateHandleDMA(UART0_Type *base,
                                    lpsci_dma_handle_t *handle,
                                    lpsci_dma_transfer_callback_t callback,
@@ -230,6 +316,62 @@ status_t LPSCI_TransferSendDMA(UART0_Type *base, lpsci_dma_handle_t *handle, lps
     return status;
 }
 
+status_t LPSCI_TransferSendSegmentsDMA(UART0_Type *base,
+                                    lpsci_dma_handle_t *handle,
+                                    const dma_sg_segment_t *segments,
+                                    uint32_t segmentCount)
+{
+    assert(handle);
+    assert(handle->txDmaHandle);
+    assert(segments);
+
+    dma_transfer_config_t xferConfig;
+    status_t status;
+    uint32_t dataSize = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < segmentCount; i++)
+    {
+        dataSize += segments[i].dataSize;
+    }
+
+    /* Input check. */
+    if (0U == dataSize)
+    {
+        status = kStatus_InvalidArgument;
+    }
+    /* If previous TX not finished. */
+    else if (kLPSCI_TxBusy == handle->txState)
+    {
+        status = kStatus_LPSCI_TxBusy;
+    }
+    else
+    {
+        handle->txState = kLPSCI_TxBusy;
+        handle->txDataSizeAll = dataSize;
+
+        /* Prepare the peripheral side, the DMA driver loads the non-empty segments. */
+        DMA_PrepareTransfer(&xferConfig, segments[0].data, sizeof(uint8_t), (void *)LPSCI_GetDataRegisterAddress(base),
+                            sizeof(uint8_t), segments[0].dataSize, kDMA_MemoryToPeripheral);
+
+        /* Submit transfer, a channel still busy leaves the handle idle. */
+        status = DMA_SubmitScatterGather(handle->txDmaHandle, &xferConfig, segments, segmentCount);
+        if (kStatus_Success == status)
+        {
+            DMA_StartTransfer(handle->txDmaHandle);
+
+            /* Enable LPSCI TX DMA. */
+            LPSCI_EnableTxDMA(base, true);
+        }
+        else
+        {
+            handle->txState = kLPSCI_TxIdle;
+        }
+    }
+
+    return status;
+}
+
 status_t LPSCI_TransferReceiveDMA(UART0_Type *base, lpsci_dma_handle_t *handle, lpsci_transfer_t *xfer)
 {
     assert(handle);
@@ -268,6 +410,72 @@ status_t LPSCI_TransferReceiveDMA(UART0_Type *base, lpsci_dma_handle_t *handle,
     return status;
 }
 
+static void LPSCI_TransferStopIdleLineDMA(UART0_Type *base, lpsci_dma_handle_t *handle)
+{
+    if (handle->rxUntilIdle)
+    {
+        handle->rxUntilIdle = false;
+        LPSCI_DisableInterrupts(base, kLPSCI_IdleLineInterruptEnable);
+        (void)LPSCI_TransferInstallHandler(base, s_dmaPrivateHandle[LPSCI_GetInstance(base)].isr);
+    }
+}
+
+static void LPSCI_TransferHandleIdleLineDMA(UART0_Type *base, lpsci_handle_t *irqHandle)
+{
+    lpsci_dma_handle_t *handle = s_dmaPrivateHandle[LPSCI_GetInstance(base)].handle;
+    uint32_t received;
+
+    if ((handle) && (handle->rxUntilIdle) && (UART0_S1_IDLE_MASK & base->S1))
+    {
+        LPSCI_ClearStatusFlags(base, kLPSCI_IdleLineFlag);
+
+        received = handle->rxDataSizeAll -
+                   DMA_GetRemainingBytes(handle->rxDmaHandle->base, handle->rxDmaHandle->channel);
+        if (received)
+        {
+            LPSCI_TransferAbortReceiveDMA(base, handle);
+            handle->rxIdleFrameSize = received;
+
+            if (handle->callback)
+            {
+                handle->callback(base, handle, kStatus_LPSCI_IdleLineDetected, handle->userData);
+            }
+        }
+    }
+
+    /* Transmit and errors of the interrupt driver sharing the instance, it leaves the data
+       register alone while the RX DMA request is enabled. */
+    if (irqHandle)
+    {
+        LPSCI_TransferHandleIRQ(base, irqHandle);
+    }
+}
+
+status_t LPSCI_TransferReceiveUntilIdleDMA(UART0_Type *base, lpsci_dma_handle_t *handle, lpsci_transfer_t *xfer)
+{
+    uint32_t instance = LPSCI_GetInstance(base);
+    status_t status;
+
+    status = LPSCI_TransferReceiveDMA(base, handle, xfer);
+    if (kStatus_Success != status)
+    {
+        return status;
+    }
+
+    handle->rxIdleFrameSize = 0U;
+    handle->rxUntilIdle = true;
+
+    /* Route the LPSCI interrupt through the idle line handler until the transfer ends. */
+    s_dmaPrivateHandle[instance].isr = LPSCI_TransferInstallHandler(base, LPSCI_TransferHandleIdleLineDMA);
+    EnableIRQ(s_lpsciIRQ[instance]);
+
+    /* Drop an idle flag left from before this transfer. */
+    LPSCI_ClearStatusFlags(base, kLPSCI_IdleLineFlag);
+    LPSCI_EnableInterrupts(base, kLPSCI_IdleLineInterruptEnable);
+
+    return kStatus_Success;
+}
+
 void LPSCI_TransferAbortSendDMA(UART0_Type *base, lpsci_dma_handle_t *handle)
 {
     assert(handle);
@@ -290,6 +498,9 @@ void LPSCI_TransferAbortReceiveDMA(UART0_Type *base, lpsci_dma_handle_t *handle)
     assert(handle);
     assert(handle->rxDmaHandle);
 
+    /* Stop waiting for an idle line. */
+    LPSCI_TransferStopIdleLineDMA(base, handle);
+
     /* Disable LPSCI RX DMA. */
     LPSCI_EnableRxDMA(base, false);
 
@@ -313,7 +524,7 @@ status_t LPSCI_TransferGetSendCountDMA(UART0_Type *base, lpsci_dma_handle_t *han
         return kStatus_NoTransferInProgress;
     }
 
-    *count = handle->txDataSizeAll - DMA_GetRemainingBytes(handle->txDmaHandle->base, handle->txDmaHandle->channel);
+    *count = handle->txDataSizeAll - DMA_GetTransferRemainingBytes(handle->txDmaHandle);
 
     return kStatus_Success;
 }
@@ -333,3 +544,142 @@ status_t LPSCI_TransferGetReceiveCountDMA(UART0_Type *base, lpsci_dma_handle_t *
 
     return kStatus_Success;
 }
+
+status_t LPSCI_TransferStartRingBufferDMA(UART0_Type *base,
+                                          lpsci_dma_handle_t *handle,
+                                          uint8_t *ringBuffer,
+                                          size_t ringBufferSize)
+{
+    assert(handle);
+    assert(handle->rxDmaHandle);
+    assert(ringBuffer);
+
+    dma_transfer_config_t xferConfig;
+    uint32_t modulo = kDMA_Modulo16Bytes;
+
+    /* The modulo feature supports power of two sizes, the buffer has to be aligned to its size. */
+    if ((ringBufferSize < 16U) || (ringBufferSize > (256U * 1024U)) || (ringBufferSize & (ringBufferSize - 1U)) ||
+        ((uint32_t)ringBuffer & (ringBufferSize - 1U)))
+    {
+        return kStatus_InvalidArgument;
+    }
+    while ((16U << (modulo - kDMA_Modulo16Bytes)) < ringBufferSize)
+    {
+        modulo++;
+    }
+
+    if (kLPSCI_RxBusy == handle->rxState)
+    {
+        return kStatus_LPSCI_RxBusy;
+    }
+    handle->rxState = kLPSCI_RxBusy;
+
+    handle->rxRingBuffer = ringBuffer;
+    handle->rxRingBufferSize = ringBufferSize;
+    /* A whole number of laps, so the destination is back at the ring start on every reload. */
+    handle->rxRingTransferSize = LPSCI_DMA_RX_RING_TRANSFER_MAX & ~(ringBufferSize - 1U);
+    handle->rxRingReloaded = 0U;
+    handle->rxRingConsumed = 0U;
+    handle->rxRingNotified = 0U;
+    handle->rxRingOverrunCount = 0U;
+    handle->rxRingStallCount = 0U;
+
+    DMA_PrepareTransfer(&xferConfig, (void *)LPSCI_GetDataRegisterAddress(base), sizeof(uint8_t), ringBuffer,
+                        sizeof(uint8_t), handle->rxRingTransferSize, kDMA_PeripheralToMemory);
+    DMA_SubmitTransfer(handle->rxDmaHandle, &xferConfig, kDMA_EnableInterrupt);
+    DMA_SetModulo(handle->rxDmaHandle->base, handle->rxDmaHandle->channel, kDMA_ModuloDisable, (dma_modulo_t)modulo);
+    /* Keep the request enabled when the count runs out, the reload only rewrites the count. */
+    handle->rxDmaHandle->base->DMA[handle->rxDmaHandle->channel].DCR &= ~DMA_DCR_D_REQ_MASK;
+    DMA_StartTransfer(handle->rxDmaHandle);
+
+    LPSCI_EnableRxDMA(base, true);
+
+    return kStatus_Success;
+}
+
+void LPSCI_TransferStopRingBufferDMA(UART0_Type *base, lpsci_dma_handle_t *handle)
+{
+    assert(handle);
+    assert(handle->rxDmaHandle);
+
+    LPSCI_TransferAbortReceiveDMA(base, handle);
+    DMA_SetModulo(handle->rxDmaHandle->base, handle->rxDmaHandle->channel, kDMA_ModuloDisable, kDMA_ModuloDisable);
+
+    handle->rxRingBuffer = NULL;
+}
+
+size_t LPSCI_TransferPeekRxRingBufferDMA(UART0_Type *base, lpsci_dma_handle_t *handle, lpsci_transfer_t spans[2])
+{
+    assert(handle);
+    assert(handle->rxRingBuffer);
+    assert(spans);
+
+    uint32_t received = LPSCI_TransferGetRingReceivedDMA(handle);
+    uint32_t pending = received - handle->rxRingConsumed;
+    uint32_t tail;
+
+    /* The DMA never waits for the reader: skip what it has already overwritten. */
+    if (pending > handle->rxRingBufferSize)
+    {
+        handle->rxRingOverrunCount += pending - handle->rxRingBufferSize;
+        handle->rxRingConsumed = received - handle->rxRingBufferSize;
+        pending = handle->rxRingBufferSize;
+    }
+
+    tail = handle->rxRingConsumed & (handle->rxRingBufferSize - 1U);
+    spans[0].data = &handle->rxRingBuffer[tail];
+    spans[0].dataSize = MIN(pending, handle->rxRingBufferSize - tail);
+    spans[1].data = handle->rxRingBuffer;
+    spans[1].dataSize = pending - spans[0].dataSize;
+
+    return pending;
+}
+
+void LPSCI_TransferCommitRxRingBufferDMA(UART0_Type *base, lpsci_dma_handle_t *handle, size_t count)
+{
+    assert(handle);
+    assert(handle->rxRingBuffer);
+
+    uint32_t pending = LPSCI_TransferGetRingReceivedDMA(handle) - handle->rxRingConsumed;
+
+    handle->rxRingConsumed += MIN(count, pending);
+}
+
+bool LPSCI_TransferPollRingBufferDMA(UART0_Type *base, lpsci_dma_handle_t *handle)
+{
+    assert(handle);
+
+    dma_handle_t *dmaHandle = handle->rxDmaHandle;
+    uint32_t received;
+    uint32_t dmaStatus;
+    uint32_t primask;
+
+    if (!handle->rxRingBuffer)
+    {
+        return false;
+    }
+
+    /* A channel stopped by a configuration error waits for its interrupt, which may be held off. */
+    primask = DisableGlobalIRQ();
+    dmaStatus = DMA_GetChannelStatusFlags(dmaHandle->base, dmaHandle->channel);
+    if (dmaStatus & kDMA_ConfigurationErrorFlag)
+    {
+        DMA_ClearChannelStatusFlags(dmaHandle->base, dmaHandle->channel, kDMA_TransactionsDoneFlag);
+        LPSCI_TransferReloadRingDMA(base, handle, dmaStatus);
+    }
+    EnableGlobalIRQ(primask);
+
+    received = LPSCI_TransferGetRingReceivedDMA(handle);
+    if (received == handle->rxRingNotified)
+    {
+        return false;
+    }
+    handle->rxRingNotified = received;
+
+    if (handle->callback)
+    {
+        handle->callback(base, handle, kStatus_LPSCI_RxIdle, handle->userData);
+    }
+
+    return true;
+}
@@ -44,6 +44,9 @@
  * Definitions
  ******************************************************************************/
 
+/*! @brief Largest DMA byte count, the continuous receive reloads it when it runs out. */
+#define LPSCI_DMA_RX_RING_TRANSFER_MAX (0xFFFFFU)
+
 /* Forward declaration of the handle typedef. */
 typedef struct _lpsci_dma_handle lpsci_dma_handle_t;
 
@@ -70,6 +73,18 @@ struct _lpsci_dma_handle
 
     volatile uint8_t txState; /*!< TX transfer state. */
     volatile uint8_t rxState; /*!< RX transfer state */
+
+    uint8_t *rxRingBuffer;              /*!< Circular receive buffer, NULL when not receiving continuously. */
+    size_t rxRingBufferSize;            /*!< Size of the ring, a power of two between 16 bytes and 256 KB. */
+    uint32_t rxRingTransferSize;        /*!< DMA byte count per reload, a multiple of the ring size. */
+    volatile uint32_t rxRingReloaded;   /*!< Bytes received by the DMA runs that have completed. */
+    uint32_t rxRingConsumed;            /*!< Bytes released by LPSCI_TransferCommitRxRingBufferDMA. */
+    uint32_t rxRingNotified;            /*!< Bytes received when the callback was last told about new data. */
+    volatile uint32_t rxRingOverrunCount; /*!< Bytes overwritten by the DMA before they were consumed. */
+    volatile uint32_t rxRingStallCount; /*!< Reloads that found the DMA stopped, with the receiver overrun. */
+
+    volatile bool rxUntilIdle; /*!< The pending receive completes on an idle line. */
+    size_t rxIdleFrameSize;    /*!< Length of the last frame completed by an idle line. */
 };
 
 /*******************************************************************************
@@ -113,6 +128,30 @@ void LPSCI_TransferCreateHandleDMA(UART0_Type *base,
  */
 status_t LPSCI_TransferSendDMA(UART0_Type *base, lpsci_dma_handle_t *handle, lpsci_transfer_t *xfer);
 
+/*!
+ * @brief Sends a list of buffers as one stream using DMA.
+ *
+ * This function sends the segments back to back without copying them into a single buffer,
+ * for example a frame header followed by its payload. The DMA interrupt loads each segment
+ * after the previous one completes. This is a non-blocking function; when all segments are
+ * sent, the send callback function is called once with kStatus_LPSCI_TxIdle.
+ *
+ * @note The segment array and the data it points to must stay valid until the transfer completes.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle LPSCI handle pointer.
+ * @param segments Array of segments to send, see #dma_sg_segment_t.
+ * @param segmentCount Number of segments in the array, empty segments are skipped.
+ * @retval kStatus_Success if successful, others failed.
+ * @retval kStatus_LPSCI_TxBusy Previous transfer on going.
+ * @retval kStatus_InvalidArgument The segments hold no data.
+ * @retval kStatus_DMA_Busy The TX DMA channel is still busy, nothing was started.
+ */
+status_t LPSCI_TransferSendSegmentsDMA(UART0_Type *base,
+                                    lpsci_dma_handle_t *handle,
+                                    const dma_sg_segment_t *segments,
+                                    uint32_t segmentCount);
+
 /*!
  * @brief Receives data using DMA.
  *
@@ -145,6 +184,27 @@ void LPSCI_TransferAbortSendDMA(UART0_Type *base, lpsci_dma_handle_t *handle);
  */
 void LPSCI_TransferAbortReceiveDMA(UART0_Type *base, lpsci_dma_handle_t *handle);
 
+/*!
+ * @brief Receives a variable-length frame using DMA.
+ *
+ * This function starts a DMA receive like LPSCI_TransferReceiveDMA and also enables the idle
+ * line interrupt. When the line goes idle after at least one byte has been received, the DMA
+ * transfer is stopped, the frame length is stored in the rxIdleFrameSize member of the handle
+ * and the callback is called with @ref kStatus_LPSCI_IdleLineDetected. A frame that fills
+ * xfer->dataSize completes with @ref kStatus_LPSCI_RxIdle as usual.
+ *
+ * The idle line interrupt is taken through the LPSCI IRQ dispatcher of fsl_lpsci. A handle
+ * from LPSCI_TransferCreateHandle, such as the debug console's, keeps being serviced by
+ * LPSCI_TransferHandleIRQ while no frame is pending, but must not receive at the same time.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle Pointer to lpsci_dma_handle_t structure.
+ * @param xfer LPSCI DMA transfer structure. See #lpsci_transfer_t.
+ * @retval kStatus_Success if succeeded; otherwise failed.
+ * @retval kStatus_LPSCI_RxBusy Previous transfer ongoing.
+ */
+status_t LPSCI_TransferReceiveUntilIdleDMA(UART0_Type *base, lpsci_dma_handle_t *handle, lpsci_transfer_t *xfer);
+
 /*!
  * @brief Gets the number of bytes written to the LPSCI TX register.
  *
@@ -174,6 +234,76 @@ status_t LPSCI_TransferGetSendCountDMA(UART0_Type *base, lpsci_dma_handle_t *han
  */
 status_t LPSCI_TransferGetReceiveCountDMA(UART0_Type *base, lpsci_dma_handle_t *handle, uint32_t *count);
 
+/*!
+ * @brief Starts receiving continuously into a circular buffer using DMA.
+ *
+ * The DMA destination wraps with the modulo feature, so received bytes cost no CPU time. The
+ * write position is derived from the DMA byte count, and the CPU is only interrupted when the
+ * byte count runs out (every LPSCI_DMA_RX_RING_TRANSFER_MAX bytes) and is reloaded. Read the
+ * data with LPSCI_TransferPeekRxRingBufferDMA() and LPSCI_TransferCommitRxRingBufferDMA().
+ *
+ * A byte that arrives before the reload stops the channel with a configuration error and waits
+ * in the receiver. If the reload comes later than one more character time, the receiver
+ * overruns and drops bytes; the reload then clears the overrun and counts it in
+ * rxRingStallCount. The reload runs in the DMA interrupt and in
+ * LPSCI_TransferPollRingBufferDMA(), so keep that interrupt's latency below a character time.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle LPSCI handle pointer, created with an RX DMA handle.
+ * @param ringBuffer Ring start address, aligned to its size.
+ * @param ringBufferSize Power of two from 16 bytes to 256 KB.
+ * @retval kStatus_Success Continuous receive started.
+ * @retval kStatus_InvalidArgument Size not supported by the modulo feature or buffer not aligned.
+ * @retval kStatus_LPSCI_RxBusy A receive is already in progress.
+ */
+status_t LPSCI_TransferStartRingBufferDMA(UART0_Type *base,
+                                          lpsci_dma_handle_t *handle,
+                                          uint8_t *ringBuffer,
+                                          size_t ringBufferSize);
+
+/*!
+ * @brief Stops the continuous receive started by LPSCI_TransferStartRingBufferDMA().
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle LPSCI handle pointer.
+ */
+void LPSCI_TransferStopRingBufferDMA(UART0_Type *base, lpsci_dma_handle_t *handle);
+
+/*!
+ * @brief Gets the received data in the circular buffer without copying it.
+ *
+ * Same contract as LPSCI_TransferPeekRxRingBuffer(). If the DMA has lapped the reader, the
+ * overwritten bytes are skipped and counted in rxRingOverrunCount.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle LPSCI handle pointer.
+ * @param spans Filled with the two spans, unused spans have dataSize 0.
+ * @return Total number of bytes in both spans.
+ */
+size_t LPSCI_TransferPeekRxRingBufferDMA(UART0_Type *base, lpsci_dma_handle_t *handle, lpsci_transfer_t spans[2]);
+
+/*!
+ * @brief Releases bytes returned by LPSCI_TransferPeekRxRingBufferDMA().
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle LPSCI handle pointer.
+ * @param count Bytes consumed from the start of spans[0], continuing into spans[1].
+ */
+void LPSCI_TransferCommitRxRingBufferDMA(UART0_Type *base, lpsci_dma_handle_t *handle, size_t count);
+
+/*!
+ * @brief Reports data received since the last call through the callback.
+ *
+ * Call it from a periodic timer or the idle loop to flush partial frames: if new bytes arrived
+ * since the previous call, the callback gets @ref kStatus_LPSCI_RxIdle. A channel stopped with
+ * its byte count run out is reloaded here as well, in case its interrupt has not run.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle LPSCI handle pointer.
+ * @return true if new data was reported.
+ */
+bool LPSCI_TransferPollRingBufferDMA(UART0_Type *base, lpsci_dma_handle_t *handle);
+
 /*@}*/
 
 #if defined(__cplusplus)
@@ -0,0 +1,792 @@
+/*
+ * Copyright (c) 2015-2016, Freescale Semiconductor, Inc.
+ * Copyright 2016-2017 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fsl_spi.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief SPI transfer state, which is used for SPI transactional APIs' internal state. */
+enum _spi_transfer_states_t
+{
+    kSPI_Idle = 0x0, /*!< SPI is idle state */
+    kSPI_Busy        /*!< SPI is busy tranferring data. */
+};
+
+/*! @brief Typedef for spi master interrupt handler. spi master and slave handle is the same. */
+typedef void (*spi_isr_t)(SPI_Type *base, spi_master_handle_t *spiHandle);
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*!
+ * @brief Get the instance for SPI module.
+ *
+ * @param base SPI base address
+ */
+uint32_t SPI_GetInstance(SPI_Type *base);
+
+/*!
+ * @brief Write one frame to the data register, the dummy data if there is no buffer.
+ *
+ * @param base SPI base pointer
+ * @param buffer Frame to send, little endian in 16-bit mode, NULL to send the dummy data.
+ * @param bytePerFrame 1 in 8-bit mode, 2 in 16-bit mode.
+ */
+static void SPI_WriteFrame(SPI_Type *base, const uint8_t *buffer, uint8_t bytePerFrame);
+
+/*!
+ * @brief Read one frame from the data register, dropping it if there is no buffer.
+ *
+ * @param base SPI base pointer
+ * @param buffer Where to store the frame, NULL to discard it.
+ * @param bytePerFrame 1 in 8-bit mode, 2 in 16-bit mode.
+ */
+static void SPI_ReadFrame(SPI_Type *base, uint8_t *buffer, uint8_t bytePerFrame);
+
+/*!
+ * @brief Check the transfer and set up the handle for it.
+ *
+ * @param base SPI base pointer
+ * @param handle SPI handle pointer.
+ * @param xfer Transfer to start.
+ */
+static status_t SPI_TransferInit(SPI_Type *base, spi_master_handle_t *handle, spi_transfer_t *xfer);
+
+/*!
+ * @brief Stop the interrupts of a transfer and report its end.
+ *
+ * @param base SPI base pointer
+ * @param handle SPI handle pointer.
+ * @param status kStatus_SPI_Idle or kStatus_SPI_Error.
+ */
+static void SPI_TransferComplete(SPI_Type *base, spi_master_handle_t *handle, status_t status);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*! @brief SPI internal handle pointer array */
+static spi_master_handle_t *s_spiHandle[FSL_FEATURE_SOC_SPI_COUNT];
+/*! @brief Base pointer array */
+static SPI_Type *const s_spiBases[] = SPI_BASE_PTRS;
+/*! @brief IRQ name array */
+static const IRQn_Type s_spiIRQ[] = SPI_IRQS;
+#if !(defined(FSL_SDK_DISABLE_DRIVER_CLOCK_CONTROL) && FSL_SDK_DISABLE_DRIVER_CLOCK_CONTROL)
+/*! @brief Clock array name */
+static const clock_ip_name_t s_spiClock[] = SPI_CLOCKS;
+#endif /* FSL_SDK_DISABLE_DRIVER_CLOCK_CONTROL */
+
+/*! @brief Pointer to master IRQ handler for each instance. */
+static spi_isr_t s_spiMasterIsr;
+static spi_isr_t s_spiSlaveIsr;
+
+/*! @brief Value sent by transfers without TX data, also used by the DMA driver. */
+uint8_t g_spiDummyData[FSL_FEATURE_SOC_SPI_COUNT] = {0};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+uint32_t SPI_GetInstance(SPI_Type *base)
+{
+    uint32_t instance;
+
+    /* Find the instance index from base address mappings. */
+    for (instance = 0; instance < ARRAY_SIZE(s_spiBases); instance++)
+    {
+        if (s_spiBases[instance] == base)
+        {
+            break;
+        }
+    }
+
+    assert(instance < ARRAY_SIZE(s_spiBases));
+
+    return instance;
+}
+
+void SPI_SetDummyData(SPI_Type *base, uint8_t dummyData)
+{
+    g_spiDummyData[SPI_GetInstance(base)] = dummyData;
+}
+
+static void SPI_WriteFrame(SPI_Type *base, const uint8_t *buffer, uint8_t bytePerFrame)
+{
+    uint8_t dummy = g_spiDummyData[SPI_GetInstance(base)];
+
+    if (bytePerFrame == 2U)
+    {
+        base->DL = buffer ? buffer[0] : dummy;
+        base->DH = buffer ? buffer[1] : dummy;
+    }
+    else
+    {
+        base->DL = buffer ? buffer[0] : dummy;
+    }
+}
+
+static void SPI_ReadFrame(SPI_Type *base, uint8_t *buffer, uint8_t bytePerFrame)
+{
+    uint8_t low = base->DL;
+
+    if (bytePerFrame == 2U)
+    {
+        uint8_t high = base->DH;
+
+        if (buffer)
+        {
+            buffer[1] = high;
+        }
+    }
+    if (buffer)
+    {
+        buffer[0] = low;
+    }
+}
+
+void SPI_MasterGetDefaultConfig(spi_master_config_t *config)
+{
+    assert(config);
+
+    config->enableMaster = true;
+    config->enableStopInWaitMode = false;
+    config->polarity = kSPI_ClockPolarityActiveHigh;
+    config->phase = kSPI_ClockPhaseFirstEdge;
+    config->direction = kSPI_MsbFirst;
+    config->dataMode = kSPI_8BitMode;
+    config->outputMode = kSPI_SlaveSelectAutomaticOutput;
+    config->baudRate_Bps = 500000U;
+}
+
+void SPI_MasterInit(SPI_Type *base, const spi_master_config_t *config, uint32_t srcClock_Hz)
+{
+    assert(config && srcClock_Hz);
+
+    uint32_t instance = SPI_GetInstance(base);
+
+#if !(defined(FSL_SDK_DISABLE_DRIVER_CLOCK_CONTROL) && FSL_SDK_DISABLE_DRIVER_CLOCK_CONTROL)
+    /* Open clock gate for SPI and open interrupt */
+    CLOCK_EnableClock(s_spiClock[instance]);
+#endif /* FSL_SDK_DISABLE_DRIVER_CLOCK_CONTROL */
+
+    /* Disable SPI before configuration */
+    base->C1 &= ~SPI_C1_SPE_MASK;
+
+    /* Configure clock polarity and phase, set SPI to master */
+    base->C1 = SPI_C1_MSTR(1U) | SPI_C1_CPOL(config->polarity) | SPI_C1_CPHA(config->phase) |
+               SPI_C1_SSOE(config->outputMode & 1U) | SPI_C1_LSBFE(config->direction);
+
+    /* Set data mode, and also pin mode and mode fault settings */
+    base->C2 = SPI_C2_MODFEN(config->outputMode >> 1U) | SPI_C2_SPISWAI(config->enableStopInWaitMode) |
+               SPI_C2_SPIMODE(config->dataMode);
+
+#if defined(FSL_FEATURE_SPI_HAS_FIFO) && FSL_FEATURE_SPI_HAS_FIFO
+    /* The transactional layer runs with the FIFO disabled */
+    if (FSL_FEATURE_SPI_FIFO_SIZEn(base) != 0)
+    {
+        base->C3 = 0U;
+    }
+#endif
+
+    /* Set baud rate */
+    SPI_MasterSetBaudRate(base, config->baudRate_Bps, srcClock_Hz);
+
+    g_spiDummyData[instance] = SPI_DUMMYDATA;
+
+    /* Enable SPI */
+    if (config->enableMaster)
+    {
+        base->C1 |= SPI_C1_SPE_MASK;
+    }
+}
+
+void SPI_SlaveGetDefaultConfig(spi_slave_config_t *config)
+{
+    assert(config);
+
+    config->enableSlave = true;
+    config->enableStopInWaitMode = false;
+    config->polarity = kSPI_ClockPolarityActiveHigh;
+    config->phase = kSPI_ClockPhaseFirstEdge;
+    config->direction = kSPI_MsbFirst;
+    config->dataMode = kSPI_8BitMode;
+}
+
+void SPI_SlaveInit(SPI_Type *base, const spi_slave_config_t *config)
+{
+    assert(config);
+
+    uint32_t instance = SPI_GetInstance(base);
+
+#if !(defined(FSL_SDK_DISABLE_DRIVER_CLOCK_CONTROL) && FSL_SDK_DISABLE_DRIVER_CLOCK_CONTROL)
+    /* Open clock gate for SPI and open interrupt */
+    CLOCK_EnableClock(s_spiClock[instance]);
+#endif /* FSL_SDK_DISABLE_DRIVER_CLOCK_CONTROL */
+
+    /* Disable SPI before configuration */
+    base->C1 &= ~SPI_C1_SPE_MASK;
+
+    /* Configure master and clock polarity and phase, the SS pin is always the slave select input */
+    base->C1 = SPI_C1_CPOL(config->polarity) | SPI_C1_CPHA(config->phase) | SPI_C1_LSBFE(config->direction);
+
+    /* Configure data mode */
+    base->C2 = SPI_C2_SPISWAI(config->enableStopInWaitMode) | SPI_C2_SPIMODE(config->dataMode);
+
+#if defined(FSL_FEATURE_SPI_HAS_FIFO) && FSL_FEATURE_SPI_HAS_FIFO
+    /* The transactional layer runs with the FIFO disabled */
+    if (FSL_FEATURE_SPI_FIFO_SIZEn(base) != 0)
+    {
+        base->C3 = 0U;
+    }
+#endif
+
+    g_spiDummyData[instance] = SPI_DUMMYDATA;
+
+    /* Enable SPI */
+    if (config->enableSlave)
+    {
+        base->C1 |= SPI_C1_SPE_MASK;
+    }
+}
+
+void SPI_Deinit(SPI_Type *base)
+{
+    /* Disable SPI module before shutting down */
+    base->C1 &= ~SPI_C1_SPE_MASK;
+
+#if !(defined(FSL_SDK_DISABLE_DRIVER_CLOCK_CONTROL) && FSL_SDK_DISABLE_DRIVER_CLOCK_CONTROL)
+    /* Gate the clock */
+    CLOCK_DisableClock(s_spiClock[SPI_GetInstance(base)]);
+#endif /* FSL_SDK_DISABLE_DRIVER_CLOCK_CONTROL */
+}
+
+uint32_t SPI_GetStatusFlags(SPI_Type *base)
+{
+#if defined(FSL_FEATURE_SPI_HAS_FIFO) && FSL_FEATURE_SPI_HAS_FIFO
+    if (FSL_FEATURE_SPI_FIFO_SIZEn(base) != 0)
+    {
+        return ((base->S) | (((uint32_t)base->CI) << 8U));
+    }
+#endif
+    return base->S;
+}
+
+void SPI_EnableInterrupts(SPI_Type *base, uint32_t mask)
+{
+    /* Rx full interrupt */
+    if (mask & kSPI_RxFullAndModfInterruptEnable)
+    {
+        base->C1 |= SPI_C1_SPIE_MASK;
+    }
+
+    /* Tx empty interrupt */
+    if (mask & kSPI_TxEmptyInterruptEnable)
+    {
+        base->C1 |= SPI_C1_SPTIE_MASK;
+    }
+
+    /* Data match interrupt */
+    if (mask & kSPI_MatchInterruptEnable)
+    {
+        base->C2 |= SPI_C2_SPMIE_MASK;
+    }
+
+#if defined(FSL_FEATURE_SPI_HAS_FIFO) && FSL_FEATURE_SPI_HAS_FIFO
+    /* FIFO interrupts */
+    if (FSL_FEATURE_SPI_FIFO_SIZEn(base) != 0)
+    {
+        if (mask & kSPI_RxFifoNearFullInterruptEnable)
+        {
+            base->C3 |= SPI_C3_RNFULLIEN_MASK;
+        }
+        if (mask & kSPI_TxFifoNearEmptyInterruptEnable)
+        {
+            base->C3 |= SPI_C3_TNEARIEN_MASK;
+        }
+    }
+#endif
+}
+
+void SPI_DisableInterrupts(SPI_Type *base, uint32_t mask)
+{
+    /* Rx full interrupt */
+    if (mask & kSPI_RxFullAndModfInterruptEnable)
+    {
+        base->C1 &= (~SPI_C1_SPIE_MASK);
+    }
+
+    /* Tx empty interrupt */
+    if (mask & kSPI_TxEmptyInterruptEnable)
+    {
+        base->C1 &= (~SPI_C1_SPTIE_MASK);
+    }
+
+    /* Data match interrupt */
+    if (mask & kSPI_MatchInterruptEnable)
+    {
+        base->C2 &= (~SPI_C2_SPMIE_MASK);
+    }
+
+#if defined(FSL_FEATURE_SPI_HAS_FIFO) && FSL_FEATURE_SPI_HAS_FIFO
+    /* FIFO interrupts */
+    if (FSL_FEATURE_SPI_FIFO_SIZEn(base) != 0)
+    {
+        if (mask & kSPI_RxFifoNearFullInterruptEnable)
+        {
+            base->C3 &= ~SPI_C3_RNFULLIEN_MASK;
+        }
+        if (mask & kSPI_TxFifoNearEmptyInterruptEnable)
+        {
+            base->C3 &= ~SPI_C3_TNEARIEN_MASK;
+        }
+    }
+#endif
+}
+
+void SPI_MasterSetBaudRate(SPI_Type *base, uint32_t baudRate_Bps, uint32_t srcClock_Hz)
+{
+    uint32_t prescaler;
+    uint32_t rateDivisor;
+    uint32_t realBaudrate;
+    uint32_t bestBaudrate = 0U;
+    /* Slowest setting, used when even that is faster than requested */
+    uint32_t bestPrescaler = 7U;
+    uint32_t bestDivisor = 8U;
+
+    /* Baud rate = clock / ((SPPR + 1) * 2^(SPR + 1)), SPPR 0 to 7, SPR 0 to 8 */
+    for (rateDivisor = 0U; rateDivisor <= 8U; rateDivisor++)
+    {
+        for (prescaler = 0U; prescaler <= 7U; prescaler++)
+        {
+            realBaudrate = srcClock_Hz / ((prescaler + 1U) * (2U << rateDivisor));
+            if ((realBaudrate <= baudRate_Bps) && (realBaudrate > bestBaudrate))
+            {
+                bestBaudrate = realBaudrate;
+                bestPrescaler = prescaler;
+                bestDivisor = rateDivisor;
+            }
+        }
+    }
+
+    base->BR = SPI_BR_SPPR(bestPrescaler) | SPI_BR_SPR(bestDivisor);
+}
+
+uint32_t SPI_MasterGetBaudRate(SPI_Type *base, uint32_t srcClock_Hz)
+{
+    uint32_t prescaler = (base->BR & SPI_BR_SPPR_MASK) >> SPI_BR_SPPR_SHIFT;
+    uint32_t rateDivisor = (base->BR & SPI_BR_SPR_MASK) >> SPI_BR_SPR_SHIFT;
+
+    return srcClock_Hz / ((prescaler + 1U) * (2U << rateDivisor));
+}
+
+#if defined(FSL_FEATURE_SPI_HAS_FIFO) && FSL_FEATURE_SPI_HAS_FIFO
+void SPI_EnableFIFO(SPI_Type *base, bool enable)
+{
+    if (FSL_FEATURE_SPI_FIFO_SIZEn(base) != 0)
+    {
+        if (enable)
+        {
+            base->C3 |= SPI_C3_FIFOMODE_MASK;
+        }
+        else
+        {
+            base->C3 &= ~SPI_C3_FIFOMODE_MASK;
+        }
+    }
+}
+#endif
+
+void SPI_WriteBlocking(SPI_Type *base, uint8_t *buffer, size_t size)
+{
+    uint8_t bytePerFrame = (base->C2 & SPI_C2_SPIMODE_MASK) ? 2U : 1U;
+    size_t i;
+
+    for (i = 0U; i < size; i += bytePerFrame)
+    {
+        while ((base->S & SPI_S_SPTEF_MASK) == 0U)
+        {
+        }
+        SPI_WriteFrame(base, &buffer[i], bytePerFrame);
+
+        /* Drain the received frame so the receive buffer never holds a stale one */
+        while ((base->S & SPI_S_SPRF_MASK) == 0U)
+        {
+        }
+        SPI_ReadFrame(base, NULL, bytePerFrame);
+    }
+}
+
+void SPI_WriteData(SPI_Type *base, uint16_t data)
+{
+    base->DL = data & 0xFFU;
+    base->DH = (data >> 8U) & 0xFFU;
+}
+
+uint16_t SPI_ReadData(SPI_Type *base)
+{
+    uint16_t val = 0;
+
+    val = base->DL;
+    val |= (uint16_t)((uint16_t)(base->DH) << 8U);
+
+    return val;
+}
+
+status_t SPI_MasterTransferBlocking(SPI_Type *base, spi_transfer_t *xfer)
+{
+    assert(xfer);
+
+    uint8_t bytePerFrame = (base->C2 & SPI_C2_SPIMODE_MASK) ? 2U : 1U;
+    size_t i;
+
+    /* Check if the argument is legal */
+    if ((xfer->dataSize == 0U) || (xfer->dataSize % bytePerFrame))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    /* Drop a frame left over from an earlier transfer */
+    if (base->S & SPI_S_SPRF_MASK)
+    {
+        SPI_ReadFrame(base, NULL, bytePerFrame);
+    }
+
+    for (i = 0U; i < xfer->dataSize; i += bytePerFrame)
+    {
+        while ((base->S & SPI_S_SPTEF_MASK) == 0U)
+        {
+        }
+        SPI_WriteFrame(base, xfer->txData ? &xfer->txData[i] : NULL, bytePerFrame);
+
+        /* One frame in flight, its reply comes back before the next goes out */
+        while ((base->S & (SPI_S_SPRF_MASK | SPI_S_MODF_MASK)) == 0U)
+        {
+        }
+        if (base->S & SPI_S_MODF_MASK)
+        {
+            /* Writing C1 after reading S clears MODF, restoring master mode */
+            base->C1 |= SPI_C1_MSTR_MASK;
+            return kStatus_SPI_Error;
+        }
+        SPI_ReadFrame(base, xfer->rxData ? &xfer->rxData[i] : NULL, bytePerFrame);
+    }
+
+    return kStatus_Success;
+}
+
+void SPI_MasterTransferCreateHandle(SPI_Type *base,
+                                    spi_master_handle_t *handle,
+                                    spi_master_callback_t callback,
+                                    void *userData)
+{
+    assert(handle);
+
+    uint32_t instance = SPI_GetInstance(base);
+
+    /* Zero the handle */
+    memset(handle, 0, sizeof(*handle));
+
+    /* Initialize the handle */
+    s_spiHandle[instance] = handle;
+    handle->callback = callback;
+    handle->userData = userData;
+    s_spiMasterIsr = SPI_MasterTransferHandleIRQ;
+
+    /* Enable SPI NVIC */
+    EnableIRQ(s_spiIRQ[instance]);
+}
+
+void SPI_SlaveTransferCreateHandle(SPI_Type *base,
+                                   spi_slave_handle_t *handle,
+                                   spi_slave_callback_t callback,
+                                   void *userData)
+{
+    assert(handle);
+
+    uint32_t instance = SPI_GetInstance(base);
+
+    /* Zero the handle */
+    memset(handle, 0, sizeof(*handle));
+
+    /* Initialize the handle */
+    s_spiHandle[instance] = handle;
+    handle->callback = callback;
+    handle->userData = userData;
+    s_spiSlaveIsr = SPI_SlaveTransferHandleIRQ;
+
+    /* Enable SPI NVIC */
+    EnableIRQ(s_spiIRQ[instance]);
+}
+
+static status_t SPI_TransferInit(SPI_Type *base, spi_master_handle_t *handle, spi_transfer_t *xfer)
+{
+    assert(handle && xfer);
+
+    handle->bytePerFrame = (base->C2 & SPI_C2_SPIMODE_MASK) ? 2U : 1U;
+
+    /* Check if SPI is busy */
+    if (handle->state == kSPI_Busy)
+    {
+        return kStatus_SPI_Busy;
+    }
+
+    /* Check if the input arguments valid */
+    if ((xfer->dataSize == 0U) || (xfer->dataSize % handle->bytePerFrame))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    /* Set the handle information */
+    handle->txData = xfer->txData;
+    handle->rxData = xfer->rxData;
+    handle->transferSize = xfer->dataSize;
+    handle->txRemainingBytes = xfer->dataSize;
+    handle->rxRemainingBytes = xfer->dataSize;
+    handle->state = kSPI_Busy;
+
+    /* Drop a frame left over from an earlier transfer, it would be taken as the first reply */
+    if (base->S & SPI_S_SPRF_MASK)
+    {
+        SPI_ReadFrame(base, NULL, handle->bytePerFrame);
+    }
+
+    return kStatus_Success;
+}
+
+static void SPI_TransferComplete(SPI_Type *base, spi_master_handle_t *handle, status_t status)
+{
+    SPI_DisableInterrupts(base, kSPI_RxFullAndModfInterruptEnable | kSPI_TxEmptyInterruptEnable);
+
+    handle->state = kSPI_Idle;
+
+    if (handle->callback)
+    {
+        (handle->callback)(base, handle, status, handle->userData);
+    }
+}
+
+/* Send the next frame, advancing the TX buffer. */
+static void SPI_SendNextFrame(SPI_Type *base, spi_master_handle_t *handle)
+{
+    SPI_WriteFrame(base, handle->txData, handle->bytePerFrame);
+    if (handle->txData)
+    {
+        handle->txData += handle->bytePerFrame;
+    }
+    handle->txRemainingBytes -= handle->bytePerFrame;
+}
+
+/* Store the received frame, advancing the RX buffer. */
+static void SPI_ReceiveNextFrame(SPI_Type *base, spi_master_handle_t *handle)
+{
+    SPI_ReadFrame(base, handle->rxData, handle->bytePerFrame);
+    if (handle->rxData)
+    {
+        handle->rxData += handle->bytePerFrame;
+    }
+    handle->rxRemainingBytes -= handle->bytePerFrame;
+}
+
+status_t SPI_MasterTransferNonBlocking(SPI_Type *base, spi_master_handle_t *handle, spi_transfer_t *xfer)
+{
+    status_t status = SPI_TransferInit(base, handle, xfer);
+
+    if (status != kStatus_Success)
+    {
+        return status;
+    }
+
+    /* Start with the first frame, each receive interrupt then sends the next one */
+    while ((base->S & SPI_S_SPTEF_MASK) == 0U)
+    {
+    }
+    SPI_SendNextFrame(base, handle);
+
+    SPI_EnableInterrupts(base, kSPI_RxFullAndModfInterruptEnable);
+
+    return kStatus_Success;
+}
+
+status_t SPI_MasterTransferGetCount(SPI_Type *base, spi_master_handle_t *handle, size_t *count)
+{
+    assert(handle);
+
+    status_t status = kStatus_Success;
+
+    if (handle->state != kSPI_Busy)
+    {
+        status = kStatus_NoTransferInProgress;
+    }
+    else
+    {
+        /* Return remaing bytes in different cases */
+        if (handle->rxData)
+        {
+            *count = handle->transferSize - handle->rxRemainingBytes;
+        }
+        else
+        {
+            *count = handle->transferSize - handle->txRemainingBytes;
+        }
+    }
+
+    return status;
+}
+
+void SPI_MasterTransferAbort(SPI_Type *base, spi_master_handle_t *handle)
+{
+    assert(handle);
+
+    /* Stop interrupts */
+    SPI_DisableInterrupts(base, kSPI_RxFullAndModfInterruptEnable | kSPI_TxEmptyInterruptEnable);
+
+    /* Transfer finished, set the state to Done*/
+    handle->state = kSPI_Idle;
+
+    /* Clear the internal state */
+    handle->rxRemainingBytes = 0;
+    handle->txRemainingBytes = 0;
+}
+
+void SPI_MasterTransferHandleIRQ(SPI_Type *base, spi_master_handle_t *handle)
+{
+    assert(handle);
+
+    uint8_t status = base->S;
+
+    /* Another master pulled SS low, the module has dropped to slave mode */
+    if (status & SPI_S_MODF_MASK)
+    {
+        /* Writing C1 after reading S clears MODF, restoring master mode */
+        base->C1 |= SPI_C1_MSTR_MASK;
+        SPI_TransferComplete(base, handle, kStatus_SPI_Error);
+        return;
+    }
+
+    if ((status & SPI_S_SPRF_MASK) && (handle->rxRemainingBytes))
+    {
+        SPI_ReceiveNextFrame(base, handle);
+    }
+
+    if (handle->rxRemainingBytes == 0U)
+    {
+        SPI_TransferComplete(base, handle, kStatus_SPI_Idle);
+        return;
+    }
+
+    /* The previous frame has come back, the transmit buffer is empty by now */
+    if ((handle->txRemainingBytes) && (handle->txRemainingBytes == handle->rxRemainingBytes) &&
+        (status & SPI_S_SPTEF_MASK))
+    {
+        SPI_SendNextFrame(base, handle);
+    }
+}
+
+status_t SPI_SlaveTransferNonBlocking(SPI_Type *base, spi_slave_handle_t *handle, spi_transfer_t *xfer)
+{
+    status_t status = SPI_TransferInit(base, handle, xfer);
+
+    if (status != kStatus_Success)
+    {
+        return status;
+    }
+
+    /* A frame of an aborted transfer may still wait in the transmit buffer, cycling SPE empties it */
+    if ((base->S & SPI_S_SPTEF_MASK) == 0U)
+    {
+        base->C1 &= ~SPI_C1_SPE_MASK;
+        base->C1 |= SPI_C1_SPE_MASK;
+        (void)base->S;
+    }
+
+    /* Preload the first frame, the master may start clocking at any time */
+    SPI_SendNextFrame(base, handle);
+
+    /* Load each next frame as soon as the previous one moves to the shifter */
+    SPI_EnableInterrupts(base, (handle->txRemainingBytes ? kSPI_TxEmptyInterruptEnable : 0U) |
+                                   kSPI_RxFullAndModfInterruptEnable);
+
+    return kStatus_Success;
+}
+
+void SPI_SlaveTransferHandleIRQ(SPI_Type *base, spi_slave_handle_t *handle)
+{
+    assert(handle);
+
+    uint8_t status = base->S;
+
+    if ((status & SPI_S_SPRF_MASK) && (handle->rxRemainingBytes))
+    {
+        SPI_ReceiveNextFrame(base, handle);
+    }
+
+    if ((status & SPI_S_SPTEF_MASK) && (handle->txRemainingBytes))
+    {
+        SPI_SendNextFrame(base, handle);
+        if (handle->txRemainingBytes == 0U)
+        {
+            SPI_DisableInterrupts(base, kSPI_TxEmptyInterruptEnable);
+        }
+    }
+
+    if (handle->rxRemainingBytes == 0U)
+    {
+        SPI_TransferComplete(base, handle, kStatus_SPI_Idle);
+    }
+}
+
+static void SPI_CommonIRQHandler(SPI_Type *base, uint32_t instance)
+{
+    if (base->C1 & SPI_C1_MSTR_MASK)
+    {
+        s_spiMasterIsr(base, s_spiHandle[instance]);
+    }
+    else
+    {
+        s_spiSlaveIsr(base, s_spiHandle[instance]);
+    }
+}
+
+#if defined(SPI0)
+void SPI0_DriverIRQHandler(void)
+{
+    assert(s_spiHandle[0]);
+    SPI_CommonIRQHandler(SPI0, 0);
+}
+#endif
+
+#if defined(SPI1)
+void SPI1_DriverIRQHandler(void)
+{
+    assert(s_spiHandle[1]);
+    SPI_CommonIRQHandler(SPI1, 1);
+}
+#endif
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2015, Freescale Semiconductor, Inc.
+ * Copyright 2016-2017 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fsl_spi_dma.h"
+
+/*******************************************************************************
+ * Definitons
+ ******************************************************************************/
+/*<! Structure definition for spi_dma_private_handle_t. The structure is private. */
+typedef struct _spi_dma_private_handle
+{
+    SPI_Type *base;
+    spi_dma_handle_t *handle;
+} spi_dma_private_handle_t;
+
+/*! @brief SPI transfer state, which is used for SPI transactiaonl APIs' internal state. */
+enum _spi_dma_states_t
+{
+    kSPI_Idle = 0x0, /*!< SPI is idle state */
+    kSPI_Busy        /*!< SPI is busy tranferring data. */
+};
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/*!
+ * @brief Get the instance for SPI module.
+ *
+ * @param base SPI base address
+ */
+extern uint32_t SPI_GetInstance(SPI_Type *base);
+
+/*!
+ * @brief DMA callback function for SPI send transfer.
+ *
+ * @param handle DMA handle pointer.
+ * @param userData User data for DMA callback function.
+ */
+static void SPI_TxDMACallback(dma_handle_t *handle, void *userData);
+
+/*!
+ * @brief DMA callback function for SPI receive transfer.
+ *
+ * @param handle DMA handle pointer.
+ * @param userData User data for DMA callback function.
+ */
+static void SPI_RxDMACallback(dma_handle_t *handle, void *userData);
+
+/*!
+ * @brief Start both DMA channels of a transfer, then the SPI requests.
+ *
+ * @param base SPI peripheral base address.
+ * @param handle SPI DMA handle pointer.
+ * @param xfer Transfer to start.
+ * @param isSlave The transmit buffer is emptied first, a slave cannot drop a stale frame by clocking it out.
+ */
+static status_t SPI_TransferDMA(SPI_Type *base, spi_dma_handle_t *handle, spi_transfer_t *xfer, bool isSlave);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*<! Private handle only used for internally. */
+static spi_dma_private_handle_t s_dmaPrivateHandle[FSL_FEATURE_SOC_SPI_COUNT];
+
+/* Value sent by transfers without TX data, defined in fsl_spi.c. */
+extern uint8_t g_spiDummyData[];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static void SPI_TransferCompleteDMA(spi_dma_private_handle_t *privHandle)
+{
+    spi_dma_handle_t *spiHandle = privHandle->handle;
+
+    if ((spiHandle->txInProgress == false) && (spiHandle->rxInProgress == false))
+    {
+        SPI_EnableDMA(privHandle->base, kSPI_DmaAllEnable, false);
+        spiHandle->state = kSPI_Idle;
+
+        /* Call user callback */
+        if (spiHandle->callback)
+        {
+            spiHandle->callback(privHandle->base, spiHandle, kStatus_Success, spiHandle->userData);
+        }
+    }
+}
+
+static void SPI_TxDMACallback(dma_handle_t *handle, void *userData)
+{
+    spi_dma_private_handle_t *privHandle = (spi_dma_private_handle_t *)userData;
+
+    /* Disable Tx dma */
+    SPI_EnableDMA(privHandle->base, kSPI_TxDmaEnable, false);
+    DMA_DisableInterrupts(handle->base, handle->channel);
+
+    /* Change the state */
+    privHandle->handle->txInProgress = false;
+
+    /* The last frame is still shifting, the receive channel reports the end */
+    SPI_TransferCompleteDMA(privHandle);
+}
+
+static void SPI_RxDMACallback(dma_handle_t *handle, void *userData)
+{
+    spi_dma_private_handle_t *privHandle = (spi_dma_private_handle_t *)userData;
+
+    /* Disable Rx dma */
+    SPI_EnableDMA(privHandle->base, kSPI_RxDmaEnable, false);
+    DMA_DisableInterrupts(handle->base, handle->channel);
+
+    /* Change the state */
+    privHandle->handle->rxInProgress = false;
+
+    SPI_TransferCompleteDMA(privHandle);
+}
+
+void SPI_MasterTransferCreateHandleDMA(SPI_Type *base,
+                                       spi_dma_handle_t *handle,
+                                       spi_dma_callback_t callback,
+                                       void *userData,
+                                       dma_handle_t *txHandle,
+                                       dma_handle_t *rxHandle)
+{
+    assert(handle);
+    assert(txHandle);
+    assert(rxHandle);
+
+    uint32_t instance = SPI_GetInstance(base);
+
+    /* Zero the handle */
+    memset(handle, 0, sizeof(*handle));
+
+    /* Set spi base to handle */
+    handle->txHandle = txHandle;
+    handle->rxHandle = rxHandle;
+    handle->callback = callback;
+    handle->userData = userData;
+
+    /* Set SPI state to idle */
+    handle->state = kSPI_Idle;
+
+    /* Set handle to global state */
+    s_dmaPrivateHandle[instance].base = base;
+    s_dmaPrivateHandle[instance].handle = handle;
+
+    /* Install callback for Tx dma channel */
+    DMA_SetCallback(txHandle, SPI_TxDMACallback, &s_dmaPrivateHandle[instance]);
+    DMA_SetCallback(rxHandle, SPI_RxDMACallback, &s_dmaPrivateHandle[instance]);
+}
+
+static status_t SPI_TransferDMA(SPI_Type *base, spi_dma_handle_t *handle, spi_transfer_t *xfer, bool isSlave)
+{
+    assert(handle && xfer);
+
+    dma_transfer_config_t config = {0};
+    uint8_t dummy = g_spiDummyData[SPI_GetInstance(base)];
+
+    /* Check if SPI is busy */
+    if (handle->state == kSPI_Busy)
+    {
+        return kStatus_SPI_Busy;
+    }
+
+    handle->bytesPerFrame = (base->C2 & SPI_C2_SPIMODE_MASK) ? 2U : 1U;
+
+    /* Check if the input arguments valid */
+    if ((xfer->dataSize == 0U) || (xfer->dataSize % handle->bytesPerFrame))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    handle->state = kSPI_Busy;
+    handle->transferSize = xfer->dataSize;
+    handle->txDummy = (uint16_t)(((uint16_t)dummy << 8U) | dummy);
+
+    /* Drop a frame left over from an earlier transfer, it would be taken as the first reply */
+    if (base->S & SPI_S_SPRF_MASK)
+    {
+        (void)base->DL;
+        (void)base->DH;
+    }
+
+    /* A frame of an aborted transfer may still wait in the transmit buffer, cycling SPE empties it */
+    if (isSlave && ((base->S & SPI_S_SPTEF_MASK) == 0U))
+    {
+        base->C1 &= ~SPI_C1_SPE_MASK;
+        base->C1 |= SPI_C1_SPE_MASK;
+        (void)base->S;
+    }
+
+    /* Configure rx DMA channel, it has to be armed before the first frame comes back */
+    if (xfer->rxData)
+    {
+        DMA_PrepareTransfer(&config, (void *)SPI_GetDataRegisterAddress(base), handle->bytesPerFrame, xfer->rxData,
+                            handle->bytesPerFrame, xfer->dataSize, kDMA_PeripheralToMemory);
+    }
+    else
+    {
+        DMA_PrepareTransfer(&config, (void *)SPI_GetDataRegisterAddress(base), handle->bytesPerFrame,
+                            &handle->rxDummy, handle->bytesPerFrame, xfer->dataSize, kDMA_PeripheralToMemory);
+        config.enableDestIncrement = false;
+    }
+    if (kStatus_Success != DMA_SubmitTransfer(handle->rxHandle, &config, kDMA_EnableInterrupt))
+    {
+        handle->state = kSPI_Idle;
+        return kStatus_SPI_Busy;
+    }
+
+    /* Configure tx DMA channel */
+    if (xfer->txData)
+    {
+        DMA_PrepareTransfer(&config, xfer->txData, handle->bytesPerFrame, (void *)SPI_GetDataRegisterAddress(base),
+                            handle->bytesPerFrame, xfer->dataSize, kDMA_MemoryToPeripheral);
+    }
+    else
+    {
+        DMA_PrepareTransfer(&config, &handle->txDummy, handle->bytesPerFrame,
+                            (void *)SPI_GetDataRegisterAddress(base), handle->bytesPerFrame, xfer->dataSize,
+                            kDMA_MemoryToPeripheral);
+        config.enableSrcIncrement = false;
+    }
+    if (kStatus_Success != DMA_SubmitTransfer(handle->txHandle, &config, kDMA_EnableInterrupt))
+    {
+        DMA_AbortTransfer(handle->rxHandle);
+        handle->state = kSPI_Idle;
+        return kStatus_SPI_Busy;
+    }
+
+    handle->txInProgress = true;
+    handle->rxInProgress = true;
+    DMA_StartTransfer(handle->rxHandle);
+    DMA_StartTransfer(handle->txHandle);
+
+    /* The transmit request is already pending, the first frame is loaded right away */
+    SPI_EnableDMA(base, kSPI_DmaAllEnable, true);
+
+    return kStatus_Success;
+}
+
+status_t SPI_MasterTransferDMA(SPI_Type *base, spi_dma_handle_t *handle, spi_transfer_t *xfer)
+{
+    return SPI_TransferDMA(base, handle, xfer, false);
+}
+
+status_t SPI_SlaveTransferDMA(SPI_Type *base, spi_dma_handle_t *handle, spi_transfer_t *xfer)
+{
+    return SPI_TransferDMA(base, handle, xfer, true);
+}
+
+status_t SPI_MasterTransferGetCountDMA(SPI_Type *base, spi_dma_handle_t *handle, size_t *count)
+{
+    assert(handle);
+
+    status_t status = kStatus_Success;
+
+    if (handle->state != kSPI_Busy)
+    {
+        status = kStatus_NoTransferInProgress;
+    }
+    else
+    {
+        /* Frames land in memory when the receive channel moves them, count those */
+        *count = handle->transferSize - DMA_GetRemainingBytes(handle->rxHandle->base, handle->rxHandle->channel);
+    }
+
+    return status;
+}
+
+void SPI_MasterTransferAbortDMA(SPI_Type *base, spi_dma_handle_t *handle)
+{
+    assert(handle);
+
+    /* Stop tx transfer first */
+    DMA_AbortTransfer(handle->txHandle);
+    /* Then rx transfer */
+    DMA_AbortTransfer(handle->rxHandle);
+
+    /* Disable DMA request */
+    SPI_EnableDMA(base, kSPI_DmaAllEnable, false);
+
+    /* Set the handle state */
+    handle->txInProgress = false;
+    handle->rxInProgress = false;
+    handle->state = kSPI_Idle;
+}
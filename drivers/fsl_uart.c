@@ -45,9 +45,6 @@ enum _uart_tansfer_states
     kUART_RxParityError   /* Rx parity error */
 };
 
-/* Typedef for interrupt handler. */
-typedef void (*uart_isr_t)(UART_Type *base, uart_handle_t *handle);
-
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -61,12 +58,21 @@ typedef void (*uart_isr_t)(UART_Type *base, uart_handle_t *handle);
 uint32_t UART_GetInstance(UART_Type *base);
 
 /*!
- * @brief Get the length of received data in RX ring buffer.
+ * @brief Queue an XON/XOFF character ahead of the TX data.
  *
+ * @param base UART peripheral base address.
  * @param handle UART handle pointer.
- * @return Length of received data in RX ring buffer.
+ * @param flowChar UART_XON_CHAR or UART_XOFF_CHAR.
  */
-static size_t UART_TransferGetRxRingBufferLength(uart_handle_t *handle);
+static void UART_TransferSendFlowChar(UART_Type *base, uart_handle_t *handle, uint8_t flowChar);
+
+/*!
+ * @brief Resume the sender once the RX ring buffer has drained to the low watermark.
+ *
+ * @param base UART peripheral base address.
+ * @param handle UART handle pointer.
+ */
+static void UART_TransferUpdateRxFlow(UART_Type *base, uart_handle_t *handle);
 
 /*!
  * @brief Check whether the RX ring buffer is full.
@@ -145,8 +151,8 @@ static const IRQn_Type s_uartIRQ[] = UART_RX_TX_IRQS;
 static const clock_ip_name_t s_uartClock[] = UART_CLOCKS;
 #endif /* FSL_SDK_DISABLE_DRIVER_CLOCK_CONTROL */
 
-/* UART ISR for transactional APIs. */
-static uart_isr_t s_uartIsr;
+/* UART ISR for transactional APIs, per instance, see UART_TransferInstallHandler. */
+static uart_isr_t s_uartIsr[UART_HANDLE_ARRAY_SIZE];
 
 /*******************************************************************************
  * Code
@@ -171,7 +177,7 @@ uint32_t UART_GetInstance(UART_Type *base)
     return instance;
 }
 
-static size_t UART_TransferGetRxRingBufferLength(uart_handle_t *handle)
+size_t UART_TransferGetRxRingBufferLength(uart_handle_t *handle)
 {
     assert(handle);
 
@@ -207,6 +213,35 @@ static bool UART_TransferIsRxRingBufferFull(uart_handle_t *handle)
     return full;
 }
 
+static void UART_TransferSendFlowChar(UART_Type *base, uart_handle_t *handle, uint8_t flowChar)
+{
+    uint32_t regPrimask;
+
+    /* The TX interrupt sends it; a newer request replaces one not yet sent. */
+    regPrimask = DisableGlobalIRQ();
+    handle->txFlowChar = flowChar;
+    base->C2 |= UART_C2_TIE_MASK;
+    EnableGlobalIRQ(regPrimask);
+}
+
+static void UART_TransferUpdateRxFlow(UART_Type *base, uart_handle_t *handle)
+{
+    if ((!handle->rxRingThrottled) || (UART_TransferGetRxRingBufferLength(handle) > handle->rxRingLowWatermark))
+    {
+        return;
+    }
+
+    handle->rxRingThrottled = false;
+    if (handle->rxRingPolicy == kUART_RxRingFlowControlRts)
+    {
+        handle->rxFlowCallback(base, handle, true);
+    }
+    else
+    {
+        UART_TransferSendFlowChar(base, handle, UART_XON_CHAR);
+    }
+}
+
 status_t UART_Init(UART_Type *base, const uart_config_t *config, uint32_t srcClock_Hz)
 {
     assert(config);
@@ -661,11 +696,26 @@ void UART_TransferCreateHandle(UART_Type *base,
     /* Save the handle in global variables to support the double weak mechanism. */
     s_uartHandle[instance] = handle;
 
-    s_uartIsr = UART_TransferHandleIRQ;
+    s_uartIsr[instance] = UART_TransferHandleIRQ;
     /* Enable interrupt in NVIC. */
     EnableIRQ(s_uartIRQ[instance]);
 }
 
+uart_isr_t UART_TransferInstallHandler(UART_Type *base, uart_isr_t isr)
+{
+    uint32_t instance = UART_GetInstance(base);
+    uart_isr_t previous;
+    uint32_t regPrimask;
+
+    /* Swap atomically, the interrupt may be taken in between. */
+    regPrimask = DisableGlobalIRQ();
+    previous = s_uartIsr[instance];
+    s_uartIsr[instance] = isr;
+    EnableGlobalIRQ(regPrimask);
+
+    return previous;
+}
+
 void UART_TransferStartRingBuffer(UART_Type *base, uart_handle_t *handle, uint8_t *ringBuffer, size_t ringBufferSize)
 {
     assert(handle);
@@ -687,6 +737,48 @@ void UART_TransferStartRingBuffer(UART_Type *base, uart_handle_t *handle, uint8_
     }
 }
 
+status_t UART_TransferSetRxRingPolicy(UART_Type *base, uart_handle_t *handle, const uart_rx_ring_config_t *config)
+{
+    assert(handle);
+    assert(config);
+
+    bool flowControl =
+        (config->policy == kUART_RxRingFlowControlRts) || (config->policy == kUART_RxRingFlowControlXonXoff);
+
+    if (!handle->rxRingBuffer)
+    {
+        return kStatus_InvalidArgument;
+    }
+    if (flowControl && ((config->highWatermark >= handle->rxRingBufferSize - 1U) ||
+                        (config->lowWatermark >= config->highWatermark)))
+    {
+        return kStatus_InvalidArgument;
+    }
+    if ((config->policy == kUART_RxRingFlowControlRts) && (!config->rtsCallback))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    /* Disable UART RX IRQ, the handler reads the policy. */
+    UART_DisableInterrupts(base, kUART_RxDataRegFullInterruptEnable);
+
+    handle->rxRingPolicy = config->policy;
+    handle->rxRingHighWatermark = config->highWatermark;
+    handle->rxRingLowWatermark = config->lowWatermark;
+    handle->rxFlowCallback = config->rtsCallback;
+    handle->rxRingThrottled = false;
+
+    /* Start with the sender allowed to send. */
+    if (config->policy == kUART_RxRingFlowControlRts)
+    {
+        config->rtsCallback(base, handle, true);
+    }
+
+    UART_EnableInterrupts(base, kUART_RxDataRegFullInterruptEnable);
+
+    return kStatus_Success;
+}
+
 void UART_TransferStopRingBuffer(UART_Type *base, uart_handle_t *handle)
 {
     assert(handle);
@@ -708,6 +800,51 @@ void UART_TransferStopRingBuffer(UART_Type *base, uart_handle_t *handle)
     handle->rxRingBufferTail = 0U;
 }
 
+size_t UART_TransferPeekRxRingBuffer(UART_Type *base, uart_handle_t *handle, uart_transfer_t spans[2])
+{
+    assert(handle);
+    assert(handle->rxRingBuffer);
+    assert(spans);
+
+    /* Sample the head once, bytes stored after this are seen by the next peek. */
+    uint16_t head = handle->rxRingBufferHead;
+    uint16_t tail = handle->rxRingBufferTail;
+
+    spans[0].data = &handle->rxRingBuffer[tail];
+    spans[1].data = handle->rxRingBuffer;
+    if (head >= tail)
+    {
+        spans[0].dataSize = (size_t)(head - tail);
+        spans[1].dataSize = 0U;
+    }
+    else
+    {
+        spans[0].dataSize = handle->rxRingBufferSize - tail;
+        spans[1].dataSize = head;
+    }
+
+    return spans[0].dataSize + spans[1].dataSize;
+}
+
+void UART_TransferCommitRxRingBuffer(UART_Type *base, uart_handle_t *handle, size_t count)
+{
+    assert(handle);
+    assert(handle->rxRingBuffer);
+
+    size_t tail;
+
+    /* Disable UART RX IRQ, the overrun path in the handler also moves the tail. */
+    UART_DisableInterrupts(base, kUART_RxDataRegFullInterruptEnable);
+
+    /* Data dropped by an overrun since the peek is not consumed twice. */
+    count = MIN(count, UART_TransferGetRxRingBufferLength(handle));
+    tail = handle->rxRingBufferTail + count;
+    handle->rxRingBufferTail = (tail >= handle->rxRingBufferSize) ? (tail - handle->rxRingBufferSize) : tail;
+    UART_TransferUpdateRxFlow(base, handle);
+
+    UART_EnableInterrupts(base, kUART_RxDataRegFullInterruptEnable);
+}
+
 status_t UART_TransferSendNonBlocking(UART_Type *base, uart_handle_t *handle, uart_transfer_t *xfer)
 {
     assert(handle);
@@ -816,21 +953,16 @@ status_t UART_TransferReceiveNonBlocking(UART_Type *base,
 
                 bytesToReceive -= bytesToCopy;
 
-                /* Copy data from ring buffer to user memory. */
-                for (i = 0U; i < bytesToCopy; i++)
-                {
-                    xfer->data[bytesCurrentReceived++] = handle->rxRingBuffer[handle->rxRingBufferTail];
+                /* Copy data from ring buffer to user memory, at most two contiguous runs. */
+                i = MIN(bytesToCopy, handle->rxRingBufferSize - handle->rxRingBufferTail);
+                memcpy(xfer->data, &handle->rxRingBuffer[handle->rxRingBufferTail], i);
+                memcpy(xfer->data + i, handle->rxRingBuffer, bytesToCopy - i);
+                bytesCurrentReceived = bytesToCopy;
 
-                    /* Wrap to 0. Not use modulo (%) because it might be large and slow. */
-                    if (handle->rxRingBufferTail + 1U == handle->rxRingBufferSize)
-                    {
-                        handle->rxRingBufferTail = 0U;
-                    }
-                    else
-                    {
-                        handle->rxRingBufferTail++;
-                    }
-                }
+                /* Wrap to 0. Not use modulo (%) because it might be large and slow. */
+                i = handle->rxRingBufferTail + bytesToCopy;
+                handle->rxRingBufferTail = (i >= handle->rxRingBufferSize) ? (i - handle->rxRingBufferSize) : i;
+                UART_TransferUpdateRxFlow(base, handle);
             }
 
             /* If ring buffer does not have enough data, still need to read more data. */
@@ -894,7 +1026,7 @@ void UART_TransferAbortReceive(UART_Type *base, uart_handle_t *handle)
     {
         /* Disable RX interrupt. */
         UART_DisableInterrupts(base, kUART_RxDataRegFullInterruptEnable | kUART_RxOverrunInterruptEnable |
-                                         kUART_FramingErrorInterruptEnable);
+                                         kUART_FramingErrorInterruptEnable | kUART_IdleLineInterruptEnable);
         /* Disable parity error interrupt when parity mode is enable*/
         if (UART_C1_PE_MASK & base->C1)
         {
@@ -903,9 +1035,53 @@ void UART_TransferAbortReceive(UART_Type *base, uart_handle_t *handle)
     }
 
     handle->rxDataSize = 0U;
+    handle->rxUntilIdle = false;
     handle->rxState = kUART_RxIdle;
 }
 
+status_t UART_TransferReceiveUntilIdleNonBlocking(UART_Type *base, uart_handle_t *handle, uart_transfer_t *xfer)
+{
+    assert(handle);
+    assert(xfer);
+    assert(xfer->data);
+    assert(xfer->dataSize);
+
+    /* Received bytes go to the ring buffer instead of xfer->data when it is installed. */
+    if ((0U == xfer->dataSize) || (NULL == xfer->data) || (handle->rxRingBuffer))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    if (kUART_RxBusy == handle->rxState)
+    {
+        return kStatus_UART_RxBusy;
+    }
+
+    handle->rxData = xfer->data;
+    handle->rxDataSize = xfer->dataSize;
+    handle->rxDataSizeAll = xfer->dataSize;
+    handle->rxIdleFrameSize = 0U;
+    handle->rxUntilIdle = true;
+    handle->rxState = kUART_RxBusy;
+
+    /* Drop an idle flag left from before this transfer, read S1 then D to clear it. */
+    if ((UART_S1_IDLE_MASK & base->S1) && (!(UART_S1_RDRF_MASK & base->S1)))
+    {
+        (void)base->D;
+    }
+
+    /* Enable RX/Rx overrun/framing error/idle line interrupt. */
+    UART_EnableInterrupts(base, kUART_RxDataRegFullInterruptEnable | kUART_RxOverrunInterruptEnable |
+                                    kUART_FramingErrorInterruptEnable | kUART_IdleLineInterruptEnable);
+    /* Enable parity error interrupt when parity mode is enable*/
+    if (UART_C1_PE_MASK & base->C1)
+    {
+        UART_EnableInterrupts(base, kUART_ParityErrorInterruptEnable);
+    }
+
+    return kStatus_Success;
+}
+
 status_t UART_TransferGetReceiveCount(UART_Type *base, uart_handle_t *handle, uint32_t *count)
 {
     assert(handle);
@@ -932,22 +1108,36 @@ void UART_TransferHandleIRQ(UART_Type *base, uart_handle_t *handle)
 
     uint8_t count;
     uint8_t tempCount;
+#if defined(FSL_FEATURE_UART_HAS_DMA_SELECT) && FSL_FEATURE_UART_HAS_DMA_SELECT
+#if (defined(FSL_FEATURE_UART_IS_SCI) && FSL_FEATURE_UART_IS_SCI)
+    bool rxDma = (bool)(base->C4 & UART_C4_RDMAS_MASK);
+#else
+    bool rxDma = (bool)(base->C5 & UART_C5_RDMAS_MASK);
+#endif
+#else
+    bool rxDma = false;
+#endif
 
+    /* While a DMA receive runs, the DMA reads the data register: its read also completes the
+       S1 then D sequence that clears the error flags, so errors are only reported here. */
     /* If RX framing error */
     if (UART_S1_FE_MASK & base->S1)
     {
-        /* Read base->D to clear framing error flag, otherwise the RX does not work. */
-        while (base->S1 & UART_S1_RDRF_MASK)
+        if (!rxDma)
         {
-            (void)base->D;
-        }
+            /* Read base->D to clear framing error flag, otherwise the RX does not work. */
+            while (base->S1 & UART_S1_RDRF_MASK)
+            {
+                (void)base->D;
+            }
 #if defined(FSL_FEATURE_UART_HAS_FIFO) && FSL_FEATURE_UART_HAS_FIFO
-        /* Flush FIFO date, otherwise FIFO pointer will be in unknown state. */
-        base->CFIFO |= UART_CFIFO_RXFLUSH_MASK;
+            /* Flush FIFO date, otherwise FIFO pointer will be in unknown state. */
+            base->CFIFO |= UART_CFIFO_RXFLUSH_MASK;
 #endif
 
-        handle->rxState = kUART_RxFramingError;
-        handle->rxDataSize = 0U;
+            handle->rxState = kUART_RxFramingError;
+            handle->rxDataSize = 0U;
+        }
         /* Trigger callback. */
         if (handle->callback)
         {
@@ -958,18 +1148,21 @@ void UART_TransferHandleIRQ(UART_Type *base, uart_handle_t *handle)
     /* If RX parity error */
     if (UART_S1_PF_MASK & base->S1)
     {
-        /* Read base->D to clear parity error flag, otherwise the RX does not work. */
-        while (base->S1 & UART_S1_RDRF_MASK)
+        if (!rxDma)
         {
-            (void)base->D;
-        }
+            /* Read base->D to clear parity error flag, otherwise the RX does not work. */
+            while (base->S1 & UART_S1_RDRF_MASK)
+            {
+                (void)base->D;
+            }
 #if defined(FSL_FEATURE_UART_HAS_FIFO) && FSL_FEATURE_UART_HAS_FIFO
-        /* Flush FIFO date, otherwise FIFO pointer will be in unknown state. */
-        base->CFIFO |= UART_CFIFO_RXFLUSH_MASK;
+            /* Flush FIFO date, otherwise FIFO pointer will be in unknown state. */
+            base->CFIFO |= UART_CFIFO_RXFLUSH_MASK;
 #endif
 
-        handle->rxState = kUART_RxParityError;
-        handle->rxDataSize = 0U;
+            handle->rxState = kUART_RxParityError;
+            handle->rxDataSize = 0U;
+        }
         /* Trigger callback. */
         if (handle->callback)
         {
@@ -980,15 +1173,19 @@ void UART_TransferHandleIRQ(UART_Type *base, uart_handle_t *handle)
     /* If RX overrun. */
     if (UART_S1_OR_MASK & base->S1)
     {
-        /* Read base->D to clear overrun flag, otherwise the RX does not work. */
-        while (base->S1 & UART_S1_RDRF_MASK)
+        if (!rxDma)
         {
-            (void)base->D;
-        }
+            /* Read base->D to clear overrun flag, otherwise the RX does not work. */
+            while (base->S1 & UART_S1_RDRF_MASK)
+            {
+                (void)base->D;
+            }
 #if defined(FSL_FEATURE_UART_HAS_FIFO) && FSL_FEATURE_UART_HAS_FIFO
-        /* Flush FIFO date, otherwise FIFO pointer will be in unknown state. */
-        base->CFIFO |= UART_CFIFO_RXFLUSH_MASK;
+            /* Flush FIFO date, otherwise FIFO pointer will be in unknown state. */
+            base->CFIFO |= UART_CFIFO_RXFLUSH_MASK;
 #endif
+        }
+        handle->rxHardwareOverrunCount++;
         /* Trigger callback. */
         if (handle->callback)
         {
@@ -996,8 +1193,8 @@ void UART_TransferHandleIRQ(UART_Type *base, uart_handle_t *handle)
         }
     }
 
-    /* Receive data register full */
-    if ((UART_S1_RDRF_MASK & base->S1) && (UART_C2_RIE_MASK & base->C2))
+    /* Receive data register full, and the DMA is not the one receiving */
+    if ((UART_S1_RDRF_MASK & base->S1) && (UART_C2_RIE_MASK & base->C2) && (!rxDma))
     {
 /* Get the size that can be stored into buffer for this interrupt. */
 #if defined(FSL_FEATURE_UART_HAS_FIFO) && FSL_FEATURE_UART_HAS_FIFO
@@ -1025,6 +1222,7 @@ void UART_TransferHandleIRQ(UART_Type *base, uart_handle_t *handle)
             if (!handle->rxDataSize)
             {
                 handle->rxState = kUART_RxIdle;
+                handle->rxUntilIdle = false;
 
                 if (handle->callback)
                 {
@@ -1047,9 +1245,18 @@ void UART_TransferHandleIRQ(UART_Type *base, uart_handle_t *handle)
                     }
                 }
 
-                /* If ring buffer is still full after callback function, the oldest data is overrided. */
+                /* If ring buffer is still full after callback function, apply the overflow policy. */
                 if (UART_TransferIsRxRingBufferFull(handle))
                 {
+                    handle->rxRingOverrunCount++;
+
+                    /* Only the default policy overrides the oldest data, the others drop the new byte. */
+                    if (handle->rxRingPolicy != kUART_RxRingOverwriteOldest)
+                    {
+                        (void)base->D;
+                        continue;
+                    }
+
                     /* Increase handle->rxRingBufferTail to make room for new data. */
                     if (handle->rxRingBufferTail + 1U == handle->rxRingBufferSize)
                     {
@@ -1074,13 +1281,28 @@ void UART_TransferHandleIRQ(UART_Type *base, uart_handle_t *handle)
                     handle->rxRingBufferHead++;
                 }
             }
+
+            /* Throttle the sender once the ring reaches the high watermark. */
+            if ((handle->rxRingPolicy >= kUART_RxRingFlowControlRts) && (!handle->rxRingThrottled) &&
+                (UART_TransferGetRxRingBufferLength(handle) >= handle->rxRingHighWatermark))
+            {
+                handle->rxRingThrottled = true;
+                if (handle->rxRingPolicy == kUART_RxRingFlowControlRts)
+                {
+                    handle->rxFlowCallback(base, handle, false);
+                }
+                else
+                {
+                    UART_TransferSendFlowChar(base, handle, UART_XOFF_CHAR);
+                }
+            }
         }
 
         else if (!handle->rxDataSize)
         {
-            /* Disable RX interrupt/overrun interrupt/fram error interrupt */
+            /* Disable RX interrupt/overrun interrupt/fram error interrupt/idle line interrupt */
             UART_DisableInterrupts(base, kUART_RxDataRegFullInterruptEnable | kUART_RxOverrunInterruptEnable |
-                                             kUART_FramingErrorInterruptEnable);
+                                             kUART_FramingErrorInterruptEnable | kUART_IdleLineInterruptEnable);
 
             /* Disable parity error interrupt when parity mode is enable*/
             if (UART_C1_PE_MASK & base->C1)
@@ -1093,12 +1315,40 @@ void UART_TransferHandleIRQ(UART_Type *base, uart_handle_t *handle)
         }
     }
 
+    /* Line went idle after a frame, complete a receive-until-idle transfer with what has arrived. */
+    if ((UART_S1_IDLE_MASK & base->S1) && (UART_C2_ILIE_MASK & base->C2) && (!(UART_S1_RDRF_MASK & base->S1)))
+    {
+        /* Read base->D to clear idle flag, S1 was read just above. */
+        (void)base->D;
+
+        if ((handle->rxUntilIdle) && (handle->rxDataSize != handle->rxDataSizeAll))
+        {
+            handle->rxIdleFrameSize = handle->rxDataSizeAll - handle->rxDataSize;
+            handle->rxDataSize = 0U;
+            handle->rxUntilIdle = false;
+            handle->rxState = kUART_RxIdle;
+
+            UART_DisableInterrupts(base, kUART_RxDataRegFullInterruptEnable | kUART_RxOverrunInterruptEnable |
+                                             kUART_FramingErrorInterruptEnable | kUART_IdleLineInterruptEnable);
+            if (UART_C1_PE_MASK & base->C1)
+            {
+                UART_DisableInterrupts(base, kUART_ParityErrorInterruptEnable);
+            }
+
+            if (handle->callback)
+            {
+                handle->callback(base, handle, kStatus_UART_IdleLineDetected, handle->userData);
+            }
+        }
+    }
+
     /* If framing error or parity error happened, stop the RX interrupt when ues no ring buffer */
     if (((handle->rxState == kUART_RxFramingError) || (handle->rxState == kUART_RxParityError)) &&
         (!handle->rxRingBuffer))
     {
+        handle->rxUntilIdle = false;
         UART_DisableInterrupts(base, kUART_RxDataRegFullInterruptEnable | kUART_RxOverrunInterruptEnable |
-                                         kUART_FramingErrorInterruptEnable);
+                                         kUART_FramingErrorInterruptEnable | kUART_IdleLineInterruptEnable);
 
         /* Disable parity error interrupt when parity mode is enable*/
         if (UART_C1_PE_MASK & base->C1)
@@ -1117,6 +1367,20 @@ void UART_TransferHandleIRQ(UART_Type *base, uart_handle_t *handle)
         count = 1;
 #endif
 
+        /* Flow control characters go out ahead of the data. */
+        if (handle->txFlowChar)
+        {
+            base->D = handle->txFlowChar;
+            handle->txFlowChar = 0U;
+            count--;
+
+            /* Interrupt was only enabled for the flow control character. */
+            if (!handle->txDataSize)
+            {
+                base->C2 = (base->C2 & ~UART_C2_TIE_MASK);
+            }
+        }
+
         while ((count) && (handle->txDataSize))
         {
 #if defined(FSL_FEATURE_UART_HAS_FIFO) && FSL_FEATURE_UART_HAS_FIFO
@@ -1159,7 +1423,7 @@ void UART_TransferHandleErrorIRQ(UART_Type *base, uart_handle_t *handle)
      ((defined(FSL_FEATURE_SOC_LPSCI_COUNT)) && (FSL_FEATURE_SOC_LPSCI_COUNT == 0)))
 void UART0_DriverIRQHandler(void)
 {
-    s_uartIsr(UART0, s_uartHandle[0]);
+    s_uartIsr[0](UART0, s_uartHandle[0]);
 }
 
 void UART0_RX_TX_DriverIRQHandler(void)
@@ -1172,7 +1436,7 @@ void UART0_RX_TX_DriverIRQHandler(void)
 #if defined(UART1)
 void UART1_DriverIRQHandler(void)
 {
-    s_uartIsr(UART1, s_uartHandle[1]);
+    s_uartIsr[1](UART1, s_uartHandle[1]);
 }
 
 void UART1_RX_TX_DriverIRQHandler(void)
@@ -1184,7 +1448,7 @@ void UART1_RX_TX_DriverIRQHandler(void)
 #if defined(UART2)
 void UART2_DriverIRQHandler(void)
 {
-    s_uartIsr(UART2, s_uartHandle[2]);
+    s_uartIsr[2](UART2, s_uartHandle[2]);
 }
 
 void UART2_RX_TX_DriverIRQHandler(void)
@@ -1196,7 +1460,7 @@ void UART2_RX_TX_DriverIRQHandler(void)
 #if defined(UART3)
 void UART3_DriverIRQHandler(void)
 {
-    s_uartIsr(UART3, s_uartHandle[3]);
+    s_uartIsr[3](UART3, s_uartHandle[3]);
 }
 
 void UART3_RX_TX_DriverIRQHandler(void)
@@ -1208,7 +1472,7 @@ void UART3_RX_TX_DriverIRQHandler(void)
 #if defined(UART4)
 void UART4_DriverIRQHandler(void)
 {
-    s_uartIsr(UART4, s_uartHandle[4]);
+    s_uartIsr[4](UART4, s_uartHandle[4]);
 }
 
 void UART4_RX_TX_DriverIRQHandler(void)
@@ -1220,7 +1484,7 @@ void UART4_RX_TX_DriverIRQHandler(void)
 #if defined(UART5)
 void UART5_DriverIRQHandler(void)
 {
-    s_uartIsr(UART5, s_uartHandle[5]);
+    s_uartIsr[5](UART5, s_uartHandle[5]);
 }
 
 void UART5_RX_TX_DriverIRQHandler(void)
@@ -66,6 +66,7 @@ enum _uart_status
     kStatus_UART_ParityError = MAKE_STATUS(kStatusGroup_UART, 12),        /*!< UART parity error. */
     kStatus_UART_BaudrateNotSupport =
         MAKE_STATUS(kStatusGroup_UART, 13), /*!< Baudrate is not support in current clock source */
+    kStatus_UART_IdleLineDetected = MAKE_STATUS(kStatusGroup_UART, 14), /*!< Receive-until-idle frame complete. */
 };
 
 /*! @brief UART parity mode. */
@@ -187,12 +188,45 @@ typedef struct _uart_transfer
     size_t dataSize; /*!< The byte count to be transfer. */
 } uart_transfer_t;
 
+/*! @brief What the driver does when received data reaches the RX ring buffer limits. */
+typedef enum _uart_rx_ring_policy
+{
+    kUART_RxRingOverwriteOldest = 0x0U, /*!< Full ring overwrites the oldest data (default). */
+    kUART_RxRingDropNewest = 0x1U,      /*!< Full ring discards the newly received data. */
+    kUART_RxRingFlowControlRts = 0x2U,  /*!< RTS (driven through a callback) deasserted at the high watermark. */
+    kUART_RxRingFlowControlXonXoff = 0x3U, /*!< XOFF sent at the high watermark, XON at the low watermark. */
+} uart_rx_ring_policy_t;
+
+/*! @brief Software flow control characters. */
+#define UART_XON_CHAR (0x11U)
+#define UART_XOFF_CHAR (0x13U)
+
 /* Forward declaration of the handle typedef. */
 typedef struct _uart_handle uart_handle_t;
 
 /*! @brief UART transfer callback function. */
 typedef void (*uart_transfer_callback_t)(UART_Type *base, uart_handle_t *handle, status_t status, void *userData);
 
+/*! @brief UART interrupt handler of the transactional APIs, see UART_TransferInstallHandler(). */
+typedef void (*uart_isr_t)(UART_Type *base, uart_handle_t *handle);
+
+/*!
+ * @brief Drives the RTS line for kUART_RxRingFlowControlRts.
+ *
+ * The UART on this SoC has no RTS output, so the line is a GPIO set by the application. Called
+ * from the UART interrupt with ready false and from the receive functions with ready true.
+ */
+typedef void (*uart_rx_flow_callback_t)(UART_Type *base, uart_handle_t *handle, bool ready);
+
+/*! @brief RX ring buffer overflow and flow control configuration. */
+typedef struct _uart_rx_ring_config
+{
+    uart_rx_ring_policy_t policy;        /*!< Behaviour when the ring fills up. */
+    size_t highWatermark;                /*!< Ring length at which the sender is throttled. */
+    size_t lowWatermark;                 /*!< Ring length at which the sender is resumed. */
+    uart_rx_flow_callback_t rtsCallback; /*!< RTS driver, kUART_RxRingFlowControlRts only. */
+} uart_rx_ring_config_t;
+
 /*! @brief UART handle structure. */
 struct _uart_handle
 {
@@ -213,6 +247,19 @@ struct _uart_handle
 
     volatile uint8_t txState; /*!< TX transfer state. */
     volatile uint8_t rxState; /*!< RX transfer state */
+
+    uint8_t rxRingPolicy;                 /*!< RX ring buffer policy, see uart_rx_ring_policy_t. */
+    volatile bool rxRingThrottled;        /*!< The sender has been asked to pause. */
+    volatile uint8_t txFlowChar;          /*!< XON/XOFF waiting to be sent ahead of TX data, 0 if none. */
+    uint16_t rxRingHighWatermark;         /*!< Ring length at which the sender is throttled. */
+    uint16_t rxRingLowWatermark;          /*!< Ring length at which the sender is resumed. */
+    uart_rx_flow_callback_t rxFlowCallback; /*!< RTS driver for kUART_RxRingFlowControlRts. */
+
+    volatile uint32_t rxRingOverrunCount;     /*!< Received bytes lost to a full RX ring buffer. */
+    volatile uint32_t rxHardwareOverrunCount; /*!< Receiver overruns, each loses at least one byte. */
+
+    volatile bool rxUntilIdle; /*!< The pending receive completes on an idle line. */
+    size_t rxIdleFrameSize;    /*!< Length of the last frame completed by an idle line. */
 };
 
 /*******************************************************************************
@@ -643,6 +690,58 @@ void UART_TransferStartRingBuffer(UART_Type *base, uart_handle_t *handle, uint8_
  */
 void UART_TransferStopRingBuffer(UART_Type *base, uart_handle_t *handle);
 
+/*!
+ * @brief Sets what happens when the RX ring buffer fills up.
+ *
+ * By default the oldest data is overwritten. With flow control, the sender is throttled once the
+ * ring holds highWatermark bytes and resumed when the application has read it down to
+ * lowWatermark; bytes that still arrive into a full ring are dropped, never overwritten. Lost bytes
+ * are counted in rxRingOverrunCount and rxHardwareOverrunCount of the handle.
+ *
+ * Call after UART_TransferStartRingBuffer().
+ *
+ * @param base UART peripheral base address.
+ * @param handle UART handle pointer.
+ * @param config Policy and watermarks; watermarks are ignored by the non flow control policies.
+ * @retval kStatus_Success          Execution successfully
+ * @retval kStatus_InvalidArgument  No ring buffer, watermarks out of order, or no RTS callback
+ */
+status_t UART_TransferSetRxRingPolicy(UART_Type *base, uart_handle_t *handle, const uart_rx_ring_config_t *config);
+
+/*!
+ * @brief Gets the number of received bytes waiting in the RX ring buffer.
+ *
+ * @param handle UART handle pointer.
+ * @return Length of received data in RX ring buffer.
+ */
+size_t UART_TransferGetRxRingBufferLength(uart_handle_t *handle);
+
+/*!
+ * @brief Gets the received data in the RX ring buffer without copying it.
+ *
+ * Pending data is described by up to two contiguous spans: spans[0] from the tail onwards and
+ * spans[1] from the start of the ring when the data wraps. Parse the data in place, then call
+ * UART_TransferCommitRxRingBuffer() to release the bytes consumed.
+ *
+ * @note The ring keeps filling in the background, but bytes already peeked stay valid until
+ * they are committed unless the ring overruns.
+ *
+ * @param base UART peripheral base address.
+ * @param handle UART handle pointer.
+ * @param spans Filled with the two spans, unused spans have dataSize 0.
+ * @return Total number of bytes in both spans.
+ */
+size_t UART_TransferPeekRxRingBuffer(UART_Type *base, uart_handle_t *handle, uart_transfer_t spans[2]);
+
+/*!
+ * @brief Releases bytes returned by UART_TransferPeekRxRingBuffer() back to the RX ring buffer.
+ *
+ * @param base UART peripheral base address.
+ * @param handle UART handle pointer.
+ * @param count Bytes consumed from the start of spans[0], continuing into spans[1].
+ */
+void UART_TransferCommitRxRingBuffer(UART_Type *base, uart_handle_t *handle, size_t count);
+
 /*!
  * @brief Transmits a buffer of data using the interrupt method.
  *
@@ -732,6 +831,28 @@ status_t UART_TransferReceiveNonBlocking(UART_Type *base,
  */
 void UART_TransferAbortReceive(UART_Type *base, uart_handle_t *handle);
 
+/*!
+ * @brief Receives a variable-length frame using the interrupt method.
+ *
+ * This function receives into xfer->data like UART_TransferReceiveNonBlocking, but the
+ * transfer also completes when the line goes idle for one character time after at least
+ * one byte has arrived. The callback is then called with @ref kStatus_UART_IdleLineDetected
+ * and the frame length is in the rxIdleFrameSize member of the handle. A frame that fills
+ * xfer->dataSize completes with @ref kStatus_UART_RxIdle as usual. The C1[ILT] bit selects
+ * whether the idle time is counted from the start bit or the stop bit of the last character;
+ * it is left as configured by UART_Init.
+ *
+ * Only usable when the RX ring buffer is not installed.
+ *
+ * @param base UART peripheral base address.
+ * @param handle UART handle pointer.
+ * @param xfer UART transfer structure, see #uart_transfer_t.
+ * @retval kStatus_Success Successfully started the receive.
+ * @retval kStatus_UART_RxBusy Previous receive request is not finished.
+ * @retval kStatus_InvalidArgument Invalid argument or the RX ring buffer is in use.
+ */
+status_t UART_TransferReceiveUntilIdleNonBlocking(UART_Type *base, uart_handle_t *handle, uart_transfer_t *xfer);
+
 /*!
  * @brief Gets the number of bytes that have been received.
  *
@@ -756,6 +877,22 @@ status_t UART_TransferGetReceiveCount(UART_Type *base, uart_handle_t *handle, ui
  */
 void UART_TransferHandleIRQ(UART_Type *base, uart_handle_t *handle);
 
+/*!
+ * @brief Routes the interrupt of a UART instance to another handler.
+ *
+ * UART_TransferCreateHandle() installs UART_TransferHandleIRQ(). A driver that needs the
+ * interrupt for a while, as the UART DMA driver does for idle line detection, installs its own
+ * handler and puts the returned one back when done. The handler gets the handle created with
+ * UART_TransferCreateHandle(), or NULL, and passes the interrupt on to UART_TransferHandleIRQ().
+ * While the RX DMA request is enabled, UART_TransferHandleIRQ() leaves the data register to the
+ * DMA and only serves transmit and reports receive errors.
+ *
+ * @param base UART peripheral base address.
+ * @param isr Interrupt handler to install.
+ * @return The handler replaced, NULL if there was none.
+ */
+uart_isr_t UART_TransferInstallHandler(UART_Type *base, uart_isr_t isr);
+
 /*!
  * @brief UART Error IRQ handle function.
  *
@@ -67,6 +67,7 @@ typedef struct _uart_dma_private_handle
 {
     UART_Type *base;
     uart_dma_handle_t *handle;
+    uart_isr_t isr; /* Interrupt handler replaced while waiting for an idle line. */
 } uart_dma_private_handle_t;
 
 /* UART DMA transfer handle. */
@@ -85,6 +86,9 @@ enum _uart_dma_tansfer_states
 /*<! Private handle only used for internally. */
 static uart_dma_private_handle_t s_dmaPrivateHandle[UART_HANDLE_ARRAY_SIZE];
 
+/* Array of UART IRQ number. */
+static const IRQn_Type s_uartIRQ[] = UART_RX_TX_IRQS;
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -111,6 +115,22 @@ static void UART_TransferSendDMACallback(dma_handle_t *handle, void *param);
  */
 static void UART_TransferReceiveDMACallback(dma_handle_t *handle, void *param);
 
+/*!
+ * @brief Stops waiting for an idle line and gives the interrupt back to its previous handler.
+ *
+ * @param base UART peripheral base address.
+ * @param handle UART DMA handle pointer.
+ */
+static void UART_TransferStopIdleLineDMA(UART_Type *base, uart_dma_handle_t *handle);
+
+/*!
+ * @brief UART IRQ handler used while a DMA receive waits for an idle line.
+ *
+ * @param base UART peripheral base address.
+ * @param irqHandle Interrupt transfer handle of this instance, NULL if none was created.
+ */
+static void UART_TransferHandleIdleLineDMA(UART_Type *base, uart_handle_t *irqHandle);
+
 /*!
  * @brief Get the UART instance from peripheral base address.
  *
@@ -152,6 +172,9 @@ static void UART_TransferReceiveDMACallback(dma_handle_t *handle, void *param)
 
     uart_dma_private_handle_t *uartPrivateHandle = (uart_dma_private_handle_t *)param;
 
+    /* Buffer filled before the line went idle. */
+    UART_TransferStopIdleLineDMA(uartPrivateHandle->base, uartPrivateHandle->handle);
+
     /* Disable UART RX DMA. */
     UART_EnableRxDMA(uartPrivateHandle->base, false);
 
@@ -258,6 +281,62 @@ status_t UART_TransferSendDMA(UART_Type *base, uart_dma_handle_t *handle, uart_t
     return status;
 }
 
+status_t UART_TransferSendSegmentsDMA(UART_Type *base,
+                                   uart_dma_handle_t *handle,
+                                   const dma_sg_segment_t *segments,
+                                   uint32_t segmentCount)
+{
+    assert(handle);
+    assert(handle->txDmaHandle);
+    assert(segments);
+
+    dma_transfer_config_t xferConfig;
+    status_t status;
+    uint32_t dataSize = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < segmentCount; i++)
+    {
+        dataSize += segments[i].dataSize;
+    }
+
+    /* Input check. */
+    if (0U == dataSize)
+    {
+        status = kStatus_InvalidArgument;
+    }
+    /* If previous TX not finished. */
+    else if (kUART_TxBusy == handle->txState)
+    {
+        status = kStatus_UART_TxBusy;
+    }
+    else
+    {
+        handle->txState = kUART_TxBusy;
+        handle->txDataSizeAll = dataSize;
+
+        /* Prepare the peripheral side, the DMA driver loads the non-empty segments. */
+        DMA_PrepareTransfer(&xferConfig, segments[0].data, sizeof(uint8_t), (void *)UART_GetDataRegisterAddress(base),
+                            sizeof(uint8_t), segments[0].dataSize, kDMA_MemoryToPeripheral);
+
+        /* Submit transfer, a channel still busy leaves the handle idle. */
+        status = DMA_SubmitScatterGather(handle->txDmaHandle, &xferConfig, segments, segmentCount);
+        if (kStatus_Success == status)
+        {
+            DMA_StartTransfer(handle->txDmaHandle);
+
+            /* Enable UART TX DMA. */
+            UART_EnableTxDMA(base, true);
+        }
+        else
+        {
+            handle->txState = kUART_TxIdle;
+        }
+    }
+
+    return status;
+}
+
 status_t UART_TransferReceiveDMA(UART_Type *base, uart_dma_handle_t *handle, uart_transfer_t *xfer)
 {
     assert(handle);
@@ -296,6 +375,77 @@ status_t UART_TransferReceiveDMA(UART_Type *base, uart_dma_handle_t *handle, uar
     return status;
 }
 
+static void UART_TransferStopIdleLineDMA(UART_Type *base, uart_dma_handle_t *handle)
+{
+    if (handle->rxUntilIdle)
+    {
+        handle->rxUntilIdle = false;
+        UART_DisableInterrupts(base, kUART_IdleLineInterruptEnable);
+        (void)UART_TransferInstallHandler(base, s_dmaPrivateHandle[UART_GetInstance(base)].isr);
+    }
+}
+
+static void UART_TransferHandleIdleLineDMA(UART_Type *base, uart_handle_t *irqHandle)
+{
+    uart_dma_handle_t *handle = s_dmaPrivateHandle[UART_GetInstance(base)].handle;
+    uint32_t received;
+
+    /* RDRF set means DMA has not fetched the last byte yet, the idle flag is cleared next time. */
+    if ((handle) && (handle->rxUntilIdle) && (UART_S1_IDLE_MASK & base->S1) && (!(UART_S1_RDRF_MASK & base->S1)))
+    {
+        /* Read base->D to clear idle flag, S1 was read just above. */
+        (void)base->D;
+
+        received = handle->rxDataSizeAll -
+                   DMA_GetRemainingBytes(handle->rxDmaHandle->base, handle->rxDmaHandle->channel);
+        if (received)
+        {
+            UART_TransferAbortReceiveDMA(base, handle);
+            handle->rxIdleFrameSize = received;
+
+            if (handle->callback)
+            {
+                handle->callback(base, handle, kStatus_UART_IdleLineDetected, handle->userData);
+            }
+        }
+    }
+
+    /* Transmit and errors of the interrupt driver sharing the instance, it leaves the data
+       register alone while the RX DMA request is enabled. */
+    if (irqHandle)
+    {
+        UART_TransferHandleIRQ(base, irqHandle);
+    }
+}
+
+status_t UART_TransferReceiveUntilIdleDMA(UART_Type *base, uart_dma_handle_t *handle, uart_transfer_t *xfer)
+{
+    uint32_t instance = UART_GetInstance(base);
+    status_t status;
+
+    status = UART_TransferReceiveDMA(base, handle, xfer);
+    if (kStatus_Success != status)
+    {
+        return status;
+    }
+
+    handle->rxIdleFrameSize = 0U;
+    handle->rxUntilIdle = true;
+
+    /* Route the UART interrupt through the idle line handler until the transfer ends. */
+    s_dmaPrivateHandle[instance].isr = UART_TransferInstallHandler(base, UART_TransferHandleIdleLineDMA);
+    EnableIRQ(s_uartIRQ[instance]);
+
+    /* Drop an idle flag left from before this transfer, read S1 then D to clear it. */
+    if ((UART_S1_IDLE_MASK & base->S1) && (!(UART_S1_RDRF_MASK & base->S1)))
+    {
+        (void)base->D;
+    }
+    UART_EnableInterrupts(base, kUART_IdleLineInterruptEnable);
+
+    return kStatus_Success;
+}
+
 void UART_TransferAbortSendDMA(UART_Type *base, uart_dma_handle_t *handle)
 {
     assert(handle);
@@ -318,6 +468,9 @@ void UART_TransferAbortReceiveDMA(UART_Type *base, uart_dma_handle_t *handle)
     assert(handle);
     assert(handle->rxDmaHandle);
 
+    /* Stop waiting for an idle line. */
+    UART_TransferStopIdleLineDMA(base, handle);
+
     /* Disable UART RX DMA. */
     UART_EnableRxDMA(base, false);
 
@@ -341,7 +494,7 @@ status_t UART_TransferGetSendCountDMA(UART_Type *base, uart_dma_handle_t *handle
         return kStatus_NoTransferInProgress;
     }
 
-    *count = handle->txDataSizeAll - DMA_GetRemainingBytes(handle->txDmaHandle->base, handle->txDmaHandle->channel);
+    *count = handle->txDataSizeAll - DMA_GetTransferRemainingBytes(handle->txDmaHandle);
 
     return kStatus_Success;
 }
@@ -70,6 +70,9 @@ struct _uart_dma_handle
 
     volatile uint8_t txState; /*!< TX transfer state. */
     volatile uint8_t rxState; /*!< RX transfer state */
+
+    volatile bool rxUntilIdle; /*!< The pending receive completes on an idle line. */
+    size_t rxIdleFrameSize;    /*!< Length of the last frame completed by an idle line. */
 };
 
 /*******************************************************************************
@@ -117,6 +120,30 @@ void UART_TransferCreateHandleDMA(UART_Type *base,
  */
 status_t UART_TransferSendDMA(UART_Type *base, uart_dma_handle_t *handle, uart_transfer_t *xfer);
 
+/*!
+ * @brief Sends a list of buffers as one stream using DMA.
+ *
+ * This function sends the segments back to back without copying them into a single buffer,
+ * for example a frame header followed by its payload. The DMA interrupt loads each segment
+ * after the previous one completes. This is a non-blocking function; when all segments are
+ * sent, the send callback function is called once with kStatus_UART_TxIdle.
+ *
+ * @note The segment array and the data it points to must stay valid until the transfer completes.
+ *
+ * @param base UART peripheral base address.
+ * @param handle UART handle pointer.
+ * @param segments Array of segments to send, see #dma_sg_segment_t.
+ * @param segmentCount Number of segments in the array, empty segments are skipped.
+ * @retval kStatus_Success if successful, others failed.
+ * @retval kStatus_UART_TxBusy Previous transfer on going.
+ * @retval kStatus_InvalidArgument The segments hold no data.
+ * @retval kStatus_DMA_Busy The TX DMA channel is still busy, nothing was started.
+ */
+status_t UART_TransferSendSegmentsDMA(UART_Type *base,
+                                   uart_dma_handle_t *handle,
+                                   const dma_sg_segment_t *segments,
+                                   uint32_t segmentCount);
+
 /*!
  * @brief Receives data using DMA.
  *
@@ -152,6 +179,26 @@ void UART_TransferAbortSendDMA(UART_Type *base, uart_dma_handle_t *handle);
  */
 void UART_TransferAbortReceiveDMA(UART_Type *base, uart_dma_handle_t *handle);
 
+/*!
+ * @brief Receives a variable-length frame using DMA.
+ *
+ * This function starts a DMA receive like UART_TransferReceiveDMA and also enables the idle
+ * line interrupt. When the line goes idle after at least one byte has been received, the DMA
+ * transfer is stopped, the frame length is stored in the rxIdleFrameSize member of the handle
+ * and the callback is called with @ref kStatus_UART_IdleLineDetected. A frame that fills
+ * xfer->dataSize completes with @ref kStatus_UART_RxIdle as usual.
+ *
+ * The idle line interrupt is taken through the UART IRQ dispatcher of fsl_uart. Instances
+ * with a handle from UART_TransferCreateHandle keep being serviced by UART_TransferHandleIRQ.
+ *
+ * @param base UART peripheral base address.
+ * @param handle Pointer to the uart_dma_handle_t structure.
+ * @param xfer UART DMA transfer structure. See #uart_transfer_t.
+ * @retval kStatus_Success if succeeded; otherwise failed.
+ * @retval kStatus_UART_RxBusy Previous transfer ongoing.
+ */
+status_t UART_TransferReceiveUntilIdleDMA(UART_Type *base, uart_dma_handle_t *handle, uart_transfer_t *xfer);
+
 /*!
  * @brief Gets the number of bytes written to UART TX register.
  *
@@ -0,0 +1,49 @@
+/*
+ * Program flash commands shared by the state store and the firmware update
+ * One flash driver configuration, commands run with interrupts held off
+ */
+
+/* SDK Included Files */
+#include "fsl_flash.h"
+#include "app_flash.h"
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static flash_config_t s_flashConfig;
+static bool s_flashReady;
+static status_t s_initStatus;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/* See app_flash.h for documentation of this function. */
+status_t AppFlash_Init(void)
+{
+    if (!s_flashReady) {
+        s_initStatus = FLASH_Init(&s_flashConfig);
+        s_flashReady = true;
+    }
+    return s_initStatus;
+}
+
+/* See app_flash.h for documentation of this function. */
+status_t AppFlash_EraseSector(uint32_t address)
+{
+    uint32_t primask = DisableGlobalIRQ();
+    status_t status = FLASH_Erase(&s_flashConfig, address, APP_FLASH_SECTOR_SIZE, kFLASH_ApiEraseKey);
+
+    EnableGlobalIRQ(primask);
+    return status;
+}
+
+/* See app_flash.h for documentation of this function. */
+status_t AppFlash_Program(uint32_t address, uint32_t *words, uint32_t length)
+{
+    uint32_t primask = DisableGlobalIRQ();
+    status_t status = FLASH_Program(&s_flashConfig, address, words, length);
+
+    EnableGlobalIRQ(primask);
+    return status;
+}
@@ -0,0 +1,44 @@
+/*
+ * Program flash commands shared by the state store and the firmware update
+ * One flash driver configuration, commands run with interrupts held off
+ */
+
+#ifndef _APP_FLASH_H_
+#define _APP_FLASH_H_
+
+#include <stdint.h>
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Erase unit and program unit of the program flash */
+#define APP_FLASH_SECTOR_SIZE   FSL_FEATURE_FLASH_PFLASH_BLOCK_SECTOR_SIZE
+#define APP_FLASH_WORD_SIZE     FSL_FEATURE_FLASH_PFLASH_BLOCK_WRITE_UNIT_SIZE
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief Set up the flash driver, once; later calls return the first result
+ */
+status_t AppFlash_Init(void);
+
+/*!
+ * @brief Erase the sector at address, a multiple of APP_FLASH_SECTOR_SIZE
+ *
+ * Vectors and handlers live in the flash being operated on, a fetch during the
+ * command would be a read collision, so interrupts are held off until it ends.
+ */
+status_t AppFlash_EraseSector(uint32_t address);
+
+/*!
+ * @brief Program length bytes (a multiple of APP_FLASH_WORD_SIZE) of erased flash
+ *
+ * Interrupts are held off as for AppFlash_EraseSector.
+ */
+status_t AppFlash_Program(uint32_t address, uint32_t *words, uint32_t length);
+
+#endif /* _APP_FLASH_H_ */
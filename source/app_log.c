@@ -0,0 +1,211 @@
+/*
+ * Leveled, rate-limited logging for the application
+ * Per-module runtime levels over a build-time threshold, printed through stdout
+ */
+
+/* Standard C Included Files */
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+/* SDK Included Files */
+#include "board.h"
+#include "fsl_debug_console.h"
+#include "app_time.h"
+#include "app_log.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+// Refill works in whole milliseconds per token, a faster rate would round to 0
+#if (APP_LOG_RATE_PER_SEC == 0U) || (APP_LOG_RATE_PER_SEC > 1000U)
+#error "APP_LOG_RATE_PER_SEC must be between 1 and 1000"
+#endif
+#define APP_LOG_MS_PER_TOKEN    (1000U / APP_LOG_RATE_PER_SEC)
+
+// The bucket is a uint8_t, a larger burst would truncate in the init and the refill
+#if (APP_LOG_BURST == 0U) || (APP_LOG_BURST > 255U)
+#error "APP_LOG_BURST must be between 1 and 255"
+#endif
+
+typedef struct {
+    uint8_t level;              // Runtime level
+    uint8_t tokens;             // Messages that may go out right now
+    uint32_t lastRefillMs;      // Time the bucket was last topped up
+    uint32_t suppressed;        // Dropped since the last printed message
+    uint32_t suppressedTotal;   // Dropped since boot
+} app_log_module_state_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static const char *const s_moduleNames[APP_LOG_MODULE_COUNT] = {"app", "i2c", "led", "packet", "spi", "store", "update"};
+static const char *const s_levelNames[] = {"none", "error", "warn", "info", "debug"};
+
+static app_log_module_state_t s_modules[APP_LOG_MODULE_COUNT];
+static bool s_initialized;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void AppLog_Init(void)
+{
+    uint32_t now = AppTime_GetMs();
+
+    for (uint32_t i = 0; i < APP_LOG_MODULE_COUNT; i++) {
+        s_modules[i].level = APP_LOG_DEFAULT_LEVEL;
+        s_modules[i].tokens = APP_LOG_BURST;
+        s_modules[i].lastRefillMs = now;
+    }
+    s_initialized = true;
+}
+
+/*!
+ * @brief Add the tokens earned since the last refill, up to the burst size
+ */
+static void AppLog_Refill(app_log_module_state_t *state)
+{
+    uint32_t now = AppTime_GetMs();
+    uint32_t earned = (now - state->lastRefillMs) / APP_LOG_MS_PER_TOKEN;
+
+    if (earned == 0U) {
+        return;
+    }
+    // Keep the remainder so slow trickles still earn tokens
+    state->lastRefillMs += earned * APP_LOG_MS_PER_TOKEN;
+    if (earned >= (uint32_t)(APP_LOG_BURST - state->tokens)) {
+        state->tokens = APP_LOG_BURST;
+        state->lastRefillMs = now;
+    } else {
+        state->tokens += earned;
+    }
+}
+
+/* See app_log.h for documentation of this function. */
+bool AppLog_Allow(app_log_module_t module, int level)
+{
+    app_log_module_state_t *state;
+
+    if (!s_initialized) {
+        AppLog_Init();
+    }
+    if ((uint32_t)module >= APP_LOG_MODULE_COUNT) {
+        return false;
+    }
+    state = &s_modules[module];
+    if (level > state->level) {
+        return false;
+    }
+
+    AppLog_Refill(state);
+    if (state->tokens == 0U) {
+        state->suppressed++;
+        state->suppressedTotal++;
+        return false;
+    }
+    state->tokens--;
+
+    if (state->suppressed != 0U) {
+        printf("[%s] %lu messages suppressed\n", s_moduleNames[module], (unsigned long)state->suppressed);
+        state->suppressed = 0U;
+    }
+    return true;
+}
+
+/* See app_log.h for documentation of this function. */
+void AppLog_Printf(app_log_module_t module, int level, const char *format, ...)
+{
+    va_list ap;
+
+    if (!AppLog_Allow(module, level)) {
+        return;
+    }
+    va_start(ap, format);
+    vprintf(format, ap);
+    va_end(ap);
+}
+
+/* See app_log.h for documentation of this function. */
+void AppLog_SetLevel(app_log_module_t module, int level)
+{
+    if (!s_initialized) {
+        AppLog_Init();
+    }
+    if ((uint32_t)module < APP_LOG_MODULE_COUNT) {
+        s_modules[module].level = (uint8_t)level;
+    }
+}
+
+/* See app_log.h for documentation of this function. */
+int AppLog_GetLevel(app_log_module_t module)
+{
+    if (!s_initialized) {
+        AppLog_Init();
+    }
+    return ((uint32_t)module < APP_LOG_MODULE_COUNT) ? s_modules[module].level : APP_LOG_LEVEL_NONE;
+}
+
+/*!
+ * @brief Index of name in a table, or -1; matches up to the next space or end of string
+ */
+static int AppLog_Lookup(const char *name, const char *const *table, int count)
+{
+    size_t len = strcspn(name, " ");
+
+    for (int i = 0; i < count; i++) {
+        if ((strlen(table[i]) == len) && (strncmp(name, table[i], len) == 0)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* See app_log.h for documentation of this function. */
+bool AppLog_Command(const char *args)
+{
+    const char *levelArg;
+    int module;
+    int level;
+
+    if (!s_initialized) {
+        AppLog_Init();
+    }
+
+    while (*args == ' ') {
+        args++;
+    }
+    if (*args == '\0') {
+        for (uint32_t i = 0; i < APP_LOG_MODULE_COUNT; i++) {
+            printf("  %-7s %-6s suppressed %lu\n", s_moduleNames[i], s_levelNames[s_modules[i].level],
+                   (unsigned long)s_modules[i].suppressedTotal);
+        }
+        printf("  (build level %s)\n", s_levelNames[APP_LOG_BUILD_LEVEL]);
+        return true;
+    }
+
+    levelArg = args + strcspn(args, " ");
+    while (*levelArg == ' ') {
+        levelArg++;
+    }
+    level = AppLog_Lookup(levelArg, s_levelNames, ARRAY_SIZE(s_levelNames));
+    if (level < 0) {
+        return false;
+    }
+
+    if (strncmp(args, "all ", 4) == 0) {
+        for (uint32_t i = 0; i < APP_LOG_MODULE_COUNT; i++) {
+            s_modules[i].level = (uint8_t)level;
+        }
+    } else {
+        module = AppLog_Lookup(args, s_moduleNames, APP_LOG_MODULE_COUNT);
+        if (module < 0) {
+            return false;
+        }
+        s_modules[module].level = (uint8_t)level;
+    }
+    if (level > APP_LOG_BUILD_LEVEL) {
+        printf("  note: levels above %s are compiled out\n", s_levelNames[APP_LOG_BUILD_LEVEL]);
+    }
+    return true;
+}
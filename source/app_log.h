@@ -0,0 +1,131 @@
+/*
+ * Leveled, rate-limited logging for the application
+ * Per-module runtime levels over a build-time threshold, printed through stdout
+ */
+
+#ifndef _APP_LOG_H_
+#define _APP_LOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Log levels, lower is more severe. */
+#define APP_LOG_LEVEL_NONE  0
+#define APP_LOG_LEVEL_ERROR 1
+#define APP_LOG_LEVEL_WARN  2
+#define APP_LOG_LEVEL_INFO  3
+#define APP_LOG_LEVEL_DEBUG 4
+
+/*!
+ * @brief Most verbose level compiled in; calls above it leave no code or strings behind
+ *
+ * Production builds set e.g. -DAPP_LOG_BUILD_LEVEL=APP_LOG_LEVEL_WARN.
+ */
+#ifndef APP_LOG_BUILD_LEVEL
+#define APP_LOG_BUILD_LEVEL APP_LOG_LEVEL_DEBUG
+#endif
+
+/*! @brief Runtime level every module starts at. */
+#ifndef APP_LOG_DEFAULT_LEVEL
+#define APP_LOG_DEFAULT_LEVEL APP_LOG_LEVEL_INFO
+#endif
+
+/*! @brief Token bucket per module: burst size (1 to 255) and sustained messages per second (1 to 1000). */
+#ifndef APP_LOG_BURST
+#define APP_LOG_BURST 16U
+#endif
+#ifndef APP_LOG_RATE_PER_SEC
+#define APP_LOG_RATE_PER_SEC 8U
+#endif
+
+/*! @brief Modules with their own level and rate limit. */
+typedef enum {
+    APP_LOG_MODULE_APP = 0,     // Banners and start-up
+    APP_LOG_MODULE_I2C,         // Slave transfers and bus errors
+    APP_LOG_MODULE_LED,         // LED changes
+    APP_LOG_MODULE_PACKET,      // Per-packet dumps
+    APP_LOG_MODULE_SPI,         // SPI link transfers and resyncs
+    APP_LOG_MODULE_STORE,       // Persistent state store
+    APP_LOG_MODULE_UPDATE,      // Firmware update over I2C
+    APP_LOG_MODULE_COUNT
+} app_log_module_t;
+
+/*!
+ * @name Logging macros
+ * Each checks the module's runtime level and rate limit, then prints like printf.
+ * Compiled out entirely above APP_LOG_BUILD_LEVEL.
+ * @{
+ */
+#if APP_LOG_BUILD_LEVEL >= APP_LOG_LEVEL_ERROR
+#define APP_LOG_ERROR(module, ...) AppLog_Printf((module), APP_LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define APP_LOG_ERROR(module, ...) ((void)0)
+#endif
+#if APP_LOG_BUILD_LEVEL >= APP_LOG_LEVEL_WARN
+#define APP_LOG_WARN(module, ...) AppLog_Printf((module), APP_LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define APP_LOG_WARN(module, ...) ((void)0)
+#endif
+#if APP_LOG_BUILD_LEVEL >= APP_LOG_LEVEL_INFO
+#define APP_LOG_INFO(module, ...) AppLog_Printf((module), APP_LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define APP_LOG_INFO(module, ...) ((void)0)
+#endif
+#if APP_LOG_BUILD_LEVEL >= APP_LOG_LEVEL_DEBUG
+#define APP_LOG_DEBUG(module, ...) AppLog_Printf((module), APP_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define APP_LOG_DEBUG(module, ...) ((void)0)
+#endif
+/*! @} */
+
+/*!
+ * @brief Guard for a multi-line record printed with plain printf
+ *
+ * Costs one rate-limit token for the whole record. Folds to 0 above APP_LOG_BUILD_LEVEL,
+ * so the guarded block is dropped by the compiler.
+ */
+#define APP_LOG_ENABLED(module, level) (((level) <= APP_LOG_BUILD_LEVEL) && AppLog_Allow((module), (level)))
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief Decide whether a message may be printed now, and take a token if so
+ *
+ * Prints a "N messages suppressed" summary first if the module dropped messages since
+ * its last printed one.
+ */
+bool AppLog_Allow(app_log_module_t module, int level);
+
+/*!
+ * @brief printf-style output gated by AppLog_Allow; use the APP_LOG_* macros instead
+ */
+void AppLog_Printf(app_log_module_t module, int level, const char *format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+/*!
+ * @brief Change the runtime level of one module
+ */
+void AppLog_SetLevel(app_log_module_t module, int level);
+
+/*!
+ * @brief Current runtime level of one module
+ */
+int AppLog_GetLevel(app_log_module_t module);
+
+/*!
+ * @brief Handle the "loglevel" control command
+ *
+ * Arguments are "<module|all> <none|error|warn|info|debug>"; with no arguments the
+ * current levels and suppression counters are listed.
+ *
+ * @return true if the arguments were understood.
+ */
+bool AppLog_Command(const char *args);
+
+#endif /* _APP_LOG_H_ */
@@ -0,0 +1,241 @@
+/*
+ * Console command shell for live inspection and tuning
+ * Input is collected by the LPSCI receive interrupt and handled only in idle time
+ */
+
+/* Standard C Included Files */
+#include <stdio.h>
+#include <string.h>
+
+/* SDK Included Files */
+#include "board.h"
+#include "fsl_debug_console.h"
+#include "app_log.h"
+#include "app_shell.h"
+
+#if APP_SHELL_ENABLE
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SHELL_PROMPT        "> "
+#define SHELL_READ_CHUNK    16U
+#define SHELL_TRACE_SHOW    8U      // Branch records printed by "trace show"
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static void shellHelp(const char *args);
+static void shellLogLevel(const char *args);
+static void shellDump(const char *args);
+static void shellTrace(const char *args);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static const app_shell_command_t s_builtinCommands[] = {
+    {"help", "list commands", shellHelp},
+    {"loglevel", "[<module|all> <none|error|warn|info|debug>]", shellLogLevel},
+    {"dump", "regs - I2C1, console LPSCI and NVIC registers", shellDump},
+    {"trace", "start|stop|show - MTB branch trace", shellTrace},
+};
+
+static const app_shell_command_t *s_appCommands;
+static uint32_t s_appCommandCount;
+
+static char s_line[APP_SHELL_LINE_SIZE + 1U];
+static uint32_t s_lineLength;
+static bool s_lineOverflow;
+static bool s_lastWasCR;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void shellHelp(const char *args)
+{
+    (void)args;
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(s_builtinCommands); i++) {
+        printf("  %-9s %s\n", s_builtinCommands[i].name, s_builtinCommands[i].help);
+    }
+    for (uint32_t i = 0; i < s_appCommandCount; i++) {
+        printf("  %-9s %s\n", s_appCommands[i].name, s_appCommands[i].help);
+    }
+}
+
+static void shellLogLevel(const char *args)
+{
+    if (!AppLog_Command(args)) {
+        printf("usage: loglevel [<module|all> <none|error|warn|info|debug>]\n");
+    }
+}
+
+static void shellDump(const char *args)
+{
+    if (strcmp(args, "regs") != 0) {
+        printf("usage: dump regs\n");
+        return;
+    }
+
+    printf("I2C1  A1=%02X F=%02X C1=%02X S=%02X C2=%02X FLT=%02X SMB=%02X\n", I2C1->A1, I2C1->F, I2C1->C1,
+           I2C1->S, I2C1->C2, I2C1->FLT, I2C1->SMB);
+    // Reading S1 does not clear flags on its own; the driver's data register read does
+    printf("UART0 BDH=%02X BDL=%02X C1=%02X C2=%02X C3=%02X C4=%02X C5=%02X S1=%02X S2=%02X\n", UART0->BDH,
+           UART0->BDL, UART0->C1, UART0->C2, UART0->C3, UART0->C4, UART0->C5, UART0->S1, UART0->S2);
+    printf("NVIC  ISER=%08lX ISPR=%08lX\n", (unsigned long)NVIC->ISER[0], (unsigned long)NVIC->ISPR[0]);
+    printf("      IPR0-7=%08lX %08lX %08lX %08lX %08lX %08lX %08lX %08lX\n", (unsigned long)NVIC->IP[0],
+           (unsigned long)NVIC->IP[1], (unsigned long)NVIC->IP[2], (unsigned long)NVIC->IP[3],
+           (unsigned long)NVIC->IP[4], (unsigned long)NVIC->IP[5], (unsigned long)NVIC->IP[6],
+           (unsigned long)NVIC->IP[7]);
+    printf("SCB   ICSR=%08lX SHP3=%08lX\n", (unsigned long)SCB->ICSR, (unsigned long)SCB->SHP[1]);
+}
+
+/*!
+ * @brief Start, stop or print the Micro Trace Buffer set up by mtb.c and the debugger
+ *
+ * The trace window is 2^(MASK+4) bytes at MTB->BASE; each record is a source/destination pair.
+ */
+static void shellTrace(const char *args)
+{
+    uint32_t windowSize = 1UL << ((MTB->MASTER & MTB_MASTER_MASK_MASK) + 4U);
+    uint32_t position = MTB->POSITION & MTB_POSITION_POINTER_MASK;
+    uint32_t windowOffset = position & ~(windowSize - 1U);
+
+    if (strcmp(args, "start") == 0) {
+        MTB->MASTER |= MTB_MASTER_EN_MASK;
+    } else if (strcmp(args, "stop") == 0) {
+        MTB->MASTER &= ~MTB_MASTER_EN_MASK;
+    } else if (strcmp(args, "show") == 0) {
+        const volatile uint32_t *window = (const volatile uint32_t *)(MTB->BASE + windowOffset);
+        bool wrapped = (MTB->POSITION & MTB_POSITION_WRAP_MASK) != 0U;
+        uint32_t records = (wrapped ? windowSize : (position - windowOffset)) / 8U;
+        uint32_t next = (position - windowOffset) / 8U;
+
+        if (MTB->MASTER & MTB_MASTER_EN_MASK) {
+            printf("trace is running, stop it first\n");
+            return;
+        }
+        if (records > SHELL_TRACE_SHOW) {
+            records = SHELL_TRACE_SHOW;
+        }
+        // Oldest of the shown records first
+        for (uint32_t i = records; i > 0U; i--) {
+            uint32_t index = (next + (windowSize / 8U) - i) & ((windowSize / 8U) - 1U);
+            printf("  %08lX -> %08lX\n", (unsigned long)(window[index * 2U] & ~1UL),
+                   (unsigned long)(window[(index * 2U) + 1U] & ~1UL));
+        }
+    } else {
+        printf("usage: trace start|stop|show\n");
+        return;
+    }
+
+    printf("trace %s, %lu byte window at %08lX\n", (MTB->MASTER & MTB_MASTER_EN_MASK) ? "on" : "off",
+           (unsigned long)windowSize, (unsigned long)(MTB->BASE + windowOffset));
+}
+
+/*!
+ * @brief Look up the first word of the line and run its handler
+ */
+static void shellExecute(char *line)
+{
+    size_t nameLength;
+    char *args;
+
+    while (*line == ' ') {
+        line++;
+    }
+    if (*line == '\0') {
+        return;
+    }
+
+    nameLength = strcspn(line, " ");
+    args = line + nameLength;
+    while (*args == ' ') {
+        args++;
+    }
+    line[nameLength] = '\0';
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(s_builtinCommands); i++) {
+        if (strcmp(line, s_builtinCommands[i].name) == 0) {
+            s_builtinCommands[i].handler(args);
+            return;
+        }
+    }
+    for (uint32_t i = 0; i < s_appCommandCount; i++) {
+        if (strcmp(line, s_appCommands[i].name) == 0) {
+            s_appCommands[i].handler(args);
+            return;
+        }
+    }
+    printf("unknown command '%s', try help\n", line);
+}
+
+/*!
+ * @brief Line editing for one received character
+ */
+static void shellInput(char c)
+{
+    if ((c == '\r') || (c == '\n')) {
+        // A CR LF pair from the terminal ends one line, not two
+        if ((c == '\n') && s_lastWasCR) {
+            s_lastWasCR = false;
+            return;
+        }
+        s_lastWasCR = (c == '\r');
+
+        printf("\n");
+        if (s_lineOverflow) {
+            printf("line too long\n");
+        } else {
+            s_line[s_lineLength] = '\0';
+            shellExecute(s_line);
+        }
+        s_lineLength = 0U;
+        s_lineOverflow = false;
+        printf(SHELL_PROMPT);
+        return;
+    }
+    s_lastWasCR = false;
+
+    if ((c == '\b') || (c == 0x7F)) {
+        if (s_lineLength > 0U) {
+            s_lineLength--;
+            printf("\b \b");
+        }
+    } else if ((c >= ' ') && (c <= '~')) {
+        if (s_lineLength < APP_SHELL_LINE_SIZE) {
+            s_line[s_lineLength++] = c;
+            putchar(c);
+        } else {
+            s_lineOverflow = true;
+        }
+    }
+}
+
+/* See app_shell.h for documentation of this function. */
+void AppShell_Init(const app_shell_command_t *commands, uint32_t count)
+{
+    s_appCommands = commands;
+    s_appCommandCount = (commands != NULL) ? count : 0U;
+
+    if (DbgConsole_StartRxRing() != kStatus_Success) {
+        APP_LOG_WARN(APP_LOG_MODULE_APP, "Shell unavailable: console has no receive interrupt\n");
+        return;
+    }
+    printf("Shell ready, type help\n" SHELL_PROMPT);
+}
+
+/* See app_shell.h for documentation of this function. */
+bool AppShell_Poll(void)
+{
+    uint8_t chunk[SHELL_READ_CHUNK];
+    size_t received = DbgConsole_ReadNonBlocking(chunk, sizeof(chunk));
+
+    for (size_t i = 0; i < received; i++) {
+        shellInput((char)chunk[i]);
+    }
+    return received != 0U;
+}
+
+#endif /* APP_SHELL_ENABLE */
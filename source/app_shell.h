@@ -0,0 +1,58 @@
+/*
+ * Console command shell for live inspection and tuning
+ * Input is collected by the LPSCI receive interrupt and handled only in idle time
+ */
+
+#ifndef _APP_SHELL_H_
+#define _APP_SHELL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Build the shell and start it at boot. */
+#ifndef APP_SHELL_ENABLE
+#define APP_SHELL_ENABLE 1
+#endif
+
+/*! @brief Longest command line accepted, excluding the terminator. */
+#ifndef APP_SHELL_LINE_SIZE
+#define APP_SHELL_LINE_SIZE 48U
+#endif
+
+/*! @brief One command: the first word of the line selects it, the rest is passed as args. */
+typedef struct {
+    const char *name;
+    const char *help;                   // One line shown by "help"
+    void (*handler)(const char *args);  // args has leading spaces removed, "" if none
+} app_shell_command_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if APP_SHELL_ENABLE
+/*!
+ * @brief Start console input and register the application's own commands
+ *
+ * help, loglevel, dump and trace are built in.
+ *
+ * @param commands Table that stays valid for the life of the program, may be NULL.
+ * @param count    Entries in commands.
+ */
+void AppShell_Init(const app_shell_command_t *commands, uint32_t count);
+
+/*!
+ * @brief Consume received input and run any complete command line
+ *
+ * Call from the idle loop only; commands print and may take a while.
+ *
+ * @return true if any input was consumed.
+ */
+bool AppShell_Poll(void);
+#endif /* APP_SHELL_ENABLE */
+
+#endif /* _APP_SHELL_H_ */
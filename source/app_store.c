@@ -0,0 +1,475 @@
+/*
+ * Persistent key/value store for the node state
+ * Log-structured records in reserved program flash sectors, rotated for wear leveling
+ * Writes are staged in RAM and reach the flash from AppStore_Poll while the bus is idle
+ */
+
+/* Standard C Included Files */
+#include <string.h>
+
+/* SDK Included Files */
+#include "app_flash.h"
+#include "app_store.h"
+#include "app_log.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define STORE_SECTOR_SIZE       APP_FLASH_SECTOR_SIZE
+#define STORE_WORD_SIZE         APP_FLASH_WORD_SIZE
+#define STORE_ERASED_WORD       0xFFFFFFFFU
+#define STORE_CRC_INIT          0xFFFFU
+
+// Sector layout: one header word, then records until the first erased word, and
+// a trailer word in the last word of the sector.
+// Header word: sequence in the low half, its complement in the high half, so a
+// torn or erased header never parses. The newest valid sequence is the active sector.
+// Record: key | length << 8 | crc16 << 16, then the value padded to whole words.
+// Trailer word: lifetime erase count of the sector, complemented the same way.
+#define STORE_HEADER_SIZE       STORE_WORD_SIZE
+#define STORE_RECORDS_END       (STORE_SECTOR_SIZE - STORE_WORD_SIZE)
+#define STORE_ERASES_MAX        0xFFFFU
+#define STORE_RECORD_SIZE(len)  (STORE_WORD_SIZE + (((len) + STORE_WORD_SIZE - 1U) & ~(STORE_WORD_SIZE - 1U)))
+
+// Flash work is done one command per AppStore_Poll, moving the live records takes several
+typedef enum {
+    STORE_STEP_APPEND = 0,      // Program the next pending record
+    STORE_STEP_ERASE,           // Active sector full: erase the next one
+    STORE_STEP_COPY,            // Copy one live record into it, then program its header
+} store_step_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static bool s_storeReady;
+static uint32_t s_activeSector;
+static uint16_t s_sequence;
+static uint32_t s_writeOffset;                      // Next free byte in the active sector
+static uint32_t s_index[APP_STORE_KEY_COUNT];       // Newest record of each key, 0 if none
+
+// Values written but not yet in flash, newest only: repeated updates coalesce
+static uint8_t s_pendingData[APP_STORE_KEY_COUNT][APP_STORE_VALUE_MAX];
+static uint8_t s_pendingLength[APP_STORE_KEY_COUNT];
+static uint32_t s_pendingKeys;                      // Bit per key
+
+// Sector move in progress
+static store_step_t s_step;
+static uint32_t s_moveKey;                          // Next key to copy
+static uint32_t s_moveOffset;                       // Next free byte in the new sector
+static uint32_t s_moveIndex[APP_STORE_KEY_COUNT];
+
+// Wear and activity counters, see AppStore_GetStats
+static app_store_stats_t s_stats;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static inline uint32_t sectorAddress(uint32_t sector)
+{
+    return APP_STORE_FLASH_BASE + (sector * STORE_SECTOR_SIZE);
+}
+
+static inline uint32_t readWord(uint32_t address)
+{
+    return *(const volatile uint32_t *)address;
+}
+
+/*!
+ * @brief CRC-16/CCITT, bitwise: records are short and written rarely
+ */
+static uint16_t crc16(uint16_t crc, const uint8_t *data, uint32_t length)
+{
+    while (length--) {
+        crc ^= (uint16_t)(*data++ << 8);
+        for (uint32_t bit = 0; bit < 8U; bit++) {
+            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t recordCrc(uint8_t key, const void *data, uint32_t length)
+{
+    uint8_t head[2] = {key, (uint8_t)length};
+
+    return crc16(crc16(STORE_CRC_INIT, head, sizeof(head)), (const uint8_t *)data, length);
+}
+
+static inline uint32_t makeCheckedWord(uint16_t value)
+{
+    return value | ((uint32_t)(uint16_t)~value << 16);
+}
+
+/*!
+ * @brief Decode a header or trailer word, false if it is erased or torn
+ */
+static bool parseCheckedWord(uint32_t word, uint16_t *value)
+{
+    if ((uint16_t)word != (uint16_t)~(word >> 16)) {
+        return false;
+    }
+    *value = (uint16_t)word;
+    return true;
+}
+
+/*!
+ * @brief Run one flash command, counted in the store statistics
+ */
+static status_t flashErase(uint32_t address)
+{
+    s_stats.erases++;
+    return AppFlash_EraseSector(address);
+}
+
+static status_t flashProgram(uint32_t address, uint32_t *words, uint32_t length)
+{
+    s_stats.programs++;
+    s_stats.bytesProgrammed += length;
+    return AppFlash_Program(address, words, length);
+}
+
+/*!
+ * @brief Index the records of the active sector and find its first free byte
+ */
+static void scanSector(uint32_t sector)
+{
+    uint32_t base = sectorAddress(sector);
+    uint32_t offset = STORE_HEADER_SIZE;
+
+    memset(s_index, 0, sizeof(s_index));
+
+    while (offset + STORE_WORD_SIZE <= STORE_RECORDS_END) {
+        uint32_t word = readWord(base + offset);
+        uint8_t key = (uint8_t)word;
+        uint8_t length = (uint8_t)(word >> 8);
+
+        if (word == STORE_ERASED_WORD) {
+            break;
+        }
+
+        // A record cut short by a reset: keep the values before it and seal the
+        // sector, the next write moves the live records to a freshly erased one
+        if ((key >= APP_STORE_KEY_COUNT) || (length > APP_STORE_VALUE_MAX) ||
+            (offset + STORE_RECORD_SIZE(length) > STORE_RECORDS_END) ||
+            ((uint16_t)(word >> 16) != recordCrc(key, (const void *)(base + offset + STORE_WORD_SIZE), length))) {
+            offset = STORE_RECORDS_END;
+            break;
+        }
+
+        s_index[key] = base + offset;
+        offset += STORE_RECORD_SIZE(length);
+    }
+
+    s_activeSector = sector;
+    s_writeOffset = offset;
+}
+
+/*!
+ * @brief Erase a sector and carry its erase count over into the new trailer
+ */
+static status_t eraseSector(uint32_t sector)
+{
+    uint32_t trailerAddress = sectorAddress(sector) + STORE_RECORDS_END;
+    uint32_t trailer;
+    status_t status;
+
+    status = flashErase(sectorAddress(sector));
+    if (status != kStatus_Success) {
+        return status;
+    }
+
+    // Saturates rather than wraps, the part is rated for far fewer cycles
+    if (s_stats.sectorErases[sector] < STORE_ERASES_MAX) {
+        s_stats.sectorErases[sector]++;
+    }
+    trailer = makeCheckedWord((uint16_t)s_stats.sectorErases[sector]);
+    return flashProgram(trailerAddress, &trailer, STORE_WORD_SIZE);
+}
+
+/*!
+ * @brief Erase a sector and write its header, with no records
+ */
+static status_t formatSector(uint32_t sector, uint16_t sequence)
+{
+    uint32_t header = makeCheckedWord(sequence);
+    status_t status;
+
+    status = eraseSector(sector);
+    if (status == kStatus_Success) {
+        status = flashProgram(sectorAddress(sector), &header, STORE_HEADER_SIZE);
+    }
+    return status;
+}
+
+static inline uint32_t nextSector(void)
+{
+    return (s_activeSector + 1U) % APP_STORE_SECTOR_COUNT;
+}
+
+/*!
+ * @brief Flash step: program the record of the lowest pending key
+ */
+static status_t stepAppend(void)
+{
+    uint32_t buffer[STORE_RECORD_SIZE(APP_STORE_VALUE_MAX) / STORE_WORD_SIZE];
+    uint8_t key = 0;
+    uint32_t length;
+    uint32_t size;
+    uint32_t address;
+    status_t status;
+
+    while (!(s_pendingKeys & (1UL << key))) {
+        key++;
+    }
+    length = s_pendingLength[key];
+    size = STORE_RECORD_SIZE(length);
+
+    if (s_writeOffset + size > STORE_RECORDS_END) {
+        s_step = STORE_STEP_ERASE;
+        return kStatus_Success;
+    }
+
+    // Padding stays erased, the CRC only covers the value bytes
+    memset(buffer, 0xFF, sizeof(buffer));
+    buffer[0] = key | (length << 8) | ((uint32_t)recordCrc(key, s_pendingData[key], length) << 16);
+    memcpy(&buffer[1], s_pendingData[key], length);
+
+    address = sectorAddress(s_activeSector) + s_writeOffset;
+    status = flashProgram(address, buffer, size);
+    if (status != kStatus_Success) {
+        // Part of the record may be programmed: seal the sector, the retry moves to the next one
+        s_writeOffset = STORE_RECORDS_END;
+        return status;
+    }
+
+    s_index[key] = address;
+    s_writeOffset += size;
+    s_pendingKeys &= ~(1UL << key);
+    return kStatus_Success;
+}
+
+/*!
+ * @brief Flash step: erase the sector the live records move to
+ */
+static status_t stepErase(void)
+{
+    status_t status = eraseSector(nextSector());
+
+    if (status != kStatus_Success) {
+        s_step = STORE_STEP_APPEND;
+        return status;
+    }
+
+    memset(s_moveIndex, 0, sizeof(s_moveIndex));
+    s_moveKey = 0;
+    s_moveOffset = STORE_HEADER_SIZE;
+    s_step = STORE_STEP_COPY;
+    return kStatus_Success;
+}
+
+/*!
+ * @brief Flash step: copy one live record, or program the header once all are copied
+ *
+ * The header goes last: until it is programmed the old sector stays the newest, so a
+ * reset part way through the move loses nothing.
+ */
+static status_t stepCopy(void)
+{
+    uint32_t buffer[STORE_RECORD_SIZE(APP_STORE_VALUE_MAX) / STORE_WORD_SIZE];
+    uint32_t base = sectorAddress(nextSector());
+    uint16_t sequence = s_sequence + 1U;
+    uint32_t header;
+    uint32_t size;
+    status_t status;
+
+    while ((s_moveKey < APP_STORE_KEY_COUNT) && (s_index[s_moveKey] == 0U)) {
+        s_moveKey++;
+    }
+
+    if (s_moveKey < APP_STORE_KEY_COUNT) {
+        // Copy through RAM, the source sector cannot be read while a command runs
+        size = STORE_RECORD_SIZE((uint8_t)(readWord(s_index[s_moveKey]) >> 8));
+        memcpy(buffer, (const void *)s_index[s_moveKey], size);
+        status = flashProgram(base + s_moveOffset, buffer, size);
+        if (status != kStatus_Success) {
+            s_step = STORE_STEP_APPEND;
+            return status;
+        }
+        s_moveIndex[s_moveKey++] = base + s_moveOffset;
+        s_moveOffset += size;
+        return kStatus_Success;
+    }
+
+    header = makeCheckedWord(sequence);
+    status = flashProgram(base, &header, STORE_HEADER_SIZE);
+    s_step = STORE_STEP_APPEND;
+    if (status != kStatus_Success) {
+        return status;
+    }
+
+    memcpy(s_index, s_moveIndex, sizeof(s_index));
+    s_activeSector = nextSector();
+    s_sequence = sequence;
+    s_writeOffset = s_moveOffset;
+    return kStatus_Success;
+}
+
+/*!
+ * @brief Current value of a key, pending or in flash
+ *
+ * @return Pointer to the value, NULL if the key has none
+ */
+static const uint8_t *currentValue(uint8_t key, uint32_t *length)
+{
+    if (s_pendingKeys & (1UL << key)) {
+        *length = s_pendingLength[key];
+        return s_pendingData[key];
+    }
+    if (s_index[key] != 0U) {
+        *length = (uint8_t)(readWord(s_index[key]) >> 8);
+        return (const uint8_t *)(s_index[key] + STORE_WORD_SIZE);
+    }
+    return NULL;
+}
+
+/* See app_store.h for documentation of this function. */
+status_t AppStore_Init(void)
+{
+    bool found = false;
+    uint32_t newest = 0;
+    uint16_t newestSequence = 0;
+    status_t status;
+
+    // Everything comes from the flash, a second call starts over as after a reset
+    s_storeReady = false;
+    s_pendingKeys = 0;
+    s_step = STORE_STEP_APPEND;
+    memset(&s_stats, 0, sizeof(s_stats));
+
+    status = AppFlash_Init();
+    if (status != kStatus_Success) {
+        return status;
+    }
+
+    for (uint32_t sector = 0; sector < APP_STORE_SECTOR_COUNT; sector++) {
+        uint16_t sequence;
+        uint16_t erases;
+
+        // No trailer: a sector never erased by the store starts its count at 0
+        if (parseCheckedWord(readWord(sectorAddress(sector) + STORE_RECORDS_END), &erases)) {
+            s_stats.sectorErases[sector] = erases;
+        }
+
+        if (!parseCheckedWord(readWord(sectorAddress(sector)), &sequence)) {
+            continue;
+        }
+        // Serial number arithmetic, the sequence wraps after 65536 sector rotations
+        if (!found || ((int16_t)(sequence - newestSequence) > 0)) {
+            found = true;
+            newest = sector;
+            newestSequence = sequence;
+        }
+    }
+
+    if (!found) {
+        // Blank or foreign contents: start an empty log in the first sector
+        status = formatSector(0U, 0U);
+        if (status != kStatus_Success) {
+            return status;
+        }
+    }
+
+    s_sequence = newestSequence;
+    scanSector(newest);
+    s_storeReady = true;
+    return kStatus_Success;
+}
+
+/* See app_store.h for documentation of this function. */
+uint32_t AppStore_Read(uint8_t key, void *data, uint32_t size)
+{
+    const uint8_t *value;
+    uint32_t length;
+
+    if (!s_storeReady || (key >= APP_STORE_KEY_COUNT)) {
+        return 0;
+    }
+
+    value = currentValue(key, &length);
+    if (value == NULL) {
+        return 0;
+    }
+    memcpy(data, value, MIN(length, size));
+    return length;
+}
+
+/* See app_store.h for documentation of this function. */
+status_t AppStore_Write(uint8_t key, const void *data, uint32_t length)
+{
+    const uint8_t *value;
+    uint32_t currentLength;
+
+    if (!s_storeReady || (key >= APP_STORE_KEY_COUNT) || (length > APP_STORE_VALUE_MAX)) {
+        return kStatus_InvalidArgument;
+    }
+
+    // Rewriting the same value would only cost wear
+    value = currentValue(key, &currentLength);
+    if ((value != NULL) && (currentLength == length) && (memcmp(value, data, length) == 0)) {
+        return kStatus_Success;
+    }
+
+    memcpy(s_pendingData[key], data, length);
+    s_pendingLength[key] = (uint8_t)length;
+    s_pendingKeys |= 1UL << key;
+    return kStatus_Success;
+}
+
+/* See app_store.h for documentation of this function. */
+bool AppStore_Poll(bool busIdle)
+{
+    status_t status;
+
+    if (!s_storeReady || !busIdle || ((s_pendingKeys == 0U) && (s_step == STORE_STEP_APPEND))) {
+        return false;
+    }
+
+    switch (s_step) {
+    case STORE_STEP_ERASE:
+        status = stepErase();
+        break;
+    case STORE_STEP_COPY:
+        status = stepCopy();
+        break;
+    default:
+        status = stepAppend();
+        break;
+    }
+
+    if (status != kStatus_Success) {
+        s_stats.failures++;
+        APP_LOG_ERROR(APP_LOG_MODULE_STORE, "ERROR: State store flash step failed: %ld\n", status);
+    }
+    return true;
+}
+
+/* See app_store.h for documentation of this function. */
+status_t AppStore_Flush(void)
+{
+    uint32_t failures = s_stats.failures;
+
+    // Stop at the first failed step, a worn or protected sector would fail forever
+    while (AppStore_Poll(true) && (s_stats.failures == failures)) {
+    }
+    return ((s_pendingKeys == 0U) && (s_step == STORE_STEP_APPEND)) ? kStatus_Success : kStatus_Fail;
+}
+
+/* See app_store.h for documentation of this function. */
+void AppStore_GetStats(app_store_stats_t *stats)
+{
+    *stats = s_stats;
+    stats->activeSector = s_activeSector;
+    stats->freeBytes = STORE_RECORDS_END - s_writeOffset;
+    stats->pendingKeys = s_pendingKeys;
+}
@@ -0,0 +1,113 @@
+/*
+ * Persistent key/value store for the node state
+ * Log-structured records in reserved program flash sectors, rotated for wear leveling
+ * Writes are staged in RAM and reach the flash from AppStore_Poll while the bus is idle
+ */
+
+#ifndef _APP_STORE_H_
+#define _APP_STORE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!
+ * @brief Flash reserved for the store, must match PERSIST_FLASH in the memory map
+ *
+ * The top four 1 KB sectors of the 128 KB program flash. The active sector takes
+ * new records until full, then the live records move to the next sector in turn,
+ * so every sector takes an equal share of the erases.
+ */
+#define APP_STORE_FLASH_BASE    (FSL_FEATURE_FLASH_PFLASH_START_ADDRESS + 0x1F000U)
+#define APP_STORE_SECTOR_COUNT  4U
+
+/*! @brief Keys are small integers, 0 to APP_STORE_KEY_COUNT - 1 */
+#define APP_STORE_KEY_COUNT     8U
+
+/*! @brief Largest value in bytes */
+#define APP_STORE_VALUE_MAX     32U
+
+/*! @brief Flash wear and activity of the store */
+typedef struct {
+    uint32_t sectorErases[APP_STORE_SECTOR_COUNT]; // Lifetime erases per sector, kept in flash
+    uint32_t erases;            // Erase commands since boot
+    uint32_t programs;          // Program commands since boot
+    uint32_t bytesProgrammed;   // Bytes programmed since boot
+    uint32_t failures;          // Flash steps that failed since boot
+    uint32_t activeSector;      // Sector taking new records
+    uint32_t freeBytes;         // Room left in the active sector
+    uint32_t pendingKeys;       // Keys staged but not yet in flash, bit per key
+} app_store_stats_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief Find the newest sector and index its records
+ *
+ * A record cut short by a reset fails its CRC and is ignored, the earlier value of
+ * that key stays current. Scans at most one sector, well under a millisecond.
+ *
+ * @return kStatus_Success, or the flash driver status if the store could not be formatted
+ */
+status_t AppStore_Init(void);
+
+/*!
+ * @brief Copy the current value of a key
+ *
+ * O(1): the RAM index holds the flash address of the newest record of each key.
+ *
+ * @return Length of the stored value (only up to size bytes are copied), 0 if the key has no value
+ */
+uint32_t AppStore_Read(uint8_t key, void *data, uint32_t size);
+
+/*!
+ * @brief Stage a new value for a key, without touching the flash
+ *
+ * Only the newest value of each key is kept, so a key updated many times before the
+ * next idle period costs one record. Nothing is staged if the value is unchanged.
+ * AppStore_Read returns the staged value at once. Thread context only.
+ *
+ * @return kStatus_Success, or kStatus_InvalidArgument
+ */
+status_t AppStore_Write(uint8_t key, const void *data, uint32_t length);
+
+/*!
+ * @brief Run at most one flash command for the staged values
+ *
+ * The flash stalls every fetch while a command runs, and interrupts are held off so
+ * no handler is fetched mid-command: a slave transfer that starts meanwhile is
+ * clock-stretched until it ends. Pass busIdle only when the bus has been quiet long
+ * enough for the longest command (about 65 us per word programmed, about 14 ms for
+ * an erase). Moving to a new sector is split into an erase and one command per live
+ * record, so the bus is checked again between them.
+ *
+ * @param busIdle No bus activity for long enough to run a flash command
+ * @return true if a flash step ran
+ */
+bool AppStore_Poll(bool busIdle);
+
+/*!
+ * @brief Write every staged value now, regardless of bus activity
+ *
+ * For a reset that must not lose the staged values, e.g. switching firmware images.
+ *
+ * @return kStatus_Success once nothing is staged, kStatus_Fail if a flash step failed
+ */
+status_t AppStore_Flush(void);
+
+/*!
+ * @brief Snapshot the wear and activity counters
+ *
+ * The lifetime erase count of each sector lives in its last word and is carried
+ * over on every erase, so wear can be tracked against the rated endurance in the
+ * field. Rotation keeps the counts within one of each other.
+ */
+void AppStore_GetStats(app_store_stats_t *stats);
+
+#endif /* _APP_STORE_H_ */
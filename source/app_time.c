@@ -0,0 +1,52 @@
+/*
+ * Millisecond time base for the application
+ * SysTick interrupt at 1 kHz, idle waits sleep in WFI between events
+ */
+
+/* SDK Included Files */
+#include "board.h"
+#include "app_time.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define APP_TIME_TICK_HZ        1000U
+#define APP_TIME_IRQ_PRIORITY   3U    // Lowest level, below I2C and console (see RTE_Device.h)
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static volatile uint32_t s_uptimeMs = APP_TIME_START_MS;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+void SysTick_Handler(void)
+{
+    s_uptimeMs++;
+}
+
+/* See app_time.h for documentation of this function. */
+void AppTime_Init(void)
+{
+    SysTick_Config(SystemCoreClock / APP_TIME_TICK_HZ);
+    NVIC_SetPriority(SysTick_IRQn, APP_TIME_IRQ_PRIORITY);
+}
+
+/* See app_time.h for documentation of this function. */
+uint32_t AppTime_GetMs(void)
+{
+    // A 32-bit load is atomic on Cortex-M0+, no masking needed
+    return s_uptimeMs;
+}
+
+/* See app_time.h for documentation of this function. */
+void AppTime_DelayMs(uint32_t ms)
+{
+    uint32_t start = AppTime_GetMs();
+
+    while (!AppTime_Elapsed(start, ms)) {
+        __WFI();
+    }
+}
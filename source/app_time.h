@@ -0,0 +1,53 @@
+/*
+ * Millisecond time base for the application
+ * SysTick interrupt at 1 kHz, idle waits sleep in WFI between events
+ */
+
+#ifndef _APP_TIME_H_
+#define _APP_TIME_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!
+ * @brief Uptime the clock starts from at boot, in milliseconds
+ *
+ * Soak builds set this close to UINT32_MAX (e.g. -DAPP_TIME_START_MS=0xFFFF0000)
+ * so the 49.7-day wraparound happens within about a minute of power-up.
+ */
+#ifndef APP_TIME_START_MS
+#define APP_TIME_START_MS 0U
+#endif
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief Start the 1 ms SysTick interrupt at the lowest priority
+ */
+void AppTime_Init(void);
+
+/*!
+ * @brief Milliseconds since boot (plus APP_TIME_START_MS), wraps at 2^32
+ */
+uint32_t AppTime_GetMs(void);
+
+/*!
+ * @brief True once at least duration_ms has passed since start_ms, across wraparound
+ */
+static inline bool AppTime_Elapsed(uint32_t start_ms, uint32_t duration_ms)
+{
+    return (uint32_t)(AppTime_GetMs() - start_ms) >= duration_ms;
+}
+
+/*!
+ * @brief Sleep for at least ms milliseconds, waking on each tick
+ */
+void AppTime_DelayMs(uint32_t ms);
+
+#endif /* _APP_TIME_H_ */
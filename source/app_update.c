@@ -0,0 +1,357 @@
+/*
+ * Firmware update streamed over the I2C slave link
+ * Chunks are programmed into the update slot while the next one is received
+ */
+
+/* Standard C Included Files */
+#include <string.h>
+
+/* SDK Included Files */
+#include "board.h"
+#include "fsl_debug_console.h"
+#include "app_flash.h"
+#include "app_update.h"
+#include "app_store.h"
+#include "app_log.h"
+
+#if APP_UPDATE_ENABLE
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define UPDATE_SECTOR_SIZE      APP_FLASH_SECTOR_SIZE
+#define UPDATE_WORD_SIZE        APP_FLASH_WORD_SIZE
+#define UPDATE_CHUNK_BUFFERS    2U
+
+// Where a handed-over image may put its initial stack pointer
+#define UPDATE_SRAM_BASE        0x1FFFF000U
+#define UPDATE_SRAM_TOP         0x20003000U
+
+typedef enum {
+    UPDATE_STATE_IDLE = 0,      // No image being received
+    UPDATE_STATE_RECEIVING,     // Between BEGIN and COMMIT
+    UPDATE_STATE_FAILED,        // Error seen, data ignored until the next BEGIN
+} update_state_t;
+
+// Activated image, kept under APP_UPDATE_STORE_KEY; no record (or an empty one) boots the primary
+typedef struct {
+    uint32_t size;
+    uint32_t crc;
+} update_image_t;
+
+typedef struct {
+    uint32_t offset;
+    uint32_t length;
+    uint32_t data[APP_UPDATE_CHUNK_MAX / 4U];   // Word aligned for FLASH_Program
+} update_chunk_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static update_state_t s_state;
+static uint32_t s_imageSize;
+static uint32_t s_imageCrc;
+static uint32_t s_receivedBytes;            // Next offset expected from the master
+static uint32_t s_erasedBytes;              // Slot bytes erased so far, from the slot start
+
+// Received chunks waiting for AppUpdate_Poll to program them, oldest at s_chunkHead
+static update_chunk_t s_chunks[UPDATE_CHUNK_BUFFERS];
+static uint32_t s_chunkHead;
+static uint32_t s_chunkCount;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static inline uint32_t readLe32(const uint8_t *data)
+{
+    return data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+/*!
+ * @brief True when this code runs from the update slot rather than the primary image
+ */
+static inline bool runningFromUpdateSlot(void)
+{
+    return (uint32_t)&AppUpdate_BootSelect >= APP_UPDATE_SLOT_BASE;
+}
+
+/*!
+ * @brief CRC-32 (IEEE 802.3), bitwise: runs once per update over at most one slot
+ */
+static uint32_t crc32(const uint8_t *data, uint32_t length)
+{
+    uint32_t crc = 0xFFFFFFFFU;
+
+    while (length--) {
+        crc ^= *data++;
+        for (uint32_t bit = 0; bit < 8U; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
+
+static void failUpdate(const char *reason)
+{
+    s_state = UPDATE_STATE_FAILED;
+    s_chunkCount = 0;
+    APP_LOG_ERROR(APP_LOG_MODULE_UPDATE, "ERROR: Update failed: %s\n", reason);
+}
+
+/*!
+ * @brief One flash command for the oldest waiting chunk: erase a sector it reaches, else program it
+ */
+static void programStep(void)
+{
+    update_chunk_t *chunk = &s_chunks[s_chunkHead];
+    status_t status;
+
+    // Chunks arrive in order, so erasing ahead of the write offset never erases written data
+    if (s_erasedBytes < chunk->offset + chunk->length) {
+        status = AppFlash_EraseSector(APP_UPDATE_SLOT_BASE + s_erasedBytes);
+        s_erasedBytes += UPDATE_SECTOR_SIZE;
+    } else {
+        status = AppFlash_Program(APP_UPDATE_SLOT_BASE + chunk->offset, chunk->data, chunk->length);
+        s_chunkHead = (s_chunkHead + 1U) % UPDATE_CHUNK_BUFFERS;
+        s_chunkCount--;
+    }
+
+    if (status != kStatus_Success) {
+        failUpdate("flash program");
+    }
+}
+
+/*!
+ * @brief Program the oldest waiting chunk to the end
+ */
+static void programChunk(void)
+{
+    uint32_t count = s_chunkCount;
+
+    while ((s_state == UPDATE_STATE_RECEIVING) && (s_chunkCount == count)) {
+        programStep();
+    }
+}
+
+#if defined(__arm__)
+/*!
+ * @brief Run the image whose vector table is at vectors, never returns
+ *
+ * In assembly so nothing uses the old stack once MSP moves, and interrupts stay
+ * masked from before VTOR changes until the image's reset handler, which masks
+ * them itself first and unmasks them once its own vectors are set up.
+ */
+__attribute__((naked)) static void startImage(uint32_t vectors)
+{
+    __asm volatile(".syntax unified\n"
+                   "CPSID  i                \n"
+                   "LDR    R1, =0xE000ED08  \n" // SCB->VTOR
+                   "STR    R0, [R1]         \n"
+                   "LDR    R1, [R0, #0]     \n"
+                   "MSR    MSP, R1          \n"
+                   "LDR    R1, [R0, #4]     \n"
+                   "DSB                     \n"
+                   "ISB                     \n"
+                   "BX     R1               \n"
+                   ".ltorg                  \n");
+}
+#else
+// Host builds of the update logic (test/host) supply the hand-over
+void AppUpdate_HostStartImage(uint32_t vectors);
+#define startImage AppUpdate_HostStartImage
+#endif
+
+/*!
+ * @brief Drop the activated image record before its slot is touched
+ *
+ * Flushed at once: a reset part way through the update must boot the primary,
+ * never a half-written slot.
+ */
+static bool deactivateImage(void)
+{
+    if ((AppStore_Write(APP_UPDATE_STORE_KEY, NULL, 0) != kStatus_Success) || (AppStore_Flush() != kStatus_Success)) {
+        failUpdate("state store");
+        return false;
+    }
+    return true;
+}
+
+static void handleBegin(const uint8_t *frame, uint32_t length)
+{
+    uint32_t size;
+
+    if (length < APP_UPDATE_HEADER_SIZE + 8U) {
+        failUpdate("short BEGIN");
+        return;
+    }
+
+    if (runningFromUpdateSlot()) {
+        // The update slot cannot rewrite itself: boot the primary, the master retries BEGIN
+        APP_LOG_WARN(APP_LOG_MODULE_UPDATE, "Update requested, restarting into the primary image\n");
+        if (deactivateImage()) {
+            DbgConsole_Flush();
+            NVIC_SystemReset();
+        }
+        return;
+    }
+
+    size = readLe32(&frame[APP_UPDATE_HEADER_SIZE]);
+    if ((size == 0U) || (size > APP_UPDATE_SLOT_SIZE) || (size % UPDATE_WORD_SIZE)) {
+        failUpdate("bad image size");
+        return;
+    }
+
+    if (AppFlash_Init() != kStatus_Success) {
+        failUpdate("flash init");
+        return;
+    }
+    if (!deactivateImage()) {
+        return;
+    }
+
+    s_state = UPDATE_STATE_RECEIVING;
+    s_imageSize = size;
+    s_imageCrc = readLe32(&frame[APP_UPDATE_HEADER_SIZE + 4U]);
+    s_receivedBytes = 0;
+    s_erasedBytes = 0;
+    s_chunkHead = 0;
+    s_chunkCount = 0;
+    APP_LOG_INFO(APP_LOG_MODULE_UPDATE, "Update started: %lu bytes\n", size);
+}
+
+static void handleData(const uint8_t *frame, uint32_t length)
+{
+    update_chunk_t *chunk;
+    uint32_t offset;
+    uint32_t dataLength;
+
+    if (s_state != UPDATE_STATE_RECEIVING) {
+        return;
+    }
+    if (length < APP_UPDATE_HEADER_SIZE + 4U) {
+        failUpdate("short DATA");
+        return;
+    }
+
+    offset = readLe32(&frame[APP_UPDATE_HEADER_SIZE]);
+    dataLength = length - (APP_UPDATE_HEADER_SIZE + 4U);
+
+    // A chunk the master resent after a NAK was already taken
+    if (offset < s_receivedBytes) {
+        return;
+    }
+    if ((offset != s_receivedBytes) || (dataLength == 0U) || (dataLength % UPDATE_WORD_SIZE) ||
+        (offset + dataLength > s_imageSize)) {
+        failUpdate("out of sequence DATA");
+        return;
+    }
+
+    // Both buffers still waiting: the master is ahead of the flash, catch up before taking more
+    if (s_chunkCount == UPDATE_CHUNK_BUFFERS) {
+        programChunk();
+        if (s_state != UPDATE_STATE_RECEIVING) {
+            return;
+        }
+    }
+
+    chunk = &s_chunks[(s_chunkHead + s_chunkCount) % UPDATE_CHUNK_BUFFERS];
+    chunk->offset = offset;
+    chunk->length = dataLength;
+    memcpy(chunk->data, &frame[APP_UPDATE_HEADER_SIZE + 4U], dataLength);
+    s_chunkCount++;
+    s_receivedBytes += dataLength;
+}
+
+static void handleCommit(void)
+{
+    update_image_t image;
+
+    if ((s_state != UPDATE_STATE_RECEIVING) || (s_receivedBytes != s_imageSize)) {
+        failUpdate("COMMIT before the whole image");
+        return;
+    }
+
+    while ((s_state == UPDATE_STATE_RECEIVING) && (s_chunkCount > 0U)) {
+        programStep();
+    }
+    if (s_state != UPDATE_STATE_RECEIVING) {
+        return;
+    }
+
+    // Check what the flash holds, not what was received
+    if (crc32((const uint8_t *)APP_UPDATE_SLOT_BASE, s_imageSize) != s_imageCrc) {
+        failUpdate("CRC mismatch");
+        return;
+    }
+
+    // The single record that switches images, written only now
+    image.size = s_imageSize;
+    image.crc = s_imageCrc;
+    if ((AppStore_Write(APP_UPDATE_STORE_KEY, &image, sizeof(image)) != kStatus_Success) ||
+        (AppStore_Flush() != kStatus_Success)) {
+        failUpdate("state store");
+        return;
+    }
+
+    APP_LOG_INFO(APP_LOG_MODULE_UPDATE, "Update verified, restarting into the new image\n");
+    DbgConsole_Flush();
+    NVIC_SystemReset();
+}
+
+/* See app_update.h for documentation of this function. */
+void AppUpdate_BootSelect(void)
+{
+    update_image_t image;
+    const uint32_t *vectors = (const uint32_t *)APP_UPDATE_SLOT_BASE;
+    uint32_t stack;
+    uint32_t entry;
+
+    if (runningFromUpdateSlot() || (AppStore_Read(APP_UPDATE_STORE_KEY, &image, sizeof(image)) != sizeof(image))) {
+        return;
+    }
+
+    // The CRC was checked before activation; only refuse an image that cannot start
+    stack = vectors[0];
+    entry = vectors[1];
+    if ((stack <= UPDATE_SRAM_BASE) || (stack > UPDATE_SRAM_TOP) || !(entry & 1U) ||
+        (entry < APP_UPDATE_SLOT_BASE) || (entry >= APP_UPDATE_SLOT_BASE + image.size)) {
+        return;
+    }
+
+    startImage(APP_UPDATE_SLOT_BASE);
+}
+
+/* See app_update.h for documentation of this function. */
+void AppUpdate_HandleFrame(const uint8_t *frame, uint32_t length)
+{
+    switch (frame[2]) {
+    case APP_UPDATE_CMD_BEGIN:
+        handleBegin(frame, length);
+        break;
+    case APP_UPDATE_CMD_DATA:
+        handleData(frame, length);
+        break;
+    case APP_UPDATE_CMD_COMMIT:
+        handleCommit();
+        break;
+    default:
+        s_state = UPDATE_STATE_IDLE;
+        s_chunkCount = 0;
+        APP_LOG_INFO(APP_LOG_MODULE_UPDATE, "Update aborted\n");
+        break;
+    }
+}
+
+/* See app_update.h for documentation of this function. */
+bool AppUpdate_Poll(void)
+{
+    if ((s_state != UPDATE_STATE_RECEIVING) || (s_chunkCount == 0U)) {
+        return false;
+    }
+
+    programStep();
+    return true;
+}
+
+#endif /* APP_UPDATE_ENABLE */
@@ -0,0 +1,114 @@
+/*
+ * Firmware update streamed over the I2C slave link
+ * Chunks are programmed into the update slot while the next one is received
+ */
+
+#ifndef _APP_UPDATE_H_
+#define _APP_UPDATE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Accept firmware updates over I2C (-DAPP_UPDATE_ENABLE=1). */
+#ifndef APP_UPDATE_ENABLE
+#define APP_UPDATE_ENABLE 0
+#endif
+
+/*!
+ * @brief Flash slots, must match PROGRAM_FLASH and UPDATE_FLASH in the memory map
+ *
+ * The 128 KB part holds two 62 KB images and the 4 KB state store, so an image is
+ * at most 62 KB. The primary image at 0 always boots first and hands over to an
+ * activated image in the update slot, which must be linked at APP_UPDATE_SLOT_BASE:
+ * "make update-image" in Debug/ links the build for the slot (makefile.targets).
+ * Updates are always written to the update slot, the primary is never overwritten.
+ */
+#define APP_UPDATE_SLOT_BASE    (FSL_FEATURE_FLASH_PFLASH_START_ADDRESS + 0xF800U)
+#define APP_UPDATE_SLOT_SIZE    0xF800U
+
+/*! @brief Largest image bytes in one data frame, a multiple of the 4-byte program unit */
+#define APP_UPDATE_CHUNK_MAX    128U
+
+/*! @brief Magic and command bytes that open every update frame */
+#define APP_UPDATE_HEADER_SIZE  3U
+
+/*! @brief Largest update frame: header, 32-bit offset, chunk */
+#define APP_UPDATE_FRAME_MAX    (APP_UPDATE_HEADER_SIZE + 4U + APP_UPDATE_CHUNK_MAX)
+
+/*! @brief State store key of the activated image record (app_store.h) */
+#define APP_UPDATE_STORE_KEY    7U
+
+/*!
+ * @brief Update frames: magic, command, fields; multi-byte fields are little endian
+ *
+ * An I2C write is an update frame only if it opens with both magic bytes and a known
+ * command, so an LED frame, even one with invalid LED states, never starts or aborts
+ * an update: its first byte would have to be 0x5A, its second 0xA5 and its third one
+ * of the four commands.
+ *   BEGIN   5A A5 B0 size[4] crc32[4]   Start an image of size bytes (multiple of 4)
+ *   DATA    5A A5 B1 offset[4] data[n]  Image bytes at offset, in order; a repeat is ignored
+ *   COMMIT  5A A5 B2                    Check the CRC-32 of the slot, activate it and reset
+ *   ABORT   5A A5 B3                    Drop the image being received
+ */
+#define APP_UPDATE_MAGIC0       0x5AU
+#define APP_UPDATE_MAGIC1       0xA5U
+
+#define APP_UPDATE_CMD_BEGIN    0xB0U
+#define APP_UPDATE_CMD_DATA     0xB1U
+#define APP_UPDATE_CMD_COMMIT   0xB2U
+#define APP_UPDATE_CMD_ABORT    0xB3U
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if APP_UPDATE_ENABLE
+/*!
+ * @brief Hand over to the activated image in the update slot, if there is one
+ *
+ * Call right after AppStore_Init, before any peripheral is set up: the image starts
+ * from the same state as after reset. The switch is one state store record, written
+ * only once the whole slot has passed its CRC check, so a reset at any point during
+ * an update boots either the old image or the new one. The image's reset handler
+ * is entered with interrupts masked, on its own stack and vectors. Returns when the
+ * primary image should run, and always when already running from the update slot.
+ */
+void AppUpdate_BootSelect(void);
+
+/*!
+ * @brief True if a received I2C frame belongs to the update protocol
+ */
+static inline bool AppUpdate_IsUpdateFrame(const uint8_t *frame, uint32_t length)
+{
+    return (length >= APP_UPDATE_HEADER_SIZE) && (frame[0] == APP_UPDATE_MAGIC0) && (frame[1] == APP_UPDATE_MAGIC1) &&
+           (frame[2] >= APP_UPDATE_CMD_BEGIN) && (frame[2] <= APP_UPDATE_CMD_ABORT);
+}
+
+/*!
+ * @brief Handle one update frame, then return so the slave can be re-armed at once
+ *
+ * A data chunk is copied into one of two chunk buffers and programmed by
+ * AppUpdate_Poll. Only when both still hold chunks is the oldest one programmed
+ * first. COMMIT does not return on success.
+ */
+void AppUpdate_HandleFrame(const uint8_t *frame, uint32_t length);
+
+/*!
+ * @brief Run one flash command for the oldest received chunk: erase a sector it reaches, or program it
+ *
+ * Interrupts are held off for the command, so a transfer that starts meanwhile is
+ * clock-stretched by the slave until it ends. Between commands the main loop
+ * re-arms the slave, and the next chunk lands in the other buffer while this one
+ * is still being written.
+ *
+ * @return true if a flash command ran
+ */
+bool AppUpdate_Poll(void);
+#endif /* APP_UPDATE_ENABLE */
+
+#endif /* _APP_UPDATE_H_ */
@@ -0,0 +1,385 @@
+/*
+ * On-target microbenchmarks for the firmware hot paths
+ * Timed with SysTick at core clock, results emitted as CSV on the console
+ */
+
+/* Standard C Included Files */
+#include <string.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+/* SDK Included Files */
+#include "board.h"
+#include "fsl_debug_console.h"
+#include "fsl_i2c.h"
+#include "fsl_lpsci.h"
+#include "fsl_uart.h"
+#include "fsl_dma_memory.h"
+#include "benchmark.h"
+
+#if APP_BENCHMARK_ENABLE
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BENCH_RING_SIZE     64U
+#define BENCH_READ_SIZE     32U
+#define BENCH_BLOCK_SIZE    512U
+
+typedef struct {
+    const char *name;           // Name printed in the CSV record
+    void (*prepare)(void);      // Untimed, runs before every iteration (may be NULL)
+    void (*run)(void);          // Timed body
+    uint32_t iterations;
+} benchmark_case_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/* Application functions under test, defined in cmsis_i2c_interrupt_transfer.c */
+void displayIPAddress(const char* ip_str);
+void parseAndDisplayData(uint8_t *buffer, uint32_t length);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t s_ringBuffer[BENCH_RING_SIZE];
+static uint8_t s_readBuffer[BENCH_READ_SIZE];
+static uart_handle_t s_uartHandle;
+static lpsci_handle_t s_lpsciHandle;
+static volatile uint8_t s_checksum;
+static uint32_t s_blockSrc[BENCH_BLOCK_SIZE / 4U];
+static uint32_t s_blockDst[BENCH_BLOCK_SIZE / 4U];
+static volatile bool s_blockDone;
+
+// A full-size frame as sent by the master: LED states + 16-byte IP field
+static const uint8_t s_sampleFrame[18] = {
+    1, 0, '1', '9', '2', '.', '1', '6', '8', '.', '1', '0', '0', '.', '2', '5', '4', 0
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void bench_empty(void)
+{
+}
+
+static void bench_i2c_master_set_baud_rate(void)
+{
+    I2C_MasterSetBaudRate(I2C0, 100000U, CLOCK_GetFreq(I2C0_CLK_SRC));
+}
+
+static void wait_console_idle(void)
+{
+    // Start each print with an empty ring, so the timing is the queueing cost only,
+    // and do not truncate a character that is still shifting out
+#if !SDK_DEBUGCONSOLE
+    DbgConsole_Flush();
+#endif
+    while (!(UART0->S1 & UART0_S1_TC_MASK)) {
+    }
+}
+
+static void bench_lpsci_set_baud_rate(void)
+{
+    LPSCI_SetBaudRate(UART0, BOARD_DEBUG_UART_BAUDRATE, BOARD_DEBUG_UART_CLK_FREQ);
+}
+
+#if SDK_DEBUGCONSOLE
+// The SDK formatter into the console; test/bench_hotpaths.c times the formatter alone on the host
+#define BENCH_PRINTF            DbgConsole_Printf
+#define BENCH_PRINTF_NAME(name) "dbgconsole_printf_" name
+#else
+// SDK_DEBUGCONSOLE=0 leaves the SDK formatter out of the image: time the toolchain printf
+// the application prints with, into the console ring
+#define BENCH_PRINTF            printf
+#define BENCH_PRINTF_NAME(name) "toolchain_printf_" name
+#endif
+
+static void bench_printf_packet_header(void)
+{
+    BENCH_PRINTF("\n=== Packet #%lu ===\n", (unsigned long)123456UL);
+}
+
+static void bench_printf_raw_byte(void)
+{
+    BENCH_PRINTF("%02X('%c') ", 0x41U, 'A');
+}
+
+static void bench_printf_led_state(void)
+{
+    BENCH_PRINTF("  LED1: %s %s\n", "ON ", "[*]");
+}
+
+static void bench_display_ip_address(void)
+{
+    displayIPAddress("192.168.100.254");
+}
+
+static void bench_parse_and_display_data(void)
+{
+    uint8_t frame[sizeof(s_sampleFrame)];
+
+    memcpy(frame, s_sampleFrame, sizeof(frame));
+    parseAndDisplayData(frame, sizeof(frame));
+}
+
+static void prepare_uart_ring_read(void)
+{
+    // Ring holds more than one read worth of data and the tail sits near the end, so each read wraps
+    s_uartHandle.rxRingBufferTail = BENCH_RING_SIZE - (BENCH_READ_SIZE / 2U);
+    s_uartHandle.rxRingBufferHead = BENCH_READ_SIZE;
+}
+
+static void bench_uart_ring_read(void)
+{
+    uart_transfer_t xfer = {s_readBuffer, BENCH_READ_SIZE};
+    size_t received;
+
+    UART_TransferReceiveNonBlocking(UART1, &s_uartHandle, &xfer, &received);
+}
+
+/*!
+ * @brief Fold the bytes of one ring span into the checksum, standing in for an in-place parser
+ */
+static uint8_t checksumSpan(const uint8_t *data, size_t length, uint8_t sum)
+{
+    while (length--) {
+        sum ^= *data++;
+    }
+    return sum;
+}
+
+static void bench_uart_ring_peek(void)
+{
+    uart_transfer_t spans[2];
+    size_t length = UART_TransferPeekRxRingBuffer(UART1, &s_uartHandle, spans);
+    uint8_t sum;
+
+    // Consume the same 32 bytes a ring read copies out, wrapping into the second span
+    length = MIN(length, BENCH_READ_SIZE);
+    sum = checksumSpan(spans[0].data, MIN(length, spans[0].dataSize), 0U);
+    if (length > spans[0].dataSize) {
+        sum = checksumSpan(spans[1].data, length - spans[0].dataSize, sum);
+    }
+    s_checksum = sum;
+    UART_TransferCommitRxRingBuffer(UART1, &s_uartHandle, length);
+}
+
+static void prepare_uart_ring_write(void)
+{
+    // Loop one byte back through UART1 so the RX handler has real data to store
+    while (!(UART1->S1 & UART_S1_TDRE_MASK)) {
+    }
+    UART1->D = 0x5AU;
+    while (!(UART1->S1 & UART_S1_RDRF_MASK)) {
+    }
+}
+
+static void bench_uart_ring_write(void)
+{
+    UART_TransferHandleIRQ(UART1, &s_uartHandle);
+}
+
+static void prepare_lpsci_ring_read(void)
+{
+    s_lpsciHandle.rxRingBufferTail = BENCH_RING_SIZE - (BENCH_READ_SIZE / 2U);
+    s_lpsciHandle.rxRingBufferHead = BENCH_READ_SIZE;
+}
+
+static void bench_lpsci_ring_read(void)
+{
+    lpsci_transfer_t xfer = {s_readBuffer, BENCH_READ_SIZE};
+    size_t received;
+
+    LPSCI_TransferReceiveNonBlocking(UART0, &s_lpsciHandle, &xfer, &received);
+}
+
+static void bench_lpsci_ring_peek(void)
+{
+    lpsci_transfer_t spans[2];
+    size_t length = LPSCI_TransferPeekRxRingBuffer(UART0, &s_lpsciHandle, spans);
+    uint8_t sum;
+
+    length = MIN(length, BENCH_READ_SIZE);
+    sum = checksumSpan(spans[0].data, MIN(length, spans[0].dataSize), 0U);
+    if (length > spans[0].dataSize) {
+        sum = checksumSpan(spans[1].data, length - spans[0].dataSize, sum);
+    }
+    s_checksum = sum;
+    LPSCI_TransferCommitRxRingBuffer(UART0, &s_lpsciHandle, length);
+}
+
+static void bench_memcpy_block(void)
+{
+    memcpy(s_blockDst, s_blockSrc, BENCH_BLOCK_SIZE);
+}
+
+static void blockDoneCallback(void *userData)
+{
+    s_blockDone = true;
+}
+
+static void bench_dmamem_copy_block(void)
+{
+    // Includes the wait for the completion interrupt, the end-to-end cost a caller sees
+    s_blockDone = false;
+    DMAMEM_Copy(s_blockDst, s_blockSrc, BENCH_BLOCK_SIZE, blockDoneCallback, NULL);
+    while (!s_blockDone) {
+    }
+}
+
+static void bench_dmamem_copy_start(void)
+{
+    // Only the CPU time to hand the copy over; the transfer finishes in prepare_dmamem_idle
+    DMAMEM_Copy(s_blockDst, s_blockSrc, BENCH_BLOCK_SIZE, blockDoneCallback, NULL);
+}
+
+static void prepare_dmamem_idle(void)
+{
+    while (!s_blockDone) {
+    }
+    s_blockDone = false;
+}
+
+static const benchmark_case_t s_benchmarkCases[] = {
+    {"i2c_master_set_baud_rate", NULL, bench_i2c_master_set_baud_rate, 64U},
+    {"lpsci_set_baud_rate", wait_console_idle, bench_lpsci_set_baud_rate, 64U},
+    {"uart_ring_read_32", prepare_uart_ring_read, bench_uart_ring_read, 64U},
+    {"uart_ring_peek_32", prepare_uart_ring_read, bench_uart_ring_peek, 64U},
+    {"uart_ring_write_1", prepare_uart_ring_write, bench_uart_ring_write, 64U},
+    {"lpsci_ring_read_32", prepare_lpsci_ring_read, bench_lpsci_ring_read, 64U},
+    {"lpsci_ring_peek_32", prepare_lpsci_ring_read, bench_lpsci_ring_peek, 64U},
+    {"memcpy_512", NULL, bench_memcpy_block, 16U},
+    {"dmamem_copy_512", NULL, bench_dmamem_copy_block, 16U},
+    {"dmamem_copy_start_512", prepare_dmamem_idle, bench_dmamem_copy_start, 16U},
+    {BENCH_PRINTF_NAME("packet_header"), wait_console_idle, bench_printf_packet_header, 8U},
+    {BENCH_PRINTF_NAME("raw_byte"), wait_console_idle, bench_printf_raw_byte, 8U},
+    {BENCH_PRINTF_NAME("led_state"), wait_console_idle, bench_printf_led_state, 8U},
+    {"display_ip_address", wait_console_idle, bench_display_ip_address, 4U},
+    {"parse_and_display_data", wait_console_idle, bench_parse_and_display_data, 4U},
+};
+
+/*!
+ * @brief Cycles between two SysTick samples (SysTick counts down and wraps at 24 bits)
+ */
+static inline uint32_t cyclesBetween(uint32_t start, uint32_t end)
+{
+    return (start - end) & SysTick_LOAD_RELOAD_Msk;
+}
+
+/*!
+ * @brief Time one call of the given function
+ */
+static uint32_t measureOnce(void (*run)(void))
+{
+    uint32_t start = SysTick->VAL;
+    run();
+    return cyclesBetween(start, SysTick->VAL);
+}
+
+/*!
+ * @brief Bring up the peripherals the cases poke at, without touching the live I2C1 slave
+ */
+static void setupBenchmarkPeripherals(void)
+{
+    uart_config_t uartConfig;
+
+    CLOCK_EnableClock(kCLOCK_I2c0);
+
+    // UART1 is unused on this board: run it in loopback to feed the RX handler
+    UART_GetDefaultConfig(&uartConfig);
+    uartConfig.baudRate_Bps = 115200U;
+    uartConfig.enableTx = true;
+    uartConfig.enableRx = true;
+    UART_Init(UART1, &uartConfig, CLOCK_GetFreq(UART1_CLK_SRC));
+    UART1->C1 |= UART_C1_LOOPS_MASK;
+
+    // Handles are driven directly, never registered with the IRQ dispatcher
+    memset(&s_uartHandle, 0, sizeof(s_uartHandle));
+    s_uartHandle.rxRingBuffer = s_ringBuffer;
+    s_uartHandle.rxRingBufferSize = BENCH_RING_SIZE;
+    UART1->C2 |= UART_C2_RIE_MASK;
+
+    memset(&s_lpsciHandle, 0, sizeof(s_lpsciHandle));
+    s_lpsciHandle.rxRingBuffer = s_ringBuffer;
+    s_lpsciHandle.rxRingBufferSize = BENCH_RING_SIZE;
+
+    // The first DMA start case waits for a completion that never ran
+    s_blockDone = true;
+}
+
+static void teardownBenchmarkPeripherals(void)
+{
+    UART_Deinit(UART1);
+
+    // The LPSCI read path re-enables the RX interrupt source on the console
+    UART0->C2 &= ~UART0_C2_RIE_MASK;
+}
+
+/* See benchmark.h for documentation of this function. */
+void Benchmark_Run(void)
+{
+    uint32_t savedCtrl = SysTick->CTRL;
+    uint32_t savedLoad = SysTick->LOAD;
+    uint32_t overhead = UINT32_MAX;
+    uint32_t i;
+    uint32_t n;
+
+    setupBenchmarkPeripherals();
+
+    SysTick->CTRL = 0U;
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0U;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    // Calibrate the cost of the timing itself
+    for (i = 0; i < 16U; i++) {
+        uint32_t cycles = measureOnce(bench_empty);
+        if (cycles < overhead) {
+            overhead = cycles;
+        }
+    }
+
+    PRINTF("\nBENCH_CLOCK,%lu\n", (unsigned long)SystemCoreClock);
+    PRINTF("BENCH,name,iterations,min_cycles,avg_cycles,max_cycles\n");
+
+    for (n = 0; n < ARRAY_SIZE(s_benchmarkCases); n++) {
+        const benchmark_case_t *bench = &s_benchmarkCases[n];
+        uint32_t minCycles = UINT32_MAX;
+        uint32_t maxCycles = 0U;
+        uint32_t totalCycles = 0U;
+
+        for (i = 0; i < bench->iterations; i++) {
+            uint32_t cycles;
+
+            if (bench->prepare) {
+                bench->prepare();
+            }
+            cycles = measureOnce(bench->run);
+            cycles = (cycles > overhead) ? (cycles - overhead) : 0U;
+
+            totalCycles += cycles;
+            if (cycles < minCycles) {
+                minCycles = cycles;
+            }
+            if (cycles > maxCycles) {
+                maxCycles = cycles;
+            }
+        }
+
+        PRINTF("BENCH,%s,%lu,%lu,%lu,%lu\n", bench->name, (unsigned long)bench->iterations,
+               (unsigned long)minCycles, (unsigned long)(totalCycles / bench->iterations),
+               (unsigned long)maxCycles);
+    }
+
+    SysTick->CTRL = 0U;
+    SysTick->LOAD = savedLoad;
+    SysTick->VAL = 0U;
+    SysTick->CTRL = savedCtrl;
+
+    teardownBenchmarkPeripherals();
+}
+
+#endif /* APP_BENCHMARK_ENABLE */
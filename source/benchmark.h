@@ -0,0 +1,43 @@
+/*
+ * On-target microbenchmarks for the firmware hot paths
+ * Timed with SysTick at core clock, results emitted as CSV on the console
+ */
+
+#ifndef _BENCHMARK_H_
+#define _BENCHMARK_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Build the benchmark suite and run it once at boot (-DAPP_BENCHMARK_ENABLE=1). */
+#ifndef APP_BENCHMARK_ENABLE
+#define APP_BENCHMARK_ENABLE 0
+#endif
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if APP_BENCHMARK_ENABLE
+/*!
+ * @brief Run every benchmark case and print one CSV record per case
+ *
+ * Output format, one line each:
+ *   BENCH_CLOCK,<core clock in Hz>
+ *   BENCH,<name>,<iterations>,<min cycles>,<avg cycles>,<max cycles>
+ *
+ * The printf cases are named after the formatter they time: dbgconsole_printf_*
+ * with SDK_DEBUGCONSOLE, toolchain_printf_* without. test/bench_hotpaths.c runs
+ * the same cases on the host, timing the SDK formatter in either build.
+ *
+ * Cycle counts have the measurement overhead removed. SysTick is borrowed as a
+ * free-running 24-bit counter for the duration of the run and restored afterwards.
+ * The application millisecond tick (app_time.h) pauses while it runs.
+ */
+void Benchmark_Run(void);
+#endif /* APP_BENCHMARK_ENABLE */
+
+#endif /* _BENCHMARK_H_ */
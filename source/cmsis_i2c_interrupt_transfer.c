@@ -17,6 +17,17 @@
 #include "fsl_i2c_cmsis.h"
 #include "pin_mux.h"
 #include "clock_config.h"
+#include "benchmark.h"
+#include "app_time.h"
+#include "i2c_async.h"
+#include "app_log.h"
+#include "app_shell.h"
+#include "app_store.h"
+#include "app_update.h"
+#if defined(APP_SPI_LINK_ENABLE) && APP_SPI_LINK_ENABLE
+#include "Driver_SPI.h"
+#include "fsl_spi_cmsis.h"
+#endif
 
 /*******************************************************************************
  * Definitions
@@ -24,25 +35,79 @@
 #define I2C_Address 0x55
 #define BUFFER_SIZE 18   // 2 bytes (LED states) + 16 bytes (IP string) = 18 bytes total
 
+// Update frames are longer than LED frames, the slave takes writes up to the longer one
+#if APP_UPDATE_ENABLE
+#define RX_FRAME_SIZE   MAX(BUFFER_SIZE, APP_UPDATE_FRAME_MAX)
+#else
+#define RX_FRAME_SIZE   BUFFER_SIZE
+#endif
+
 // LED GPIO definitions - adjust these based on your board
 #define LED1_GPIO       GPIOE
 #define LED1_GPIO_PIN   20U
 #define LED2_GPIO       GPIOE  // Adjust if you have a second LED
 #define LED2_GPIO_PIN   21U
 
+// Node state kept in flash across resets (app_store.h)
+#define STORE_KEY_LEDS  0U   // 2 bytes: LED1, LED2 (0 or 1)
+#define STORE_KEY_IP    1U   // Up to 16 bytes: the raw IP field of the last frame
+
+// Flash writes wait for this much bus silence, longer than a sector erase (about 14 ms)
+#ifndef STORE_BUS_IDLE_MS
+#define STORE_BUS_IDLE_MS 20U
+#endif
+
 // Timeout for I2C operations (in milliseconds)
 #define I2C_TIMEOUT_MS  5000
 
+// Soak builds start near the wrap point to exercise counter rollover early
+#ifndef APP_PACKET_COUNTER_START
+#define APP_PACKET_COUNTER_START 0U
+#endif
+
+// Also take the same frames from the master over SPI0 as a slave (-DAPP_SPI_LINK_ENABLE=1)
+#ifndef APP_SPI_LINK_ENABLE
+#define APP_SPI_LINK_ENABLE 0
+#endif
+
+#if APP_SPI_LINK_ENABLE
+// A frame that stalls part way for this long is dropped, so the next one starts aligned
+#define SPI_RESYNC_MS   50U
+#endif
+
 /*******************************************************************************
  * Global Variables
  ******************************************************************************/
 extern ARM_DRIVER_I2C Driver_I2C1;
 static ARM_DRIVER_I2C *I2Cdrv = &Driver_I2C1;
-static volatile uint32_t I2C_Event;
+static i2c_async_t I2C_SlaveOp;
 
 // Buffer to store received data
-static uint8_t rxBuffer[BUFFER_SIZE];
-static uint32_t packetCounter = 0;
+static uint8_t rxBuffer[RX_FRAME_SIZE];
+static uint32_t packetCounter = APP_PACKET_COUNTER_START;
+
+// Transfer outcomes reported by the "stats" command
+static uint32_t i2cTimeouts = 0;
+static uint32_t i2cBusErrors = 0;
+static uint32_t i2cIncomplete = 0;
+
+// Last time the I2C bus was seen busy, gates the deferred flash writes
+static volatile uint32_t i2cLastActivityMs;
+
+#if APP_SPI_LINK_ENABLE
+extern ARM_DRIVER_SPI Driver_SPI0;
+static ARM_DRIVER_SPI *SPIdrv = &Driver_SPI0;
+static uint8_t spiRxBuffer[BUFFER_SIZE];
+static volatile uint32_t spiEvents;
+
+// SPI link counters reported by the "stats" command
+static uint32_t spiFrames = 0;
+static uint32_t spiResyncs = 0;
+
+// Receive progress, for spotting a frame the master abandoned
+static uint32_t spiLastCount;
+static uint32_t spiLastProgressMs;
+#endif
 
 // LED state tracking
 static uint8_t currentLED1State = 0;
@@ -64,8 +129,30 @@ void initializeLEDs(void);
 void controlLEDs(uint8_t led1_state, uint8_t led2_state);
 void displayLEDStates(uint8_t led1, uint8_t led2);
 void displayIPAddress(const char* ip_str);
+static bool parseIPv4Octets(const char* ip_str, int octets[4]);
 void parseAndDisplayData(uint8_t *buffer, uint32_t length);
-bool waitForI2CEvent(uint32_t event_mask, uint32_t timeout_ms);
+static void startFrameReceive(void);
+static void onFrameReceived(i2c_async_t *op, uint32_t event, void *context);
+static void restoreNodeState(status_t storeStatus);
+static void saveNodeState(const uint8_t *frame, uint32_t length);
+static bool i2cBusIdle(uint32_t quietMs);
+static int32_t startLinks(void);
+static void pollMainLoop(void);
+#if APP_SPI_LINK_ENABLE
+uint32_t SPI0_GetFreq(void);
+static void SPI_SignalEvent(uint32_t event);
+static void startSpiFrameReceive(void);
+static bool pollSpiLink(void);
+#endif
+#if APP_SHELL_ENABLE
+static void shellStats(const char *args);
+static void shellI2C(const char *args);
+
+static const app_shell_command_t shellCommands[] = {
+    {"stats", "packet, I2C, console and flash counters", shellStats},
+    {"i2c", "speed <100|400|1000> - I2C1 divider, sets the slave SDA hold time", shellI2C},
+};
+#endif
 
 /*******************************************************************************
  * Code
@@ -78,9 +165,37 @@ uint32_t I2C1_GetFreq(void)
 
 static void I2C_SignalEvent(uint32_t event)
 {
-    I2C_Event |= event;
+    // Catches transfers too short for the main loop to see the bus busy
+    i2cLastActivityMs = AppTime_GetMs();
+    I2CAsync_SignalEvent(&I2C_SlaveOp, event);
 }
 
+/*!
+ * @brief True once the I2C bus (any address) has been quiet for quietMs
+ *
+ * Samples the bus busy flag, set from START to STOP, on every main loop pass.
+ */
+static bool i2cBusIdle(uint32_t quietMs)
+{
+    if (I2Cdrv->GetStatus().busy) {
+        i2cLastActivityMs = AppTime_GetMs();
+        return false;
+    }
+    return AppTime_Elapsed(i2cLastActivityMs, quietMs);
+}
+
+#if APP_SPI_LINK_ENABLE
+uint32_t SPI0_GetFreq(void)
+{
+    return CLOCK_GetFreq(SPI0_CLK_SRC);
+}
+
+static void SPI_SignalEvent(uint32_t event)
+{
+    spiEvents |= event;
+}
+#endif
+
 /*!
  * @brief Initialize LED GPIOs
  */
@@ -99,14 +214,14 @@ void initializeLEDs(void)
     GPIO_PinInit(LED2_GPIO, LED2_GPIO_PIN, &led_config);
     #endif
 
-    printf("LEDs initialized successfully.\n");
+    APP_LOG_INFO(APP_LOG_MODULE_LED, "LEDs initialized successfully.\n");
 
     // Test LEDs briefly
-    printf("Testing LEDs...\n");
+    APP_LOG_INFO(APP_LOG_MODULE_LED, "Testing LEDs...\n");
     controlLEDs(1, 1);  // Turn both on
-    for(volatile uint32_t i = 0; i < 400000; ++i) { __asm("NOP"); }  // Brief delay
+    AppTime_DelayMs(100);  // Brief delay
     controlLEDs(0, 0);  // Turn both off
-    printf("LED test complete.\n");
+    APP_LOG_INFO(APP_LOG_MODULE_LED, "LED test complete.\n");
 }
 
 /*!
@@ -122,20 +237,20 @@ void controlLEDs(uint8_t led1_state, uint8_t led2_state)
     if (led1_state != currentLED1State) {
         GPIO_WritePinOutput(LED1_GPIO, LED1_GPIO_PIN, led1_state);
         currentLED1State = led1_state;
-        printf("LED1 %s\n", led1_state ? "ON" : "OFF");
+        APP_LOG_INFO(APP_LOG_MODULE_LED, "LED1 %s\n", led1_state ? "ON" : "OFF");
     }
 
     #ifdef LED2_GPIO
     if (led2_state != currentLED2State) {
         GPIO_WritePinOutput(LED2_GPIO, LED2_GPIO_PIN, led2_state);
         currentLED2State = led2_state;
-        printf("LED2 %s\n", led2_state ? "ON" : "OFF");
+        APP_LOG_INFO(APP_LOG_MODULE_LED, "LED2 %s\n", led2_state ? "ON" : "OFF");
     }
     #else
     // If no second LED available, just track the state
     if (led2_state != currentLED2State) {
         currentLED2State = led2_state;
-        printf("LED2 %s (virtual - no physical LED2 available)\n", led2_state ? "ON" : "OFF");
+        APP_LOG_INFO(APP_LOG_MODULE_LED, "LED2 %s (virtual - no physical LED2 available)\n", led2_state ? "ON" : "OFF");
     }
     #endif
 }
@@ -160,6 +275,39 @@ void displayLEDStates(uint8_t led1, uint8_t led2)
            led2 ? " ● " : " ○ ");
 }
 
+/*!
+ * @brief Parse a dotted-quad IPv4 string into its four octets
+ *
+ * Accepts exactly four groups of 1-3 decimal digits (each <= 255) separated by dots.
+ * Runs in time bounded by the 16-byte IP field regardless of the bytes received,
+ * unlike sscanf which accepts arbitrarily long digit runs and overflows on them.
+ */
+static bool parseIPv4Octets(const char* ip_str, int octets[4])
+{
+    for (int i = 0; i < 4; i++) {
+        int value = 0;
+        int digits = 0;
+
+        while (*ip_str >= '0' && *ip_str <= '9') {
+            if (++digits > 3) {
+                return false;
+            }
+            value = (value * 10) + (*ip_str++ - '0');
+        }
+        if (digits == 0 || value > 255) {
+            return false;
+        }
+        octets[i] = value;
+
+        if (i < 3) {
+            if (*ip_str++ != '.') {
+                return false;
+            }
+        }
+    }
+    return (*ip_str == '\0');
+}
+
 /*!
  * @brief Parse and display IP address information
  */
@@ -168,10 +316,11 @@ void displayIPAddress(const char* ip_str)
     printf("IP Address: %s\n", ip_str);
 
     // Parse IP string to get individual octets for classification
-    int ip1, ip2, ip3, ip4;
-    int parsed = sscanf(ip_str, "%d.%d.%d.%d", &ip1, &ip2, &ip3, &ip4);
+    int octets[4];
+
+    if (parseIPv4Octets(ip_str, octets)) {
+        int ip1 = octets[0], ip2 = octets[1], ip3 = octets[2], ip4 = octets[3];
 
-    if (parsed == 4) {
         // Additional IP information
         if (ip1 == 192 && ip2 == 168) {
             printf("  Type: Private IP (Class C)\n");
@@ -194,55 +343,42 @@ void displayIPAddress(const char* ip_str)
     }
 }
 
-/*!
- * @brief Wait for specific I2C event with timeout
- */
-bool waitForI2CEvent(uint32_t event_mask, uint32_t timeout_ms)
-{
-    uint32_t timeout_counter = 0;
-    const uint32_t delay_per_loop = 1; // 1ms per loop iteration
-
-    while ((I2C_Event & event_mask) == 0) {
-        // Simple delay (adjust based on your system clock)
-        for(volatile uint32_t i = 0; i < 1000; ++i) { __asm("NOP"); }
-
-        timeout_counter += delay_per_loop;
-        if (timeout_counter >= timeout_ms) {
-            return false; // Timeout occurred
-        }
-    }
-    return true; // Event occurred within timeout
-}
-
 /*!
  * @brief Parse and display the complete received data
  */
 void parseAndDisplayData(uint8_t *buffer, uint32_t length)
 {
     if (length < 2) {
-        printf("Incomplete data received: %lu bytes (minimum 2 expected)\n", length);
+        APP_LOG_WARN(APP_LOG_MODULE_PACKET, "Incomplete data received: %lu bytes (minimum 2 expected)\n", length);
         return;
     }
 
-    printf("\n=== Packet #%lu ===\n", ++packetCounter);
+    packetCounter++;
 
     // Parse LED states (first 2 bytes)
     uint8_t led1_state = buffer[0];
     uint8_t led2_state = buffer[1];
 
-    // Validate LED states (should be 0 or 1)
+    // Validate LED states (should be 0 or 1), warned whether or not the packet is dumped
     bool led1_valid = true, led2_valid = true;
     if (led1_state > 1) {
-        printf("WARNING: LED1 state invalid (%d), expected 0 or 1\n", led1_state);
+        APP_LOG_WARN(APP_LOG_MODULE_I2C, "WARNING: LED1 state invalid (%d), expected 0 or 1\n", led1_state);
         led1_state = led1_state ? 1 : 0;  // Normalize to 0 or 1
         led1_valid = false;
     }
     if (led2_state > 1) {
-        printf("WARNING: LED2 state invalid (%d), expected 0 or 1\n", led2_state);
+        APP_LOG_WARN(APP_LOG_MODULE_I2C, "WARNING: LED2 state invalid (%d), expected 0 or 1\n", led2_state);
         led2_state = led2_state ? 1 : 0;  // Normalize to 0 or 1
         led2_valid = false;
     }
 
+    // The dump below is one log record: one level check and one rate-limit token for all of it
+    if (!APP_LOG_ENABLED(APP_LOG_MODULE_PACKET, APP_LOG_LEVEL_INFO)) {
+        return;
+    }
+
+    printf("\n=== Packet #%lu ===\n", packetCounter);
+
     // Display LED states
     displayLEDStates(led1_state, led2_state);
     printf("\n");
@@ -306,111 +442,396 @@ void parseAndDisplayData(uint8_t *buffer, uint32_t length)
 }
 
 /*!
- * @brief Main function
+ * @brief Bring back the LEDs and IP of the last frame received before the reset
+ *
+ * Saves the master a resend to every node after a site-wide power cycle.
  */
-int main(void)
+static void restoreNodeState(status_t storeStatus)
+{
+    uint8_t leds[2];
+    char ip_string[17] = {0};
+
+    if (storeStatus != kStatus_Success) {
+        APP_LOG_ERROR(APP_LOG_MODULE_STORE, "ERROR: State store init failed: %ld\n", storeStatus);
+        return;
+    }
+
+    if (AppStore_Read(STORE_KEY_LEDS, leds, sizeof(leds)) == sizeof(leds)) {
+        controlLEDs(leds[0], leds[1]);
+        APP_LOG_INFO(APP_LOG_MODULE_STORE, "Restored LEDs: LED1=%s LED2=%s\n",
+                     leds[0] ? "ON" : "OFF", leds[1] ? "ON" : "OFF");
+    }
+
+    if (AppStore_Read(STORE_KEY_IP, ip_string, sizeof(ip_string) - 1U) > 0U) {
+        APP_LOG_INFO(APP_LOG_MODULE_STORE, "Restored IP: %s\n", ip_string);
+    }
+}
+
+/*!
+ * @brief Keep the LED and IP fields of a frame for the next boot
+ *
+ * Only staged here: the flash is written from the main loop once the bus is idle,
+ * and a value updated several times meanwhile is written once.
+ */
+static void saveNodeState(const uint8_t *frame, uint32_t length)
+{
+    uint8_t leds[2];
+    status_t status;
+
+    if (length < 2) {
+        return;
+    }
+
+    leds[0] = frame[0] ? 1 : 0;
+    leds[1] = frame[1] ? 1 : 0;
+    status = AppStore_Write(STORE_KEY_LEDS, leds, sizeof(leds));
+    if ((status == kStatus_Success) && (length > 2)) {
+        status = AppStore_Write(STORE_KEY_IP, &frame[2], MIN(length - 2, 16U));
+    }
+    if (status != kStatus_Success) {
+        APP_LOG_ERROR(APP_LOG_MODULE_STORE, "ERROR: State store write failed: %ld\n", status);
+    }
+}
+
+/*!
+ * @brief Arm the slave for the next frame, retrying until the driver accepts it
+ */
+static void startFrameReceive(void)
 {
     int32_t status;
+
+    // Clear the buffer before the master can write into it
+    memset(rxBuffer, 0, sizeof(rxBuffer));
+
+    while ((status = I2CAsync_SlaveReceive(&I2C_SlaveOp, rxBuffer, RX_FRAME_SIZE, I2C_TIMEOUT_MS,
+                                           onFrameReceived, NULL)) != ARM_DRIVER_OK) {
+        APP_LOG_ERROR(APP_LOG_MODULE_I2C, "ERROR: SlaveReceive failed: %ld\n", status);
+        // Brief delay before retry
+        AppTime_DelayMs(20);
+    }
+}
+
+/*!
+ * @brief Handle one finished (or timed out) slave receive, then arm the next one
+ */
+static void onFrameReceived(i2c_async_t *op, uint32_t event, void *context)
+{
     uint32_t bytesReceived;
 
-    /* Board pin, clock, debug console init */
-    BOARD_InitPins();
-    BOARD_BootClockRUN();
-    BOARD_InitDebugConsole();
+    (void)context;
 
-    printf("\n");
-    printf("==============================================\n");
-    printf("I2C Slave - LED Control + IP Address Receiver\n");
-    printf("==============================================\n");
-    printf("Slave Address: 0x%02X\n", I2C_Address);
-    printf("Expected Data: 2 bytes (LED states) + 16 bytes (IP string) = %d bytes total\n", BUFFER_SIZE);
-    printf("Data Format: [LED1][LED2][IP_STRING_16_BYTES]\n");
-    printf("==============================================\n\n");
+    if (event & I2C_ASYNC_EVENT_TIMEOUT) {
+        i2cTimeouts++;
+        APP_LOG_WARN(APP_LOG_MODULE_I2C, "WARNING: I2C transfer timeout\n");
+    } else if (event & ARM_I2C_EVENT_BUS_ERROR) {
+        i2cBusErrors++;
+        APP_LOG_ERROR(APP_LOG_MODULE_I2C, "ERROR: Bus error detected!\n");
+    } else {
+        // Get the actual number of bytes received
+        bytesReceived = op->driver->GetDataCount();
+#if APP_UPDATE_ENABLE
+        // Update chunks stream back to back: no logging or delay, re-arm at once
+        if (AppUpdate_IsUpdateFrame(rxBuffer, bytesReceived)) {
+            AppUpdate_HandleFrame(rxBuffer, bytesReceived);
+            startFrameReceive();
+            return;
+        }
+#endif
+        if (bytesReceived > BUFFER_SIZE) {
+            bytesReceived = BUFFER_SIZE;
+        }
 
-    // Initialize LEDs
-    initializeLEDs();
-    printf("\n");
+        if (bytesReceived > 0) {
+            APP_LOG_INFO(APP_LOG_MODULE_I2C, "📨 Received %lu bytes\n", bytesReceived);
+
+            // Parse and display the structured data
+            parseAndDisplayData(rxBuffer, bytesReceived);
+
+            // If we have LED data, control the physical LEDs
+            if (bytesReceived >= 2) {
+                controlLEDs(rxBuffer[0], rxBuffer[1]);
+            }
+            saveNodeState(rxBuffer, bytesReceived);
+
+            // Check if transfer was incomplete
+            if (event & ARM_I2C_EVENT_TRANSFER_INCOMPLETE) {
+                i2cIncomplete++;
+                APP_LOG_WARN(APP_LOG_MODULE_I2C, "⚠️  WARNING: Transfer was incomplete!\n"
+                             "Expected: %d bytes, Received: %lu bytes\n", BUFFER_SIZE, bytesReceived);
+            }
+        } else {
+            APP_LOG_INFO(APP_LOG_MODULE_I2C, "ℹ️  No data received in this transfer.\n");
+        }
+    }
+
+    // Re-arm at once: the master may send the next frame right behind this one
+    startFrameReceive();
+}
+
+#if APP_SPI_LINK_ENABLE
+/*!
+ * @brief Arm the SPI slave for the next frame
+ */
+static void startSpiFrameReceive(void)
+{
+    int32_t status;
+
+    memset(spiRxBuffer, 0, BUFFER_SIZE);
+    spiEvents = 0;
+    spiLastCount = 0;
+    spiLastProgressMs = AppTime_GetMs();
+
+    status = SPIdrv->Receive(spiRxBuffer, BUFFER_SIZE);
+    if (status != ARM_DRIVER_OK) {
+        APP_LOG_ERROR(APP_LOG_MODULE_SPI, "ERROR: SPI Receive failed: %ld\n", status);
+    }
+}
+
+/*!
+ * @brief Handle a finished SPI frame, or drop one the master stopped sending part way
+ *
+ * @return true if a frame was handled or dropped
+ */
+static bool pollSpiLink(void)
+{
+    uint32_t count;
+    uint32_t now;
+
+    if (spiEvents & ARM_SPI_EVENT_TRANSFER_COMPLETE) {
+        spiFrames++;
+        APP_LOG_INFO(APP_LOG_MODULE_SPI, "Received %d bytes over SPI\n", BUFFER_SIZE);
+
+        parseAndDisplayData(spiRxBuffer, BUFFER_SIZE);
+        controlLEDs(spiRxBuffer[0], spiRxBuffer[1]);
+        saveNodeState(spiRxBuffer, BUFFER_SIZE);
+
+        startSpiFrameReceive();
+        return true;
+    }
+
+    // SPI has no frame delimiter the slave can see, a short frame would shift every later one
+    count = SPIdrv->GetDataCount();
+    now = AppTime_GetMs();
+    if (count != spiLastCount) {
+        spiLastCount = count;
+        spiLastProgressMs = now;
+    } else if ((count > 0U) && AppTime_Elapsed(spiLastProgressMs, SPI_RESYNC_MS)) {
+        spiResyncs++;
+        APP_LOG_WARN(APP_LOG_MODULE_SPI, "WARNING: SPI frame stalled after %lu bytes, resyncing\n", count);
+        SPIdrv->Control(ARM_SPI_ABORT_TRANSFER, 0);
+        startSpiFrameReceive();
+        return true;
+    }
+
+    return false;
+}
+#endif /* APP_SPI_LINK_ENABLE */
+
+#if APP_SHELL_ENABLE
+/*!
+ * @brief "stats" command: counters since boot
+ */
+static void shellStats(const char *args)
+{
+    app_store_stats_t storeStats;
+
+    (void)args;
+
+    printf("  uptime     %lu ms\n", AppTime_GetMs());
+    printf("  packets    %lu\n", packetCounter);
+    printf("  timeouts   %lu\n", i2cTimeouts);
+    printf("  bus errors %lu\n", i2cBusErrors);
+    printf("  incomplete %lu\n", i2cIncomplete);
+#if APP_SPI_LINK_ENABLE
+    printf("  spi frames %lu, %lu resyncs\n", spiFrames, spiResyncs);
+#endif
+    printf("  console    %lu bytes dropped, %lu rx overruns\n", DbgConsole_GetTxDropCount(),
+           DbgConsole_GetRxOverrunCount());
+
+    AppStore_GetStats(&storeStats);
+    printf("  store      sector %lu, %lu bytes free, pending keys 0x%02lX, %lu failed steps\n",
+           storeStats.activeSector, storeStats.freeBytes, storeStats.pendingKeys, storeStats.failures);
+    printf("  flash      %lu erases, %lu programs (%lu bytes) since boot\n", storeStats.erases,
+           storeStats.programs, storeStats.bytesProgrammed);
+    printf("  wear      ");
+    for (uint32_t i = 0; i < APP_STORE_SECTOR_COUNT; i++) {
+        printf(" %lu", storeStats.sectorErases[i]);
+    }
+    printf(" erases per sector\n");
+}
+
+/*!
+ * @brief "i2c speed <kHz>" command
+ *
+ * The master clocks the bus, but the slave's divider still sets the SDA hold time it uses,
+ * which has to shrink for fast-mode masters.
+ */
+static void shellI2C(const char *args)
+{
+    uint32_t speed;
+    int32_t status;
+
+    if (strcmp(args, "speed 100") == 0) {
+        speed = ARM_I2C_BUS_SPEED_STANDARD;
+    } else if (strcmp(args, "speed 400") == 0) {
+        speed = ARM_I2C_BUS_SPEED_FAST;
+    } else if (strcmp(args, "speed 1000") == 0) {
+        speed = ARM_I2C_BUS_SPEED_FAST_PLUS;
+    } else {
+        printf("usage: i2c speed <100|400|1000>\n");
+        return;
+    }
+
+    status = I2Cdrv->Control(ARM_I2C_BUS_SPEED, speed);
+    if (status != ARM_DRIVER_OK) {
+        printf("ERROR: I2C Control (bus speed) failed: %ld\n", status);
+    }
+}
+#endif /* APP_SHELL_ENABLE */
+
+/*!
+ * @brief Bring up the I2C slave, and the SPI slave when enabled
+ *
+ * @return ARM_DRIVER_OK, or the status of the first driver call that failed
+ */
+static int32_t startLinks(void)
+{
+    int32_t status;
 
     /* Initialize I2C peripheral */
+    I2CAsync_Init(&I2C_SlaveOp, I2Cdrv);
     status = I2Cdrv->Initialize(I2C_SignalEvent);
     if (status != ARM_DRIVER_OK) {
-        printf("ERROR: I2C Initialize failed: %ld\n", status);
-        return -1;
+        APP_LOG_ERROR(APP_LOG_MODULE_I2C, "ERROR: I2C Initialize failed: %ld\n", status);
+        return status;
     }
 
     /* Power-on I2C peripheral */
     status = I2Cdrv->PowerControl(ARM_POWER_FULL);
     if (status != ARM_DRIVER_OK) {
-        printf("ERROR: I2C PowerControl failed: %ld\n", status);
-        return -1;
+        APP_LOG_ERROR(APP_LOG_MODULE_I2C, "ERROR: I2C PowerControl failed: %ld\n", status);
+        return status;
     }
 
     /* Configure I2C bus - Set slave address */
     status = I2Cdrv->Control(ARM_I2C_OWN_ADDRESS, I2C_Address);
     if (status != ARM_DRIVER_OK) {
-        printf("ERROR: I2C Control (set address) failed: %ld\n", status);
-        return -1;
+        APP_LOG_ERROR(APP_LOG_MODULE_I2C, "ERROR: I2C Control (set address) failed: %ld\n", status);
+        return status;
     }
 
     printf("✓ I2C Slave initialized successfully.\n");
-    printf("✓ LEDs ready for control.\n");
-    printf("⏳ Waiting for LED commands and IP address from ESP32 master...\n\n");
 
-    while (1) {
-        // Clear the buffer and event flags
-        memset(rxBuffer, 0, BUFFER_SIZE);
-        I2C_Event = 0;
-
-        // Start slave receive operation
-        status = I2Cdrv->SlaveReceive(rxBuffer, BUFFER_SIZE);
-        if (status != ARM_DRIVER_OK) {
-            printf("ERROR: SlaveReceive failed: %ld\n", status);
-            // Brief delay before retry
-            for(volatile uint32_t i = 0; i < 100000; ++i) { __asm("NOP"); }
-            continue;
-        }
+#if APP_SPI_LINK_ENABLE
+    /* SPI0 slave: mode 0, 8-bit frames, MSB first, SS driven by the master */
+    status = SPIdrv->Initialize(SPI_SignalEvent);
+    if (status == ARM_DRIVER_OK) {
+        status = SPIdrv->PowerControl(ARM_POWER_FULL);
+    }
+    if (status == ARM_DRIVER_OK) {
+        status = SPIdrv->Control(ARM_SPI_MODE_SLAVE | ARM_SPI_CPOL0_CPHA0 | ARM_SPI_DATA_BITS(8) | ARM_SPI_MSB_LSB |
+                                 ARM_SPI_SS_SLAVE_HW, 0);
+    }
+    if (status != ARM_DRIVER_OK) {
+        APP_LOG_ERROR(APP_LOG_MODULE_SPI, "ERROR: SPI slave setup failed: %ld\n", status);
+        return status;
+    }
+    printf("✓ SPI0 Slave initialized successfully.\n");
+#endif
 
-        // Wait for transfer to complete with timeout
-        if (!waitForI2CEvent(ARM_I2C_EVENT_TRANSFER_DONE, I2C_TIMEOUT_MS)) {
-            printf("WARNING: I2C transfer timeout\n");
-            continue;
-        }
+    return ARM_DRIVER_OK;
+}
 
-        // Check for errors
-        if (I2C_Event & ARM_I2C_EVENT_BUS_ERROR) {
-            printf("ERROR: Bus error detected!\n");
-            I2C_Event &= ~ARM_I2C_EVENT_BUS_ERROR;
-            continue;
+/*!
+ * @brief One pass of the main loop: at most one piece of work, else sleep
+ */
+static void pollMainLoop(void)
+{
+    if (!I2CAsync_Poll(&I2C_SlaveOp)) {
+#if APP_UPDATE_ENABLE
+        // One flash command of a received chunk, the slave is re-armed for the next one
+        if (AppUpdate_Poll()) {
+            return;
+        }
+#endif
+#if APP_SPI_LINK_ENABLE
+        if (pollSpiLink()) {
+            return;
+        }
+#endif
+        // Flash commands stall the CPU, run them only in gaps between frames
+        if (AppStore_Poll(i2cBusIdle(STORE_BUS_IDLE_MS))) {
+            return;
+        }
+#if APP_SHELL_ENABLE
+        // Commands only run when no I2C continuation is waiting
+        if (AppShell_Poll()) {
+            return;
         }
+#endif
+        // Sleep only once queued console output has been handed to the LPSCI
+        if (!DbgConsole_TryFlush()) {
+            I2CAsync_Idle(&I2C_SlaveOp);
+        }
+    }
+}
 
-        // Get the actual number of bytes received
-        bytesReceived = I2Cdrv->GetDataCount();
+/*!
+ * @brief Main function
+ */
+int main(void)
+{
+    status_t storeStatus;
 
-        if (bytesReceived > 0) {
-            printf("📨 Received %lu bytes\n", bytesReceived);
+    // State store first: an activated update image takes over before anything is set up
+    storeStatus = AppStore_Init();
+#if APP_UPDATE_ENABLE
+    AppUpdate_BootSelect();
+#endif
 
-            // Parse and display the structured data
-            parseAndDisplayData(rxBuffer, bytesReceived);
+    /* Board pin, clock, debug console init */
+    BOARD_InitPins();
+    BOARD_BootClockRUN();
+    BOARD_InitDebugConsole();
+    AppTime_Init();
 
-            // If we have LED data, control the physical LEDs
-            if (bytesReceived >= 2) {
-                controlLEDs(rxBuffer[0], rxBuffer[1]);
-            }
+    printf("\n");
+    printf("==============================================\n");
+    printf("I2C Slave - LED Control + IP Address Receiver\n");
+    printf("==============================================\n");
+    printf("Slave Address: 0x%02X\n", I2C_Address);
+    printf("Expected Data: 2 bytes (LED states) + 16 bytes (IP string) = %d bytes total\n", BUFFER_SIZE);
+    printf("Data Format: [LED1][LED2][IP_STRING_16_BYTES]\n");
+    printf("==============================================\n\n");
 
-            // Check if transfer was incomplete
-            if (I2C_Event & ARM_I2C_EVENT_TRANSFER_INCOMPLETE) {
-                printf("⚠️  WARNING: Transfer was incomplete!\n");
-                printf("Expected: %d bytes, Received: %lu bytes\n", BUFFER_SIZE, bytesReceived);
-            }
-        } else {
-            printf("ℹ️  No data received in this transfer.\n");
-        }
+    // Initialize LEDs, then put back the state from before the reset
+    initializeLEDs();
+    restoreNodeState(storeStatus);
+    printf("\n");
+
+#if APP_BENCHMARK_ENABLE
+    // Emit hot path cycle counts before the slave goes live
+    Benchmark_Run();
+    printf("\n");
+#endif
 
-        // Clear transfer flags
-        I2C_Event &= ~(ARM_I2C_EVENT_TRANSFER_DONE | ARM_I2C_EVENT_TRANSFER_INCOMPLETE | ARM_I2C_EVENT_GENERAL_CALL);
+    if (startLinks() != ARM_DRIVER_OK) {
+        return -1;
+    }
+    printf("✓ LEDs ready for control.\n");
+    printf("⏳ Waiting for LED commands and IP address from ESP32 master...\n\n");
+
+#if APP_SHELL_ENABLE
+    AppShell_Init(shellCommands, ARRAY_SIZE(shellCommands));
+#endif
 
-        // Small delay to prevent overwhelming the console
-        for(volatile uint32_t i = 0; i < 50000; ++i) { __asm("NOP"); }
+    // Everything from here on runs as continuations of the slave receive
+    startFrameReceive();
+#if APP_SPI_LINK_ENABLE
+    startSpiFrameReceive();
+#endif
+    while (1) {
+        pollMainLoop();
     }
 
     return 0;
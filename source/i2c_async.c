@@ -0,0 +1,135 @@
+/*
+ * Continuation-style asynchronous operations over ARM_DRIVER_I2C
+ * The driver callback only records events; continuations run from the main loop
+ */
+
+/* Standard C Included Files */
+#include <stddef.h>
+
+/* SDK Included Files */
+#include "board.h"
+#include "app_time.h"
+#include "i2c_async.h"
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief Claim the operation object before the driver can raise its first event
+ */
+static bool I2CAsync_Arm(i2c_async_t *op, uint32_t timeoutMs, i2c_async_continuation_t continuation, void *context)
+{
+    if (op->continuation != NULL) {
+        return false;
+    }
+    op->events = 0U;
+    op->context = context;
+    op->startMs = AppTime_GetMs();
+    op->timeoutMs = timeoutMs;
+    op->continuation = continuation;
+    return true;
+}
+
+/*!
+ * @brief Release the operation object if the driver refused to start
+ */
+static int32_t I2CAsync_Started(i2c_async_t *op, int32_t status)
+{
+    if (status != ARM_DRIVER_OK) {
+        op->continuation = NULL;
+    }
+    return status;
+}
+
+/* See i2c_async.h for documentation of this function. */
+void I2CAsync_Init(i2c_async_t *op, ARM_DRIVER_I2C *driver)
+{
+    op->driver = driver;
+    op->events = 0U;
+    op->continuation = NULL;
+    op->context = NULL;
+    op->startMs = 0U;
+    op->timeoutMs = 0U;
+}
+
+/* See i2c_async.h for documentation of this function. */
+void I2CAsync_SignalEvent(i2c_async_t *op, uint32_t event)
+{
+    op->events |= event;
+}
+
+/* See i2c_async.h for documentation of this function. */
+int32_t I2CAsync_SlaveReceive(i2c_async_t *op, uint8_t *data, uint32_t num, uint32_t timeoutMs,
+                              i2c_async_continuation_t continuation, void *context)
+{
+    if (!I2CAsync_Arm(op, timeoutMs, continuation, context)) {
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+    return I2CAsync_Started(op, op->driver->SlaveReceive(data, num));
+}
+
+/* See i2c_async.h for documentation of this function. */
+int32_t I2CAsync_SlaveTransmit(i2c_async_t *op, const uint8_t *data, uint32_t num, uint32_t timeoutMs,
+                               i2c_async_continuation_t continuation, void *context)
+{
+    if (!I2CAsync_Arm(op, timeoutMs, continuation, context)) {
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+    return I2CAsync_Started(op, op->driver->SlaveTransmit(data, num));
+}
+
+/* See i2c_async.h for documentation of this function. */
+int32_t I2CAsync_MasterReceive(i2c_async_t *op, uint32_t addr, uint8_t *data, uint32_t num, bool xferPending,
+                               uint32_t timeoutMs, i2c_async_continuation_t continuation, void *context)
+{
+    if (!I2CAsync_Arm(op, timeoutMs, continuation, context)) {
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+    return I2CAsync_Started(op, op->driver->MasterReceive(addr, data, num, xferPending));
+}
+
+/* See i2c_async.h for documentation of this function. */
+int32_t I2CAsync_MasterTransmit(i2c_async_t *op, uint32_t addr, const uint8_t *data, uint32_t num, bool xferPending,
+                                uint32_t timeoutMs, i2c_async_continuation_t continuation, void *context)
+{
+    if (!I2CAsync_Arm(op, timeoutMs, continuation, context)) {
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+    return I2CAsync_Started(op, op->driver->MasterTransmit(addr, data, num, xferPending));
+}
+
+/* See i2c_async.h for documentation of this function. */
+bool I2CAsync_Poll(i2c_async_t *op)
+{
+    i2c_async_continuation_t continuation = op->continuation;
+    uint32_t event;
+
+    if (continuation == NULL) {
+        return false;
+    }
+
+    event = op->events;
+    if ((event & I2C_ASYNC_TERMINAL_EVENTS) == 0U) {
+        if ((op->timeoutMs == 0U) || !AppTime_Elapsed(op->startMs, op->timeoutMs)) {
+            return false;
+        }
+        event |= I2C_ASYNC_EVENT_TIMEOUT;
+    }
+
+    // Idle again before the continuation runs, so it can chain the next step
+    op->continuation = NULL;
+    continuation(op, event, op->context);
+    return true;
+}
+
+/* See i2c_async.h for documentation of this function. */
+void I2CAsync_Idle(const i2c_async_t *op)
+{
+    // Masked check-then-sleep: an event landing in between still wakes WFI as a pending IRQ
+    __disable_irq();
+    if ((op->continuation == NULL) || ((op->events & I2C_ASYNC_TERMINAL_EVENTS) == 0U)) {
+        __WFI();
+    }
+    __enable_irq();
+}
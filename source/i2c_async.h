@@ -0,0 +1,93 @@
+/*
+ * Continuation-style asynchronous operations over ARM_DRIVER_I2C
+ * The driver callback only records events; continuations run from the main loop
+ */
+
+#ifndef _I2C_ASYNC_H_
+#define _I2C_ASYNC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Driver_I2C.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Passed to the continuation when the operation did not finish within its timeout. */
+#define I2C_ASYNC_EVENT_TIMEOUT (1UL << 31)
+
+/*! @brief Driver events that end an operation. */
+#define I2C_ASYNC_TERMINAL_EVENTS                                                            \
+    (ARM_I2C_EVENT_TRANSFER_DONE | ARM_I2C_EVENT_TRANSFER_INCOMPLETE | ARM_I2C_EVENT_ADDRESS_NACK | \
+     ARM_I2C_EVENT_ARBITRATION_LOST | ARM_I2C_EVENT_BUS_ERROR)
+
+typedef struct _i2c_async i2c_async_t;
+
+/*!
+ * @brief Runs in thread context once an operation ends
+ *
+ * @param op      The operation; it is idle again, so the continuation may start the next step.
+ * @param event   All ARM_I2C_EVENT_* flags seen during the operation, plus I2C_ASYNC_EVENT_TIMEOUT.
+ * @param context Pointer given when the operation was started.
+ */
+typedef void (*i2c_async_continuation_t)(i2c_async_t *op, uint32_t event, void *context);
+
+/*! @brief One in-flight operation on one driver instance. Statically allocated by the caller. */
+struct _i2c_async {
+    ARM_DRIVER_I2C *driver;
+    volatile uint32_t events;               // Accumulated by I2CAsync_SignalEvent in the ISR
+    i2c_async_continuation_t continuation;  // NULL while idle
+    void *context;
+    uint32_t startMs;
+    uint32_t timeoutMs;                     // 0 waits forever
+};
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief Bind an operation object to a driver instance
+ */
+void I2CAsync_Init(i2c_async_t *op, ARM_DRIVER_I2C *driver);
+
+/*!
+ * @brief Record a driver event
+ *
+ * CMSIS callbacks carry no context pointer, so the application registers a one-line
+ * ARM_I2C_SignalEvent_t per instance that forwards here. Safe to call from the ISR.
+ */
+void I2CAsync_SignalEvent(i2c_async_t *op, uint32_t event);
+
+/*!
+ * @name Operation start
+ * Each returns the driver status. On ARM_DRIVER_OK the continuation runs exactly once,
+ * from I2CAsync_Poll. ARM_DRIVER_ERROR_BUSY is returned while a previous operation is pending.
+ * @{
+ */
+int32_t I2CAsync_SlaveReceive(i2c_async_t *op, uint8_t *data, uint32_t num, uint32_t timeoutMs,
+                              i2c_async_continuation_t continuation, void *context);
+int32_t I2CAsync_SlaveTransmit(i2c_async_t *op, const uint8_t *data, uint32_t num, uint32_t timeoutMs,
+                               i2c_async_continuation_t continuation, void *context);
+int32_t I2CAsync_MasterReceive(i2c_async_t *op, uint32_t addr, uint8_t *data, uint32_t num, bool xferPending,
+                               uint32_t timeoutMs, i2c_async_continuation_t continuation, void *context);
+int32_t I2CAsync_MasterTransmit(i2c_async_t *op, uint32_t addr, const uint8_t *data, uint32_t num, bool xferPending,
+                                uint32_t timeoutMs, i2c_async_continuation_t continuation, void *context);
+/*! @} */
+
+/*!
+ * @brief Run the continuation if the operation has ended or timed out
+ *
+ * @return true if a continuation ran.
+ */
+bool I2CAsync_Poll(i2c_async_t *op);
+
+/*!
+ * @brief Sleep in WFI unless the operation already has a result to deliver
+ *
+ * Wakes on any interrupt, including the 1 ms tick that drives timeouts.
+ */
+void I2CAsync_Idle(const i2c_async_t *op);
+
+#endif /* _I2C_ASYNC_H_ */
@@ -0,0 +1,65 @@
+/*
+ * State store cost on the FTFA model: flash busy time and wear per record
+ */
+
+#include <string.h>
+#include <time.h>
+
+#include "app_store.h"
+#include "host_hw.h"
+#include "host_flash.h"
+#include "host_check.h"
+
+// Rated program/erase cycles per sector (KL26 datasheet minimum)
+#define ENDURANCE_CYCLES    10000U
+
+static double nowUs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void benchValueSize(uint32_t length, uint32_t records)
+{
+    uint8_t value[APP_STORE_VALUE_MAX];
+    const host_flash_stats_t *flash = HostFlash_GetStats();
+    app_store_stats_t stats;
+    uint32_t maxErases = 0;
+    double startUs;
+    double hostUs;
+
+    HostFlash_Reset();
+    AppStore_Init();
+    HostFlash_ClearStats();
+
+    startUs = nowUs();
+    for (uint32_t n = 0; n < records; n++) {
+        memset(value, (int)n, length);
+        AppStore_Write((uint8_t)(n % APP_STORE_KEY_COUNT), value, length);
+        AppStore_Flush();
+    }
+    hostUs = nowUs() - startUs;
+
+    AppStore_GetStats(&stats);
+    for (uint32_t i = 0; i < APP_STORE_SECTOR_COUNT; i++) {
+        maxErases = MAX(maxErases, stats.sectorErases[i]);
+    }
+    CHECK_EQ(stats.failures, 0);
+    CHECK_EQ(flash->overwrites, 0);
+
+    printf("  %2lu B  %7.1f us flash/record  %5.2f erases/1k records  %8.0f records to %u cycles  (%.2f us host)\n",
+           (unsigned long)length, (double)flash->busyUs / records, 1000.0 * flash->erases / records,
+           (double)records * ENDURANCE_CYCLES / maxErases, ENDURANCE_CYCLES, hostUs / records);
+}
+
+int main(void)
+{
+    printf("bench_flash: %u records per size, %u store sectors\n", 20000U, APP_STORE_SECTOR_COUNT);
+    benchValueSize(1, 20000);
+    benchValueSize(4, 20000);
+    benchValueSize(16, 20000);
+    benchValueSize(APP_STORE_VALUE_MAX, 20000);
+    return HostCheck_Result();
+}
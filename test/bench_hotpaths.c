@@ -0,0 +1,453 @@
+/*
+ * Host timings of the firmware hot paths benchmarked on the target (source/benchmark.c)
+ * Same cases, run against the register models and timed with CLOCK_MONOTONIC. The
+ * printf cases run the SDK formatter (host_fmt.h), also under the application's
+ * packet dump, and again as *_ref on the formatter from before the span sink and
+ * the division-free conversion. Output is CSV, one line each:
+ *   BENCH_HOST,<compiler>
+ *   BENCH,<name>,<iterations>,<min ns>,<avg ns>,<max ns>,<output bytes per call>
+ *   RATE,<name>,<ref chars/s>,<chars/s>,<ref min ns / min ns>
+ * Times have the measurement overhead removed. RATE compares each *_ref case with
+ * its counterpart on the fastest call, which preemption of the host cannot inflate;
+ * chars/s is 0 for cases that print nothing.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "fsl_i2c.h"
+#include "fsl_lpsci.h"
+#include "fsl_uart.h"
+#include "app_log.h"
+#include "host_hw.h"
+#include "host_app.h"
+#include "host_fmt.h"
+
+#define BENCH_ITERATIONS    20000U
+#define BENCH_RING_SIZE     64U
+#define BENCH_READ_SIZE     32U
+
+// Milliseconds that earn the packet log one rate-limit token (app_log.c)
+#define LOG_MS_PER_TOKEN    (1000U / APP_LOG_RATE_PER_SEC)
+
+typedef struct {
+    const char *name;
+    void (*prepare)(void);      // Untimed, runs before every iteration (may be NULL)
+    void (*run)(void);          // Timed body
+} bench_case_t;
+
+// Application functions under test, defined in cmsis_i2c_interrupt_transfer.c
+void displayIPAddress(const char* ip_str);
+void parseAndDisplayData(uint8_t *buffer, uint32_t length);
+void SysTick_Handler(void);
+
+static uint8_t s_ringBuffer[BENCH_RING_SIZE];
+static uint8_t s_readBuffer[BENCH_READ_SIZE];
+static uart_handle_t s_uartHandle;
+static lpsci_handle_t s_lpsciHandle;
+static volatile uint8_t s_checksum;
+static uint64_t s_outBytes;
+static uint64_t s_minNs[32];
+static uint64_t s_outChars[32];
+
+// A full-size frame as sent by the master: LED states + 16-byte IP field
+static const uint8_t s_sampleFrame[18] = {
+    1, 0, '1', '9', '2', '.', '1', '6', '8', '.', '1', '0', '0', '.', '2', '5', '4', 0
+};
+
+static uint64_t nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+static int discardBytes(const uint8_t *data, size_t length)
+{
+    s_outBytes += length;
+    return (int)length;
+}
+
+// The console device: formatter output goes nowhere, only its length is kept
+static int (*volatile s_consoleWrite)(const uint8_t *data, size_t length) = discardBytes;
+
+// DbgConsole_WriteSpan: one device call per run
+static int consoleSpan(const char *span, size_t length)
+{
+    if (length) {
+        s_consoleWrite((const uint8_t *)span, length);
+    }
+    return (int)length;
+}
+
+// DbgConsole_Putchar as the old formatter called it: one device call per character
+static int consolePutchar(int c)
+{
+    uint8_t ch = (uint8_t)c;
+
+    s_consoleWrite(&ch, 1);
+    return 1;
+}
+
+static int consoleOutput(const char *format, va_list ap)
+{
+    return HostFmt_VFormat(consoleSpan, format, ap);
+}
+
+static int consoleOutputRef(const char *format, va_list ap)
+{
+    return HostFmtRef_VFormat(consolePutchar, format, ap);
+}
+
+static void bench_empty(void)
+{
+}
+
+static void bench_i2c_master_set_baud_rate(void)
+{
+    I2C_MasterSetBaudRate(I2C0, 100000U, 24000000U);
+}
+
+static void bench_lpsci_set_baud_rate(void)
+{
+    LPSCI_SetBaudRate(UART0, 115200U, 48000000U);
+}
+
+// The formats of the per-packet dump, on the current formatter and on the reference
+#define FMT_PACKET_HEADER   "\n=== Packet #%lu ===\n", (unsigned long)123456UL
+#define FMT_RAW_BYTE        "%02X('%c') ", 0x41U, 'A'
+#define FMT_LED_STATE       "  LED1: %s %s\n", "ON ", "[*]"
+#define FMT_IP_HEX          "  Hex: 0x%02X.0x%02X.0x%02X.0x%02X\n", 192, 168, 100, 254
+
+static void bench_fmt_packet_header(void)
+{
+    HostFmt_Format(consoleSpan, FMT_PACKET_HEADER);
+}
+
+static void bench_fmt_packet_header_ref(void)
+{
+    HostFmtRef_Format(consolePutchar, FMT_PACKET_HEADER);
+}
+
+static void bench_fmt_raw_byte(void)
+{
+    HostFmt_Format(consoleSpan, FMT_RAW_BYTE);
+}
+
+static void bench_fmt_raw_byte_ref(void)
+{
+    HostFmtRef_Format(consolePutchar, FMT_RAW_BYTE);
+}
+
+static void bench_fmt_led_state(void)
+{
+    HostFmt_Format(consoleSpan, FMT_LED_STATE);
+}
+
+static void bench_fmt_led_state_ref(void)
+{
+    HostFmtRef_Format(consolePutchar, FMT_LED_STATE);
+}
+
+static void bench_fmt_ip_hex(void)
+{
+    HostFmt_Format(consoleSpan, FMT_IP_HEX);
+}
+
+static void bench_fmt_ip_hex_ref(void)
+{
+    HostFmtRef_Format(consolePutchar, FMT_IP_HEX);
+}
+
+static void bench_radix_dec_u32(void)
+{
+    char digits[66];
+    host_fmt_uint_t value = 4000000000U;
+
+    s_checksum = (uint8_t)HostFmt_ConvertRadix(digits, &value, false, 10, false);
+}
+
+static void bench_radix_dec_u32_ref(void)
+{
+    char digits[66];
+    host_fmt_uint_t value = 4000000000U;
+
+    s_checksum = (uint8_t)HostFmtRef_ConvertRadix(digits, &value, false, 10, false);
+}
+
+static void bench_radix_hex_u32(void)
+{
+    char digits[66];
+    host_fmt_uint_t value = 0xDEADBEEFU;
+
+    s_checksum = (uint8_t)HostFmt_ConvertRadix(digits, &value, false, 16, true);
+}
+
+static void bench_radix_hex_u32_ref(void)
+{
+    char digits[66];
+    host_fmt_uint_t value = 0xDEADBEEFU;
+
+    s_checksum = (uint8_t)HostFmtRef_ConvertRadix(digits, &value, false, 16, true);
+}
+
+#if HOST_FMT_ADVANCED
+static void bench_radix_dec_u64(void)
+{
+    char digits[66];
+    host_fmt_uint_t value = 18000000000000000000ULL;
+
+    s_checksum = (uint8_t)HostFmt_ConvertRadix(digits, &value, false, 10, false);
+}
+
+static void bench_radix_dec_u64_ref(void)
+{
+    char digits[66];
+    host_fmt_uint_t value = 18000000000000000000ULL;
+
+    s_checksum = (uint8_t)HostFmtRef_ConvertRadix(digits, &value, false, 10, false);
+}
+#endif
+
+static void prepare_output(void)
+{
+    HostApp_SetOutput(consoleOutput);
+}
+
+static void prepare_output_ref(void)
+{
+    HostApp_SetOutput(consoleOutputRef);
+}
+
+static void prepare_log_token(void)
+{
+    // The packet dump is one rate-limited log record: let a token come in
+    for (uint32_t ms = 0; ms < LOG_MS_PER_TOKEN; ms++) {
+        SysTick_Handler();
+    }
+    HostApp_SetOutput(consoleOutput);
+}
+
+static void prepare_log_token_ref(void)
+{
+    prepare_log_token();
+    HostApp_SetOutput(consoleOutputRef);
+}
+
+static void bench_display_ip_address(void)
+{
+    displayIPAddress("192.168.100.254");
+}
+
+static void bench_parse_and_display_data(void)
+{
+    uint8_t frame[sizeof(s_sampleFrame)];
+
+    memcpy(frame, s_sampleFrame, sizeof(frame));
+    parseAndDisplayData(frame, sizeof(frame));
+}
+
+static void prepare_uart_ring_read(void)
+{
+    // Ring holds more than one read worth of data and the tail sits near the end, so each read wraps
+    s_uartHandle.rxRingBufferTail = BENCH_RING_SIZE - (BENCH_READ_SIZE / 2U);
+    s_uartHandle.rxRingBufferHead = BENCH_READ_SIZE;
+}
+
+static void bench_uart_ring_read(void)
+{
+    uart_transfer_t xfer = {s_readBuffer, BENCH_READ_SIZE};
+    size_t received;
+
+    UART_TransferReceiveNonBlocking(UART1, &s_uartHandle, &xfer, &received);
+}
+
+static uint8_t checksumSpan(const uint8_t *data, size_t length, uint8_t sum)
+{
+    while (length--) {
+        sum ^= *data++;
+    }
+    return sum;
+}
+
+static void bench_uart_ring_peek(void)
+{
+    uart_transfer_t spans[2];
+    size_t length = UART_TransferPeekRxRingBuffer(UART1, &s_uartHandle, spans);
+    uint8_t sum;
+
+    length = MIN(length, BENCH_READ_SIZE);
+    sum = checksumSpan(spans[0].data, MIN(length, spans[0].dataSize), 0U);
+    if (length > spans[0].dataSize) {
+        sum = checksumSpan(spans[1].data, length - spans[0].dataSize, sum);
+    }
+    s_checksum = sum;
+    UART_TransferCommitRxRingBuffer(UART1, &s_uartHandle, length);
+}
+
+static void prepare_uart_ring_write(void)
+{
+    // One received byte waiting, as the loopback leaves it on the target; S1 is read-only
+    *(volatile uint8_t *)&UART1->S1 = UART_S1_RDRF_MASK;
+    UART1->D = 0x5AU;
+}
+
+static void bench_uart_ring_write(void)
+{
+    UART_TransferHandleIRQ(UART1, &s_uartHandle);
+}
+
+static void prepare_lpsci_ring_read(void)
+{
+    s_lpsciHandle.rxRingBufferTail = BENCH_RING_SIZE - (BENCH_READ_SIZE / 2U);
+    s_lpsciHandle.rxRingBufferHead = BENCH_READ_SIZE;
+}
+
+static void bench_lpsci_ring_read(void)
+{
+    lpsci_transfer_t xfer = {s_readBuffer, BENCH_READ_SIZE};
+    size_t received;
+
+    LPSCI_TransferReceiveNonBlocking(UART0, &s_lpsciHandle, &xfer, &received);
+}
+
+static void bench_lpsci_ring_peek(void)
+{
+    lpsci_transfer_t spans[2];
+    size_t length = LPSCI_TransferPeekRxRingBuffer(UART0, &s_lpsciHandle, spans);
+    uint8_t sum;
+
+    length = MIN(length, BENCH_READ_SIZE);
+    sum = checksumSpan(spans[0].data, MIN(length, spans[0].dataSize), 0U);
+    if (length > spans[0].dataSize) {
+        sum = checksumSpan(spans[1].data, length - spans[0].dataSize, sum);
+    }
+    s_checksum = sum;
+    LPSCI_TransferCommitRxRingBuffer(UART0, &s_lpsciHandle, length);
+}
+
+static const bench_case_t s_cases[] = {
+    {"i2c_master_set_baud_rate", NULL, bench_i2c_master_set_baud_rate},
+    {"lpsci_set_baud_rate", NULL, bench_lpsci_set_baud_rate},
+    {"uart_ring_read_32", prepare_uart_ring_read, bench_uart_ring_read},
+    {"uart_ring_peek_32", prepare_uart_ring_read, bench_uart_ring_peek},
+    {"uart_ring_write_1", prepare_uart_ring_write, bench_uart_ring_write},
+    {"lpsci_ring_read_32", prepare_lpsci_ring_read, bench_lpsci_ring_read},
+    {"lpsci_ring_peek_32", prepare_lpsci_ring_read, bench_lpsci_ring_peek},
+    {"radix_dec_u32", NULL, bench_radix_dec_u32},
+    {"radix_dec_u32_ref", NULL, bench_radix_dec_u32_ref},
+    {"radix_hex_u32", NULL, bench_radix_hex_u32},
+    {"radix_hex_u32_ref", NULL, bench_radix_hex_u32_ref},
+#if HOST_FMT_ADVANCED
+    {"radix_dec_u64", NULL, bench_radix_dec_u64},
+    {"radix_dec_u64_ref", NULL, bench_radix_dec_u64_ref},
+#endif
+    {"fmt_packet_header", NULL, bench_fmt_packet_header},
+    {"fmt_packet_header_ref", NULL, bench_fmt_packet_header_ref},
+    {"fmt_raw_byte", NULL, bench_fmt_raw_byte},
+    {"fmt_raw_byte_ref", NULL, bench_fmt_raw_byte_ref},
+    {"fmt_led_state", NULL, bench_fmt_led_state},
+    {"fmt_led_state_ref", NULL, bench_fmt_led_state_ref},
+    {"fmt_ip_hex", NULL, bench_fmt_ip_hex},
+    {"fmt_ip_hex_ref", NULL, bench_fmt_ip_hex_ref},
+    {"display_ip_address", prepare_output, bench_display_ip_address},
+    {"display_ip_address_ref", prepare_output_ref, bench_display_ip_address},
+    {"parse_and_display_data", prepare_log_token, bench_parse_and_display_data},
+    {"parse_and_display_data_ref", prepare_log_token_ref, bench_parse_and_display_data},
+};
+
+static double charsPerSecond(uint64_t chars, uint64_t ns)
+{
+    return (ns != 0U) ? (double)chars * 1e9 / (double)ns : 0.0;
+}
+
+static uint64_t measureOnce(void (*run)(void))
+{
+    uint64_t start = nowNs();
+
+    run();
+    return nowNs() - start;
+}
+
+static void setUp(void)
+{
+    HostHw_Reset();
+
+    // The application prints through the SDK formatter into the console stand-in
+    HostApp_SetVerbose(false);
+    HostApp_SetOutput(consoleOutput);
+    AppLog_SetLevel(APP_LOG_MODULE_PACKET, APP_LOG_LEVEL_INFO);
+
+    // Handles are driven directly, as on the target
+    memset(&s_uartHandle, 0, sizeof(s_uartHandle));
+    s_uartHandle.rxRingBuffer = s_ringBuffer;
+    s_uartHandle.rxRingBufferSize = BENCH_RING_SIZE;
+    UART1->C2 |= UART_C2_RIE_MASK;
+
+    memset(&s_lpsciHandle, 0, sizeof(s_lpsciHandle));
+    s_lpsciHandle.rxRingBuffer = s_ringBuffer;
+    s_lpsciHandle.rxRingBufferSize = BENCH_RING_SIZE;
+}
+
+static void run(void)
+{
+    uint64_t overhead = UINT64_MAX;
+
+    setUp();
+    for (uint32_t i = 0; i < 1000U; i++) {
+        overhead = MIN(overhead, measureOnce(bench_empty));
+    }
+
+#if defined(__clang__)
+    printf("BENCH_HOST,clang %s\n", __clang_version__);
+#else
+    printf("BENCH_HOST,gcc %s\n", __VERSION__);
+#endif
+    printf("BENCH,name,iterations,min_ns,avg_ns,max_ns,out_bytes\n");
+
+    for (uint32_t n = 0; n < ARRAY_SIZE(s_cases); n++) {
+        const bench_case_t *bench = &s_cases[n];
+        uint64_t minNs = UINT64_MAX;
+        uint64_t maxNs = 0;
+        uint64_t totalNs = 0;
+
+        s_outBytes = 0;
+        for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+            uint64_t ns;
+
+            if (bench->prepare) {
+                bench->prepare();
+            }
+            ns = measureOnce(bench->run);
+            ns = (ns > overhead) ? (ns - overhead) : 0U;
+
+            totalNs += ns;
+            minNs = MIN(minNs, ns);
+            maxNs = MAX(maxNs, ns);
+        }
+
+        s_minNs[n] = minNs;
+        s_outChars[n] = s_outBytes / BENCH_ITERATIONS;
+        printf("BENCH,%s,%u,%llu,%llu,%llu,%llu\n", bench->name, BENCH_ITERATIONS, (unsigned long long)minNs,
+               (unsigned long long)(totalNs / BENCH_ITERATIONS), (unsigned long long)maxNs,
+               (unsigned long long)s_outChars[n]);
+    }
+
+    // Every *_ref case follows its counterpart
+    for (uint32_t n = 1; n < ARRAY_SIZE(s_cases); n++) {
+        size_t length = strlen(s_cases[n].name);
+
+        if ((length > 4U) && (strcmp(&s_cases[n].name[length - 4U], "_ref") == 0)) {
+            printf("RATE,%.*s,%.0f,%.0f,%.2f\n", (int)(length - 4U), s_cases[n].name,
+                   charsPerSecond(s_outChars[n], s_minNs[n]), charsPerSecond(s_outChars[n - 1U], s_minNs[n - 1U]),
+                   (double)s_minNs[n] / (double)MAX(s_minNs[n - 1U], 1U));
+        }
+    }
+}
+
+int main(void)
+{
+    return (HostHw_Run(run) == HOST_RUN_RETURNED) ? 0 : 1;
+}
@@ -0,0 +1,521 @@
+/*
+ * Coverage-guided fuzzer for the I2C slave receive chain
+ *
+ * Each input is a sequence of bus events played by the I2C bus model into the
+ * booted application: raw interrupts with any status flags, master writes and
+ * reads, main loop passes. The slave ISR (fsl_i2c.c, fsl_i2c_cmsis.c) and the
+ * application TU are built with -fsanitize-coverage=trace-pc; their basic block
+ * counts steer the search and are held to a budget per interrupt (one byte on
+ * the bus) and per main loop pass (one frame parsed and acted on).
+ *
+ * build/fuzz_i2c_slave [-runs=N] [-seed=N] [input files...]
+ *   Without files: fuzz for N inputs (default 20000) from the built-in seeds.
+ *   With files: run each one and print its costs.
+ * Exits non-zero if an input goes over budget or never finishes.
+ *
+ * LLVMFuzzerTestOneInput is the libFuzzer entry point, for a clang build with
+ * -fsanitize=fuzzer -DHOST_LIBFUZZER instead of the loop here.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include "app_log.h"
+#include "app_update.h"
+#include "host_hw.h"
+#include "host_flash.h"
+#include "host_i2c.h"
+#include "host_app.h"
+#include "host_cov.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+// Budgets in basic blocks, a few cycles each on the Cortex-M0+. A byte at 400 kHz
+// lasts about 1000 cycles at 48 MHz; a pass holds off the next receive, so it gets
+// about ten bytes' worth.
+#define IRQ_BLOCK_BUDGET    80U
+#define PASS_BLOCK_BUDGET   1500U
+
+// A run past this is a loop that does not end
+#define INPUT_BLOCK_LIMIT   2000000U
+
+#define INPUT_MAX           512U
+#define CORPUS_MAX          2048U
+#define EDGE_MAP_SIZE       65536U
+#define REPORT_MAX          5U
+
+// Input events, three bytes each: kind, a, b
+enum {
+    EVENT_RAW = 0,      // Interrupt with S = a (but ARBL), D = b, STARTF/STOPF from the kind byte
+    EVENT_WRITE,        // Master write of the next a bytes to the slave (b selects the address)
+    EVENT_READ,         // Master read of a % 8 + 1 bytes
+    EVENT_POLL,         // a % 8 + 1 main loop passes; b bit 0 lets 25 ms of bus silence pass first
+};
+
+typedef struct {
+    uint8_t data[INPUT_MAX];
+    uint32_t size;
+} fuzz_input_t;
+
+typedef struct {
+    uint32_t irqBlocks;         // Worst interrupt
+    uint32_t passBlocks;        // Worst main loop pass
+    uint32_t irqs;
+    uint32_t frames;
+    bool hung;
+} fuzz_cost_t;
+
+void I2C1_DriverIRQHandler(void);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static const uint8_t *s_input;
+static uint32_t s_inputSize;
+static fuzz_cost_t s_cost;
+
+static uint8_t s_edges[EDGE_MAP_SIZE];
+static uint8_t s_seenEdges[EDGE_MAP_SIZE];
+static uint32_t s_edgeCount;
+
+static fuzz_input_t s_corpus[CORPUS_MAX];
+static uint32_t s_corpusSize;
+
+static fuzz_cost_t s_worst;
+static uint32_t s_overBudget;
+
+static uint32_t s_random;
+static uint32_t s_reports;
+static int s_stdout = -1;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+// Application output would swamp the report and is not what is measured
+static void muteApp(bool mute)
+{
+    fflush(stdout);
+    if (mute) {
+        int null = open("/dev/null", O_WRONLY);
+
+        s_stdout = dup(STDOUT_FILENO);
+        dup2(null, STDOUT_FILENO);
+        close(null);
+    } else if (s_stdout >= 0) {
+        dup2(s_stdout, STDOUT_FILENO);
+        close(s_stdout);
+        s_stdout = -1;
+    }
+}
+
+// Not reached: every input boots from erased flash, and a COMMIT ends the input with its reset
+void AppUpdate_HostStartImage(uint32_t vectors)
+{
+    (void)vectors;
+    HostHw_Stop();
+}
+
+static void measuredIrq(void)
+{
+    uint64_t start = HostCov_Blocks();
+
+    I2C1_DriverIRQHandler();
+    s_cost.irqs++;
+    s_cost.irqBlocks = MAX(s_cost.irqBlocks, (uint32_t)(HostCov_Blocks() - start));
+}
+
+static void measuredPass(void)
+{
+    uint64_t start = HostCov_Blocks();
+    uint32_t packets = HostApp_GetPacketCount();
+
+    HostApp_Poll(1);
+    s_cost.frames += HostApp_GetPacketCount() - packets;
+    s_cost.passBlocks = MAX(s_cost.passBlocks, (uint32_t)(HostCov_Blocks() - start));
+}
+
+static void skipMs(uint32_t ms)
+{
+    extern void SysTick_Handler(void);
+
+    while (ms--) {
+        SysTick_Handler();
+    }
+}
+
+static uint8_t targetAddress(uint8_t select)
+{
+    if (select == 0U) {
+        return 0;   // General call
+    }
+    return (select & 0x80U) ? (select & 0x7FU) : HOST_APP_I2C_ADDRESS;
+}
+
+static void runInput(void)
+{
+    static uint8_t readBuffer[8];
+    uint32_t pos = 0;
+
+    HostApp_Boot();
+    HostI2c_Attach(I2C1, I2C1_IRQn, measuredIrq);
+    // Every log and packet dump is formatted, with a full rate limit bucket
+    for (uint32_t i = 0; i < APP_LOG_MODULE_COUNT; i++) {
+        AppLog_SetLevel((app_log_module_t)i, APP_LOG_LEVEL_DEBUG);
+    }
+    skipMs(3000);
+
+    HostCov_SetBlockLimit(INPUT_BLOCK_LIMIT);
+    while (pos + 3U <= s_inputSize) {
+        uint8_t kind = s_input[pos];
+        uint8_t a = s_input[pos + 1U];
+        uint8_t b = s_input[pos + 2U];
+        uint32_t length;
+
+        pos += 3U;
+        switch (kind & 3U) {
+        case EVENT_RAW:
+            // Arbitration is only lost by a master, the slave never sees ARBL
+            HostI2c_Raw(a & ~I2C_S_ARBL_MASK, kind & (I2C_FLT_STARTF_MASK | I2C_FLT_STOPF_MASK), b);
+            break;
+        case EVENT_WRITE:
+            length = MIN(a, s_inputSize - pos);
+            HostI2c_Write(targetAddress(b), &s_input[pos], length);
+            pos += length;
+            break;
+        case EVENT_READ:
+            HostI2c_Read(targetAddress(b | 1U), readBuffer, (a % sizeof(readBuffer)) + 1U);
+            break;
+        default:
+            if (b & 1U) {
+                skipMs(25);
+            }
+            for (uint32_t i = (a % 8U) + 1U; i > 0U; i--) {
+                measuredPass();
+            }
+            break;
+        }
+    }
+
+    // Whatever the input left waiting
+    for (uint32_t i = 0; i < 4U; i++) {
+        measuredPass();
+    }
+    HostCov_SetBlockLimit(0);
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    host_run_result_t result;
+
+    s_input = data;
+    s_inputSize = (uint32_t)size;
+    memset(&s_cost, 0, sizeof(s_cost));
+
+    HostFlash_Reset();
+    HostHw_Reset();
+    result = HostHw_Run(runInput);
+    HostCov_SetBlockLimit(0);
+
+    // An update COMMIT resets the part, that ends the input as well
+    s_cost.hung = (result == HOST_RUN_STOPPED);
+    return 0;
+}
+
+static bool overBudget(const fuzz_cost_t *cost)
+{
+    return cost->hung || (cost->irqBlocks > IRQ_BLOCK_BUDGET) || (cost->passBlocks > PASS_BLOCK_BUDGET);
+}
+
+static void printCost(FILE *out, const char *name, const fuzz_cost_t *cost)
+{
+    fprintf(out, "%s irq_blocks=%u pass_blocks=%u irqs=%u frames=%u%s\n", name, cost->irqBlocks,
+            cost->passBlocks, cost->irqs, cost->frames, cost->hung ? " hung" : "");
+}
+
+static void reportInput(const uint8_t *data, uint32_t size)
+{
+    if (s_reports++ >= REPORT_MAX) {
+        return;
+    }
+    printCost(stderr, "over budget:", &s_cost);
+    for (uint32_t i = 0; i < size; i++) {
+        fprintf(stderr, "%02x%s", data[i], ((i % 24U) == 23U) ? "\n" : "");
+    }
+    fprintf(stderr, "\n");
+}
+
+static uint32_t nextRandom(void)
+{
+    // xorshift32, the same sequence for the same -seed
+    s_random ^= s_random << 13;
+    s_random ^= s_random >> 17;
+    s_random ^= s_random << 5;
+    return s_random;
+}
+
+// Run one input with the edge map; true if it reached an edge no earlier input did
+static bool runWithCoverage(const uint8_t *data, uint32_t size)
+{
+    bool fresh = false;
+
+    memset(s_edges, 0, sizeof(s_edges));
+    HostCov_SetEdgeMap(s_edges, sizeof(s_edges));
+    LLVMFuzzerTestOneInput(data, size);
+    HostCov_SetEdgeMap(NULL, 0);
+
+    s_worst.irqBlocks = MAX(s_worst.irqBlocks, s_cost.irqBlocks);
+    s_worst.passBlocks = MAX(s_worst.passBlocks, s_cost.passBlocks);
+    if (overBudget(&s_cost)) {
+        s_overBudget++;
+        reportInput(data, size);
+    }
+
+    for (uint32_t i = 0; i < EDGE_MAP_SIZE; i++) {
+        if (s_edges[i] && !s_seenEdges[i]) {
+            s_seenEdges[i] = 1;
+            s_edgeCount++;
+            fresh = true;
+        }
+    }
+    return fresh;
+}
+
+static void addToCorpus(const uint8_t *data, uint32_t size)
+{
+    fuzz_input_t *entry;
+
+    if (s_corpusSize >= CORPUS_MAX) {
+        return;
+    }
+    entry = &s_corpus[s_corpusSize++];
+    memcpy(entry->data, data, size);
+    entry->size = size;
+}
+
+static void appendEvent(fuzz_input_t *input, uint8_t kind, uint8_t a, uint8_t b)
+{
+    if (input->size + 3U <= INPUT_MAX) {
+        input->data[input->size++] = kind;
+        input->data[input->size++] = a;
+        input->data[input->size++] = b;
+    }
+}
+
+static void appendWrite(fuzz_input_t *input, uint8_t select, const uint8_t *data, uint8_t length)
+{
+    appendEvent(input, EVENT_WRITE, length, select);
+    if (input->size + length <= INPUT_MAX) {
+        memcpy(&input->data[input->size], data, length);
+        input->size += length;
+    }
+}
+
+// Traffic the slave sees in the field, the fuzzer works outwards from it
+static void addSeeds(void)
+{
+    static const uint8_t ledFrame[] = {1, 0, '1', '9', '2', '.', '1', '6', '8', '.', '0', '.', '2', '5', '5', 0, 0, 0};
+    static const uint8_t oddFrame[] = {7, 1, '9', '9', '9', '9', '.', 0xC3, 0xA9, ' ', '1', '.', '2', '.', 0xFF};
+    static const uint8_t begin[] = {APP_UPDATE_MAGIC0, APP_UPDATE_MAGIC1, APP_UPDATE_CMD_BEGIN,
+                                    0x00, 0x01, 0x00, 0x00, 0x78, 0x56, 0x34, 0x12};
+    static uint8_t longFrame[200];
+    fuzz_input_t seed;
+
+    memset(longFrame, '7', sizeof(longFrame));
+
+    memset(&seed, 0, sizeof(seed));
+    appendWrite(&seed, 1, ledFrame, sizeof(ledFrame));
+    appendEvent(&seed, EVENT_POLL, 3, 1);
+    runWithCoverage(seed.data, seed.size);
+    addToCorpus(seed.data, seed.size);
+
+    // Oversized write, cut short by NAKs, then odd IP bytes
+    memset(&seed, 0, sizeof(seed));
+    appendWrite(&seed, 1, longFrame, sizeof(longFrame));
+    appendEvent(&seed, EVENT_POLL, 2, 0);
+    appendWrite(&seed, 1, oddFrame, sizeof(oddFrame));
+    appendEvent(&seed, EVENT_POLL, 2, 1);
+    runWithCoverage(seed.data, seed.size);
+    addToCorpus(seed.data, seed.size);
+
+    // Repeated start part way through a write, then a read and a general call
+    memset(&seed, 0, sizeof(seed));
+    appendEvent(&seed, EVENT_RAW | I2C_FLT_STARTF_MASK, 0, 0);
+    appendEvent(&seed, EVENT_RAW, I2C_S_IAAS_MASK | I2C_S_TCF_MASK, HOST_APP_I2C_ADDRESS << 1U);
+    appendEvent(&seed, EVENT_RAW, I2C_S_TCF_MASK, 1);
+    appendEvent(&seed, EVENT_RAW | I2C_FLT_STARTF_MASK, 0, 0);
+    appendEvent(&seed, EVENT_RAW, I2C_S_IAAS_MASK | I2C_S_TCF_MASK | I2C_S_SRW_MASK, (HOST_APP_I2C_ADDRESS << 1U) | 1U);
+    appendEvent(&seed, EVENT_RAW, I2C_S_TCF_MASK | I2C_S_SRW_MASK | I2C_S_RXAK_MASK, 0);
+    appendEvent(&seed, EVENT_RAW | I2C_FLT_STOPF_MASK, 0, 0);
+    appendEvent(&seed, EVENT_READ, 3, 1);
+    appendWrite(&seed, 0, ledFrame, 2);
+    appendEvent(&seed, EVENT_POLL, 4, 1);
+    runWithCoverage(seed.data, seed.size);
+    addToCorpus(seed.data, seed.size);
+
+    // Start of an update
+    memset(&seed, 0, sizeof(seed));
+    appendWrite(&seed, 1, begin, sizeof(begin));
+    appendEvent(&seed, EVENT_POLL, 2, 0);
+    runWithCoverage(seed.data, seed.size);
+    addToCorpus(seed.data, seed.size);
+}
+
+static uint32_t mutate(uint8_t *data, uint32_t size)
+{
+    static const uint8_t interesting[] = {0x00, 0x01, 0x02, 0x7F, 0x80, 0xFF, '.', '0', '9', ' ',
+                                          HOST_APP_I2C_ADDRESS << 1U, APP_UPDATE_MAGIC0,
+                                          APP_UPDATE_MAGIC1, APP_UPDATE_CMD_BEGIN,
+                                          APP_UPDATE_CMD_DATA, APP_UPDATE_CMD_COMMIT, APP_UPDATE_CMD_ABORT,
+                                          I2C_S_IAAS_MASK | I2C_S_TCF_MASK, I2C_S_TCF_MASK | I2C_S_SRW_MASK,
+                                          I2C_S_RXAK_MASK, EVENT_RAW | I2C_FLT_STARTF_MASK,
+                                          EVENT_RAW | I2C_FLT_STOPF_MASK};
+    uint32_t steps = 1U + (nextRandom() % 4U);
+
+    while (steps--) {
+        uint32_t at = (size != 0U) ? nextRandom() % size : 0U;
+        const fuzz_input_t *other;
+        uint32_t length;
+
+        switch (nextRandom() % 7U) {
+        case 0:
+            if (size != 0U) {
+                data[at] ^= (uint8_t)(1U << (nextRandom() % 8U));
+            }
+            break;
+        case 1:
+            if (size != 0U) {
+                data[at] = (uint8_t)nextRandom();
+            }
+            break;
+        case 2:
+            if (size != 0U) {
+                data[at] = interesting[nextRandom() % sizeof(interesting)];
+            }
+            break;
+        case 3:
+            // Insert one event
+            if (size + 3U <= INPUT_MAX) {
+                memmove(&data[at + 3U], &data[at], size - at);
+                data[at] = (uint8_t)nextRandom();
+                data[at + 1U] = (uint8_t)nextRandom();
+                data[at + 2U] = (uint8_t)nextRandom();
+                size += 3U;
+            }
+            break;
+        case 4:
+            // Delete a few bytes
+            length = 1U + (nextRandom() % 6U);
+            length = MIN(size - at, length);
+            memmove(&data[at], &data[at + length], size - at - length);
+            size -= length;
+            break;
+        case 5:
+            // Repeat a stretch
+            length = 1U + (nextRandom() % 24U);
+            length = MIN(size - at, length);
+            length = MIN(length, INPUT_MAX - size);
+            memmove(&data[at + length], &data[at], size - at);
+            size += length;
+            break;
+        default:
+            // Splice the tail of another input in
+            other = &s_corpus[nextRandom() % s_corpusSize];
+            if (other->size != 0U) {
+                uint32_t from = nextRandom() % other->size;
+
+                length = MIN(other->size - from, INPUT_MAX - at);
+                memcpy(&data[at], &other->data[from], length);
+                size = MAX(size, at + length);
+            }
+            break;
+        }
+    }
+    return size;
+}
+
+static bool readFile(const char *path, fuzz_input_t *input)
+{
+    FILE *file = fopen(path, "rb");
+
+    if (file == NULL) {
+        return false;
+    }
+    input->size = (uint32_t)fread(input->data, 1, INPUT_MAX, file);
+    fclose(file);
+    return true;
+}
+
+#ifndef HOST_LIBFUZZER
+int main(int argc, char **argv)
+{
+    uint32_t runs = 20000;
+    uint32_t overBudgetCount = 0;
+    fuzz_input_t input;
+    int files = 0;
+
+    s_random = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "-runs=", 6) == 0) {
+            runs = (uint32_t)strtoul(&argv[i][6], NULL, 0);
+        } else if (strncmp(argv[i], "-seed=", 6) == 0) {
+            s_random = (uint32_t)strtoul(&argv[i][6], NULL, 0) | 1U;
+        } else {
+            files++;
+        }
+    }
+
+    printf("fuzz_i2c_slave\n");
+    muteApp(true);
+
+    if (files != 0) {
+        for (int i = 1; i < argc; i++) {
+            if (argv[i][0] == '-') {
+                continue;
+            }
+            if (!readFile(argv[i], &input)) {
+                muteApp(false);
+                fprintf(stderr, "cannot read %s\n", argv[i]);
+                return 2;
+            }
+            LLVMFuzzerTestOneInput(input.data, input.size);
+            fflush(stdout);
+            printCost(stderr, argv[i], &s_cost);
+            overBudgetCount += overBudget(&s_cost);
+        }
+        muteApp(false);
+        return overBudgetCount ? 1 : 0;
+    }
+
+    addSeeds();
+    for (uint32_t run = 0; run < runs; run++) {
+        const fuzz_input_t *parent = &s_corpus[nextRandom() % s_corpusSize];
+
+        memcpy(input.data, parent->data, parent->size);
+        input.size = mutate(input.data, parent->size);
+
+        if (runWithCoverage(input.data, input.size)) {
+            addToCorpus(input.data, input.size);
+        }
+    }
+    muteApp(false);
+
+    // One line of key=value pairs for scripts
+    printf("  runs=%u corpus=%u edges=%u worst_irq_blocks=%u irq_budget=%u worst_pass_blocks=%u "
+           "pass_budget=%u over_budget=%u\n",
+           runs, s_corpusSize, s_edgeCount, s_worst.irqBlocks, IRQ_BLOCK_BUDGET, s_worst.passBlocks,
+           PASS_BLOCK_BUDGET, s_overBudget);
+    if (s_overBudget) {
+        printf("FAILED: %u inputs over budget\n", s_overBudget);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
+#endif /* HOST_LIBFUZZER */
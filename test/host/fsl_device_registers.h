@@ -0,0 +1,65 @@
+/*
+ * Host build of the device header: the firmware sources compiled for Linux
+ * Register blocks are plain memory mapped at their device addresses by host_hw.c,
+ * the core intrinsics below stand in for cmsis_gcc.h.
+ */
+
+#ifndef __FSL_DEVICE_REGISTERS_H__
+#define __FSL_DEVICE_REGISTERS_H__
+
+#include <stdint.h>
+
+#define KL26Z4_SERIES
+
+// Skip cmsis_gcc.h, its intrinsics are ARM instructions
+#define __CMSIS_GCC_H
+
+#define __ASM               __asm
+#define __STATIC_INLINE     static inline
+
+// PRIMASK, the reset request and WFI are modelled by host_hw.c
+void __enable_irq(void);
+void __disable_irq(void);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t priMask);
+void __set_MSP(uint32_t topOfMainStack);
+void __DSB(void);
+void __WFI(void);
+
+static inline void __NOP(void)
+{
+}
+
+static inline void __ISB(void)
+{
+}
+
+static inline void __DMB(void)
+{
+}
+
+#define __BKPT(value)       __builtin_trap()
+
+#include "MKL26Z4.h"
+#include "MKL26Z4_features.h"
+
+// The NVIC sets and clears its enable and pending bits through separate registers,
+// host_hw.c keeps them in ISER and ISPR, where the interrupt models look
+void HostHw_NvicEnableIRQ(IRQn_Type IRQn);
+void HostHw_NvicDisableIRQ(IRQn_Type IRQn);
+uint32_t HostHw_NvicGetPendingIRQ(IRQn_Type IRQn);
+void HostHw_NvicSetPendingIRQ(IRQn_Type IRQn);
+void HostHw_NvicClearPendingIRQ(IRQn_Type IRQn);
+
+#define NVIC_EnableIRQ          HostHw_NvicEnableIRQ
+#define NVIC_DisableIRQ         HostHw_NvicDisableIRQ
+#define NVIC_GetPendingIRQ      HostHw_NvicGetPendingIRQ
+#define NVIC_SetPendingIRQ      HostHw_NvicSetPendingIRQ
+#define NVIC_ClearPendingIRQ    HostHw_NvicClearPendingIRQ
+
+// Program flash lives at HOST_FLASH_BASE on the host, address 0 cannot be mapped
+#define HOST_FLASH_BASE     0x10000000U
+#undef FSL_FEATURE_FLASH_PFLASH_START_ADDRESS
+#define FSL_FEATURE_FLASH_PFLASH_START_ADDRESS HOST_FLASH_BASE
+
+#endif /* __FSL_DEVICE_REGISTERS_H__ */
@@ -0,0 +1,153 @@
+/*
+ * The application TU (source/cmsis_i2c_interrupt_transfer.c) built for the host
+ * Boots like main without the board bring-up, then runs main loop passes on demand.
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+
+#include "host_app.h"
+#include "host_hw.h"
+#include "host_i2c.h"
+#include "host_spi.h"
+#include "host_dma.h"
+
+// Vectors of I2C1 in fsl_i2c.c and SPI0 in fsl_spi.c
+void I2C1_DriverIRQHandler(void);
+void SPI0_DriverIRQHandler(void);
+
+static bool s_verbose;
+static host_app_output_t s_output;
+
+// The application prints its banners and packet dumps with printf
+static int hostAppPrintf(const char *format, ...)
+{
+    va_list ap;
+    int written = 0;
+
+    if (s_output || s_verbose) {
+        va_start(ap, format);
+        written = s_output ? s_output(format, ap) : vprintf(format, ap);
+        va_end(ap);
+    }
+    return written;
+}
+
+#define printf hostAppPrintf
+#define main   HostApp_FirmwareMain
+#include "cmsis_i2c_interrupt_transfer.c"
+#undef main
+#undef printf
+
+/* See host_app.h for documentation of this function. */
+void HostApp_SetVerbose(bool verbose)
+{
+    s_verbose = verbose;
+    for (uint32_t i = 0; i < APP_LOG_MODULE_COUNT; i++) {
+        AppLog_SetLevel((app_log_module_t)i, verbose ? APP_LOG_DEFAULT_LEVEL : APP_LOG_LEVEL_NONE);
+    }
+}
+
+/* See host_app.h for documentation of this function. */
+void HostApp_SetOutput(host_app_output_t output)
+{
+    s_output = output;
+}
+
+/* See host_app.h for documentation of this function. */
+void HostApp_Boot(void)
+{
+    status_t storeStatus;
+
+    // Zeroed or loaded by the startup code on the target
+    packetCounter = APP_PACKET_COUNTER_START;
+    i2cTimeouts = 0;
+    i2cBusErrors = 0;
+    i2cIncomplete = 0;
+    i2cLastActivityMs = 0;
+    currentLED1State = 0;
+    currentLED2State = 0;
+#if APP_SPI_LINK_ENABLE
+    spiFrames = 0;
+    spiResyncs = 0;
+#endif
+    HostApp_SetVerbose(s_verbose);
+
+#if APP_SPI_LINK_ENABLE
+    // SPI driver state from before the reset, zeroed with the rest on the target; the
+    // I2C slave handle is created afresh by every receive
+    SPIdrv->PowerControl(ARM_POWER_OFF);
+    SPIdrv->Uninitialize();
+#endif
+    HostI2c_Attach(I2C1, I2C1_IRQn, I2C1_DriverIRQHandler);
+#if APP_SPI_LINK_ENABLE
+    HostDma_Reset();
+    HostSpi_Attach(SPI0, SPI0_IRQn, SPI0_DriverIRQHandler, kDmaRequestMux0SPI0Rx, kDmaRequestMux0SPI0Tx);
+#endif
+
+    // The steps of main, in its order
+    storeStatus = AppStore_Init();
+#if APP_UPDATE_ENABLE
+    AppUpdate_BootSelect();
+#endif
+    AppTime_Init();
+    initializeLEDs();
+    restoreNodeState(storeStatus);
+    if (startLinks() != ARM_DRIVER_OK) {
+        HostHw_Stop();
+    }
+#if APP_SHELL_ENABLE
+    AppShell_Init(shellCommands, ARRAY_SIZE(shellCommands));
+#endif
+    startFrameReceive();
+#if APP_SPI_LINK_ENABLE
+    startSpiFrameReceive();
+#endif
+}
+
+/* See host_app.h for documentation of this function. */
+void HostApp_Poll(uint32_t passes)
+{
+    while (passes--) {
+        pollMainLoop();
+    }
+}
+
+/* See host_app.h for documentation of this function. */
+void HostApp_ParseFrame(uint8_t *buffer, uint32_t length)
+{
+    parseAndDisplayData(buffer, length);
+}
+
+/* See host_app.h for documentation of this function. */
+uint32_t HostApp_GetPacketCount(void)
+{
+    return packetCounter;
+}
+
+/* See host_app.h for documentation of this function. */
+void HostApp_GetLeds(uint8_t *led1, uint8_t *led2)
+{
+    *led1 = currentLED1State;
+    *led2 = currentLED2State;
+}
+
+/* See host_app.h for documentation of this function. */
+void HostApp_GetI2cCounts(uint32_t *timeouts, uint32_t *busErrors, uint32_t *incomplete)
+{
+    *timeouts = i2cTimeouts;
+    *busErrors = i2cBusErrors;
+    *incomplete = i2cIncomplete;
+}
+
+/* See host_app.h for documentation of this function. */
+void HostApp_GetSpiCounts(uint32_t *frames, uint32_t *resyncs)
+{
+#if APP_SPI_LINK_ENABLE
+    *frames = spiFrames;
+    *resyncs = spiResyncs;
+#else
+    *frames = 0;
+    *resyncs = 0;
+#endif
+}
@@ -0,0 +1,76 @@
+/*
+ * The application TU (source/cmsis_i2c_interrupt_transfer.c) built for the host
+ * Boots like main without the board bring-up, then runs main loop passes on demand.
+ */
+
+#ifndef _HOST_APP_H_
+#define _HOST_APP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+// Slave address of the application
+#define HOST_APP_I2C_ADDRESS    0x55U
+
+// Takes the application's printf calls, vprintf-like
+typedef int (*host_app_output_t)(const char *format, va_list ap);
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief Run main up to its loop: store, boot select, LEDs, links, first receive
+ *
+ * Pins, clocks and the debug console are left out, BOARD_BootClockRUN waits on
+ * oscillator status bits no model sets. The application's statics are set back to
+ * their reset values first. Attaches the I2C bus model (host_i2c.h) to I2C1, and
+ * with the SPI link the SPI bus model (host_spi.h) to SPI0.
+ * Stops the run (HostHw_Stop) if a link cannot be started.
+ */
+void HostApp_Boot(void);
+
+/*!
+ * @brief Run passes of the main loop
+ */
+void HostApp_Poll(uint32_t passes);
+
+/*!
+ * @brief Show the application's printf and log output (default off)
+ */
+void HostApp_SetVerbose(bool verbose);
+
+/*!
+ * @brief Send the application's printf output to output instead (NULL: back to SetVerbose)
+ *
+ * The log levels are left alone, AppLog_SetLevel picks what the application prints.
+ */
+void HostApp_SetOutput(host_app_output_t output);
+
+/*!
+ * @brief The packet parser of the application, for the fuzz harness
+ */
+void HostApp_ParseFrame(uint8_t *buffer, uint32_t length);
+
+/*!
+ * @brief Frames parsed since boot, and the LED states driven
+ */
+uint32_t HostApp_GetPacketCount(void);
+void HostApp_GetLeds(uint8_t *led1, uint8_t *led2);
+
+/*!
+ * @brief I2C slave counters since boot: receives timed out, bus errors, short frames
+ */
+void HostApp_GetI2cCounts(uint32_t *timeouts, uint32_t *busErrors, uint32_t *incomplete);
+
+/*!
+ * @brief SPI link counters since boot: frames handled, stalled frames dropped
+ */
+void HostApp_GetSpiCounts(uint32_t *frames, uint32_t *resyncs);
+
+#endif /* _HOST_APP_H_ */
@@ -0,0 +1,49 @@
+/*
+ * Minimal checks for the host tests: report every failed check, exit non-zero
+ */
+
+#ifndef _HOST_CHECK_H_
+#define _HOST_CHECK_H_
+
+#include <stdio.h>
+
+extern int g_hostCheckFailures;
+
+#define CHECK(cond)                                                                  \
+    do {                                                                             \
+        if (!(cond)) {                                                               \
+            g_hostCheckFailures++;                                                   \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+        }                                                                            \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                        \
+    do {                                                                                  \
+        long long _a = (long long)(actual);                                               \
+        long long _e = (long long)(expected);                                             \
+        if (_a != _e) {                                                                   \
+            g_hostCheckFailures++;                                                        \
+            fprintf(stderr, "%s:%d: CHECK_EQ failed: %s is %lld, expected %lld\n", __FILE__, \
+                    __LINE__, #actual, _a, _e);                                           \
+        }                                                                                 \
+    } while (0)
+
+// Run one test function and print its name
+#define RUN_TEST(fn)                  \
+    do {                              \
+        printf("  %s\n", #fn);        \
+        fn();                         \
+    } while (0)
+
+// Exit status of a test program
+static inline int HostCheck_Result(void)
+{
+    if (g_hostCheckFailures) {
+        printf("FAILED: %d checks\n", g_hostCheckFailures);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
+
+#endif /* _HOST_CHECK_H_ */
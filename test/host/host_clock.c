@@ -0,0 +1,130 @@
+/*
+ * Discrete-event virtual clock for the host tests
+ * Time is a microsecond count that moves only when a test says the CPU was busy or
+ * the firmware sleeps: a WFI fast-forwards to the next scheduled event, so idle
+ * loops and AppTime waits cost nothing to run. The 1 ms SysTick of app_time.c is
+ * one of the events; peripheral models and tests schedule their own. Events are
+ * interrupts: one that falls due while PRIMASK is set runs once it is cleared.
+ */
+
+#include <stddef.h>
+
+#include "host_clock.h"
+#include "host_hw.h"
+
+void SysTick_Handler(void);
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define TICK_US     1000U
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static uint64_t s_nowUs;
+static host_event_t *s_queue;       // By due time, first come first served on a tie
+static host_event_t s_tick;
+static bool s_running;              // An event runs, those it makes due wait for it
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+// Due again at the next millisecond: ticks missed while masked are not made up
+static void tick(host_event_t *event)
+{
+    SysTick_Handler();
+    HostClock_Schedule(event, (s_nowUs / TICK_US + 1U) * TICK_US);
+}
+
+/* See host_clock.h for documentation of this function. */
+void HostClock_Reset(void)
+{
+    s_nowUs = 0;
+    s_queue = NULL;
+    s_running = false;
+    s_tick.fn = tick;
+    s_tick.queued = false;
+    HostClock_Schedule(&s_tick, TICK_US);
+    HostHw_SetWfiHook(HostClock_Sleep);
+    HostHw_SetUnmaskHook(HostClock_RunDue);
+}
+
+/* See host_clock.h for documentation of this function. */
+uint64_t HostClock_Now(void)
+{
+    return s_nowUs;
+}
+
+/* See host_clock.h for documentation of this function. */
+void HostClock_Cancel(host_event_t *event)
+{
+    host_event_t **link = &s_queue;
+
+    if (!event->queued) {
+        return;
+    }
+    while (*link != event) {
+        link = &(*link)->next;
+    }
+    *link = event->next;
+    event->queued = false;
+}
+
+/* See host_clock.h for documentation of this function. */
+void HostClock_Schedule(host_event_t *event, uint64_t atUs)
+{
+    host_event_t **link = &s_queue;
+
+    HostClock_Cancel(event);
+    while ((*link != NULL) && ((*link)->atUs <= atUs)) {
+        link = &(*link)->next;
+    }
+    event->atUs = atUs;
+    event->next = *link;
+    event->queued = true;
+    *link = event;
+}
+
+/* See host_clock.h for documentation of this function. */
+void HostClock_RunDue(void)
+{
+    if (s_running || HostHw_IrqMasked()) {
+        return;
+    }
+    s_running = true;
+    while ((s_queue != NULL) && (s_queue->atUs <= s_nowUs) && !HostHw_IrqMasked()) {
+        host_event_t *event = s_queue;
+
+        s_queue = event->next;
+        event->queued = false;
+        event->fn(event);
+    }
+    s_running = false;
+}
+
+/* See host_clock.h for documentation of this function. */
+void HostClock_Advance(uint64_t us)
+{
+    uint64_t end = s_nowUs + us;
+
+    while (!HostHw_IrqMasked() && !s_running && (s_queue != NULL) && (s_queue->atUs <= end)) {
+        if (s_queue->atUs > s_nowUs) {
+            s_nowUs = s_queue->atUs;
+        }
+        HostClock_RunDue();
+    }
+    s_nowUs = end;
+}
+
+/* See host_clock.h for documentation of this function. */
+void HostClock_Sleep(void)
+{
+    if ((s_queue != NULL) && (s_queue->atUs > s_nowUs)) {
+        s_nowUs = s_queue->atUs;
+    }
+    HostClock_RunDue();
+}
@@ -0,0 +1,79 @@
+/*
+ * Discrete-event virtual clock for the host tests
+ * Time is a microsecond count that moves only when a test says the CPU was busy or
+ * the firmware sleeps: a WFI fast-forwards to the next scheduled event, so idle
+ * loops and AppTime waits cost nothing to run. The 1 ms SysTick of app_time.c is
+ * one of the events; peripheral models and tests schedule their own. Events are
+ * interrupts: one that falls due while PRIMASK is set runs once it is cleared.
+ */
+
+#ifndef _HOST_CLOCK_H_
+#define _HOST_CLOCK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+typedef struct host_event host_event_t;
+
+// Runs at the time the event was due, or late if interrupts were masked then
+typedef void (*host_event_fn_t)(host_event_t *event);
+
+struct host_event {
+    host_event_fn_t fn;         // Set by the owner before scheduling
+    void *context;              // Free for the owner
+    uint64_t atUs;              // Time it is due, while queued
+    bool queued;
+    host_event_t *next;
+};
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief Time 0, nothing scheduled but the SysTick
+ *
+ * Takes the WFI and unmask hooks of host_hw.h. A tick lost to a masked stretch
+ * longer than 1 ms stays lost, as a second pending SysTick is on the target.
+ */
+void HostClock_Reset(void);
+
+/*!
+ * @brief Current time in microseconds
+ */
+uint64_t HostClock_Now(void);
+
+/*!
+ * @brief Queue event for atUs, moving it if queued already; a past time runs it next
+ */
+void HostClock_Schedule(host_event_t *event, uint64_t atUs);
+
+/*!
+ * @brief Take event off the queue, if queued
+ */
+void HostClock_Cancel(host_event_t *event);
+
+/*!
+ * @brief The CPU is busy for us: events falling due meanwhile run at their time
+ *
+ * With interrupts masked they run once PRIMASK is cleared instead, late.
+ */
+void HostClock_Advance(uint64_t us);
+
+/*!
+ * @brief Sleep until the next event and run it, as a WFI with nothing pending does
+ *
+ * The WFI hook; masked, the event runs once PRIMASK is cleared.
+ */
+void HostClock_Sleep(void);
+
+/*!
+ * @brief Run every event due by now, unless interrupts are masked
+ */
+void HostClock_RunDue(void);
+
+#endif /* _HOST_CLOCK_H_ */
@@ -0,0 +1,61 @@
+/*
+ * Basic block counts of the code built with -fsanitize-coverage=trace-pc
+ * The fuzz harnesses take them as the branch count of a call and as coverage.
+ */
+
+#include "host_cov.h"
+#include "host_hw.h"
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static uint64_t s_blocks;
+static uint64_t s_stopAt;
+static uint8_t *s_map;
+static size_t s_mapMask;
+static uintptr_t s_previous;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+// Called by the compiler at the start of every instrumented basic block
+void __sanitizer_cov_trace_pc(void)
+{
+    s_blocks++;
+
+    if (s_map != NULL) {
+        uintptr_t block = (uintptr_t)__builtin_return_address(0);
+
+        block = (block ^ (block >> 12)) * 0x9E3779B1U;
+        s_map[(block ^ s_previous) & s_mapMask]++;
+        // Shifted so that A->B and B->A are different edges
+        s_previous = block >> 1;
+    }
+
+    if ((s_stopAt != 0U) && (s_blocks > s_stopAt)) {
+        s_stopAt = 0;
+        HostHw_Stop();
+    }
+}
+
+/* See host_cov.h for documentation of this function. */
+uint64_t HostCov_Blocks(void)
+{
+    return s_blocks;
+}
+
+/* See host_cov.h for documentation of this function. */
+void HostCov_SetEdgeMap(uint8_t *map, size_t size)
+{
+    s_map = map;
+    s_mapMask = size - 1U;
+    s_previous = 0;
+}
+
+/* See host_cov.h for documentation of this function. */
+void HostCov_SetBlockLimit(uint64_t limit)
+{
+    s_stopAt = (limit != 0U) ? s_blocks + limit : 0U;
+}
@@ -0,0 +1,35 @@
+/*
+ * Basic block counts of the code built with -fsanitize-coverage=trace-pc
+ * The fuzz harnesses take them as the branch count of a call and as coverage.
+ */
+
+#ifndef _HOST_COV_H_
+#define _HOST_COV_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief Basic blocks entered in the instrumented code so far
+ */
+uint64_t HostCov_Blocks(void);
+
+/*!
+ * @brief Count edges (pairs of consecutive blocks) into map, size a power of two
+ *
+ * NULL stops the counting.
+ */
+void HostCov_SetEdgeMap(uint8_t *map, size_t size);
+
+/*!
+ * @brief Stop the run (HostHw_Stop) once more than limit further blocks are entered
+ *
+ * Catches loops that never end; 0 disarms.
+ */
+void HostCov_SetBlockLimit(uint64_t limit);
+
+#endif /* _HOST_COV_H_ */
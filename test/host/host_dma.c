@@ -0,0 +1,216 @@
+/*
+ * Host model of the DMA0 controller and its DMAMUX
+ * A request moves data on the channels the DMAMUX routes its source to, a finished
+ * block sets DONE and raises the channel interrupt, delivered while it is enabled
+ * in the NVIC and unmasked.
+ */
+
+#include <string.h>
+
+#include "host_dma.h"
+#include "host_hw.h"
+
+// Channel vectors in fsl_dma.c
+void DMA0_DriverIRQHandler(void);
+void DMA1_DriverIRQHandler(void);
+void DMA2_DriverIRQHandler(void);
+void DMA3_DriverIRQHandler(void);
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define CHANNELS            FSL_FEATURE_DMA_MODULE_CHANNEL
+
+// DCR bit 24 is reserved; set by the model on every move, cleared by a DCR write
+#define MOVED_TAG           (1UL << 24U)
+
+// DMAMUX sources that request all the time
+#define ALWAYS_ON_FIRST     ((uint32_t)kDmaRequestMux0AlwaysOn60 & DMAMUX_CHCFG_SOURCE_MASK)
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static void (*const s_handlers[CHANNELS])(void) = {
+    DMA0_DriverIRQHandler, DMA1_DriverIRQHandler, DMA2_DriverIRQHandler, DMA3_DriverIRQHandler,
+};
+
+static host_dma_stats_t s_stats;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+// SSIZE and DSIZE encode 32, 8 and 16 bits; 3 is reserved
+static uint32_t unitBytes(uint32_t size)
+{
+    static const uint32_t bytes[] = {4U, 1U, 2U, 0U};
+
+    return bytes[size & 3U];
+}
+
+// SMOD and DMOD keep the address inside an aligned circular buffer of 16 << (mod - 1) bytes
+static uint32_t advance(uint32_t address, uint32_t unit, uint32_t mod)
+{
+    uint32_t size;
+
+    if (mod == 0U) {
+        return address + unit;
+    }
+    size = 16UL << (mod - 1U);
+    return (address & ~(size - 1U)) | ((address + unit) & (size - 1U));
+}
+
+/*!
+ * @brief Deliver the channel interrupt if pending, enabled and unmasked
+ *
+ * DMA_HandleIRQ clears DONE by writing it back, which plain memory keeps set, so it
+ * is cleared here once the handler has run. A handler that loaded the next block
+ * has written DSR_BCR and cleared it already.
+ */
+static void deliver(uint32_t channel)
+{
+    uint32_t bit = 1UL << (uint32_t)(DMA0_IRQn + channel);
+
+    if (!(NVIC->ISPR[0] & bit) || !(NVIC->ISER[0] & bit) || HostHw_IrqMasked()) {
+        return;
+    }
+    NVIC->ISPR[0] &= ~bit;
+    s_stats.irqs++;
+    s_handlers[channel]();
+    DMA0->DMA[channel].DSR_BCR &= ~DMA_DSR_BCR_DONE_MASK;
+}
+
+/*!
+ * @brief One move on channel, or the rest of its block without cycle steal
+ *
+ * @return true if data moved
+ */
+static bool move(uint32_t channel)
+{
+    volatile uint32_t *dcr = &DMA0->DMA[channel].DCR;
+    uint32_t sUnit = unitBytes((*dcr & DMA_DCR_SSIZE_MASK) >> DMA_DCR_SSIZE_SHIFT);
+    uint32_t dUnit = unitBytes((*dcr & DMA_DCR_DSIZE_MASK) >> DMA_DCR_DSIZE_SHIFT);
+    bool moved = false;
+
+    if (!(*dcr & DMA_DCR_ERQ_MASK) && !(*dcr & DMA_DCR_START_MASK)) {
+        return false;
+    }
+    if ((sUnit == 0U) || (sUnit != dUnit)) {
+        DMA0->DMA[channel].DSR_BCR |= DMA_DSR_BCR_CE_MASK | DMA_DSR_BCR_DONE_MASK;
+        s_stats.configErrors++;
+        return false;
+    }
+    *dcr &= ~DMA_DCR_START_MASK;
+
+    do {
+        uint32_t bcr = DMA0->DMA[channel].DSR_BCR & DMA_DSR_BCR_BCR_MASK;
+        uint32_t sar = DMA0->DMA[channel].SAR;
+        uint32_t dar = DMA0->DMA[channel].DAR;
+
+        if (bcr < sUnit) {
+            break;
+        }
+        memcpy((void *)(uintptr_t)dar, (const void *)(uintptr_t)sar, sUnit);
+        if (*dcr & DMA_DCR_SINC_MASK) {
+            DMA0->DMA[channel].SAR = advance(sar, sUnit, (*dcr & DMA_DCR_SMOD_MASK) >> DMA_DCR_SMOD_SHIFT);
+        }
+        if (*dcr & DMA_DCR_DINC_MASK) {
+            DMA0->DMA[channel].DAR = advance(dar, sUnit, (*dcr & DMA_DCR_DMOD_MASK) >> DMA_DCR_DMOD_SHIFT);
+        }
+        bcr -= sUnit;
+        DMA0->DMA[channel].DSR_BCR = (DMA0->DMA[channel].DSR_BCR & ~DMA_DSR_BCR_BCR_MASK) | bcr;
+        s_stats.moves++;
+        moved = true;
+
+        if (bcr == 0U) {
+            s_stats.completions++;
+            DMA0->DMA[channel].DSR_BCR |= DMA_DSR_BCR_DONE_MASK;
+            if (*dcr & DMA_DCR_D_REQ_MASK) {
+                *dcr &= ~DMA_DCR_ERQ_MASK;
+            }
+            *dcr |= MOVED_TAG;
+            if (*dcr & DMA_DCR_EINT_MASK) {
+                NVIC->ISPR[0] |= 1UL << (uint32_t)(DMA0_IRQn + channel);
+                deliver(channel);
+                if (NVIC->ISPR[0] & (1UL << (uint32_t)(DMA0_IRQn + channel))) {
+                    s_stats.stalled++;
+                }
+            }
+            return true;
+        }
+    } while (!(*dcr & DMA_DCR_CS_MASK));
+
+    *dcr |= MOVED_TAG;
+    return moved;
+}
+
+static bool routed(uint32_t channel, uint32_t source)
+{
+    uint8_t chcfg = DMAMUX0->CHCFG[channel];
+
+    return (chcfg & DMAMUX_CHCFG_ENBL_MASK) && ((chcfg & DMAMUX_CHCFG_SOURCE_MASK) == source);
+}
+
+/* See host_dma.h for documentation of this function. */
+void HostDma_Reset(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+/* See host_dma.h for documentation of this function. */
+int32_t HostDma_Request(uint32_t source)
+{
+    int32_t first = -1;
+
+    source &= DMAMUX_CHCFG_SOURCE_MASK;
+    for (uint32_t channel = 0; channel < CHANNELS; channel++) {
+        if (routed(channel, source) && (DMA0->DMA[channel].DCR & DMA_DCR_ERQ_MASK) && move(channel) &&
+            (first < 0)) {
+            first = (int32_t)channel;
+        }
+    }
+    return first;
+}
+
+/* See host_dma.h for documentation of this function. */
+void HostDma_Run(void)
+{
+    bool moved;
+
+    // Channel 0 has the highest priority; a completion interrupt may start more work
+    do {
+        moved = false;
+        for (uint32_t channel = 0; channel < CHANNELS; channel++) {
+            uint32_t dcr = DMA0->DMA[channel].DCR;
+            bool alwaysOn = (DMAMUX0->CHCFG[channel] & DMAMUX_CHCFG_ENBL_MASK) &&
+                            ((DMAMUX0->CHCFG[channel] & DMAMUX_CHCFG_SOURCE_MASK) >= ALWAYS_ON_FIRST);
+
+            if (((alwaysOn && (dcr & DMA_DCR_ERQ_MASK)) || (dcr & DMA_DCR_START_MASK)) && move(channel)) {
+                moved = true;
+                break;
+            }
+        }
+    } while (moved);
+}
+
+/* See host_dma.h for documentation of this function. */
+void HostDma_Service(void)
+{
+    for (uint32_t channel = 0; channel < CHANNELS; channel++) {
+        deliver(channel);
+    }
+}
+
+/* See host_dma.h for documentation of this function. */
+bool HostDma_ChannelReset(uint32_t channel)
+{
+    return !(DMA0->DMA[channel].DCR & MOVED_TAG);
+}
+
+/* See host_dma.h for documentation of this function. */
+const host_dma_stats_t *HostDma_GetStats(void)
+{
+    return &s_stats;
+}
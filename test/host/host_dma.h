@@ -0,0 +1,71 @@
+/*
+ * Host model of the DMA0 controller and its DMAMUX
+ * A request moves data on the channels the DMAMUX routes its source to, a finished
+ * block sets DONE and raises the channel interrupt, delivered while it is enabled
+ * in the NVIC and unmasked.
+ */
+
+#ifndef _HOST_DMA_H_
+#define _HOST_DMA_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "fsl_device_registers.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+typedef struct {
+    uint32_t moves;             // Source to destination moves, of SSIZE bytes each
+    uint32_t completions;       // Blocks finished: BCR reached zero
+    uint32_t irqs;              // Channel interrupts delivered
+    uint32_t stalled;           // Completions whose interrupt was left pending: disabled or masked
+    uint32_t configErrors;      // Requests on a channel with unequal or reserved sizes (CE)
+} host_dma_stats_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief Clear the statistics
+ */
+void HostDma_Reset(void);
+
+/*!
+ * @brief A peripheral request for source, a dma_request_source_t
+ *
+ * Every channel the DMAMUX routes source to and whose ERQ is set makes one move,
+ * or the whole block if cycle steal (CS) is off, then the interrupt of a
+ * finished block with EINT is delivered or left pending.
+ *
+ * @return Channel that moved data, the lowest numbered if several did, -1 for none
+ */
+int32_t HostDma_Request(uint32_t source);
+
+/*!
+ * @brief Run the channels with a software START or an always enabled source to the end of their block
+ */
+void HostDma_Run(void);
+
+/*!
+ * @brief Deliver the channel interrupts left pending, if they are enabled and unmasked now
+ */
+void HostDma_Service(void);
+
+/*!
+ * @brief true if the driver reset the channel (DMA_ResetChannel) after its last move
+ *
+ * The model tags a channel in a reserved DCR bit when it moves data, DMA_ResetChannel
+ * writes the whole DCR. A peripheral model uses it to see a transfer submitted afresh.
+ */
+bool HostDma_ChannelReset(uint32_t channel);
+
+/*!
+ * @brief Statistics since HostDma_Reset
+ */
+const host_dma_stats_t *HostDma_GetStats(void);
+
+#endif /* _HOST_DMA_H_ */
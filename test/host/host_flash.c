@@ -0,0 +1,252 @@
+/*
+ * Host model of the FTFA program flash controller
+ * Runs the commands fsl_flash.c launches on the flash at HOST_FLASH_BASE, with
+ * datasheet busy times, erase-before-program checks and per-sector wear counts.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "fsl_device_registers.h"
+#include "host_hw.h"
+#include "host_flash.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+// FTFA commands (FCCOB0)
+#define CMD_VERIFY_SECTION      0x01U
+#define CMD_PROGRAM_CHECK       0x02U
+#define CMD_READ_RESOURCE       0x03U
+#define CMD_PROGRAM_LONGWORD    0x06U
+#define CMD_ERASE_SECTOR        0x09U
+
+#define FLASH_SIZE              (HOST_FLASH_SECTOR_SIZE * HOST_FLASH_SECTOR_COUNT)
+#define ERASED_WORD             0xFFFFFFFFU
+
+// First halfword of the two Thumb routines fsl_flash.c copies into RAM
+#define CODE_RUN_COMMAND        0x2180U
+#define CODE_COMMON_BIT_OP      0xB510U
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static host_flash_stats_t s_stats;
+static uint32_t s_powerLossIn;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static inline volatile uint32_t *flashWord(uint32_t offset)
+{
+    return (volatile uint32_t *)(uintptr_t)(HOST_FLASH_BASE + offset);
+}
+
+// Longword of FCCOB4-7 or FCCOB8-B, in the byte order the driver wrote it
+static inline uint32_t fccobWord(volatile uint8_t *first)
+{
+    return *(volatile uint32_t *)first;
+}
+
+/*!
+ * @brief True if the power is cut during this command; counts down the armed loss
+ */
+static bool powerFails(void)
+{
+    return (s_powerLossIn != 0U) && (--s_powerLossIn == 0U);
+}
+
+static uint8_t eraseSector(uint32_t address)
+{
+    uint32_t sector = address / HOST_FLASH_SECTOR_SIZE;
+
+    if ((address >= FLASH_SIZE) || (address % HOST_FLASH_SECTOR_SIZE)) {
+        return FTFA_FSTAT_ACCERR_MASK;
+    }
+    s_stats.busyUs += HOST_FLASH_ERASE_SECTOR_US;
+
+    if (powerFails()) {
+        for (uint32_t offset = 0; offset < HOST_FLASH_SECTOR_SIZE / 2U; offset += 4U) {
+            *flashWord(address + offset) = ERASED_WORD;
+        }
+        HostHw_PowerLoss();
+    }
+
+    for (uint32_t offset = 0; offset < HOST_FLASH_SECTOR_SIZE; offset += 4U) {
+        *flashWord(address + offset) = ERASED_WORD;
+    }
+    s_stats.erases++;
+    s_stats.sectorErases[sector]++;
+    return 0;
+}
+
+static uint8_t programLongword(uint32_t address, uint32_t data)
+{
+    volatile uint32_t *word = flashWord(address);
+
+    if ((address >= FLASH_SIZE) || (address % 4U)) {
+        return FTFA_FSTAT_ACCERR_MASK;
+    }
+    s_stats.busyUs += HOST_FLASH_PROGRAM_WORD_US;
+
+    if (powerFails()) {
+        *word &= data | 0xFFFF0000U;
+        HostHw_PowerLoss();
+    }
+
+    // Programming only clears bits: anything but an erased word does not read back
+    if (*word != ERASED_WORD) {
+        s_stats.overwrites++;
+    }
+    *word &= data;
+    s_stats.programs++;
+    return (*word == data) ? 0U : FTFA_FSTAT_MGSTAT0_MASK;
+}
+
+static uint8_t verifySection(uint32_t address, uint32_t longwords)
+{
+    if ((address >= FLASH_SIZE) || (address % 4U) || (longwords == 0U) || (address + longwords * 4U > FLASH_SIZE)) {
+        return FTFA_FSTAT_ACCERR_MASK;
+    }
+    s_stats.busyUs += HOST_FLASH_VERIFY_US;
+
+    for (uint32_t i = 0; i < longwords; i++) {
+        if (*flashWord(address + i * 4U) != ERASED_WORD) {
+            return FTFA_FSTAT_MGSTAT0_MASK;
+        }
+    }
+    return 0;
+}
+
+static uint8_t programCheck(uint32_t address, uint32_t expected)
+{
+    if ((address >= FLASH_SIZE) || (address % 4U)) {
+        return FTFA_FSTAT_ACCERR_MASK;
+    }
+    s_stats.busyUs += HOST_FLASH_READ_US;
+    return (*flashWord(address) == expected) ? 0U : FTFA_FSTAT_MGSTAT0_MASK;
+}
+
+/*!
+ * @brief Stand-in for the RAM copy of flash_run_command(): run the command in FCCOB
+ */
+static void runCommand(volatile uint8_t *fstat)
+{
+    uint8_t command = FTFA->FCCOB0;
+    uint32_t address = ((uint32_t)FTFA->FCCOB1 << 16) | ((uint32_t)FTFA->FCCOB2 << 8) | FTFA->FCCOB3;
+    uint8_t flags;
+
+    s_stats.commands++;
+    if (!HostHw_IrqMasked()) {
+        s_stats.irqUnmasked++;
+    }
+
+    switch (command) {
+    case CMD_ERASE_SECTOR:
+        flags = eraseSector(address);
+        break;
+    case CMD_PROGRAM_LONGWORD:
+        flags = programLongword(address, fccobWord(&FTFA->FCCOB7));
+        break;
+    case CMD_VERIFY_SECTION:
+        flags = verifySection(address, ((uint32_t)FTFA->FCCOB4 << 8) | FTFA->FCCOB5);
+        break;
+    case CMD_PROGRAM_CHECK:
+        flags = programCheck(address, fccobWord(&FTFA->FCCOBB));
+        break;
+    case CMD_READ_RESOURCE:
+        // No IFR contents are modelled, the resource reads as erased
+        s_stats.busyUs += HOST_FLASH_READ_US;
+        FTFA->FCCOB4 = FTFA->FCCOB5 = FTFA->FCCOB6 = FTFA->FCCOB7 = 0xFFU;
+        flags = 0;
+        break;
+    default:
+        flags = FTFA_FSTAT_ACCERR_MASK;
+        break;
+    }
+
+    if (flags & FTFA_FSTAT_ACCERR_MASK) {
+        s_stats.accessErrors++;
+    }
+    *fstat = FTFA_FSTAT_CCIF_MASK | flags;
+}
+
+/*!
+ * @brief Stand-in for the RAM copy of flash_common_bit_operation()
+ */
+static void commonBitOperation(volatile uint32_t *base, uint32_t bitMask, uint32_t bitShift, uint32_t bitValue)
+{
+    if (bitMask) {
+        *base = (*base & ~bitMask) | ((bitValue << bitShift) & bitMask);
+    }
+}
+
+/*!
+ * @brief Put "movabs rax, target; jmp rax" where the driver will call (at code + 1)
+ */
+static void writeJump(uint8_t *code, void *target)
+{
+    uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t page = (uintptr_t)code & ~(pageSize - 1U);
+    uintptr_t end = ((uintptr_t)code + 13U + pageSize - 1U) & ~(pageSize - 1U);
+    uintptr_t value = (uintptr_t)target;
+
+    code[1] = 0x48;
+    code[2] = 0xB8;
+    for (int i = 0; i < 8; i++) {
+        code[3 + i] = (uint8_t)(value >> (8 * i));
+    }
+    code[11] = 0xFF;
+    code[12] = 0xE0;
+
+    if (mprotect((void *)page, end - page, PROT_READ | PROT_WRITE | PROT_EXEC) != 0) {
+        perror("host_flash: mprotect");
+        exit(2);
+    }
+}
+
+/* See host_flash_code.h for documentation of this function. */
+void *HostFlash_CopyCode(void *dst, const void *src, size_t size)
+{
+    uint16_t first = (size >= 2U) ? *(const uint16_t *)src : 0U;
+
+    memmove(dst, src, size);
+    if (first == CODE_RUN_COMMAND) {
+        writeJump(dst, (void *)runCommand);
+    } else if (first == CODE_COMMON_BIT_OP) {
+        writeJump(dst, (void *)commonBitOperation);
+    }
+    return dst;
+}
+
+/* See host_flash.h for documentation of this function. */
+void HostFlash_Reset(void)
+{
+    HostHw_EraseFlash();
+    HostFlash_ClearStats();
+    s_powerLossIn = 0;
+}
+
+/* See host_flash.h for documentation of this function. */
+const host_flash_stats_t *HostFlash_GetStats(void)
+{
+    return &s_stats;
+}
+
+/* See host_flash.h for documentation of this function. */
+void HostFlash_ClearStats(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+/* See host_flash.h for documentation of this function. */
+void HostFlash_SetPowerLoss(uint32_t commandsLeft)
+{
+    s_powerLossIn = commandsLeft;
+}
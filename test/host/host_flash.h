@@ -0,0 +1,60 @@
+/*
+ * Host model of the FTFA program flash controller
+ * Runs the commands fsl_flash.c launches on the flash at HOST_FLASH_BASE, with
+ * datasheet busy times, erase-before-program checks and per-sector wear counts.
+ */
+
+#ifndef _HOST_FLASH_H_
+#define _HOST_FLASH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define HOST_FLASH_SECTOR_SIZE      1024U
+#define HOST_FLASH_SECTOR_COUNT     128U
+
+// Typical command times of the KL26 datasheet, microseconds
+#define HOST_FLASH_ERASE_SECTOR_US  14000U
+#define HOST_FLASH_PROGRAM_WORD_US  65U
+#define HOST_FLASH_VERIFY_US        60U
+#define HOST_FLASH_READ_US          30U
+
+typedef struct {
+    uint32_t commands;          // Commands launched
+    uint32_t erases;            // Sector erases
+    uint32_t programs;          // Longwords programmed
+    uint32_t overwrites;        // Longwords programmed without an erase in between
+    uint32_t accessErrors;      // Commands refused with ACCERR
+    uint32_t irqUnmasked;       // Commands launched with interrupts enabled
+    uint64_t busyUs;            // Time the flash was busy
+    uint32_t sectorErases[HOST_FLASH_SECTOR_COUNT];
+} host_flash_stats_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief Erase the whole flash and clear the statistics and any power loss
+ */
+void HostFlash_Reset(void);
+
+/*!
+ * @brief Statistics since HostFlash_Reset or HostFlash_ClearStats
+ */
+const host_flash_stats_t *HostFlash_GetStats(void);
+void HostFlash_ClearStats(void);
+
+/*!
+ * @brief Cut the power part way through the commandsLeft-th command from now
+ *
+ * An erase is cut after the first half of the sector, a program after half of
+ * the bits of the longword; the model then calls HostHw_PowerLoss. 0 disarms.
+ */
+void HostFlash_SetPowerLoss(uint32_t commandsLeft);
+
+#endif /* _HOST_FLASH_H_ */
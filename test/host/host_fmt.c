@@ -0,0 +1,49 @@
+/*
+ * The SDK printf formatter of fsl_debug_console.c, built for the host
+ * The application links the toolchain printf (SDK_DEBUGCONSOLE=0), which leaves the
+ * SDK formatter out of libfirmware.a: this is a second build of it with the console
+ * entry points renamed, so it links next to the first.
+ */
+
+#include "host_fmt.h"
+
+#undef SDK_DEBUGCONSOLE
+#define SDK_DEBUGCONSOLE 1U
+
+// The application's formats carry length modifiers (%lu), which only the advanced parser takes
+#ifndef PRINTF_ADVANCED_ENABLE
+#define PRINTF_ADVANCED_ENABLE 1U
+#endif
+
+#define DbgConsole_Init         HostFmt_DbgConsole_Init
+#define DbgConsole_Deinit       HostFmt_DbgConsole_Deinit
+#define DbgConsole_Printf       HostFmt_DbgConsole_Printf
+#define DbgConsole_WriteSpan    HostFmt_DbgConsole_WriteSpan
+#define DbgConsole_Putchar      HostFmt_DbgConsole_Putchar
+#define DbgConsole_Scanf        HostFmt_DbgConsole_Scanf
+#define DbgConsole_Getchar      HostFmt_DbgConsole_Getchar
+#include "fsl_debug_console.c"
+
+/* See host_fmt.h for documentation of this function. */
+int HostFmt_VFormat(host_fmt_sink_t sink, const char *format, va_list ap)
+{
+    return DbgConsole_PrintfFormattedData(sink, format, ap);
+}
+
+/* See host_fmt.h for documentation of this function. */
+int HostFmt_Format(host_fmt_sink_t sink, const char *format, ...)
+{
+    va_list ap;
+    int written;
+
+    va_start(ap, format);
+    written = DbgConsole_PrintfFormattedData(sink, format, ap);
+    va_end(ap);
+    return written;
+}
+
+/* See host_fmt.h for documentation of this function. */
+int32_t HostFmt_ConvertRadix(char *digits, void *number, bool sign, int32_t radix, bool upperCase)
+{
+    return DbgConsole_ConvertRadixNumToString(digits, number, sign, radix, upperCase);
+}
@@ -0,0 +1,74 @@
+/*
+ * The SDK printf formatter of fsl_debug_console.c, built for the host
+ * The application links the toolchain printf (SDK_DEBUGCONSOLE=0), which leaves the
+ * SDK formatter out of libfirmware.a: this is a second build of it with the console
+ * entry points renamed, so it links next to the first. Built with
+ * PRINTF_ADVANCED_ENABLE unless told otherwise, as an SDK_DEBUGCONSOLE=1 build of
+ * the application needs. HostFmtRef_* is the formatter from before the span sink and
+ * the division-free conversion (host_fmt_ref.c), built the same way.
+ */
+
+#ifndef _HOST_FMT_H_
+#define _HOST_FMT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdarg.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+// Output sink of the formatter, one call per run of characters (PUTSPAN_FUNC)
+typedef int (*host_fmt_sink_t)(const char *span, size_t length);
+
+// Output of the reference formatter, one call per character (PUTCHAR_FUNC)
+typedef int (*host_fmt_putchar_t)(int c);
+
+// PRINTF_ADVANCED_ENABLE of the build, on unless set
+#if !defined(PRINTF_ADVANCED_ENABLE) || PRINTF_ADVANCED_ENABLE
+#define HOST_FMT_ADVANCED 1U
+#else
+#define HOST_FMT_ADVANCED 0U
+#endif
+
+// What HostFmt_ConvertRadix takes a pointer to
+#if HOST_FMT_ADVANCED
+typedef uint64_t host_fmt_uint_t;
+typedef int64_t host_fmt_int_t;
+#else
+typedef uint32_t host_fmt_uint_t;
+typedef int32_t host_fmt_int_t;
+#endif
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief DbgConsole_PrintfFormattedData: format into sink
+ *
+ * @return Characters written
+ */
+int HostFmt_Format(host_fmt_sink_t sink, const char *format, ...);
+int HostFmt_VFormat(host_fmt_sink_t sink, const char *format, va_list ap);
+
+/*!
+ * @brief DbgConsole_ConvertRadixNumToString: digits of *number least significant
+ *        first, after a leading '\0'
+ *
+ * number points to a host_fmt_int_t (sign) or a host_fmt_uint_t.
+ *
+ * @return Digit count
+ */
+int32_t HostFmt_ConvertRadix(char *digits, void *number, bool sign, int32_t radix, bool upperCase);
+
+/*!
+ * @brief The same calls on the reference formatter
+ */
+int HostFmtRef_Format(host_fmt_putchar_t output, const char *format, ...);
+int HostFmtRef_VFormat(host_fmt_putchar_t output, const char *format, va_list ap);
+int32_t HostFmtRef_ConvertRadix(char *digits, void *number, bool sign, int32_t radix, bool upperCase);
+
+#endif /* _HOST_FMT_H_ */
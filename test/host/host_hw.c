@@ -0,0 +1,248 @@
+/*
+ * Host stand-in for the MKL26Z128 core and register blocks
+ * Register blocks are zeroed memory at their device addresses, interrupts are
+ * handler calls made by the test, resets unwind to HostHw_Run.
+ */
+
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "fsl_device_registers.h"
+#include "host_hw.h"
+#include "host_check.h"
+
+void SysTick_Handler(void);
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+typedef struct {
+    uintptr_t base;
+    size_t size;
+    bool keepOnReset;
+} host_region_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+// Everything the firmware touches by absolute address
+static const host_region_t s_regions[] = {
+    {0x40000000U, 0x100000U, false},                // Peripheral bridge and GPIO
+    {0xE0000000U, 0x100000U, false},                // Private peripheral bus: SysTick, NVIC, SCB
+    {0xF0000000U, 0x4000U, false},                  // ROM table, MCM
+    {0xF8000000U, 0x1000U, false},                  // FGPIO
+    {HOST_FLASH_BASE, FSL_FEATURE_FLASH_PFLASH_BLOCK_SIZE, true},
+};
+
+int g_hostCheckFailures;
+
+static uint32_t s_primask;
+static void (*s_wfiHook)(void);
+static void (*s_pollHook)(void);
+static void (*s_unmaskHook)(void);
+static bool s_inPollHook;
+static jmp_buf *s_runJump;
+
+// Core clock after BOARD_BootClockRUN, system_MKL26Z4.c is not built for the host
+uint32_t SystemCoreClock = 48000000U;
+
+// Vector table symbols of the linker script, for InstallIRQHandler in fsl_common.c
+uint32_t __VECTOR_TABLE[48];
+uint32_t __VECTOR_RAM[48];
+uint32_t __RAM_VECTOR_TABLE_SIZE[1];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+__attribute__((constructor)) static void mapRegions(void)
+{
+    for (size_t i = 0; i < sizeof(s_regions) / sizeof(s_regions[0]); i++) {
+        void *map = mmap((void *)s_regions[i].base, s_regions[i].size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+        if (map != (void *)s_regions[i].base) {
+            fprintf(stderr, "host_hw: cannot map 0x%08lx\n", (unsigned long)s_regions[i].base);
+            exit(2);
+        }
+    }
+    HostHw_EraseFlash();
+    HostHw_Reset();
+}
+
+/* See host_hw.h for documentation of this function. */
+void HostHw_Reset(void)
+{
+    for (size_t i = 0; i < sizeof(s_regions) / sizeof(s_regions[0]); i++) {
+        if (!s_regions[i].keepOnReset) {
+            memset((void *)s_regions[i].base, 0, s_regions[i].size);
+        }
+    }
+    // Flash idle, size from the feature file
+    FTFA->FSTAT = FTFA_FSTAT_CCIF_MASK;
+    SIM->FCFG1 = SIM_FCFG1_PFSIZE(0xFU);
+    s_primask = 0;
+}
+
+/* See host_hw.h for documentation of this function. */
+void HostHw_EraseFlash(void)
+{
+    memset((void *)HOST_FLASH_BASE, 0xFF, FSL_FEATURE_FLASH_PFLASH_BLOCK_SIZE);
+}
+
+/* See host_hw.h for documentation of this function. */
+host_run_result_t HostHw_Run(void (*fn)(void))
+{
+    jmp_buf jump;
+    jmp_buf *outer = s_runJump;
+    volatile host_run_result_t result;
+
+    s_runJump = &jump;
+    result = (host_run_result_t)setjmp(jump);
+    if (result == HOST_RUN_RETURNED) {
+        fn();
+    }
+    s_runJump = outer;
+    s_primask = 0;
+    s_inPollHook = false;
+    return result;
+}
+
+static void unwind(host_run_result_t result)
+{
+    if (s_runJump == NULL) {
+        fprintf(stderr, "host_hw: reset outside HostHw_Run\n");
+        abort();
+    }
+    longjmp(*s_runJump, (int)result);
+}
+
+/* See host_hw.h for documentation of this function. */
+void HostHw_PowerLoss(void)
+{
+    unwind(HOST_RUN_POWER_LOSS);
+}
+
+/* See host_hw.h for documentation of this function. */
+void HostHw_Stop(void)
+{
+    unwind(HOST_RUN_STOPPED);
+}
+
+/* See host_hw.h for documentation of this function. */
+void HostHw_SetWfiHook(void (*hook)(void))
+{
+    s_wfiHook = hook;
+}
+
+/* See host_hw.h for documentation of this function. */
+void HostHw_SetPollHook(void (*hook)(void))
+{
+    s_pollHook = hook;
+}
+
+/* See host_hw.h for documentation of this function. */
+void HostHw_SetUnmaskHook(void (*hook)(void))
+{
+    s_unmaskHook = hook;
+}
+
+/* See host_hw.h for documentation of this function. */
+bool HostHw_IrqMasked(void)
+{
+    return s_primask != 0U;
+}
+
+// Clearing PRIMASK takes the interrupts that fell due while it was set
+static void unmask(void)
+{
+    if ((s_primask != 0U) && (s_unmaskHook != NULL)) {
+        s_primask = 0;
+        s_unmaskHook();
+    }
+    s_primask = 0;
+}
+
+void __enable_irq(void)
+{
+    unmask();
+}
+
+void __disable_irq(void)
+{
+    s_primask = 1;
+}
+
+// DisableGlobalIRQ reads PRIMASK first: the hook runs while an interrupt can still be taken
+uint32_t __get_PRIMASK(void)
+{
+    if ((s_pollHook != NULL) && !s_inPollHook) {
+        s_inPollHook = true;
+        s_pollHook();
+        s_inPollHook = false;
+    }
+    return s_primask;
+}
+
+void __set_PRIMASK(uint32_t priMask)
+{
+    if ((priMask & 1U) == 0U) {
+        unmask();
+    } else {
+        s_primask = 1;
+    }
+}
+
+void HostHw_NvicEnableIRQ(IRQn_Type IRQn)
+{
+    NVIC->ISER[0] |= 1UL << ((uint32_t)IRQn & 0x1FUL);
+}
+
+void HostHw_NvicDisableIRQ(IRQn_Type IRQn)
+{
+    NVIC->ISER[0] &= ~(1UL << ((uint32_t)IRQn & 0x1FUL));
+}
+
+uint32_t HostHw_NvicGetPendingIRQ(IRQn_Type IRQn)
+{
+    return (NVIC->ISPR[0] >> ((uint32_t)IRQn & 0x1FUL)) & 1UL;
+}
+
+void HostHw_NvicSetPendingIRQ(IRQn_Type IRQn)
+{
+    NVIC->ISPR[0] |= 1UL << ((uint32_t)IRQn & 0x1FUL);
+}
+
+void HostHw_NvicClearPendingIRQ(IRQn_Type IRQn)
+{
+    NVIC->ISPR[0] &= ~(1UL << ((uint32_t)IRQn & 0x1FUL));
+}
+
+void __set_MSP(uint32_t topOfMainStack)
+{
+    (void)topOfMainStack;
+}
+
+// NVIC_SystemReset writes SYSRESETREQ between two barriers
+void __DSB(void)
+{
+    if (SCB->AIRCR & SCB_AIRCR_SYSRESETREQ_Msk) {
+        HostHw_Reset();
+        unwind(HOST_RUN_SYSTEM_RESET);
+    }
+}
+
+// Without a hook the next interrupt is the 1 ms tick of app_time.c
+void __WFI(void)
+{
+    if (s_wfiHook != NULL) {
+        s_wfiHook();
+    } else {
+        SysTick_Handler();
+    }
+}
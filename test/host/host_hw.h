@@ -0,0 +1,82 @@
+/*
+ * Host stand-in for the MKL26Z128 core and register blocks
+ * Register blocks are zeroed memory at their device addresses, interrupts are
+ * handler calls made by the test, resets unwind to HostHw_Run.
+ */
+
+#ifndef _HOST_HW_H_
+#define _HOST_HW_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+// Why HostHw_Run came back early
+typedef enum {
+    HOST_RUN_RETURNED = 0,      // The function returned
+    HOST_RUN_SYSTEM_RESET,      // NVIC_SystemReset (SYSRESETREQ)
+    HOST_RUN_POWER_LOSS,        // HostHw_PowerLoss, from a simulator
+    HOST_RUN_STOPPED,           // HostHw_Stop, from a test hook
+} host_run_result_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief Zero every register block and clear PRIMASK, as after a reset
+ *
+ * The program flash is left alone, it survives resets.
+ */
+void HostHw_Reset(void);
+
+/*!
+ * @brief Run fn until it returns, resets or a simulator stops it
+ *
+ * Nests: a reset unwinds to the innermost call. PRIMASK is clear afterwards.
+ */
+host_run_result_t HostHw_Run(void (*fn)(void));
+
+/*!
+ * @brief Unwind to HostHw_Run with HOST_RUN_POWER_LOSS or HOST_RUN_STOPPED
+ */
+void HostHw_PowerLoss(void);
+void HostHw_Stop(void);
+
+/*!
+ * @brief Called from __WFI; a hook usually delivers the interrupt the code waits for
+ *
+ * Without a hook (NULL) every WFI runs SysTick_Handler: 1 ms passes.
+ */
+void HostHw_SetWfiHook(void (*hook)(void));
+
+/*!
+ * @brief Called when the code reads PRIMASK, as each pass of a busy-wait loop around a
+ *        critical section does; a hook runs the hardware that works on meanwhile
+ *
+ * Not called again from inside the hook. NULL, the default, for none.
+ */
+void HostHw_SetPollHook(void (*hook)(void));
+
+/*!
+ * @brief Called when the code clears PRIMASK; a hook delivers the interrupts that fell
+ *        due while it was set
+ *
+ * NULL, the default, for none.
+ */
+void HostHw_SetUnmaskHook(void (*hook)(void));
+
+/*!
+ * @brief Current PRIMASK, true while interrupts are masked
+ */
+bool HostHw_IrqMasked(void);
+
+/*!
+ * @brief Fill the program flash with erased bytes
+ */
+void HostHw_EraseFlash(void);
+
+#endif /* _HOST_HW_H_ */
@@ -0,0 +1,190 @@
+/*
+ * Host model of a master on the bus of one Kinetis I2C slave
+ * Each bus event sets the status flags a real controller would and calls the
+ * interrupt handler, as long as the slave has the interrupt enabled and unmasked.
+ */
+
+#include <string.h>
+
+#include "host_i2c.h"
+#include "host_hw.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define START_STOP_FLAGS (I2C_FLT_STARTF_MASK | I2C_FLT_STOPF_MASK)
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static I2C_Type *s_base;
+static IRQn_Type s_irqn;
+static void (*s_handler)(void);
+static host_i2c_stats_t s_stats;
+
+static bool s_busy;                 // Between START and STOP
+static uint8_t s_startStop;         // STARTF/STOPF set and not yet seen by the handler
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief Raise one event and run the handler if the slave takes the interrupt
+ *
+ * Plain memory has no write-1-to-clear bits, so the flags are rebuilt here for
+ * every event and cleared once the handler has run, as the handler would have.
+ *
+ * @return false if the event was stalled
+ */
+static bool deliver(uint8_t status, uint8_t startStop, uint8_t data)
+{
+    I2C_Type *base = s_base;
+
+    if (!(base->C1 & I2C_C1_IICEN_MASK)) {
+        return true;
+    }
+
+    s_startStop |= startStop & START_STOP_FLAGS;
+    base->S = status | I2C_S_IICIF_MASK | (s_busy ? I2C_S_BUSY_MASK : 0U);
+    base->FLT = (base->FLT & ~START_STOP_FLAGS) | s_startStop;
+    base->D = data;
+
+    // Without SSIE a START or STOP only sets its flag, the next byte interrupt sees it
+    if ((status == 0U) && !(base->FLT & I2C_FLT_SSIE_MASK)) {
+        return true;
+    }
+
+    if (!(base->C1 & I2C_C1_IICIE_MASK) || !(NVIC->ISER[0] & (1UL << (uint32_t)s_irqn)) || HostHw_IrqMasked()) {
+        s_stats.stalled++;
+        return false;
+    }
+
+    s_stats.irqs++;
+    s_handler();
+
+    s_startStop = 0;
+    base->S = s_busy ? I2C_S_BUSY_MASK : 0U;
+    base->FLT &= ~START_STOP_FLAGS;
+    return true;
+}
+
+static bool start(void)
+{
+    s_busy = true;
+    return deliver(0, I2C_FLT_STARTF_MASK, 0);
+}
+
+static bool stop(void)
+{
+    s_busy = false;
+    return deliver(0, I2C_FLT_STOPF_MASK, 0);
+}
+
+/*!
+ * @brief Address byte; the slave answers its own address, and a general call write if enabled
+ */
+static bool addressed(uint8_t address, bool read)
+{
+    I2C_Type *base = s_base;
+    bool match = (base->C1 & I2C_C1_IICEN_MASK) &&
+                 (((uint8_t)(address << 1U) == (base->A1 & 0xFEU)) ||
+                  ((address == 0U) && !read && (base->C2 & I2C_C2_GCAEN_MASK)));
+
+    if (!match) {
+        s_stats.addressNaks++;
+        return false;
+    }
+    return deliver(I2C_S_IAAS_MASK | I2C_S_TCF_MASK | (read ? I2C_S_SRW_MASK : 0U), 0,
+                   (uint8_t)((address << 1U) | (read ? 1U : 0U)));
+}
+
+/* See host_i2c.h for documentation of this function. */
+void HostI2c_Attach(I2C_Type *base, IRQn_Type irqn, void (*handler)(void))
+{
+    s_base = base;
+    s_irqn = irqn;
+    s_handler = handler;
+    s_busy = false;
+    s_startStop = 0;
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+/* See host_i2c.h for documentation of this function. */
+int32_t HostI2c_Write(uint8_t address, const uint8_t *data, uint32_t length)
+{
+    int32_t acked = 0;
+
+    if (!start()) {
+        return -1;
+    }
+    if (!addressed(address, false)) {
+        stop();
+        return -1;
+    }
+
+    while ((uint32_t)acked < length) {
+        // The acknowledge goes out before the interrupt, with the TXAK set by the previous one
+        bool ack = !(s_base->C1 & I2C_C1_TXAK_MASK);
+
+        if (!deliver(I2C_S_TCF_MASK, 0, data[acked])) {
+            return -1;
+        }
+        if (!ack) {
+            s_stats.dataNaks++;
+            break;
+        }
+        acked++;
+    }
+
+    return stop() ? acked : -1;
+}
+
+/* See host_i2c.h for documentation of this function. */
+int32_t HostI2c_Read(uint8_t address, uint8_t *data, uint32_t length)
+{
+    I2C_Type *base = s_base;
+
+    if ((length == 0U) || !start()) {
+        return -1;
+    }
+    if (!addressed(address, true)) {
+        stop();
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < length; i++) {
+        bool last = (i + 1U == length);
+
+        // A slave that is not transmitting leaves SDA released
+        data[i] = (base->C1 & I2C_C1_TX_MASK) ? base->D : 0xFFU;
+        if (!deliver(I2C_S_TCF_MASK | I2C_S_SRW_MASK | (last ? I2C_S_RXAK_MASK : 0U), 0, base->D)) {
+            return -1;
+        }
+    }
+
+    return stop() ? (int32_t)length : -1;
+}
+
+/* See host_i2c.h for documentation of this function. */
+bool HostI2c_Raw(uint8_t status, uint8_t startStop, uint8_t data)
+{
+    uint32_t irqs = s_stats.irqs;
+
+    if (startStop & I2C_FLT_STARTF_MASK) {
+        s_busy = true;
+    }
+    if (startStop & I2C_FLT_STOPF_MASK) {
+        s_busy = false;
+    }
+    deliver(status & ~(I2C_S_IICIF_MASK | I2C_S_BUSY_MASK), startStop, data);
+    return s_stats.irqs != irqs;
+}
+
+/* See host_i2c.h for documentation of this function. */
+const host_i2c_stats_t *HostI2c_GetStats(void)
+{
+    return &s_stats;
+}
@@ -0,0 +1,67 @@
+/*
+ * Host model of a master on the bus of one Kinetis I2C slave
+ * Each bus event sets the status flags a real controller would and calls the
+ * interrupt handler, as long as the slave has the interrupt enabled and unmasked.
+ */
+
+#ifndef _HOST_I2C_H_
+#define _HOST_I2C_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "fsl_device_registers.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+typedef struct {
+    uint32_t irqs;              // Interrupts delivered
+    uint32_t stalled;           // Events the slave could not take: disabled, masked or not enabled in the NVIC
+    uint32_t addressNaks;       // Transfers to an address the slave does not answer
+    uint32_t dataNaks;          // Written bytes the slave did not acknowledge
+} host_i2c_stats_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief Put the master on the bus of base, whose interrupt is irqn served by handler
+ *
+ * Clears the statistics.
+ */
+void HostI2c_Attach(I2C_Type *base, IRQn_Type irqn, void (*handler)(void));
+
+/*!
+ * @brief START, address with write, data bytes until one is NAKed, STOP
+ *
+ * @return Data bytes the slave acknowledged, -1 if the address was not acknowledged
+ *         or an event was stalled
+ */
+int32_t HostI2c_Write(uint8_t address, const uint8_t *data, uint32_t length);
+
+/*!
+ * @brief START, address with read, length bytes (the last NAKed by the master), STOP
+ *
+ * @return Bytes read, -1 if the address was not acknowledged or an event was stalled
+ */
+int32_t HostI2c_Read(uint8_t address, uint8_t *data, uint32_t length);
+
+/*!
+ * @brief Deliver one interrupt with arbitrary flags, for fuzzing the handler
+ *
+ * S gets status plus IICIF, FLT gets the STARTF/STOPF bits of startStop and D
+ * holds data. BUSY is kept from the last START or STOP.
+ *
+ * @return true if the handler ran
+ */
+bool HostI2c_Raw(uint8_t status, uint8_t startStop, uint8_t data);
+
+/*!
+ * @brief Statistics since HostI2c_Attach
+ */
+const host_i2c_stats_t *HostI2c_GetStats(void);
+
+#endif /* _HOST_I2C_H_ */
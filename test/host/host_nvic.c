@@ -0,0 +1,202 @@
+/*
+ * Timing model of the Cortex-M0+ NVIC, for worst-case interrupt response times
+ * Sources are the interrupts the firmware configured: their levels are read back from
+ * the NVIC and SCB registers, so the analysis checks the priorities as programmed.
+ * Four levels, 0 most urgent; a request preempts only a strictly less urgent handler,
+ * equal levels wait their turn in exception number order, a handler returning into
+ * another pending one tail-chains. Times are core cycles.
+ */
+
+#include <string.h>
+
+#include "host_nvic.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define SOURCES_MAX     32U
+#define MASKED          (-1)        // The PRIMASK section in place of a source index
+
+// A handler taken, or the PRIMASK section, on the exception stack
+typedef struct {
+    int32_t source;
+    uint32_t level;             // Preempted by a lower level only: none is below 0 for PRIMASK
+    uint64_t remaining;         // Cycles to its return
+    uint64_t requestAt;
+} nvic_frame_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static const host_nvic_core_t *s_core;
+static const host_nvic_source_t *s_sources;
+static uint32_t s_count;
+static uint32_t s_levels[SOURCES_MAX];
+static host_nvic_result_t *s_results;
+
+static uint64_t s_now;
+static bool s_pending[SOURCES_MAX];
+static uint64_t s_pendingAt[SOURCES_MAX];   // Oldest request the pending bit stands for
+static uint64_t s_nextRequest[SOURCES_MAX];
+static nvic_frame_t s_stack[HOST_NVIC_LEVELS + 1U];
+static uint32_t s_depth;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/* See host_nvic.h for documentation of this function. */
+uint32_t HostNvic_GetLevel(IRQn_Type irqn)
+{
+    return NVIC_GetPriority(irqn);
+}
+
+// Most urgent pending source, the lower exception number on a tie; -1 for none
+static int32_t mostUrgent(void)
+{
+    int32_t best = -1;
+
+    for (uint32_t i = 0; i < s_count; i++) {
+        if (s_pending[i] && ((best < 0) || (s_levels[i] < s_levels[best]) ||
+                             ((s_levels[i] == s_levels[best]) && (s_sources[i].irqn < s_sources[best].irqn)))) {
+            best = (int32_t)i;
+        }
+    }
+    return best;
+}
+
+static bool preempts(int32_t source)
+{
+    return (s_depth == 0U) || (s_levels[source] < s_stack[s_depth - 1U].level);
+}
+
+static void push(int32_t source, uint32_t level, uint64_t cycles, uint64_t requestAt)
+{
+    nvic_frame_t *frame = &s_stack[s_depth++];
+
+    frame->source = source;
+    frame->level = level;
+    frame->remaining = cycles;
+    frame->requestAt = requestAt;
+}
+
+static void enter(int32_t source, uint32_t overhead)
+{
+    s_pending[source] = false;
+    push(source, s_levels[source], (uint64_t)overhead + s_sources[source].handlerCycles, s_pendingAt[source]);
+}
+
+// A second request before the first was taken only sets the pending bit again
+static void request(uint32_t source)
+{
+    if (s_pending[source]) {
+        s_results[source].lost++;
+    } else {
+        s_pending[source] = true;
+        s_pendingAt[source] = s_now;
+    }
+    s_nextRequest[source] += s_sources[source].periodCycles;
+}
+
+static void complete(void)
+{
+    nvic_frame_t *frame = &s_stack[--s_depth];
+    int32_t next;
+
+    if (frame->source == MASKED) {
+        return;
+    }
+    if (s_now - frame->requestAt > s_results[frame->source].worstCycles) {
+        s_results[frame->source].worstCycles = (uint32_t)(s_now - frame->requestAt);
+    }
+
+    next = mostUrgent();
+    if ((next >= 0) && preempts(next)) {
+        enter(next, s_core->tailChainCycles);
+    } else if (s_depth > 0U) {
+        s_stack[s_depth - 1U].remaining += s_core->exitCycles;
+    }
+}
+
+/*
+ * Everything requests at cycle 1, just after blocker began at 0: a source's handler,
+ * the PRIMASK section or, below MASKED, nothing
+ */
+static void simulate(int32_t blocker, uint32_t maskedCycles, uint64_t horizonCycles)
+{
+    s_now = 0;
+    s_depth = 0;
+    for (uint32_t i = 0; i < s_count; i++) {
+        s_pending[i] = false;
+        s_nextRequest[i] = 1U;
+    }
+    if (blocker == MASKED) {
+        push(MASKED, 0U, maskedCycles, 0U);
+    } else if (blocker >= 0) {
+        s_pendingAt[blocker] = 0;
+        enter(blocker, s_core->entryCycles);
+        s_nextRequest[blocker] = s_sources[blocker].periodCycles;
+    }
+
+    while (s_now < horizonCycles) {
+        int32_t next = mostUrgent();
+        uint64_t until = horizonCycles;
+
+        if ((next >= 0) && preempts(next)) {
+            enter(next, s_core->entryCycles);
+            continue;
+        }
+
+        for (uint32_t i = 0; i < s_count; i++) {
+            if (s_nextRequest[i] < until) {
+                until = s_nextRequest[i];
+            }
+        }
+        if ((s_depth > 0U) && (s_now + s_stack[s_depth - 1U].remaining < until)) {
+            until = s_now + s_stack[s_depth - 1U].remaining;
+        }
+        if (s_depth > 0U) {
+            s_stack[s_depth - 1U].remaining -= until - s_now;
+        }
+        s_now = until;
+
+        for (uint32_t i = 0; i < s_count; i++) {
+            if (s_nextRequest[i] == s_now) {
+                request(i);
+            }
+        }
+        if ((s_depth > 0U) && (s_stack[s_depth - 1U].remaining == 0U)) {
+            complete();
+        }
+    }
+}
+
+/* See host_nvic.h for documentation of this function. */
+void HostNvic_Analyse(const host_nvic_core_t *core,
+                      uint32_t maskedCycles,
+                      const host_nvic_source_t *sources,
+                      uint32_t count,
+                      uint32_t horizonCycles,
+                      host_nvic_result_t *results)
+{
+    s_core = core;
+    s_sources = sources;
+    s_count = (count < SOURCES_MAX) ? count : SOURCES_MAX;
+    s_results = results;
+    memset(results, 0, count * sizeof(results[0]));
+    for (uint32_t i = 0; i < s_count; i++) {
+        s_levels[i] = HostNvic_GetLevel(sources[i].irqn);
+        results[i].level = s_levels[i];
+    }
+
+    // A blocker that cannot hold a source off only gives it another starting point
+    simulate(MASKED - 1, 0U, horizonCycles);
+    if (maskedCycles > 0U) {
+        simulate(MASKED, maskedCycles, horizonCycles);
+    }
+    for (uint32_t i = 0; i < s_count; i++) {
+        simulate((int32_t)i, 0U, horizonCycles);
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ * Timing model of the Cortex-M0+ NVIC, for worst-case interrupt response times
+ * Sources are the interrupts the firmware configured: their levels are read back from
+ * the NVIC and SCB registers, so the analysis checks the priorities as programmed.
+ * Four levels, 0 most urgent; a request preempts only a strictly less urgent handler,
+ * equal levels wait their turn in exception number order, a handler returning into
+ * another pending one tail-chains. Times are core cycles.
+ */
+
+#ifndef _HOST_NVIC_H_
+#define _HOST_NVIC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "fsl_device_registers.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define HOST_NVIC_LEVELS    (1U << __NVIC_PRIO_BITS)
+
+// Exception overheads of the core
+typedef struct {
+    uint32_t entryCycles;       // Request to the first handler instruction, stacking included
+    uint32_t exitCycles;        // Handler return to the preempted handler, unstacking included
+    uint32_t tailChainCycles;   // Handler return straight into the next pending handler
+} host_nvic_core_t;
+
+// Cortex-M0+ with zero wait state vector fetch; flash wait states go in the handler costs
+#define HOST_NVIC_CORE_M0PLUS {15U, 13U, 11U}
+
+typedef struct {
+    const char *name;
+    IRQn_Type irqn;             // Its level is the one the firmware set
+    uint32_t handlerCycles;     // Longest handler run, first instruction to return
+    uint32_t periodCycles;      // Shortest time between two requests
+} host_nvic_source_t;
+
+typedef struct {
+    uint32_t level;             // Read from the NVIC, 0 most urgent
+    uint32_t worstCycles;       // Longest time from a request to its handler's return
+    uint32_t lost;              // Requests that found the previous one still pending, all starts
+} host_nvic_result_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief Priority level of irqn as programmed, exceptions (SysTick) included
+ */
+uint32_t HostNvic_GetLevel(IRQn_Type irqn);
+
+/*!
+ * @brief Worst-case response time of every source under the traffic of all of them
+ *
+ * For each source, from the critical instant: every source requests at once and then
+ * at its shortest period, right after the code that holds it off longest has begun,
+ * either a PRIMASK section of maskedCycles or a handler at its own level. The busy
+ * stretch is followed for horizonCycles, results[i] takes the worst of the blockers.
+ *
+ * @param core Exception overheads
+ * @param maskedCycles Longest section the code runs with PRIMASK set, 0 for none
+ * @param sources Interrupt sources, at most 32
+ * @param count Number of sources
+ * @param horizonCycles Time simulated after each critical instant
+ * @param results One per source
+ */
+void HostNvic_Analyse(const host_nvic_core_t *core,
+                      uint32_t maskedCycles,
+                      const host_nvic_source_t *sources,
+                      uint32_t count,
+                      uint32_t horizonCycles,
+                      host_nvic_result_t *results);
+
+#endif /* _HOST_NVIC_H_ */
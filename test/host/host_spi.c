@@ -0,0 +1,176 @@
+/*
+ * Host model of a master on the bus of one Kinetis SPI slave
+ * Each frame sets the status flags a real controller would, raises the DMA requests
+ * the slave enabled (host_dma.h) and calls the interrupt handler, as long as the
+ * slave has the interrupt enabled and unmasked.
+ */
+
+#include <string.h>
+
+#include "host_spi.h"
+#include "host_dma.h"
+#include "host_hw.h"
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static SPI_Type *s_base;
+static IRQn_Type s_irqn;
+static void (*s_handler)(void);
+static uint32_t s_rxSource;
+static uint32_t s_txSource;
+static host_spi_stats_t s_stats;
+
+/*
+ * The transmit buffer and the receive buffer share DL and DH in plain memory. A frame
+ * the handler or a DMA channel loaded is held here as loaded, SPTEF stays clear
+ * until the master clocks it out; a frame the CPU loaded outside the handler is not
+ * seen, the data register goes out as it stands.
+ */
+static bool s_txLoaded;
+static int32_t s_txChannel;         // DMA channel that loaded it, -1 for the handler
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static bool wideFrames(void)
+{
+    return (s_base->C2 & SPI_C2_SPIMODE_MASK) != 0U;
+}
+
+static uint16_t readData(void)
+{
+    return wideFrames() ? (uint16_t)(s_base->DL | (s_base->DH << 8U)) : s_base->DL;
+}
+
+static void writeData(uint16_t frame)
+{
+    s_base->DL = (uint8_t)frame;
+    if (wideFrames()) {
+        s_base->DH = (uint8_t)(frame >> 8U);
+    }
+}
+
+static bool irqTakeable(void)
+{
+    return (NVIC->ISER[0] & (1UL << (uint32_t)s_irqn)) && !HostHw_IrqMasked();
+}
+
+// A transmit DMA request; the channel that answers has loaded the next frame
+static void requestTx(void)
+{
+    int32_t channel = HostDma_Request(s_txSource);
+
+    if (channel >= 0) {
+        s_stats.dmaMoves++;
+        s_txLoaded = true;
+        s_txChannel = channel;
+    }
+}
+
+/* See host_spi.h for documentation of this function. */
+void HostSpi_Attach(SPI_Type *base, IRQn_Type irqn, void (*handler)(void), uint32_t rxSource, uint32_t txSource)
+{
+    s_base = base;
+    s_irqn = irqn;
+    s_handler = handler;
+    s_rxSource = rxSource;
+    s_txSource = txSource;
+    s_txLoaded = false;
+    s_txChannel = -1;
+    memset(&s_stats, 0, sizeof(s_stats));
+    base->S = SPI_S_SPTEF_MASK;
+}
+
+/* See host_spi.h for documentation of this function. */
+uint16_t HostSpi_Exchange(uint16_t frame)
+{
+    SPI_Type *base = s_base;
+    uint16_t sent;
+    uint8_t c1;
+    bool taken = false;
+
+    if (!(base->C1 & SPI_C1_SPE_MASK)) {
+        s_stats.disabled++;
+        return 0xFFFFU;
+    }
+    s_stats.frames++;
+
+    // Drivers cycle SPE to empty the buffer before they submit a transfer afresh
+    if (s_txLoaded && (s_txChannel >= 0) && HostDma_ChannelReset((uint32_t)s_txChannel)) {
+        s_txLoaded = false;
+    }
+    // The transmit request stands while the buffer is empty, the frame is in before the first edge
+    if (!s_txLoaded && (base->C2 & SPI_C2_TXDMAE_MASK)) {
+        requestTx();
+    }
+    sent = readData();
+    if (!wideFrames()) {
+        sent &= 0xFFU;
+    }
+    s_txLoaded = false;
+
+    // The frame received, the buffer emptied by the shift
+    writeData(frame);
+    base->S = SPI_S_SPRF_MASK | SPI_S_SPTEF_MASK;
+
+    // Receive request first: the frame has to be read before the next one is loaded
+    if ((base->C2 & SPI_C2_RXDMAE_MASK) && (HostDma_Request(s_rxSource) >= 0)) {
+        s_stats.dmaMoves++;
+        taken = true;
+    }
+    if (base->C2 & SPI_C2_TXDMAE_MASK) {
+        requestTx();
+    }
+
+    // SPRF with SPIE, SPTEF with SPTIE; the handler reads the frame and loads the next
+    c1 = base->C1;
+    if (((!taken && (c1 & SPI_C1_SPIE_MASK)) || (!s_txLoaded && (c1 & SPI_C1_SPTIE_MASK))) && irqTakeable()) {
+        base->S = (taken ? 0U : SPI_S_SPRF_MASK) | (s_txLoaded ? 0U : SPI_S_SPTEF_MASK);
+        s_stats.irqs++;
+        s_handler();
+        if (c1 & SPI_C1_SPIE_MASK) {
+            taken = true;
+        }
+        if (c1 & SPI_C1_SPTIE_MASK) {
+            s_txLoaded = true;
+            s_txChannel = -1;
+        }
+    }
+
+    if (!taken) {
+        s_stats.unread++;
+    }
+    base->S = (taken ? 0U : SPI_S_SPRF_MASK) | (s_txLoaded ? 0U : SPI_S_SPTEF_MASK);
+    return sent;
+}
+
+/* See host_spi.h for documentation of this function. */
+void HostSpi_Transfer(const uint8_t *txData, uint8_t *rxData, uint32_t length)
+{
+    uint32_t step = wideFrames() ? 2U : 1U;
+
+    for (uint32_t i = 0; i + step <= length; i += step) {
+        uint16_t frame = 0;
+        uint16_t reply;
+
+        if (txData != NULL) {
+            frame = (step == 2U) ? (uint16_t)(txData[i] | (txData[i + 1U] << 8U)) : txData[i];
+        }
+        reply = HostSpi_Exchange(frame);
+        if (rxData != NULL) {
+            rxData[i] = (uint8_t)reply;
+            if (step == 2U) {
+                rxData[i + 1U] = (uint8_t)(reply >> 8U);
+            }
+        }
+    }
+}
+
+/* See host_spi.h for documentation of this function. */
+const host_spi_stats_t *HostSpi_GetStats(void)
+{
+    return &s_stats;
+}
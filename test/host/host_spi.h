@@ -0,0 +1,60 @@
+/*
+ * Host model of a master on the bus of one Kinetis SPI slave
+ * Each frame sets the status flags a real controller would, raises the DMA requests
+ * the slave enabled (host_dma.h) and calls the interrupt handler, as long as the
+ * slave has the interrupt enabled and unmasked.
+ */
+
+#ifndef _HOST_SPI_H_
+#define _HOST_SPI_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "fsl_device_registers.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+typedef struct {
+    uint32_t frames;            // Frames clocked while the slave was enabled
+    uint32_t disabled;          // Frames clocked while SPE was clear, the slave ignored them
+    uint32_t irqs;              // Interrupts delivered
+    uint32_t dmaMoves;          // Frames a DMA channel moved, to or from the data register
+    uint32_t unread;            // Received frames neither the handler nor a DMA channel took
+} host_spi_stats_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief Put the master on the bus of base
+ *
+ * Its interrupt is irqn served by handler, its DMA requests are rxSource and
+ * txSource (dma_request_source_t). Clears the statistics.
+ */
+void HostSpi_Attach(SPI_Type *base, IRQn_Type irqn, void (*handler)(void), uint32_t rxSource, uint32_t txSource);
+
+/*!
+ * @brief Clock one frame: send frame, return the one the slave sent
+ *
+ * A frame is 8 or 16 bits as C2 SPIMODE selects; a disabled slave returns all ones.
+ */
+uint16_t HostSpi_Exchange(uint16_t frame);
+
+/*!
+ * @brief Clock length bytes, in frames of one or two bytes with the low byte first
+ *
+ * @param txData Bytes to send, NULL sends zeros.
+ * @param rxData Bytes the slave sent, NULL drops them.
+ */
+void HostSpi_Transfer(const uint8_t *txData, uint8_t *rxData, uint32_t length);
+
+/*!
+ * @brief Statistics since HostSpi_Attach
+ */
+const host_spi_stats_t *HostSpi_GetStats(void);
+
+#endif /* _HOST_SPI_H_ */
@@ -0,0 +1,176 @@
+/*
+ * Host model of the far end of a serial line on one UART or LPSCI
+ * Both share the BDH..D register layout. Each received byte sets RDRF and calls the
+ * interrupt handler, as long as the receiver has the interrupt enabled and unmasked;
+ * the transmitter is emptied one byte per TDRE interrupt, as without a FIFO. TDRE is
+ * only set while HostUart_Transmit runs, so a byte the driver writes is never lost
+ * under a received one in the shared D of plain memory; TC stays set in between, for
+ * the deinit functions that wait for it.
+ */
+
+#include <string.h>
+
+#include "host_uart.h"
+#include "host_dma.h"
+#include "host_hw.h"
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+// S1 is read-only to the driver
+static inline void setStatus(UART_Type *base, uint8_t status)
+{
+    *(volatile uint8_t *)&base->S1 = status;
+}
+
+static bool irqTaken(host_uart_t *uart)
+{
+    return !HostHw_IrqMasked() && (NVIC->ISER[0] & (1UL << (uint32_t)uart->irqn));
+}
+
+// The LPSCI enables its requests in C5, the UARTs (SCI variant) select them in C4
+static bool isLpsci(host_uart_t *uart)
+{
+    return (void *)uart->base == (void *)UART0;
+}
+
+static bool rxDma(host_uart_t *uart)
+{
+    return isLpsci(uart) ? (((UART0_Type *)uart->base)->C5 & UART0_C5_RDMAE_MASK) != 0U
+                         : (uart->base->C4 & UART_C4_RDMAS_MASK) != 0U;
+}
+
+static bool txDma(host_uart_t *uart)
+{
+    return isLpsci(uart) ? (((UART0_Type *)uart->base)->C5 & UART0_C5_TDMAE_MASK) != 0U
+                         : (uart->base->C4 & UART_C4_TDMAS_MASK) != 0U;
+}
+
+// A byte in D taken by the receive DMA request, false if no channel answered
+static bool takeByDma(host_uart_t *uart)
+{
+    if (HostDma_Request(uart->rxSource) < 0) {
+        return false;
+    }
+    setStatus(uart->base, UART_S1_TC_MASK);
+    uart->stats.dmaMoves++;
+    uart->stats.received++;
+    return true;
+}
+
+/* See host_uart.h for documentation of this function. */
+void HostUart_Attach(host_uart_t *uart, void *base, IRQn_Type irqn, void (*handler)(void))
+{
+    uart->base = (UART_Type *)base;
+    uart->irqn = irqn;
+    uart->handler = handler;
+    if (isLpsci(uart)) {
+        uart->rxSource = kDmaRequestMux0LPSCI0Rx;
+        uart->txSource = kDmaRequestMux0LPSCI0Tx;
+    } else if ((void *)base == (void *)UART1) {
+        uart->rxSource = kDmaRequestMux0UART1Rx;
+        uart->txSource = kDmaRequestMux0UART1Tx;
+    } else {
+        uart->rxSource = kDmaRequestMux0UART2Rx;
+        uart->txSource = kDmaRequestMux0UART2Tx;
+    }
+    uart->overrun = false;
+    memset(&uart->stats, 0, sizeof(uart->stats));
+    setStatus(uart->base, UART_S1_TC_MASK);
+}
+
+/* See host_uart.h for documentation of this function. */
+bool HostUart_Service(host_uart_t *uart)
+{
+    UART_Type *base = uart->base;
+
+    if (!(base->S1 & UART_S1_RDRF_MASK) || !(base->C2 & UART_C2_RIE_MASK)) {
+        return false;
+    }
+    // An overrun is flagged by interrupt, with or without the DMA select
+    if (rxDma(uart) && !uart->overrun) {
+        return takeByDma(uart);
+    }
+    if (!irqTaken(uart)) {
+        return false;
+    }
+
+    uart->stats.irqs++;
+    if (uart->overrun) {
+        uart->overrun = false;
+        setStatus(base, UART_S1_TC_MASK | UART_S1_OR_MASK);
+        uart->handler();
+        setStatus(base, UART_S1_TC_MASK);
+        return false;
+    }
+
+    // The handler read D; the status is rebuilt, as a write-1-to-clear on plain memory overwrites it
+    uart->handler();
+    setStatus(base, UART_S1_TC_MASK);
+    uart->stats.received++;
+    return true;
+}
+
+/* See host_uart.h for documentation of this function. */
+bool HostUart_Receive(host_uart_t *uart, uint8_t byte)
+{
+    UART_Type *base = uart->base;
+
+    if (!(base->C2 & UART_C2_RE_MASK)) {
+        uart->stats.disabled++;
+        return false;
+    }
+    if (base->S1 & UART_S1_RDRF_MASK) {
+        uart->overrun = true;
+        uart->stats.overruns++;
+        return false;
+    }
+
+    base->D = byte;
+    uart->heldByte = byte;
+    setStatus(base, base->S1 | UART_S1_RDRF_MASK);
+    return HostUart_Service(uart);
+}
+
+/* See host_uart.h for documentation of this function. */
+uint32_t HostUart_Transmit(host_uart_t *uart, uint8_t *data, uint32_t length)
+{
+    UART_Type *base = uart->base;
+    uint32_t sent = 0;
+    uint8_t held;
+
+    if (!(base->C2 & UART_C2_TE_MASK)) {
+        return 0;
+    }
+
+    // A byte held in D with RIE off stays pending
+    held = base->S1 & UART_S1_RDRF_MASK;
+    while ((base->C2 & UART_C2_TIE_MASK) && (sent < length)) {
+        setStatus(base, held | UART_S1_TDRE_MASK | UART_S1_TC_MASK);
+        if (txDma(uart)) {
+            if (HostDma_Request(uart->txSource) < 0) {
+                break;
+            }
+            uart->stats.dmaMoves++;
+        } else if (irqTaken(uart)) {
+            uart->stats.irqs++;
+            uart->handler();
+        } else {
+            break;
+        }
+        data[sent++] = base->D;
+    }
+    if ((base->C2 & UART_C2_TCIE_MASK) && irqTaken(uart)) {
+        setStatus(base, held | UART_S1_TDRE_MASK | UART_S1_TC_MASK);
+        uart->stats.irqs++;
+        uart->handler();
+    }
+    if (held) {
+        base->D = uart->heldByte;
+    }
+    setStatus(base, held | UART_S1_TC_MASK);
+
+    uart->stats.transmitted += sent;
+    return sent;
+}
@@ -0,0 +1,88 @@
+/*
+ * Host model of the far end of a serial line on one UART or LPSCI
+ * Both share the BDH..D register layout. Each received byte sets RDRF and calls the
+ * interrupt handler, as long as the receiver has the interrupt enabled and unmasked;
+ * the transmitter is emptied one byte per TDRE interrupt, as without a FIFO. TDRE is
+ * only set while HostUart_Transmit runs, so a byte the driver writes is never lost
+ * under a received one in the shared D of plain memory; TC stays set in between, for
+ * the deinit functions that wait for it. With the DMA select bits set, RDRF and TDRE
+ * raise DMA requests into the DMA model (host_dma.h) instead of interrupts.
+ */
+
+#ifndef _HOST_UART_H_
+#define _HOST_UART_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "fsl_device_registers.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+typedef struct {
+    uint32_t irqs;              // Interrupts delivered
+    uint32_t received;          // Bytes taken by the receiver
+    uint32_t overruns;          // Bytes that found RDRF still set: lost, as with OR on the target
+    uint32_t disabled;          // Bytes sent while the receiver was off
+    uint32_t transmitted;       // Bytes the transmitter sent
+    uint32_t dmaMoves;          // Bytes a DMA channel moved, to or from D
+} host_uart_stats_t;
+
+typedef struct {
+    UART_Type *base;            // UART1/UART2, or UART0 (the LPSCI) cast
+    IRQn_Type irqn;
+    void (*handler)(void);
+    uint32_t rxSource;          // DMA requests of the instance, dma_request_source_t
+    uint32_t txSource;
+    bool overrun;               // OR to deliver with the next interrupt
+    uint8_t heldByte;           // Last byte received, D is shared with the transmitter
+    host_uart_stats_t stats;
+} host_uart_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief Connect the line to base, whose interrupt is irqn served by handler
+ *
+ * Its DMA requests are those of the instance at base. Clears the statistics.
+ */
+void HostUart_Attach(host_uart_t *uart, void *base, IRQn_Type irqn, void (*handler)(void));
+
+/*!
+ * @brief One byte arrives
+ *
+ * RDRF stays set until an interrupt takes the byte: with RIE off, or the interrupt
+ * masked, the next byte is an overrun. It is lost, and so is the byte held in D:
+ * the next interrupt sees OR with RDRF already clear, as after the driver's drain
+ * loop on the target, which would spin forever on plain memory. With RX DMA selected
+ * a DMA request takes the byte instead.
+ *
+ * @return true if the driver took the byte in an interrupt or a DMA channel did
+ */
+bool HostUart_Receive(host_uart_t *uart, uint8_t byte);
+
+/*!
+ * @brief Deliver the interrupt of a byte left in D by HostUart_Receive, once it can be taken
+ *
+ * After an overrun only OR is delivered.
+ *
+ * @return true if the driver took a byte
+ */
+bool HostUart_Service(host_uart_t *uart);
+
+/*!
+ * @brief Run the transmitter: one TDRE interrupt per byte while TIE is set, then the
+ *        TC interrupt if TCIE is set
+ *
+ * With TX DMA selected each byte is a DMA request instead; the transmitter stops at
+ * the first request no channel answers, as the line goes quiet on the target.
+ *
+ * @return Bytes sent into data, at most length
+ */
+uint32_t HostUart_Transmit(host_uart_t *uart, uint8_t *data, uint32_t length);
+
+#endif /* _HOST_UART_H_ */
@@ -0,0 +1,38 @@
+/*
+ * The CMSIS USART driver of fsl_uart_cmsis.c, built for the host
+ * RTE_Device.h leaves every USART instance off, which leaves Driver_USARTn out of
+ * libfirmware.a: this is a second build with all three on, in their interrupt variants.
+ * Built with HOST_USART_DMA=1 (build/usart_dma) it has USART0 and USART1 on DMA instead.
+ */
+
+#include "RTE_Device.h"
+#include "host_usart_cmsis.h"
+
+#undef RTE_USART0
+#undef RTE_USART1
+#undef RTE_USART2
+#undef RTE_USART0_DMA_EN
+#undef RTE_USART1_DMA_EN
+#undef RTE_USART2_DMA_EN
+
+#if HOST_USART_DMA
+#define RTE_USART0 1
+#define RTE_USART1 1
+#define RTE_USART2 0
+#define RTE_USART0_DMA_EN 1
+#define RTE_USART1_DMA_EN 1
+#define RTE_USART2_DMA_EN 0
+#else
+#define RTE_USART0 1
+#define RTE_USART1 1
+#define RTE_USART2 1
+#define RTE_USART0_DMA_EN 0
+#define RTE_USART1_DMA_EN 0
+#define RTE_USART2_DMA_EN 0
+
+#define RTE_USART1_RX_BUFFER_ENABLE 1
+#define RTE_USART1_RX_BUFFER_SIZE HOST_USART_RX_BUFFER_SIZE
+#define RTE_USART1_RTS_HOOK HostUsart_SetRts1
+#endif /* HOST_USART_DMA */
+
+#include "fsl_uart_cmsis.c"
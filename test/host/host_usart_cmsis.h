@@ -0,0 +1,41 @@
+/*
+ * The CMSIS USART driver of fsl_uart_cmsis.c, built for the host
+ * RTE_Device.h leaves every USART instance off, which leaves Driver_USARTn out of
+ * libfirmware.a: this is a second build with all three on, in their interrupt variants.
+ *   Driver_USART0  LPSCI0, receive straight into the caller's buffer, no RTS line
+ *   Driver_USART1  UART1, HOST_USART_RX_BUFFER_SIZE byte RX ring buffer, RTS through HostUsart_SetRts1
+ *   Driver_USART2  UART2, no ring buffer, no RTS line
+ * Built with HOST_USART_DMA=1, for test_usart_cmsis_dma, it has the DMA variants instead:
+ *   Driver_USART0  LPSCI0, both directions on DMA channels from the DMA manager
+ *   Driver_USART1  UART1, the same
+ * As on the target, the user provides UARTn_GetFreq/InitPins/DeinitPins and the RTS hook.
+ */
+
+#ifndef _HOST_USART_CMSIS_H_
+#define _HOST_USART_CMSIS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Driver_USART.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define HOST_USART_RX_BUFFER_SIZE   16U
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+extern ARM_DRIVER_USART Driver_USART0;
+extern ARM_DRIVER_USART Driver_USART1;
+extern ARM_DRIVER_USART Driver_USART2;
+
+/*!
+ * @brief RTS line of Driver_USART1, active meaning ready to receive (provided by the test)
+ */
+void HostUsart_SetRts1(bool active);
+
+#endif /* _HOST_USART_CMSIS_H_ */
@@ -0,0 +1,178 @@
+/*
+ * Console output sent one ring run per DMA transfer, over the LPSCI and DMA models:
+ * the hand-over from the LPSCI interrupt in DbgConsole_EnableTxDMA, runs split at the
+ * ring end, and a flush that polls the channel with interrupts masked
+ */
+
+#include <string.h>
+
+#include "fsl_debug_console.h"
+#include "fsl_lpsci.h"
+#include "host_hw.h"
+#include "host_uart.h"
+#include "host_dma.h"
+#include "host_check.h"
+
+#define OUT_MAX         2048U
+#define POLL_LIMIT      10000U      // Busy-wait passes before a test gives up on a hung flush
+
+int _write(int handle, char *buffer, int size);
+void UART0_DriverIRQHandler(void);
+
+// The tests run in order on one console: once on DMA it cannot be initialised again
+static host_uart_t s_line;
+static uint8_t s_out[OUT_MAX];
+static uint32_t s_outLength;
+static uint32_t s_written;
+static uint32_t s_polls;
+
+// Every byte printed is its index, so a byte lost, repeated or reordered shows
+static uint8_t expected(uint32_t index)
+{
+    return (uint8_t)(index % 251U);
+}
+
+static void print(uint32_t length)
+{
+    static char buffer[DEBUG_CONSOLE_TX_RING_SIZE];
+
+    for (uint32_t i = 0; i < length; i++) {
+        buffer[i] = (char)expected(s_written + i);
+    }
+    CHECK_EQ(_write(1, buffer, (int)length), length);
+    s_written += length;
+}
+
+static uint32_t drain(uint32_t length)
+{
+    uint32_t sent = HostUart_Transmit(&s_line, &s_out[s_outLength], length);
+
+    s_outLength += sent;
+    return sent;
+}
+
+static void checkOutput(void)
+{
+    CHECK_EQ(s_outLength, s_written);
+    for (uint32_t i = 0; i < s_outLength; i++) {
+        if (s_out[i] != expected(i)) {
+            CHECK_EQ(s_out[i], expected(i));
+            break;
+        }
+    }
+}
+
+// The line sends one byte per busy-wait pass; an interrupt is taken if unmasked
+static void lineRuns(void)
+{
+    if (++s_polls > POLL_LIMIT) {
+        HostHw_Stop();
+    }
+    drain(1U);
+}
+
+static void setUp(void)
+{
+    HostHw_Reset();
+    HostDma_Reset();
+    CHECK_EQ(DbgConsole_Init((uint32_t)UART0, 115200U, DEBUG_CONSOLE_DEVICE_TYPE_LPSCI, 48000000U), kStatus_Success);
+    HostUart_Attach(&s_line, UART0, UART0_IRQn, UART0_DriverIRQHandler);
+}
+
+static void enableDma(void)
+{
+    CHECK_EQ(DbgConsole_EnableTxDMA(DMAMGR_DYNAMIC_ALLOCATE, kDmaRequestMux0LPSCI0Tx), kStatus_Success);
+}
+
+// The run the LPSCI interrupt sends is finished by it, the next goes by DMA
+static void testHandOver(void)
+{
+    uint32_t irqs;
+
+    print(40U);
+    CHECK_EQ(drain(10U), 10);
+    CHECK_EQ(s_line.stats.irqs, 10);
+
+    s_polls = 0;
+    HostHw_SetPollHook(lineRuns);
+    CHECK_EQ(HostHw_Run(enableDma), HOST_RUN_RETURNED);
+    HostHw_SetPollHook(NULL);
+    CHECK_EQ(s_outLength, 40);
+    CHECK_EQ(s_line.stats.dmaMoves, 0);
+
+    irqs = s_line.stats.irqs;
+    print(60U);
+    CHECK_EQ(drain(OUT_MAX), 60);
+    CHECK_EQ(s_line.stats.irqs, irqs);
+    CHECK_EQ(s_line.stats.dmaMoves, 60);
+    CHECK_EQ(HostDma_GetStats()->irqs, 1);
+    checkOutput();
+}
+
+// Output that wraps the ring goes as two runs, one completion interrupt each
+static void testRingWrap(void)
+{
+    uint32_t irqs = HostDma_GetStats()->irqs;
+    uint32_t moves = s_line.stats.dmaMoves;
+
+    print(DEBUG_CONSOLE_TX_RING_SIZE - 56U);
+    CHECK_EQ(drain(OUT_MAX), DEBUG_CONSOLE_TX_RING_SIZE - 56U);
+    CHECK_EQ(HostDma_GetStats()->irqs - irqs, 2);
+    CHECK_EQ(s_line.stats.dmaMoves - moves, DEBUG_CONSOLE_TX_RING_SIZE - 56U);
+    checkOutput();
+
+    // The largest the ring holds, wrapping again
+    irqs = HostDma_GetStats()->irqs;
+    print(DEBUG_CONSOLE_TX_RING_SIZE - 1U);
+    CHECK_EQ(drain(OUT_MAX), DEBUG_CONSOLE_TX_RING_SIZE - 1U);
+    CHECK_EQ(HostDma_GetStats()->irqs - irqs, 2);
+    CHECK_EQ(DbgConsole_GetTxDropCount(), 0);
+    checkOutput();
+}
+
+/*
+ * A flush with interrupts masked serves the completions by polling DONE; the interrupt
+ * they left pending must not release the run started after it
+ */
+static void flushMasked(void)
+{
+    uint32_t primask = DisableGlobalIRQ();
+    const host_dma_stats_t *dma = HostDma_GetStats();
+    uint32_t irqs = dma->irqs;
+    uint32_t stalled = dma->stalled;
+
+    print(DEBUG_CONSOLE_TX_RING_SIZE - 6U);
+    CHECK_EQ(DbgConsole_Flush(), kStatus_Success);
+    CHECK_EQ(s_outLength, s_written);
+    CHECK_EQ(dma->irqs, irqs);
+    CHECK_EQ(dma->stalled - stalled, 2);
+
+    print(20U);
+    EnableGlobalIRQ(primask);
+    HostDma_Service();
+}
+
+static void testFlushMasked(void)
+{
+    uint32_t irqs;
+
+    s_polls = 0;
+    HostHw_SetPollHook(lineRuns);
+    CHECK_EQ(HostHw_Run(flushMasked), HOST_RUN_RETURNED);
+    HostHw_SetPollHook(NULL);
+
+    irqs = HostDma_GetStats()->irqs;
+    CHECK_EQ(drain(OUT_MAX), 20);
+    CHECK_EQ(HostDma_GetStats()->irqs - irqs, 1);
+    checkOutput();
+}
+
+int main(void)
+{
+    printf("test_console_dma\n");
+    setUp();
+    RUN_TEST(testHandOver);
+    RUN_TEST(testRingWrap);
+    RUN_TEST(testFlushMasked);
+    return HostCheck_Result();
+}
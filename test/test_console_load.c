@@ -0,0 +1,354 @@
+/*
+ * Console output under load, over the LPSCI model on the event clock (host_clock.h),
+ * once per DEBUG_CONSOLE_TX_OVERFLOW_POLICY: build/test_console_load is BLOCK, the
+ * _drop and _drop_oldest builds link their own console object.
+ *
+ * A ring overflowed behind a run in flight keeps what the policy says it keeps, the
+ * drop count adds up, and frames from the I2C master are handled as fast with the
+ * console loaded as with it quiet, unless BLOCK has the main loop wait for the line.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "fsl_debug_console.h"
+#include "host_hw.h"
+#include "host_clock.h"
+#include "host_flash.h"
+#include "host_uart.h"
+#include "host_i2c.h"
+#include "host_app.h"
+#include "host_check.h"
+
+#define POLICY          DEBUG_CONSOLE_TX_OVERFLOW_POLICY
+#define RING            DEBUG_CONSOLE_TX_RING_SIZE
+#define CAPACITY        (RING - 1U)
+#define OUT_MAX         2048U
+#define POLL_LIMIT      100000U     // Busy-wait passes before a test gives up on a hung writer
+
+#define SPAN            10U         // Bytes handed to the interrupt before the burst
+#define BURST           300U        // Overflows the ring once under every policy
+
+#define LINE_BYTE_US    87U         // 10 bits at 115200 baud
+#define LINE_RATE       (1000000U / LINE_BYTE_US)  // Bytes per second
+#define SPIN_US         1U          // One pass of a busy-wait loop
+#define FRAME_SIZE      18U         // BUFFER_SIZE of the application
+#define FRAME_PERIOD_US 2500U
+#define RUN_US          1000000U
+#define LOAD_CHUNK      48U         // A log line
+#define LATENCY_SLACK_US 4U         // A few busy-wait passes on a write the frame lands in
+
+int _write(int handle, char *buffer, int size);
+void UART0_DriverIRQHandler(void);
+
+// Not reached: the flash holds no update image
+void AppUpdate_HostStartImage(uint32_t vectors)
+{
+    (void)vectors;
+    HostHw_Stop();
+}
+
+typedef struct {
+    uint32_t frames;            // Frames the slave took to the last byte
+    uint32_t refused;
+    uint32_t handled;           // Frames the main loop was done with
+    uint64_t latencyMaxUs;      // Frame end to the slave re-armed for the next
+} latency_stats_t;
+
+// One console for every test: it cannot be initialised twice
+static host_uart_t s_line;
+static uint8_t s_out[OUT_MAX];
+static uint32_t s_outLength;        // Bytes the line sent since mark(), as far as s_out holds
+static uint32_t s_sent;             // Bytes the line sent since boot: the ring index once empty
+static uint8_t s_expected[OUT_MAX];
+static uint32_t s_expectedLength;
+static uint32_t s_written;          // Bytes printed since boot
+static uint32_t s_polls;
+
+static host_event_t s_lineEvent;
+static host_event_t s_frameEvent;
+static uint64_t s_frameAt;
+static latency_stats_t s_latency;
+static uint32_t s_loadPerSec;
+
+// Every byte printed is its index, so a byte lost, repeated or reordered shows
+static uint8_t pattern(uint32_t index)
+{
+    return (uint8_t)(index % 251U);
+}
+
+static void print(uint32_t length)
+{
+    static char buffer[BURST];
+
+    for (uint32_t i = 0; i < length; i++) {
+        buffer[i] = (char)pattern(s_written + i);
+    }
+    CHECK_EQ(_write(1, buffer, (int)length), length);
+    s_written += length;
+}
+
+static uint32_t drain(uint32_t length)
+{
+    uint8_t byte;
+    uint32_t sent = 0;
+
+    while ((sent < length) && (HostUart_Transmit(&s_line, &byte, 1U) == 1U)) {
+        if (s_outLength < OUT_MAX) {
+            s_out[s_outLength++] = byte;
+        }
+        sent++;
+    }
+    s_sent += sent;
+    return sent;
+}
+
+static void mark(void)
+{
+    s_outLength = 0;
+    s_expectedLength = 0;
+}
+
+static void expect(uint32_t first, uint32_t length)
+{
+    for (uint32_t i = 0; i < length; i++) {
+        s_expected[s_expectedLength++] = pattern(first + i);
+    }
+}
+
+static void checkOutput(void)
+{
+    CHECK_EQ(s_outLength, s_expectedLength);
+    CHECK(memcmp(s_out, s_expected, s_expectedLength) == 0);
+}
+
+static void boot(void)
+{
+    HostApp_Boot();
+    CHECK_EQ(DbgConsole_Init((uint32_t)UART0, 115200U, DEBUG_CONSOLE_DEVICE_TYPE_LPSCI, 48000000U), kStatus_Success);
+}
+
+static void setUp(void)
+{
+    HostFlash_Reset();
+    HostHw_Reset();
+    HostClock_Reset();
+    CHECK_EQ(HostHw_Run(boot), HOST_RUN_RETURNED);
+    HostUart_Attach(&s_line, UART0, UART0_IRQn, UART0_DriverIRQHandler);
+}
+
+/*
+ * Overflow behind a run in flight
+ */
+
+#if (POLICY == DEBUG_CONSOLE_TX_OVERFLOW_BLOCK)
+// The line sends one byte per busy-wait pass, with the interrupt taken if unmasked
+static void lineRuns(void)
+{
+    if (++s_polls > POLL_LIMIT) {
+        HostHw_Stop();
+    }
+    drain(1U);
+}
+#endif
+
+static void printBurst(void)
+{
+    print(BURST);
+}
+
+// Empty the ring with its head at index, by sending filler through it
+static void emptyAt(uint32_t index)
+{
+    print((index + RING - s_sent % RING) % RING);
+    drain(OUT_MAX);
+    CHECK_EQ(s_sent, s_written - DbgConsole_GetTxDropCount());
+}
+
+/*
+ * SPAN bytes go to the interrupt as one run, cut short at the ring end, and a BURST
+ * follows before the line sends any: only BLOCK waits for it
+ */
+static void overflowBehindRun(uint32_t index)
+{
+    uint32_t dropped = DbgConsole_GetTxDropCount();
+    uint32_t inFlight = (SPAN < RING - index) ? SPAN : RING - index;
+    uint32_t first;
+
+    emptyAt(index);
+    mark();
+    first = s_written;
+    print(SPAN);
+
+#if (POLICY == DEBUG_CONSOLE_TX_OVERFLOW_BLOCK)
+    (void)inFlight;
+    s_polls = 0;
+    HostHw_SetPollHook(lineRuns);
+    CHECK_EQ(HostHw_Run(printBurst), HOST_RUN_RETURNED);
+    HostHw_SetPollHook(NULL);
+    expect(first, SPAN + BURST);
+    CHECK_EQ(DbgConsole_GetTxDropCount() - dropped, 0);
+#elif (POLICY == DEBUG_CONSOLE_TX_OVERFLOW_DROP)
+    (void)inFlight;
+    printBurst();
+    expect(first, CAPACITY);
+    CHECK_EQ(DbgConsole_GetTxDropCount() - dropped, SPAN + BURST - CAPACITY);
+#else
+    // The byte that finds the ring full rewinds head to the end of the run in flight
+    printBurst();
+    expect(first, inFlight);
+    expect(first + CAPACITY, SPAN + BURST - CAPACITY);
+    CHECK_EQ(DbgConsole_GetTxDropCount() - dropped, CAPACITY - inFlight);
+#endif
+
+    drain(OUT_MAX);
+    checkOutput();
+}
+
+static void testOverflowAtRingStart(void)
+{
+    overflowBehindRun(0U);
+}
+
+// The run in flight stops at the ring end: what is kept starts over at index 0
+static void testOverflowAtRingEnd(void)
+{
+    overflowBehindRun(RING - SPAN / 2U);
+}
+
+/*
+ * Frame handling under console load
+ */
+
+// The line sends a byte per character time, whenever the driver has one for it
+static void lineByte(host_event_t *event)
+{
+    drain(1U);
+    HostClock_Schedule(event, HostClock_Now() + LINE_BYTE_US);
+}
+
+// A busy-wait pass takes time, in which the line and the bus go on
+static void spin(void)
+{
+    if (++s_polls > POLL_LIMIT) {
+        HostHw_Stop();
+    }
+    HostClock_Advance(SPIN_US);
+}
+
+static void sendFrame(host_event_t *event)
+{
+    uint8_t frame[FRAME_SIZE] = {1, 0, '1', '0', '.', '0', '.', '0', '.', '1'};
+
+    if (HostI2c_Write(HOST_APP_I2C_ADDRESS, frame, FRAME_SIZE) == (int32_t)FRAME_SIZE) {
+        s_latency.frames++;
+        s_frameAt = HostClock_Now();
+    } else {
+        s_latency.refused++;
+    }
+    HostClock_Schedule(event, HostClock_Now() + FRAME_PERIOD_US);
+}
+
+/*
+ * Main loop passes for RUN_US, with up to s_loadPerSec bytes of other console output
+ * a second printed between them, LOAD_CHUNK at a time
+ */
+static void runLoaded(void)
+{
+    uint64_t start = HostClock_Now();
+    uint64_t printed = 0;
+
+    while (HostClock_Now() - start < RUN_US) {
+        uint32_t packets = HostApp_GetPacketCount();
+
+        s_polls = 0;
+        HostApp_Poll(1);
+        if (HostApp_GetPacketCount() != packets) {
+            s_latency.handled++;
+            if (HostClock_Now() - s_frameAt > s_latency.latencyMaxUs) {
+                s_latency.latencyMaxUs = HostClock_Now() - s_frameAt;
+            }
+        }
+        // A line a pass at most: under BLOCK the printing code is held back too
+        if ((printed + LOAD_CHUNK) * 1000000U <= (HostClock_Now() - start) * s_loadPerSec) {
+            s_polls = 0;
+            print(LOAD_CHUNK);
+            printed += LOAD_CHUNK;
+        }
+    }
+}
+
+static void flush(void)
+{
+    CHECK_EQ(DbgConsole_Flush(), kStatus_Success);
+}
+
+/*
+ * Frames every FRAME_PERIOD_US for RUN_US against loadPerSec of console output; every
+ * byte printed is sent or counted as dropped
+ */
+static latency_stats_t measure(uint32_t loadPerSec)
+{
+    uint32_t written = s_written;
+    uint32_t sent = s_sent;
+    uint32_t dropped = DbgConsole_GetTxDropCount();
+
+    memset(&s_latency, 0, sizeof(s_latency));
+    s_loadPerSec = loadPerSec;
+    HostHw_SetPollHook(spin);
+    s_lineEvent.fn = lineByte;
+    s_frameEvent.fn = sendFrame;
+    HostClock_Schedule(&s_lineEvent, HostClock_Now() + LINE_BYTE_US);
+    HostClock_Schedule(&s_frameEvent, HostClock_Now() + FRAME_PERIOD_US / 2U);
+    CHECK_EQ(HostHw_Run(runLoaded), HOST_RUN_RETURNED);
+
+    HostClock_Cancel(&s_frameEvent);
+    s_polls = 0;
+    CHECK_EQ(HostHw_Run(flush), HOST_RUN_RETURNED);
+    HostClock_Cancel(&s_lineEvent);
+    HostHw_SetPollHook(NULL);
+
+    CHECK_EQ((s_sent - sent) + (DbgConsole_GetTxDropCount() - dropped), s_written - written);
+    printf("    %5lu B/s: %lu frames, %lu refused, worst latency %lu us, %lu dropped\n", (unsigned long)loadPerSec,
+           (unsigned long)s_latency.frames, (unsigned long)s_latency.refused, (unsigned long)s_latency.latencyMaxUs,
+           (unsigned long)(DbgConsole_GetTxDropCount() - dropped));
+    return s_latency;
+}
+
+static void testFrameLatencyUnderLoad(void)
+{
+    latency_stats_t quiet = measure(0U);
+    latency_stats_t loaded;
+
+    CHECK(quiet.frames > 0U);
+    CHECK_EQ(quiet.refused, 0);
+    CHECK_EQ(quiet.handled, quiet.frames);
+
+#if (POLICY == DEBUG_CONSOLE_TX_OVERFLOW_BLOCK)
+    // Within the line rate the ring takes the bursts, past it the main loop waits
+    loaded = measure(LINE_RATE * 3U / 4U);
+    CHECK_EQ(loaded.refused, 0);
+    CHECK(loaded.latencyMaxUs <= quiet.latencyMaxUs + LATENCY_SLACK_US);
+
+    loaded = measure(LINE_RATE * 2U);
+    CHECK(loaded.latencyMaxUs > quiet.latencyMaxUs + LINE_BYTE_US);
+    CHECK(loaded.refused > 0U);
+#else
+    // Twice what the line can send: the excess is dropped, frames see no difference
+    loaded = measure(LINE_RATE * 2U);
+    CHECK(DbgConsole_GetTxDropCount() > 0U);
+    CHECK_EQ(loaded.refused, 0);
+    CHECK_EQ(loaded.handled, loaded.frames);
+    CHECK(loaded.latencyMaxUs <= quiet.latencyMaxUs + LATENCY_SLACK_US);
+#endif
+}
+
+int main(void)
+{
+    printf("test_console_load: overflow policy %u\n", POLICY);
+    setUp();
+    RUN_TEST(testOverflowAtRingStart);
+    RUN_TEST(testOverflowAtRingEnd);
+    RUN_TEST(testFrameLatencyUnderLoad);
+    return HostCheck_Result();
+}
@@ -0,0 +1,351 @@
+/*
+ * DMA channel manager over the DMA model: allocation order and errors, release,
+ * completion interrupts routed to the owning handle, reclaim on completion, and
+ * clients contending for the four channels from thread and interrupt context
+ */
+
+#include <string.h>
+
+#include "fsl_dma_manager.h"
+#include "host_hw.h"
+#include "host_dma.h"
+#include "host_check.h"
+
+#define CHANNELS        FSL_FEATURE_DMA_MODULE_CHANNEL
+#define CLIENTS         6U
+#define COPY_BYTES      32U
+#define ROUNDS          20000U
+
+typedef struct {
+    dma_handle_t handle;
+    bool owner;                     // Holds a channel, as the test believes
+    bool busy;                      // A copy is running on it
+    bool reclaim;                   // The copy was requested with releaseOnCompletion
+    bool again;                     // Request a channel again from the completion callback
+    uint32_t submitted;
+    uint32_t completed;
+    uint32_t aborted;               // Released with the copy still running
+    uint32_t misrouted;             // Callbacks that came with another client's handle
+    uint8_t src[COPY_BYTES];
+    uint8_t dst[COPY_BYTES];
+} client_t;
+
+static client_t s_clients[CLIENTS];
+static uint32_t s_random;
+
+/*
+ * Set up
+ */
+
+static uint32_t nextRandom(void)
+{
+    s_random = s_random * 1103515245U + 12345U;
+    return s_random >> 16;
+}
+
+static void setUp(void)
+{
+    HostHw_Reset();
+    HostDma_Reset();
+    memset(s_clients, 0, sizeof(s_clients));
+    s_random = 1;
+}
+
+// Every test gives back what it took, the manager state outlives HostHw_Reset
+static void tearDown(void)
+{
+    for (uint32_t i = 0; i < CLIENTS; i++) {
+        if (s_clients[i].owner) {
+            CHECK_EQ(DMAMGR_ReleaseChannel(&s_clients[i].handle), kStatus_Success);
+            s_clients[i].owner = false;
+        }
+    }
+    for (uint32_t channel = 0; channel < CHANNELS; channel++) {
+        CHECK(!DMAMGR_IsChannelOccupied(channel));
+    }
+}
+
+static status_t request(client_t *client, uint32_t channel, dmamgr_channel_priority_t priority, bool reclaim);
+
+static void copyDone(dma_handle_t *handle, void *userData)
+{
+    client_t *client = (client_t *)userData;
+
+    if (handle != &client->handle) {
+        client->misrouted++;
+        return;
+    }
+    client->completed++;
+    client->busy = false;
+    CHECK(memcmp(client->dst, client->src, COPY_BYTES) == 0);
+
+    if (client->reclaim) {
+        // Already free when the callback runs
+        CHECK(!DMAMGR_IsChannelOccupied(handle->channel));
+        CHECK_EQ(DMAMGR_ReleaseChannel(handle), kStatus_DMAMGR_ChannelNotUsed);
+        client->owner = false;
+        if (client->again) {
+            client->again = false;
+            CHECK_EQ(request(client, DMAMGR_DYNAMIC_ALLOCATE, kDMAMGR_PriorityLow, false), kStatus_Success);
+        }
+    }
+}
+
+static status_t request(client_t *client, uint32_t channel, dmamgr_channel_priority_t priority, bool reclaim)
+{
+    dmamgr_channel_config_t config;
+    status_t status;
+
+    DMAMGR_GetDefaultChannelConfig(&config);
+    config.channel = channel;
+    config.priority = priority;
+    config.releaseOnCompletion = reclaim;
+    config.callback = copyDone;
+    config.userData = client;
+    status = DMAMGR_RequestChannel(&client->handle, &config);
+    if (status == kStatus_Success) {
+        client->owner = true;
+        client->reclaim = reclaim;
+    }
+    return status;
+}
+
+// A memory to memory copy on the client's channel, run by HostDma_Run
+static void startCopy(client_t *client, uint32_t seed)
+{
+    dma_transfer_config_t config;
+
+    for (uint32_t i = 0; i < COPY_BYTES; i++) {
+        client->src[i] = (uint8_t)(seed + i * 7U);
+    }
+    memset(client->dst, 0, COPY_BYTES);
+    DMA_PrepareTransfer(&config, client->src, 4U, client->dst, 4U, COPY_BYTES, kDMA_MemoryToMemory);
+    CHECK_EQ(DMA_SubmitTransfer(&client->handle, &config, kDMA_EnableInterrupt), kStatus_Success);
+    DMA_StartTransfer(&client->handle);
+    client->busy = true;
+    client->submitted++;
+}
+
+/*
+ * Tests
+ */
+
+// Low priority takes the highest free channel, high priority the lowest
+static void testDynamicAllocation(void)
+{
+    setUp();
+    CHECK_EQ(request(&s_clients[0], DMAMGR_DYNAMIC_ALLOCATE, kDMAMGR_PriorityLow, false), kStatus_Success);
+    CHECK_EQ(s_clients[0].handle.channel, 3);
+    CHECK_EQ(request(&s_clients[1], DMAMGR_DYNAMIC_ALLOCATE, kDMAMGR_PriorityHigh, false), kStatus_Success);
+    CHECK_EQ(s_clients[1].handle.channel, 0);
+    CHECK_EQ(request(&s_clients[2], DMAMGR_DYNAMIC_ALLOCATE, kDMAMGR_PriorityLow, false), kStatus_Success);
+    CHECK_EQ(s_clients[2].handle.channel, 2);
+    CHECK_EQ(request(&s_clients[3], DMAMGR_DYNAMIC_ALLOCATE, kDMAMGR_PriorityLow, false), kStatus_Success);
+    CHECK_EQ(s_clients[3].handle.channel, 1);
+
+    CHECK_EQ(request(&s_clients[4], DMAMGR_DYNAMIC_ALLOCATE, kDMAMGR_PriorityHigh, false),
+             kStatus_DMAMGR_NoFreeChannel);
+    CHECK(!s_clients[4].owner);
+
+    // A freed channel is the next one handed out
+    CHECK_EQ(DMAMGR_ReleaseChannel(&s_clients[2].handle), kStatus_Success);
+    s_clients[2].owner = false;
+    CHECK_EQ(request(&s_clients[4], DMAMGR_DYNAMIC_ALLOCATE, kDMAMGR_PriorityHigh, false), kStatus_Success);
+    CHECK_EQ(s_clients[4].handle.channel, 2);
+    tearDown();
+}
+
+static void testFixedChannel(void)
+{
+    setUp();
+    CHECK_EQ(request(&s_clients[0], 2U, kDMAMGR_PriorityLow, false), kStatus_Success);
+    CHECK_EQ(s_clients[0].handle.channel, 2);
+    CHECK(DMAMGR_IsChannelOccupied(2));
+    CHECK_EQ(request(&s_clients[1], 2U, kDMAMGR_PriorityLow, false), kStatus_DMAMGR_ChannelOccupied);
+    CHECK_EQ(request(&s_clients[1], CHANNELS, kDMAMGR_PriorityLow, false), kStatus_InvalidArgument);
+    CHECK(DMAMGR_IsChannelOccupied(CHANNELS));
+
+    // Dynamic requests go around it
+    CHECK_EQ(request(&s_clients[1], DMAMGR_DYNAMIC_ALLOCATE, kDMAMGR_PriorityLow, false), kStatus_Success);
+    CHECK_EQ(s_clients[1].handle.channel, 3);
+    CHECK_EQ(request(&s_clients[2], DMAMGR_DYNAMIC_ALLOCATE, kDMAMGR_PriorityLow, false), kStatus_Success);
+    CHECK_EQ(s_clients[2].handle.channel, 1);
+
+    // The routing follows the owner's request source
+    CHECK_EQ(DMAMUX0->CHCFG[2], DMAMUX_CHCFG_ENBL_MASK | ((uint32_t)kDmaRequestMux0AlwaysOn60 & 0x3FU));
+    tearDown();
+}
+
+/*
+ * Release: the transfer stops, its interrupt is disabled and a pending one dropped,
+ * the routing removed; only the owner can release, once
+ */
+static void testRelease(void)
+{
+    client_t *first = &s_clients[0];
+    client_t *next = &s_clients[1];
+
+    setUp();
+    CHECK_EQ(request(first, 1U, kDMAMGR_PriorityLow, false), kStatus_Success);
+    CHECK_EQ(DMAMGR_ReleaseChannel(&next->handle), kStatus_DMAMGR_ChannelNotUsed);
+
+    // The copy finishes with interrupts masked, its interrupt stays pending
+    startCopy(first, 1);
+    __disable_irq();
+    HostDma_Run();
+    CHECK_EQ(HostDma_GetStats()->stalled, 1);
+    CHECK_EQ(DMAMGR_ReleaseChannel(&first->handle), kStatus_Success);
+    first->owner = false;
+    __enable_irq();
+    CHECK_EQ(DMAMGR_ReleaseChannel(&first->handle), kStatus_DMAMGR_ChannelNotUsed);
+
+    CHECK_EQ(DMAMUX0->CHCFG[1] & DMAMUX_CHCFG_ENBL_MASK, 0);
+    CHECK_EQ(NVIC->ISER[0] & (1UL << DMA1_IRQn), 0);
+    CHECK_EQ(NVIC->ISPR[0] & (1UL << DMA1_IRQn), 0);
+
+    // The next owner of the channel never sees the old completion
+    CHECK_EQ(request(next, 1U, kDMAMGR_PriorityLow, false), kStatus_Success);
+    HostDma_Service();
+    CHECK_EQ(first->completed, 0);
+    CHECK_EQ(next->completed, 0);
+    CHECK_EQ(HostDma_GetStats()->irqs, 0);
+
+    // A running copy is aborted: nothing more moves
+    startCopy(next, 2);
+    CHECK_EQ(DMAMGR_ReleaseChannel(&next->handle), kStatus_Success);
+    next->owner = false;
+    HostDma_Run();
+    CHECK_EQ(next->completed, 0);
+    CHECK_EQ(next->dst[0], 0);
+    tearDown();
+}
+
+// Every channel busy at once, each completion reaches the handle that owns the channel
+static void testInterruptRouting(void)
+{
+    setUp();
+    for (uint32_t i = 0; i < CHANNELS; i++) {
+        CHECK_EQ(request(&s_clients[i], DMAMGR_DYNAMIC_ALLOCATE, (dmamgr_channel_priority_t)(i & 1U), false),
+                 kStatus_Success);
+        startCopy(&s_clients[i], i * 31U);
+    }
+    HostDma_Run();
+    for (uint32_t i = 0; i < CHANNELS; i++) {
+        CHECK_EQ(s_clients[i].completed, 1);
+        CHECK_EQ(s_clients[i].misrouted, 0);
+        CHECK(DMAMGR_IsChannelOccupied(s_clients[i].handle.channel));
+    }
+    CHECK_EQ(HostDma_GetStats()->irqs, CHANNELS);
+    tearDown();
+}
+
+// The channel is free before the callback runs, which can take one again
+static void testReleaseOnCompletion(void)
+{
+    client_t *client = &s_clients[0];
+
+    setUp();
+    CHECK_EQ(request(client, DMAMGR_DYNAMIC_ALLOCATE, kDMAMGR_PriorityLow, true), kStatus_Success);
+    CHECK_EQ(client->handle.channel, 3);
+    client->again = true;
+    startCopy(client, 3);
+    HostDma_Run();
+    CHECK_EQ(client->completed, 1);
+    CHECK(client->owner);
+    CHECK(!client->reclaim);
+    CHECK_EQ(client->handle.channel, 3);
+
+    // Without reclaim the channel stays after the next copy
+    startCopy(client, 4);
+    HostDma_Run();
+    CHECK_EQ(client->completed, 2);
+    CHECK(DMAMGR_IsChannelOccupied(3));
+    tearDown();
+}
+
+/*
+ * Clients request, copy and release at random, some copies reclaiming their channel
+ * and requesting again from the callback, some completing with interrupts masked.
+ * No channel is ever held twice, every copy completes once on its own handle, and
+ * the manager agrees with the owners at every step.
+ */
+static void testContention(void)
+{
+    uint32_t refused = 0;
+    uint32_t submitted = 0;
+    uint32_t completed = 0;
+    uint32_t aborted = 0;
+
+    setUp();
+    for (uint32_t round = 0; round < ROUNDS; round++) {
+        client_t *client = &s_clients[nextRandom() % CLIENTS];
+        uint32_t action = nextRandom() % 8U;
+        bool owners[CHANNELS] = {false};
+
+        if (!client->owner) {
+            bool reclaim = (nextRandom() & 1U) != 0U;
+            status_t status = request(client, DMAMGR_DYNAMIC_ALLOCATE, (dmamgr_channel_priority_t)(nextRandom() & 1U),
+                                      reclaim);
+
+            if (status != kStatus_Success) {
+                CHECK_EQ(status, kStatus_DMAMGR_NoFreeChannel);
+                refused++;
+            } else {
+                client->again = reclaim && ((nextRandom() & 3U) == 0U);
+            }
+        } else if (!client->busy && (action < 5U)) {
+            startCopy(client, round);
+        } else if (action == 5U) {
+            // Give it back, a running copy with it
+            if (client->busy) {
+                client->aborted++;
+                client->busy = false;
+            }
+            CHECK_EQ(DMAMGR_ReleaseChannel(&client->handle), kStatus_Success);
+            client->owner = false;
+        } else if (action == 6U) {
+            __disable_irq();
+            HostDma_Run();
+            __enable_irq();
+            HostDma_Service();
+        } else {
+            HostDma_Run();
+        }
+
+        // At most one owner per channel, the manager agrees with the owners
+        for (uint32_t i = 0; i < CLIENTS; i++) {
+            if (s_clients[i].owner) {
+                CHECK(!owners[s_clients[i].handle.channel]);
+                owners[s_clients[i].handle.channel] = true;
+            }
+        }
+        for (uint32_t channel = 0; channel < CHANNELS; channel++) {
+            CHECK_EQ(DMAMGR_IsChannelOccupied(channel), owners[channel]);
+        }
+    }
+    HostDma_Run();
+
+    for (uint32_t i = 0; i < CLIENTS; i++) {
+        CHECK_EQ(s_clients[i].misrouted, 0);
+        CHECK(!s_clients[i].busy);
+        submitted += s_clients[i].submitted;
+        completed += s_clients[i].completed;
+        aborted += s_clients[i].aborted;
+    }
+    printf("  %u copies, %u aborted by a release, %u requests refused\n", submitted, aborted, refused);
+    CHECK_EQ(completed + aborted, submitted);
+    CHECK(refused > 0U);
+    tearDown();
+}
+
+int main(void)
+{
+    printf("test_dma_manager\n");
+    RUN_TEST(testDynamicAllocation);
+    RUN_TEST(testFixedChannel);
+    RUN_TEST(testRelease);
+    RUN_TEST(testInterruptRouting);
+    RUN_TEST(testReleaseOnCompletion);
+    RUN_TEST(testContention);
+    return HostCheck_Result();
+}
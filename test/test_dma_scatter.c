@@ -0,0 +1,321 @@
+/*
+ * Scatter-gather DMA sends over the UART, LPSCI and DMA models: a header and a payload
+ * sent as one transfer, empty segments anywhere, the counts at every segment
+ * boundary, a busy channel and a segment that ends on a bus error
+ */
+
+#include <string.h>
+
+#include "fsl_uart_dma.h"
+#include "fsl_lpsci_dma.h"
+#include "fsl_dma_manager.h"
+#include "host_hw.h"
+#include "host_uart.h"
+#include "host_dma.h"
+#include "host_check.h"
+
+#define LINE_MAX        64U
+
+// Segments are static: the channel registers hold 32-bit addresses, the host stack is above 4 GB
+
+// The calls under test, on one driver
+typedef struct {
+    const char *name;
+    void *base;
+    IRQn_Type irqn;
+    void (*handler)(void);
+    uint32_t txSource;
+    void (*setUp)(void);
+    status_t (*send)(const dma_sg_segment_t *segments, uint32_t count);
+    status_t (*sendCount)(uint32_t *count);
+} driver_t;
+
+static const driver_t *s_driver;
+static host_uart_t s_line;
+static dma_handle_t s_txDma;
+static uart_dma_handle_t s_uartHandle;
+static lpsci_dma_handle_t s_lpsciHandle;
+static uint32_t s_callbacks;
+static status_t s_lastStatus;
+
+void UART1_DriverIRQHandler(void);
+void UART0_DriverIRQHandler(void);
+
+static void uartCallback(UART_Type *base, uart_dma_handle_t *handle, status_t status, void *userData)
+{
+    s_callbacks++;
+    s_lastStatus = status;
+}
+
+static void lpsciCallback(UART0_Type *base, lpsci_dma_handle_t *handle, status_t status, void *userData)
+{
+    s_callbacks++;
+    s_lastStatus = status;
+}
+
+/*
+ * UART1
+ */
+
+static void uartSetUp(void)
+{
+    uart_config_t config;
+
+    UART_GetDefaultConfig(&config);
+    config.enableTx = true;
+    UART_Init(UART1, &config, 24000000U);
+    UART_TransferCreateHandleDMA(UART1, &s_uartHandle, uartCallback, NULL, &s_txDma, NULL);
+}
+
+static status_t uartSend(const dma_sg_segment_t *segments, uint32_t count)
+{
+    return UART_TransferSendSegmentsDMA(UART1, &s_uartHandle, segments, count);
+}
+
+static status_t uartSendCount(uint32_t *count)
+{
+    return UART_TransferGetSendCountDMA(UART1, &s_uartHandle, count);
+}
+
+/*
+ * LPSCI (UART0)
+ */
+
+static void lpsciSetUp(void)
+{
+    lpsci_config_t config;
+
+    LPSCI_GetDefaultConfig(&config);
+    config.enableTx = true;
+    LPSCI_Init(UART0, &config, 48000000U);
+    LPSCI_TransferCreateHandleDMA(UART0, &s_lpsciHandle, lpsciCallback, NULL, &s_txDma, NULL);
+}
+
+static status_t lpsciSend(const dma_sg_segment_t *segments, uint32_t count)
+{
+    return LPSCI_TransferSendSegmentsDMA(UART0, &s_lpsciHandle, segments, count);
+}
+
+static status_t lpsciSendCount(uint32_t *count)
+{
+    return LPSCI_TransferGetSendCountDMA(UART0, &s_lpsciHandle, count);
+}
+
+static const driver_t s_drivers[] = {
+    {"uart1", UART1, UART1_IRQn, UART1_DriverIRQHandler, kDmaRequestMux0UART1Tx, uartSetUp, uartSend,
+     uartSendCount},
+    {"lpsci", UART0, UART0_IRQn, UART0_DriverIRQHandler, kDmaRequestMux0LPSCI0Tx, lpsciSetUp, lpsciSend,
+     lpsciSendCount},
+};
+
+/*
+ * Set up
+ */
+
+static void setUp(const driver_t *driver)
+{
+    dmamgr_channel_config_t config;
+
+    HostHw_Reset();
+    HostDma_Reset();
+    s_driver = driver;
+    s_callbacks = 0;
+    s_lastStatus = kStatus_Fail;
+
+    DMAMGR_GetDefaultChannelConfig(&config);
+    config.requestSource = driver->txSource;
+    CHECK_EQ(DMAMGR_RequestChannel(&s_txDma, &config), kStatus_Success);
+    driver->setUp();
+    HostUart_Attach(&s_line, driver->base, driver->irqn, driver->handler);
+}
+
+static void tearDown(void)
+{
+    CHECK_EQ(DMAMGR_ReleaseChannel(&s_txDma), kStatus_Success);
+}
+
+static uint32_t totalSize(const dma_sg_segment_t *segments, uint32_t count)
+{
+    uint32_t total = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        total += segments[i].dataSize;
+    }
+    return total;
+}
+
+// Count the driver and the DMA driver report after sent bytes
+static void checkCounts(uint32_t sent, uint32_t total)
+{
+    uint32_t count = 0xFFFFFFFFU;
+
+    CHECK_EQ(DMA_GetTransferRemainingBytes(&s_txDma), total - sent);
+    CHECK_EQ(s_driver->sendCount(&count), kStatus_Success);
+    CHECK_EQ(count, sent);
+}
+
+/*
+ * Send segments one by one, checking the counts before, inside and after each: the
+ * line stops at every boundary, where the channel interrupt has loaded the next one
+ */
+static void sendAndCheck(const dma_sg_segment_t *segments, uint32_t count)
+{
+    uint8_t line[LINE_MAX];
+    uint8_t expected[LINE_MAX];
+    uint32_t total = totalSize(segments, count);
+    uint32_t sent = 0;
+    uint32_t countAfter;
+
+    for (uint32_t i = 0; i < count; i++) {
+        memcpy(&expected[sent], segments[i].data, segments[i].dataSize);
+        sent += segments[i].dataSize;
+    }
+    sent = 0;
+
+    CHECK_EQ(s_driver->send(segments, count), kStatus_Success);
+    checkCounts(0, total);
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t size = segments[i].dataSize;
+
+        if (size == 0U) {
+            continue;
+        }
+        if (size > 1U) {
+            CHECK_EQ(HostUart_Transmit(&s_line, &line[sent], 1U), 1);
+            sent++;
+            size--;
+            checkCounts(sent, total);
+        }
+        CHECK_EQ(HostUart_Transmit(&s_line, &line[sent], size), size);
+        sent += size;
+        if (sent < total) {
+            CHECK_EQ(s_callbacks, 0);
+            checkCounts(sent, total);
+        }
+    }
+
+    // The last segment ends the send: one callback, the request is off, nothing more goes out
+    CHECK_EQ(sent, total);
+    CHECK(memcmp(line, expected, total) == 0);
+    CHECK_EQ(s_callbacks, 1);
+    CHECK_EQ(s_lastStatus, (s_driver->base == (void *)UART0) ? kStatus_LPSCI_TxIdle : kStatus_UART_TxIdle);
+    CHECK_EQ(s_driver->sendCount(&countAfter), kStatus_NoTransferInProgress);
+    CHECK_EQ(HostUart_Transmit(&s_line, line, 1U), 0);
+    CHECK_EQ(HostDma_GetStats()->stalled, 0);
+}
+
+/*
+ * Tests
+ */
+
+static void testHeaderAndPayload(void)
+{
+    static uint8_t header[4] = {0xA5, 0x02, 0x00, 0x0B};
+    static uint8_t payload[11] = "hello world";
+    dma_sg_segment_t segments[] = {{header, sizeof(header)}, {payload, sizeof(payload)}};
+
+    for (uint32_t d = 0; d < ARRAY_SIZE(s_drivers); d++) {
+        setUp(&s_drivers[d]);
+        sendAndCheck(segments, ARRAY_SIZE(segments));
+        CHECK_EQ(s_line.stats.dmaMoves, sizeof(header) + sizeof(payload));
+
+        // Again on the same handle, with a one byte header
+        s_callbacks = 0;
+        segments[0].dataSize = 1U;
+        sendAndCheck(segments, ARRAY_SIZE(segments));
+        segments[0].dataSize = sizeof(header);
+        tearDown();
+    }
+}
+
+static void testEmptySegments(void)
+{
+    static uint8_t a[3] = {1, 2, 3};
+    static uint8_t b[1] = {4};
+    static uint8_t c[5] = {5, 6, 7, 8, 9};
+    const dma_sg_segment_t leading[] = {{a, 0}, {a, 0}, {b, sizeof(b)}, {c, sizeof(c)}};
+    const dma_sg_segment_t middle[] = {{a, sizeof(a)}, {b, 0}, {b, 0}, {c, sizeof(c)}};
+    const dma_sg_segment_t trailing[] = {{a, sizeof(a)}, {c, sizeof(c)}, {b, 0}, {b, 0}};
+    const dma_sg_segment_t everywhere[] = {{a, 0}, {a, sizeof(a)}, {b, 0}, {b, sizeof(b)}, {c, 0},
+                                           {c, sizeof(c)}, {c, 0}};
+    const dma_sg_segment_t none[] = {{a, 0}, {b, 0}};
+    uint32_t count;
+
+    for (uint32_t d = 0; d < ARRAY_SIZE(s_drivers); d++) {
+        setUp(&s_drivers[d]);
+        sendAndCheck(leading, ARRAY_SIZE(leading));
+        s_callbacks = 0;
+        sendAndCheck(middle, ARRAY_SIZE(middle));
+        s_callbacks = 0;
+        sendAndCheck(trailing, ARRAY_SIZE(trailing));
+        s_callbacks = 0;
+        sendAndCheck(everywhere, ARRAY_SIZE(everywhere));
+
+        // Nothing to send is refused and leaves the handle idle
+        s_callbacks = 0;
+        CHECK_EQ(s_driver->send(none, ARRAY_SIZE(none)), kStatus_InvalidArgument);
+        CHECK_EQ(s_driver->sendCount(&count), kStatus_NoTransferInProgress);
+        sendAndCheck(middle, ARRAY_SIZE(middle));
+        tearDown();
+    }
+}
+
+// A channel still busy refuses the submit: the handle stays idle and takes the next send
+static void testBusyChannel(void)
+{
+    static uint8_t data[6] = {1, 2, 3, 4, 5, 6};
+    const dma_sg_segment_t segments[] = {{data, 2}, {&data[2], 4}};
+    uint8_t line[LINE_MAX];
+    uint32_t count;
+
+    for (uint32_t d = 0; d < ARRAY_SIZE(s_drivers); d++) {
+        setUp(&s_drivers[d]);
+        DMA0->DMA[s_txDma.channel].DSR_BCR |= DMA_DSR_BCR_BSY_MASK;
+        CHECK_EQ(s_driver->send(segments, ARRAY_SIZE(segments)), kStatus_DMA_Busy);
+        CHECK_EQ(s_driver->sendCount(&count), kStatus_NoTransferInProgress);
+        CHECK_EQ(HostUart_Transmit(&s_line, line, sizeof(line)), 0);
+        CHECK_EQ(s_callbacks, 0);
+
+        DMA0->DMA[s_txDma.channel].DSR_BCR &= ~DMA_DSR_BCR_BSY_MASK;
+        sendAndCheck(segments, ARRAY_SIZE(segments));
+        tearDown();
+    }
+}
+
+// A bus error in a segment ends the chain there, the callback is told at once
+static void testSegmentError(void)
+{
+    static uint8_t data[12] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    const dma_sg_segment_t segments[] = {{data, 4}, {&data[4], 4}, {&data[8], 4}};
+    uint8_t line[LINE_MAX];
+
+    for (uint32_t d = 0; d < ARRAY_SIZE(s_drivers); d++) {
+        setUp(&s_drivers[d]);
+        CHECK_EQ(s_driver->send(segments, ARRAY_SIZE(segments)), kStatus_Success);
+        CHECK_EQ(HostUart_Transmit(&s_line, line, 4U), 4);
+        CHECK_EQ(HostUart_Transmit(&s_line, line, 2U), 2);
+
+        // The rest of the second segment reads from a faulting address
+        DMA0->DMA[s_txDma.channel].DSR_BCR |= DMA_DSR_BCR_BES_MASK;
+        CHECK_EQ(HostUart_Transmit(&s_line, line, sizeof(line)), 2);
+        CHECK_EQ(s_callbacks, 1);
+        CHECK(s_txDma.status & kDMA_BusErrorOnSourceFlag);
+        CHECK_EQ(DMA0->DMA[s_txDma.channel].DCR & DMA_DCR_ERQ_MASK, 0);
+        CHECK_EQ(DMA_GetTransferRemainingBytes(&s_txDma), 0);
+
+        // The third segment is not loaded, the line stays quiet
+        CHECK_EQ(HostUart_Transmit(&s_line, line, sizeof(line)), 0);
+        CHECK_EQ(s_line.stats.dmaMoves, 8);
+        tearDown();
+    }
+}
+
+int main(void)
+{
+    printf("test_dma_scatter\n");
+    RUN_TEST(testHeaderAndPayload);
+    RUN_TEST(testEmptySegments);
+    RUN_TEST(testBusyChannel);
+    RUN_TEST(testSegmentError);
+    return HostCheck_Result();
+}
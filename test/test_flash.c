@@ -0,0 +1,141 @@
+/*
+ * FTFA flash model under the SDK flash driver, and the state store wear counts on it
+ */
+
+#include <string.h>
+
+#include "fsl_flash.h"
+#include "app_store.h"
+#include "host_hw.h"
+#include "host_flash.h"
+#include "host_check.h"
+
+#define SECTOR(n)   (HOST_FLASH_BASE + (n) * HOST_FLASH_SECTOR_SIZE)
+
+static flash_config_t s_config;
+
+static void testEraseProgramVerify(void)
+{
+    uint32_t words[4] = {0x12345678U, 0xDEADBEEFU, 0x00000000U, 0xA5A5A5A5U};
+    uint32_t failedAddress;
+    uint32_t failedData;
+
+    HostFlash_Reset();
+    CHECK_EQ(FLASH_Init(&s_config), kStatus_FLASH_Success);
+    CHECK_EQ(s_config.PFlashBlockBase, HOST_FLASH_BASE);
+    CHECK_EQ(s_config.PFlashTotalSize, HOST_FLASH_SECTOR_SIZE * HOST_FLASH_SECTOR_COUNT);
+
+    CHECK_EQ(FLASH_VerifyErase(&s_config, SECTOR(10), HOST_FLASH_SECTOR_SIZE, kFLASH_MarginValueNormal),
+             kStatus_FLASH_Success);
+    CHECK_EQ(FLASH_Program(&s_config, SECTOR(10) + 16U, words, sizeof(words)), kStatus_FLASH_Success);
+    CHECK(memcmp((const void *)(uintptr_t)(SECTOR(10) + 16U), words, sizeof(words)) == 0);
+    CHECK_EQ(HostFlash_GetStats()->programs, 4);
+    CHECK_EQ(HostFlash_GetStats()->busyUs, 4 * HOST_FLASH_PROGRAM_WORD_US + HOST_FLASH_VERIFY_US);
+
+    CHECK_EQ(FLASH_VerifyProgram(&s_config, SECTOR(10) + 16U, sizeof(words), words, kFLASH_MarginValueUser,
+                                 &failedAddress, &failedData),
+             kStatus_FLASH_Success);
+    CHECK_EQ(FLASH_VerifyErase(&s_config, SECTOR(10), HOST_FLASH_SECTOR_SIZE, kFLASH_MarginValueNormal),
+             kStatus_FLASH_CommandFailure);
+
+    words[1] = 0;
+    CHECK_EQ(FLASH_VerifyProgram(&s_config, SECTOR(10) + 16U, sizeof(words), words, kFLASH_MarginValueUser,
+                                 &failedAddress, &failedData),
+             kStatus_FLASH_CommandFailure);
+    // Reported as the command address, relative to the flash base
+    CHECK_EQ(failedAddress, SECTOR(10) + 20U - HOST_FLASH_BASE);
+
+    CHECK_EQ(FLASH_Erase(&s_config, SECTOR(10), HOST_FLASH_SECTOR_SIZE, kFLASH_ApiEraseKey), kStatus_FLASH_Success);
+    CHECK_EQ(FLASH_VerifyErase(&s_config, SECTOR(10), HOST_FLASH_SECTOR_SIZE, kFLASH_MarginValueNormal),
+             kStatus_FLASH_Success);
+    CHECK_EQ(HostFlash_GetStats()->sectorErases[10], 1);
+    CHECK_EQ(HostFlash_GetStats()->overwrites, 0);
+}
+
+static void testEraseBeforeProgram(void)
+{
+    uint32_t first = 0xFFFF0000U;
+    uint32_t second = 0x0000FFFFU;
+
+    HostFlash_Reset();
+    CHECK_EQ(FLASH_Program(&s_config, SECTOR(3), &first, 4), kStatus_FLASH_Success);
+
+    // Programming over programmed bits only clears more of them
+    CHECK_EQ(FLASH_Program(&s_config, SECTOR(3), &second, 4), kStatus_FLASH_CommandFailure);
+    CHECK_EQ(*(volatile uint32_t *)(uintptr_t)SECTOR(3), 0);
+    CHECK_EQ(HostFlash_GetStats()->overwrites, 1);
+
+    CHECK_EQ(FLASH_Erase(&s_config, SECTOR(3), HOST_FLASH_SECTOR_SIZE, kFLASH_ApiEraseKey), kStatus_FLASH_Success);
+    CHECK_EQ(FLASH_Program(&s_config, SECTOR(3), &second, 4), kStatus_FLASH_Success);
+    CHECK_EQ(*(volatile uint32_t *)(uintptr_t)SECTOR(3), second);
+    CHECK_EQ(HostFlash_GetStats()->overwrites, 1);
+}
+
+static void testReadResourceAndErrors(void)
+{
+    uint32_t word = 0;
+
+    HostFlash_Reset();
+    CHECK_EQ(FLASH_ReadResource(&s_config, 0, &word, 4, kFLASH_ResourceOptionFlashIfr), kStatus_FLASH_Success);
+    CHECK_EQ(word, 0xFFFFFFFFU);
+    CHECK_EQ(HostFlash_GetStats()->busyUs, HOST_FLASH_READ_US);
+
+    // The driver refuses ranges outside the flash before launching anything
+    CHECK_EQ(FLASH_Erase(&s_config, SECTOR(HOST_FLASH_SECTOR_COUNT), HOST_FLASH_SECTOR_SIZE, kFLASH_ApiEraseKey),
+             kStatus_FLASH_AddressError);
+    CHECK_EQ(HostFlash_GetStats()->commands, 1);
+    CHECK_EQ(HostFlash_GetStats()->accessErrors, 0);
+}
+
+static void testStoreWearCounts(void)
+{
+    app_store_stats_t stats;
+    uint8_t value[APP_STORE_VALUE_MAX];
+    uint32_t storeSector = (APP_STORE_FLASH_BASE - HOST_FLASH_BASE) / HOST_FLASH_SECTOR_SIZE;
+
+    HostFlash_Reset();
+    CHECK_EQ(AppStore_Init(), kStatus_Success);
+
+    // Sectors the store never erased start at 0, the formatted one at 1
+    AppStore_GetStats(&stats);
+    CHECK_EQ(stats.sectorErases[0], 1);
+    for (uint32_t i = 1; i < APP_STORE_SECTOR_COUNT; i++) {
+        CHECK_EQ(stats.sectorErases[i], 0);
+    }
+
+    // Enough distinct records to go round every sector several times
+    for (uint32_t n = 0; n < 400U; n++) {
+        memset(value, (int)n, sizeof(value));
+        CHECK_EQ(AppStore_Write((uint8_t)(n % APP_STORE_KEY_COUNT), value, sizeof(value)), kStatus_Success);
+        CHECK_EQ(AppStore_Flush(), kStatus_Success);
+    }
+
+    AppStore_GetStats(&stats);
+    for (uint32_t i = 0; i < APP_STORE_SECTOR_COUNT; i++) {
+        CHECK_EQ(stats.sectorErases[i], HostFlash_GetStats()->sectorErases[storeSector + i]);
+        CHECK(stats.sectorErases[i] + 1U >= stats.sectorErases[0]);
+        CHECK(stats.sectorErases[i] <= stats.sectorErases[0]);
+    }
+    CHECK(stats.sectorErases[0] >= 3U);
+    CHECK_EQ(HostFlash_GetStats()->overwrites, 0);
+    CHECK_EQ(HostFlash_GetStats()->irqUnmasked, 0);
+
+    // The counts come back from the trailers after a reset
+    CHECK_EQ(AppStore_Init(), kStatus_Success);
+    AppStore_GetStats(&stats);
+    for (uint32_t i = 0; i < APP_STORE_SECTOR_COUNT; i++) {
+        CHECK_EQ(stats.sectorErases[i], HostFlash_GetStats()->sectorErases[storeSector + i]);
+    }
+    CHECK_EQ(AppStore_Read(7U, value, sizeof(value)), sizeof(value));
+    CHECK_EQ(value[0], (uint8_t)399U);
+}
+
+int main(void)
+{
+    printf("test_flash\n");
+    RUN_TEST(testEraseProgramVerify);
+    RUN_TEST(testEraseBeforeProgram);
+    RUN_TEST(testReadResourceAndErrors);
+    RUN_TEST(testStoreWearCounts);
+    return HostCheck_Result();
+}
@@ -0,0 +1,157 @@
+/*
+ * Worst-case response of the I2C1 slave byte interrupt, on the NVIC model with the
+ * priorities the firmware programs: booted application, SPI link on DMA, console on
+ * its LPSCI interrupt and DMA channel. At full console and DMA interrupt load the
+ * slave must still finish each byte within one byte time of the bus.
+ */
+
+#include <stdio.h>
+
+#include "board.h"
+#include "fsl_debug_console.h"
+#include "host_hw.h"
+#include "host_flash.h"
+#include "host_nvic.h"
+#include "host_app.h"
+#include "host_check.h"
+
+#define CORE_HZ         48000000U
+#define I2C_HZ          400000U                             // Default speed of the slave
+#define BYTE_CYCLES     (9U * (CORE_HZ / I2C_HZ))           // 8 data bits and the acknowledge
+#define SPI_FRAME_CYCLES (18U * 8U * (CORE_HZ / 6000000U))  // BUFFER_SIZE bytes at the 6 MHz slave limit
+#define UART_BYTE_CYCLES (10U * CORE_HZ / 115200U)          // Console, 8N1
+#define TICK_CYCLES     (CORE_HZ / 1000U)
+#define HORIZON_CYCLES  (2U * TICK_CYCLES)
+
+/*
+ * Handler budgets: the longest path through each handler as built, with the flash wait
+ * state, rounded up. The PRIMASK figure is the console waiting for ring space (a span
+ * started and a completion polled); the flash steps mask for longer, but only on a bus
+ * quiet for STORE_BUS_IDLE_MS.
+ */
+#define I2C_SLAVE_CYCLES        300U    // Byte handler, the transfer callback on the last
+#define SPI_RX_DMA_CYCLES       250U    // Frame in, event to the application
+#define SPI_TX_DMA_CYCLES       150U    // Dummy bytes out
+#define CONSOLE_DMA_CYCLES      400U    // Span done, next span submitted
+#define CONSOLE_UART_CYCLES     250U    // One byte from the ring
+#define SYSTICK_CYCLES          100U
+#define MASKED_CYCLES           500U
+
+#define DMA_CHANNELS            4U
+#define SOURCES_MAX             (4U + DMA_CHANNELS)
+
+// Not reached: the flash holds no update image
+void AppUpdate_HostStartImage(uint32_t vectors)
+{
+    (void)vectors;
+    HostHw_Stop();
+}
+
+static host_nvic_source_t s_sources[SOURCES_MAX];
+static host_nvic_result_t s_results[SOURCES_MAX];
+static uint32_t s_count;
+
+// BOARD_InitDebugConsole, with the core clock the host clock model does not give
+static void boot(void)
+{
+    HostApp_Boot();
+    CHECK_EQ(DbgConsole_Init(BOARD_DEBUG_UART_BASEADDR, BOARD_DEBUG_UART_BAUDRATE, BOARD_DEBUG_UART_TYPE, CORE_HZ),
+             kStatus_Success);
+    NVIC_SetPriority(BOARD_UART_IRQ, BOARD_UART_IRQ_PRIORITY);
+    CHECK_EQ(DbgConsole_EnableTxDMA(BOARD_DEBUG_UART_DMA_CHANNEL, BOARD_DEBUG_UART_DMA_REQUEST), kStatus_Success);
+}
+
+static void addSource(const char *name, IRQn_Type irqn, uint32_t handlerCycles, uint32_t periodCycles)
+{
+    s_sources[s_count].name = name;
+    s_sources[s_count].irqn = irqn;
+    s_sources[s_count].handlerCycles = handlerCycles;
+    s_sources[s_count].periodCycles = periodCycles;
+    s_count++;
+}
+
+// Every DMA channel the firmware routed, at the rate of what feeds it
+static void addDmaChannels(void)
+{
+    for (uint32_t channel = 0; channel < DMA_CHANNELS; channel++) {
+        uint32_t chcfg = DMAMUX0->CHCFG[channel];
+        uint32_t source = chcfg & DMAMUX_CHCFG_SOURCE_MASK;
+        IRQn_Type irqn = (IRQn_Type)(DMA0_IRQn + channel);
+
+        if (!(chcfg & DMAMUX_CHCFG_ENBL_MASK)) {
+            continue;
+        }
+        if (source == ((uint32_t)kDmaRequestMux0SPI0Rx & DMAMUX_CHCFG_SOURCE_MASK)) {
+            addSource("SPI0 rx DMA", irqn, SPI_RX_DMA_CYCLES, SPI_FRAME_CYCLES);
+        } else if (source == ((uint32_t)kDmaRequestMux0SPI0Tx & DMAMUX_CHCFG_SOURCE_MASK)) {
+            addSource("SPI0 tx DMA", irqn, SPI_TX_DMA_CYCLES, SPI_FRAME_CYCLES);
+        } else if (source == ((uint32_t)kDmaRequestMux0LPSCI0Tx & DMAMUX_CHCFG_SOURCE_MASK)) {
+            // A span can be a single byte
+            addSource("console DMA", irqn, CONSOLE_DMA_CYCLES, UART_BYTE_CYCLES);
+        } else {
+            CHECK_EQ(source, 0);
+        }
+    }
+}
+
+static uint32_t analyse(void)
+{
+    const host_nvic_core_t core = HOST_NVIC_CORE_M0PLUS;
+
+    HostNvic_Analyse(&core, MASKED_CYCLES, s_sources, s_count, HORIZON_CYCLES, s_results);
+    return s_results[0].worstCycles;
+}
+
+static void setUp(void)
+{
+    HostFlash_Reset();
+    HostHw_Reset();
+    CHECK_EQ(HostHw_Run(boot), HOST_RUN_RETURNED);
+
+    s_count = 0;
+    addSource("I2C1 slave", I2C1_IRQn, I2C_SLAVE_CYCLES, BYTE_CYCLES);
+    addSource("console LPSCI", UART0_IRQn, CONSOLE_UART_CYCLES, UART_BYTE_CYCLES);
+    addSource("SysTick", SysTick_IRQn, SYSTICK_CYCLES, TICK_CYCLES);
+    addDmaChannels();
+}
+
+// The slave answers each byte within one byte time, none merges into the next
+static void testI2cSlaveWithinByte(void)
+{
+    uint32_t worst = analyse();
+
+    printf("  %-14s level  worst  lost  (cycles, one I2C byte %u)\n", "", BYTE_CYCLES);
+    for (uint32_t i = 0; i < s_count; i++) {
+        printf("  %-14s %5lu %6lu %5lu\n", s_sources[i].name, (unsigned long)s_results[i].level,
+               (unsigned long)s_results[i].worstCycles, (unsigned long)s_results[i].lost);
+    }
+
+    CHECK_EQ(s_count, 6);
+    CHECK_EQ(s_results[0].level, 0);
+    CHECK(worst <= BYTE_CYCLES);
+    CHECK_EQ(s_results[0].lost, 0);
+}
+
+// The check has teeth: with the console at the slave's level the byte time is missed
+static void testConsoleAtSlaveLevel(void)
+{
+    uint32_t worst;
+
+    for (uint32_t i = 1; i < s_count; i++) {
+        if ((s_sources[i].irqn == UART0_IRQn) || (s_sources[i].periodCycles == UART_BYTE_CYCLES)) {
+            NVIC_SetPriority(s_sources[i].irqn, 0U);
+        }
+    }
+    worst = analyse();
+    CHECK(worst > BYTE_CYCLES);
+}
+
+int main(void)
+{
+    printf("test_nvic_wcrt\n");
+    // Once: the console cannot be initialised again after it went to DMA
+    setUp();
+    RUN_TEST(testI2cSlaveWithinByte);
+    RUN_TEST(testConsoleAtSlaveLevel);
+    return HostCheck_Result();
+}
@@ -0,0 +1,296 @@
+/*
+ * The SDK printf formatter against the one from before the span sink and the
+ * division-free conversion (host_fmt_ref.c): same characters, same count
+ *
+ * Built twice, with and without PRINTF_ADVANCED_ENABLE (64-bit conversions, flags,
+ * length modifiers). "test_printf all" also sweeps every 32-bit value in radix 10.
+ */
+
+#include <string.h>
+
+#include "fsl_common.h"
+#include "host_fmt.h"
+#include "host_check.h"
+
+#define OUT_MAX         256U
+#define MISMATCHES_SHOWN 8U
+
+typedef struct {
+    char text[OUT_MAX];
+    uint32_t length;
+} output_t;
+
+static output_t s_new;
+static output_t s_ref;
+static uint32_t s_mismatches;
+static uint32_t s_compared;
+
+static int newSpan(const char *span, size_t length)
+{
+    for (size_t i = 0; (i < length) && (s_new.length < OUT_MAX - 1U); i++) {
+        s_new.text[s_new.length++] = span[i];
+    }
+    return (int)length;
+}
+
+static int refPutchar(int c)
+{
+    if (s_ref.length < OUT_MAX - 1U) {
+        s_ref.text[s_ref.length++] = (char)c;
+    }
+    return 1;
+}
+
+static uint64_t s_random = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t nextRandom(void)
+{
+    // xorshift64*
+    s_random ^= s_random >> 12;
+    s_random ^= s_random << 25;
+    s_random ^= s_random >> 27;
+    return s_random * 0x2545F4914F6CDD1DULL;
+}
+
+static void mismatch(const char *what, const char *detail)
+{
+    g_hostCheckFailures++;
+    if (++s_mismatches <= MISMATCHES_SHOWN) {
+        fprintf(stderr, "  %s \"%s\": \"%.*s\" (%u) vs reference \"%.*s\" (%u)\n", what, detail,
+                (int)s_new.length, s_new.text, s_new.length, (int)s_ref.length, s_ref.text, s_ref.length);
+    }
+}
+
+/*
+ * Radix conversion
+ */
+
+static void compareRadix(host_fmt_uint_t value, bool sign, int32_t radix, bool upperCase)
+{
+    char newDigits[2U + 8U * sizeof(host_fmt_uint_t)];
+    char refDigits[sizeof(newDigits)];
+    host_fmt_uint_t newValue = value;
+    host_fmt_uint_t refValue = value;
+    int32_t newLength = HostFmt_ConvertRadix(newDigits, &newValue, sign, radix, upperCase);
+    int32_t refLength = HostFmtRef_ConvertRadix(refDigits, &refValue, sign, radix, upperCase);
+
+    s_compared++;
+    if ((newLength != refLength) || (memcmp(newDigits, refDigits, (size_t)newLength + 1U) != 0)) {
+        char detail[64];
+
+        s_new.length = (uint32_t)newLength;
+        s_ref.length = (uint32_t)refLength;
+        for (int32_t i = 0; i < newLength; i++) {
+            s_new.text[i] = newDigits[newLength - i];
+        }
+        for (int32_t i = 0; i < refLength; i++) {
+            s_ref.text[i] = refDigits[refLength - i];
+        }
+        snprintf(detail, sizeof(detail), "%s radix %d 0x%llx", sign ? "signed" : "unsigned", (int)radix,
+                 (unsigned long long)value);
+        mismatch("conversion", detail);
+    }
+}
+
+static void compareRadixAll(host_fmt_uint_t value)
+{
+    static const int32_t radixes[] = {2, 8, 10, 16};
+
+    // Signed values only ever go out in decimal; the old code has no letters on that path
+    for (uint32_t r = 0; r < ARRAY_SIZE(radixes); r++) {
+        compareRadix(value, false, radixes[r], false);
+    }
+    compareRadix(value, false, 16, true);
+    compareRadix(value, true, 10, false);
+}
+
+static void testRadixSmallValues(void)
+{
+    // Every value of up to 20 bits, positive and as the negative of the same magnitude
+    for (host_fmt_uint_t v = 0; v < (1U << 20); v++) {
+        compareRadixAll(v);
+        compareRadixAll((host_fmt_uint_t)0U - v);
+    }
+    CHECK_EQ(s_mismatches, 0);
+}
+
+static void testRadixBoundaries(void)
+{
+    // Either side of every power of two and of ten, where digit counts change
+    for (uint32_t bit = 0; bit < 8U * sizeof(host_fmt_uint_t); bit++) {
+        host_fmt_uint_t power = (host_fmt_uint_t)1U << bit;
+
+        for (host_fmt_uint_t d = 0; d < 64U; d++) {
+            compareRadixAll(power + d);
+            compareRadixAll(power - d - 1U);
+        }
+    }
+    for (host_fmt_uint_t power = 10U; power != 0U; power = (power <= (host_fmt_uint_t)-1 / 10U) ? power * 10U : 0U) {
+        for (host_fmt_uint_t d = 0; d < 64U; d++) {
+            compareRadixAll(power + d);
+            compareRadixAll(power - d - 1U);
+        }
+    }
+    CHECK_EQ(s_mismatches, 0);
+}
+
+static void testRadixRandom(void)
+{
+    // Random values of random bit lengths
+    for (uint32_t n = 0; n < 2000000U; n++) {
+        uint64_t value = nextRandom();
+        uint32_t bits = 1U + (uint32_t)(nextRandom() % (8U * sizeof(host_fmt_uint_t)));
+
+        compareRadixAll((host_fmt_uint_t)(value >> (64U - bits)));
+    }
+    CHECK_EQ(s_mismatches, 0);
+}
+
+static void testRadixAll32(void)
+{
+    uint32_t v = 0;
+
+    do {
+        compareRadix(v, false, 10, false);
+        compareRadix((host_fmt_uint_t)(int32_t)v, true, 10, false);
+    } while (++v != 0U);
+    CHECK_EQ(s_mismatches, 0);
+}
+
+/*
+ * Whole conversions
+ */
+
+typedef enum {
+    ARG_INT,
+    ARG_INT64,
+    ARG_STRING,
+    ARG_POINTER,
+} arg_kind_t;
+
+// Both formatters on the same arguments
+static void compareFormat(const char *format, ...)
+{
+    va_list ap;
+    va_list refAp;
+    int newCount;
+    int refCount;
+
+    s_new.length = 0;
+    s_ref.length = 0;
+    va_start(ap, format);
+    va_copy(refAp, ap);
+    newCount = HostFmt_VFormat(newSpan, format, ap);
+    refCount = HostFmtRef_VFormat(refPutchar, format, refAp);
+    va_end(refAp);
+    va_end(ap);
+
+    s_compared++;
+    if ((newCount != refCount) || (s_new.length != s_ref.length) ||
+        (memcmp(s_new.text, s_ref.text, s_new.length) != 0)) {
+        mismatch("format", format);
+    }
+}
+
+// One conversion, after the width and precision a '*' takes
+static void compareConversion(const char *format, arg_kind_t kind, uint64_t value, const char *string,
+                              uint32_t stars)
+{
+    static const uint32_t star = 5U;
+
+    switch (kind) {
+        case ARG_INT64:
+            (stars == 2U) ? compareFormat(format, star, star, value)
+                          : (stars ? compareFormat(format, star, value) : compareFormat(format, value));
+            break;
+        case ARG_STRING:
+            (stars == 2U) ? compareFormat(format, star, star, string)
+                          : (stars ? compareFormat(format, star, string) : compareFormat(format, string));
+            break;
+        case ARG_POINTER:
+            (stars == 2U) ? compareFormat(format, star, star, (void *)(uintptr_t)value)
+                          : (stars ? compareFormat(format, star, (void *)(uintptr_t)value)
+                                   : compareFormat(format, (void *)(uintptr_t)value));
+            break;
+        default:
+            (stars == 2U) ? compareFormat(format, star, star, (uint32_t)value)
+                          : (stars ? compareFormat(format, star, (uint32_t)value)
+                                   : compareFormat(format, (uint32_t)value));
+            break;
+    }
+}
+
+static void testFormatMatrix(void)
+{
+    static const char *const flagSets[] = {"", "-", "+", " ", "0", "#", "-0", "+0", "- ", "#0", "-#", "+ 0#"};
+    static const char *const widths[] = {"", "1", "2", "8", "24", "*"};
+    static const char *const precisions[] = {"", ".", ".0", ".1", ".5", ".12", ".*"};
+    static const char *const lengths[] = {"", "hh", "h", "l", "ll"};
+    static const char specifiers[] = "diuxXopcs%";
+    static const uint64_t values[] = {
+        0U, 1U, 7U, 9U, 10U, 42U, 255U, 0x80U, 0xFFFFU, 0x12345678U, 0x7FFFFFFFU, 0x80000000U, 0xFFFFFFFFU,
+        0xFFFFFFFFFFFFFFFFULL, 0x8000000000000000ULL, 0x7FFFFFFFFFFFFFFFULL, 1234567890123456789ULL,
+    };
+    static const char *const strings[] = {"", "a", "ON ", "192.168.100.254", "a string longer than 24 chars"};
+    char format[32];
+
+    for (uint32_t f = 0; f < ARRAY_SIZE(flagSets); f++) {
+        for (uint32_t w = 0; w < ARRAY_SIZE(widths); w++) {
+            for (uint32_t p = 0; p < ARRAY_SIZE(precisions); p++) {
+                for (uint32_t l = 0; l < ARRAY_SIZE(lengths); l++) {
+                    for (const char *spec = specifiers; *spec; spec++) {
+                        uint32_t stars = (widths[w][0] == '*') + (precisions[p][1] == '*');
+                        arg_kind_t kind = (*spec == 's') ? ARG_STRING : (*spec == 'p') ? ARG_POINTER
+                                        : (lengths[l][0] == 'l' && lengths[l][1] == 'l') ? ARG_INT64 : ARG_INT;
+
+                        // Literal text on both sides, as in the application's formats
+                        snprintf(format, sizeof(format), "<%%%s%s%s%s%c>", flagSets[f], widths[w], precisions[p],
+                                 lengths[l], *spec);
+                        if (kind == ARG_STRING) {
+                            for (uint32_t s = 0; s < ARRAY_SIZE(strings); s++) {
+                                compareConversion(format, kind, 0, strings[s], stars);
+                            }
+                        } else {
+                            for (uint32_t v = 0; v < ARRAY_SIZE(values); v++) {
+                                compareConversion(format, kind, values[v], NULL, stars);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    CHECK_EQ(s_mismatches, 0);
+}
+
+static void testApplicationFormats(void)
+{
+    // The formats the application prints its packet dump and status with
+    compareFormat("\n=== Packet #%lu ===\n", 123456U);
+    compareFormat("%02X('%c') ", 0x41U, 'A');
+    compareFormat("%d ", 1);
+    compareFormat("  LED1: %s %s\n", "ON ", "[*]");
+    compareFormat("IP Address: %s\n", "192.168.100.254");
+    compareFormat("  Hex: 0x%02X.0x%02X.0x%02X.0x%02X\n", 192, 168, 100, 254);
+    compareFormat("\nRaw Data (%lu bytes): ", 18U);
+    compareFormat("  %-7s %-6s suppressed %lu\n", "packet", "info", 3U);
+    compareFormat("no conversion at all\n");
+    compareFormat("");
+    compareFormat("trailing %");
+    CHECK_EQ(s_mismatches, 0);
+}
+
+int main(int argc, char **argv)
+{
+    printf("test_printf: PRINTF_ADVANCED_ENABLE=%u\n", HOST_FMT_ADVANCED);
+    RUN_TEST(testRadixSmallValues);
+    RUN_TEST(testRadixBoundaries);
+    RUN_TEST(testRadixRandom);
+    RUN_TEST(testFormatMatrix);
+    RUN_TEST(testApplicationFormats);
+    if ((argc > 1) && (strcmp(argv[1], "all") == 0)) {
+        RUN_TEST(testRadixAll32);
+    }
+    printf("  %u comparisons\n", s_compared);
+    return HostCheck_Result();
+}
@@ -0,0 +1,266 @@
+/*
+ * Soak: minutes of random LED frames on the event clock (host_clock.h), built with the
+ * uptime and the packet counter started just short of 2^32 so both wrap early in
+ * the run. Across the wraps no frame is lost, quiet-bus writes, receive timeouts and
+ * the log rate limit keep their timing, and the last frame boots back.
+ *
+ * build/test_soak [seed [seconds]]     default seed 1, 600 s of bus time
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app_store.h"
+#include "app_time.h"
+#include "app_log.h"
+#include "host_hw.h"
+#include "host_clock.h"
+#include "host_flash.h"
+#include "host_i2c.h"
+#include "host_app.h"
+#include "host_check.h"
+
+#ifndef APP_PACKET_COUNTER_START
+#error "Build with the APP_TIME_START_MS and APP_PACKET_COUNTER_START of the soak objects"
+#endif
+
+#define FRAME_SIZE      18U         // BUFFER_SIZE of the application
+#define FRAME_US        500U        // 18 bytes and the address at 400 kHz
+#define QUIET_MS        20U         // STORE_BUS_IDLE_MS of the application
+#define TIMEOUT_MS      5000U       // I2C_TIMEOUT_MS of the application
+#define LOG_PERIOD_MS   200U        // Below APP_LOG_RATE_PER_SEC, never limited
+#define STORE_KEY_IP    1U
+
+typedef struct {
+    uint32_t frames;            // Frames written
+    uint32_t refused;           // Frames not acknowledged to the last byte
+    uint32_t timeouts;          // Receive timeouts the silent gaps before frames should cause
+    uint32_t steps;             // Main loop passes that ran flash commands
+    uint32_t early;             // Steps started less than QUIET_MS after a frame
+    uint64_t lostTicksMax;      // Ticks at most lost to steps longer than 1 ms
+    uint32_t logDenied;         // Log messages refused though within the rate
+} soak_stats_t;
+
+static uint32_t s_seed;
+static soak_stats_t s_soak;
+static uint64_t s_lastFrameUs;
+static uint32_t s_gapTimeouts;      // Timeouts in the gap before the next frame
+static uint8_t s_lastFrame[FRAME_SIZE];
+static host_event_t s_frameEvent;
+static host_event_t s_logEvent;
+static uint64_t s_trafficEndUs;     // No frame scheduled after it
+
+// State when the uptime wrapped
+static bool s_wrapped;
+static uint32_t s_framesAtWrap;
+static uint32_t s_stepsAtWrap;
+static app_store_stats_t s_storeAtWrap;
+
+// Not reached: the flash holds no update image
+void AppUpdate_HostStartImage(uint32_t vectors)
+{
+    (void)vectors;
+    HostHw_Stop();
+}
+
+static uint32_t nextRandom(void)
+{
+    s_seed = s_seed * 1103515245U + 12345U;
+    return s_seed >> 16;
+}
+
+static void boot(void)
+{
+    HostApp_Boot();
+}
+
+/*
+ * Mostly bursts shorter than the quiet time, every fourth gap long enough to write,
+ * now and then a master silent for one or two receive timeouts and a half
+ */
+static uint32_t nextGapMs(void)
+{
+    uint32_t r = nextRandom();
+
+    if (r % 500U == 0U) {
+        s_gapTimeouts = 1U + (r >> 9) % 2U;
+        return s_gapTimeouts * TIMEOUT_MS + TIMEOUT_MS / 2U;
+    }
+    s_gapTimeouts = 0;
+    return ((r & 3U) == 0U) ? QUIET_MS + 5U + (r >> 2) % 200U : 1U + (r >> 2) % (QUIET_MS - 5U);
+}
+
+static void checkWrap(void)
+{
+    if (!s_wrapped && (AppTime_GetMs() < APP_TIME_START_MS)) {
+        s_wrapped = true;
+        s_framesAtWrap = s_soak.frames;
+        s_stepsAtWrap = s_soak.steps;
+        AppStore_GetStats(&s_storeAtWrap);
+    }
+}
+
+// Random LED states and IP address, taken by the slave as the frame ends
+static void sendFrame(host_event_t *event)
+{
+    uint8_t frame[FRAME_SIZE] = {0};
+    uint32_t r = nextRandom();
+
+    checkWrap();
+    s_soak.timeouts += s_gapTimeouts;
+    frame[0] = r & 1U;
+    frame[1] = (r >> 1) & 1U;
+    snprintf((char *)&frame[2], FRAME_SIZE - 2U, "10.%lu.%lu.%lu", (unsigned long)((r >> 2) % 8U),
+             (unsigned long)((r >> 5) % 256U), (unsigned long)(s_soak.frames % 250U));
+    if (HostI2c_Write(HOST_APP_I2C_ADDRESS, frame, FRAME_SIZE) != (int32_t)FRAME_SIZE) {
+        s_soak.refused++;
+    }
+    s_soak.frames++;
+    s_lastFrameUs = HostClock_Now();
+    memcpy(s_lastFrame, frame, sizeof(frame));
+
+    if (HostClock_Now() < s_trafficEndUs) {
+        HostClock_Schedule(event, HostClock_Now() + nextGapMs() * 1000ULL + FRAME_US);
+    }
+}
+
+// A message now and then, well within the rate: the bucket must always have a token
+static void logSomething(host_event_t *event)
+{
+    checkWrap();
+    if (!AppLog_Allow(APP_LOG_MODULE_UPDATE, APP_LOG_LEVEL_ERROR)) {
+        s_soak.logDenied++;
+    }
+    HostClock_Schedule(event, HostClock_Now() + LOG_PERIOD_MS * 1000U);
+}
+
+// Flash commands of a main loop pass stall the CPU with interrupts masked
+static void runStep(uint64_t busyUs)
+{
+    uint32_t primask;
+
+    s_soak.steps++;
+    if (HostClock_Now() - s_lastFrameUs < (QUIET_MS - 1U) * 1000U) {
+        s_soak.early++;
+    }
+    s_soak.lostTicksMax += busyUs / 1000U;
+
+    primask = DisableGlobalIRQ();
+    HostClock_Advance(busyUs);
+    EnableGlobalIRQ(primask);
+}
+
+static void runFor(uint64_t durationUs)
+{
+    const host_flash_stats_t *flash = HostFlash_GetStats();
+    uint64_t end = HostClock_Now() + durationUs;
+
+    while (HostClock_Now() < end) {
+        uint64_t busyUs = flash->busyUs;
+
+        HostApp_Poll(1);
+        if (flash->busyUs != busyUs) {
+            runStep(flash->busyUs - busyUs);
+        }
+    }
+}
+
+static void checkRestored(void)
+{
+    uint8_t ip[APP_STORE_VALUE_MAX] = {0};
+    uint8_t led1;
+    uint8_t led2;
+
+    HostHw_Reset();
+    HostClock_Reset();
+    CHECK_EQ(HostHw_Run(boot), HOST_RUN_RETURNED);
+    HostApp_GetLeds(&led1, &led2);
+    CHECK_EQ(led1, s_lastFrame[0]);
+    CHECK_EQ(led2, s_lastFrame[1]);
+    CHECK_EQ(AppStore_Read(STORE_KEY_IP, ip, sizeof(ip)), FRAME_SIZE - 2U);
+    CHECK(memcmp(ip, &s_lastFrame[2], FRAME_SIZE - 2U) == 0);
+}
+
+static void soak(uint32_t seconds)
+{
+    const host_i2c_stats_t *i2c = HostI2c_GetStats();
+    const host_flash_stats_t *flash = HostFlash_GetStats();
+    app_store_stats_t store;
+    uint32_t timeouts;
+    uint32_t busErrors;
+    uint32_t incomplete;
+    uint32_t uptimeMs;
+
+    HostFlash_Reset();
+    HostHw_Reset();
+    HostClock_Reset();
+    CHECK_EQ(HostHw_Run(boot), HOST_RUN_RETURNED);
+    HostFlash_ClearStats();
+    AppLog_SetLevel(APP_LOG_MODULE_UPDATE, APP_LOG_LEVEL_ERROR);
+
+    HostClock_Reset();
+    uptimeMs = AppTime_GetMs();
+    s_frameEvent.fn = sendFrame;
+    s_logEvent.fn = logSomething;
+    HostClock_Schedule(&s_frameEvent, nextGapMs() * 1000ULL + FRAME_US);
+    HostClock_Schedule(&s_logEvent, LOG_PERIOD_MS * 1000U);
+    s_trafficEndUs = seconds * 1000000ULL;
+    runFor(s_trafficEndUs);
+
+    // The master stops after the frame it is due to send, the last values get written
+    while (s_frameEvent.queued) {
+        runFor(1000U);
+    }
+    runFor(3U * QUIET_MS * 1000U);
+    HostClock_Cancel(&s_logEvent);
+
+    // Both counters went round
+    CHECK(s_wrapped);
+    CHECK(s_soak.frames > (uint32_t)(0U - APP_PACKET_COUNTER_START));
+    CHECK(HostApp_GetPacketCount() < APP_PACKET_COUNTER_START);
+    CHECK_EQ(HostApp_GetPacketCount(), (uint32_t)(APP_PACKET_COUNTER_START + s_soak.frames));
+
+    // The uptime kept the clock's pace, less the ticks a step may have swallowed
+    uptimeMs = AppTime_GetMs() - uptimeMs;
+    CHECK(uptimeMs <= HostClock_Now() / 1000U);
+    CHECK(uptimeMs + s_soak.lostTicksMax >= HostClock_Now() / 1000U);
+
+    // Every frame taken, no write on a busy bus, before or after the wrap
+    CHECK_EQ(s_soak.refused, 0);
+    CHECK_EQ(i2c->stalled, 0);
+    CHECK_EQ(i2c->addressNaks, 0);
+    CHECK_EQ(i2c->dataNaks, 0);
+    CHECK_EQ(s_soak.early, 0);
+    CHECK_EQ(flash->irqUnmasked, 0);
+    CHECK_EQ(flash->accessErrors, 0);
+
+    AppStore_GetStats(&store);
+    CHECK_EQ(store.failures, 0);
+    CHECK_EQ(store.pendingKeys, 0);
+    CHECK(s_soak.frames - s_framesAtWrap > 0U);
+    CHECK(s_soak.steps - s_stepsAtWrap > 0U);
+    CHECK(store.programs - s_storeAtWrap.programs > 0U);
+
+    // Each silent gap timed out as often as it should, the rate limit never cut in
+    HostApp_GetI2cCounts(&timeouts, &busErrors, &incomplete);
+    CHECK(s_soak.timeouts > 0U);
+    CHECK_EQ(timeouts, s_soak.timeouts);
+    CHECK_EQ(busErrors, 0);
+    CHECK_EQ(incomplete, 0);
+    CHECK_EQ(s_soak.logDenied, 0);
+
+    checkRestored();
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seconds = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 600U;
+
+    s_seed = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 1U;
+    printf("test_soak: seed %lu, %lu s\n", (unsigned long)s_seed, (unsigned long)seconds);
+    soak(seconds);
+    printf("  %lu frames, %lu steps, %lu timeouts\n", (unsigned long)s_soak.frames, (unsigned long)s_soak.steps,
+           (unsigned long)s_soak.timeouts);
+    return HostCheck_Result();
+}
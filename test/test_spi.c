@@ -0,0 +1,387 @@
+/*
+ * SPI slave over the bus and DMA models: fsl_spi interrupt transfers and fsl_spi_dma
+ * transfers in 8 and 16-bit frames, their counts and aborts, and CMSIS Driver_SPI0
+ */
+
+#include <string.h>
+
+#include "fsl_spi.h"
+#include "fsl_spi_dma.h"
+#include "fsl_dma_manager.h"
+#include "Driver_SPI.h"
+#include "host_hw.h"
+#include "host_dma.h"
+#include "host_spi.h"
+#include "host_check.h"
+
+#define FRAME_BYTES     64U
+#define DUMMY           0xA5U
+
+void SPI0_DriverIRQHandler(void);
+void SPI1_DriverIRQHandler(void);
+
+extern ARM_DRIVER_SPI Driver_SPI0;
+
+static uint8_t s_slaveTx[FRAME_BYTES];
+static uint8_t s_slaveRx[FRAME_BYTES];
+static uint8_t s_masterTx[FRAME_BYTES];
+static uint8_t s_masterRx[FRAME_BYTES];
+
+// Transfer callbacks and CMSIS events since setUp
+static uint32_t s_callbacks;
+static status_t s_lastStatus;
+static uint32_t s_events;
+
+static spi_slave_handle_t s_handle;
+static spi_dma_handle_t s_dmaHandle;
+static dma_handle_t s_txDmaHandle;
+static dma_handle_t s_rxDmaHandle;
+
+/*
+ * What the board provides
+ */
+
+uint32_t SPI0_GetFreq(void)
+{
+    return 24000000U;
+}
+
+/*
+ * Set up
+ */
+
+static void fill(uint8_t *data, uint32_t length, uint32_t seed)
+{
+    for (uint32_t i = 0; i < length; i++) {
+        seed = seed * 1103515245U + 12345U;
+        data[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+static void slaveCallback(SPI_Type *base, spi_slave_handle_t *handle, status_t status, void *userData)
+{
+    s_callbacks++;
+    s_lastStatus = status;
+}
+
+static void dmaCallback(SPI_Type *base, spi_dma_handle_t *handle, status_t status, void *userData)
+{
+    s_callbacks++;
+    s_lastStatus = status;
+}
+
+static void spiEvent(uint32_t event)
+{
+    s_events |= event;
+}
+
+// SPI1 as a mode 0 slave in 8 or 16-bit frames, the master attached; fresh patterns
+static void setUp(bool wide)
+{
+    spi_slave_config_t config;
+
+    HostHw_Reset();
+    HostDma_Reset();
+    HostSpi_Attach(SPI1, SPI1_IRQn, SPI1_DriverIRQHandler, kDmaRequestMux0SPI1Rx, kDmaRequestMux0SPI1Tx);
+    s_callbacks = 0;
+    s_lastStatus = kStatus_Fail;
+    s_events = 0;
+
+    SPI_SlaveGetDefaultConfig(&config);
+    config.dataMode = wide ? kSPI_16BitMode : kSPI_8BitMode;
+    SPI_SlaveInit(SPI1, &config);
+    SPI_SetDummyData(SPI1, DUMMY);
+
+    fill(s_slaveTx, FRAME_BYTES, wide ? 1U : 2U);
+    fill(s_masterTx, FRAME_BYTES, wide ? 3U : 4U);
+    memset(s_slaveRx, 0, FRAME_BYTES);
+    memset(s_masterRx, 0, FRAME_BYTES);
+}
+
+// Both channels from the DMA manager, as Driver_SPI takes them
+static void requestChannels(void)
+{
+    dmamgr_channel_config_t config;
+
+    DMAMGR_GetDefaultChannelConfig(&config);
+    config.priority = kDMAMGR_PriorityHigh;
+    config.requestSource = kDmaRequestMux0SPI1Tx;
+    CHECK_EQ(DMAMGR_RequestChannel(&s_txDmaHandle, &config), kStatus_Success);
+    config.requestSource = kDmaRequestMux0SPI1Rx;
+    CHECK_EQ(DMAMGR_RequestChannel(&s_rxDmaHandle, &config), kStatus_Success);
+    SPI_SlaveTransferCreateHandleDMA(SPI1, &s_dmaHandle, dmaCallback, NULL, &s_txDmaHandle, &s_rxDmaHandle);
+}
+
+static void releaseChannels(void)
+{
+    CHECK_EQ(DMAMGR_ReleaseChannel(&s_txDmaHandle), kStatus_Success);
+    CHECK_EQ(DMAMGR_ReleaseChannel(&s_rxDmaHandle), kStatus_Success);
+}
+
+static spi_transfer_t transfer(uint8_t *txData, uint8_t *rxData, size_t length)
+{
+    spi_transfer_t xfer = {txData, rxData, length, 0U};
+
+    return xfer;
+}
+
+/*
+ * Tests
+ */
+
+// Full-duplex frames both ways, twice in a row, each reply in step with its frame
+static void testInterruptTransfer(void)
+{
+    for (uint32_t wide = 0; wide < 2U; wide++) {
+        spi_transfer_t xfer = transfer(s_slaveTx, s_slaveRx, FRAME_BYTES);
+        uint32_t frames = FRAME_BYTES >> wide;
+
+        setUp(wide);
+        SPI_SlaveTransferCreateHandle(SPI1, &s_handle, slaveCallback, NULL);
+
+        for (uint32_t round = 0; round < 2U; round++) {
+            CHECK_EQ(SPI_SlaveTransferNonBlocking(SPI1, &s_handle, &xfer), kStatus_Success);
+            CHECK_EQ(SPI_SlaveTransferNonBlocking(SPI1, &s_handle, &xfer), kStatus_SPI_Busy);
+            HostSpi_Transfer(s_masterTx, s_masterRx, FRAME_BYTES);
+
+            CHECK_EQ(s_callbacks, round + 1U);
+            CHECK_EQ(s_lastStatus, kStatus_SPI_Idle);
+            CHECK(memcmp(s_masterRx, s_slaveTx, FRAME_BYTES) == 0);
+            CHECK(memcmp(s_slaveRx, s_masterTx, FRAME_BYTES) == 0);
+        }
+        CHECK_EQ(HostSpi_GetStats()->frames, 2U * frames);
+        CHECK_EQ(HostSpi_GetStats()->irqs, 2U * frames);
+        CHECK_EQ(HostSpi_GetStats()->unread, 0);
+        SPI_Deinit(SPI1);
+    }
+}
+
+// No TX buffer sends the dummy byte, no RX buffer drops the frames
+static void testInterruptNullBuffers(void)
+{
+    spi_transfer_t xfer = transfer(NULL, s_slaveRx, 8U);
+    uint8_t dummies[8];
+
+    setUp(false);
+    SPI_SlaveTransferCreateHandle(SPI1, &s_handle, slaveCallback, NULL);
+    memset(dummies, DUMMY, sizeof(dummies));
+
+    CHECK_EQ(SPI_SlaveTransferNonBlocking(SPI1, &s_handle, &xfer), kStatus_Success);
+    HostSpi_Transfer(s_masterTx, s_masterRx, 8U);
+    CHECK(memcmp(s_masterRx, dummies, 8U) == 0);
+    CHECK(memcmp(s_slaveRx, s_masterTx, 8U) == 0);
+
+    xfer = transfer(s_slaveTx, NULL, 8U);
+    CHECK_EQ(SPI_SlaveTransferNonBlocking(SPI1, &s_handle, &xfer), kStatus_Success);
+    HostSpi_Transfer(s_masterTx, s_masterRx, 8U);
+    CHECK(memcmp(s_masterRx, s_slaveTx, 8U) == 0);
+
+    CHECK_EQ(s_callbacks, 2);
+    CHECK_EQ(HostSpi_GetStats()->unread, 0);
+    xfer = transfer(s_slaveTx, s_slaveRx, 0U);
+    CHECK_EQ(SPI_SlaveTransferNonBlocking(SPI1, &s_handle, &xfer), kStatus_InvalidArgument);
+    SPI_Deinit(SPI1);
+}
+
+/*
+ * Abort part way: the count stops, frames clocked meanwhile are left unread, and the
+ * next transfer starts with its own first frame both ways
+ */
+static void testInterruptAbort(void)
+{
+    spi_transfer_t xfer = transfer(s_slaveTx, s_slaveRx, 16U);
+    size_t count = 0;
+
+    setUp(false);
+    SPI_SlaveTransferCreateHandle(SPI1, &s_handle, slaveCallback, NULL);
+
+    CHECK_EQ(SPI_SlaveTransferNonBlocking(SPI1, &s_handle, &xfer), kStatus_Success);
+    HostSpi_Transfer(s_masterTx, s_masterRx, 5U);
+    CHECK_EQ(SPI_SlaveTransferGetCount(SPI1, &s_handle, &count), kStatus_Success);
+    CHECK_EQ(count, 5);
+    SPI_SlaveTransferAbort(SPI1, &s_handle);
+    CHECK_EQ(SPI_SlaveTransferGetCount(SPI1, &s_handle, &count), kStatus_NoTransferInProgress);
+
+    HostSpi_Transfer(NULL, NULL, 2U);
+    CHECK_EQ(HostSpi_GetStats()->unread, 2);
+
+    xfer = transfer(&s_slaveTx[16], s_slaveRx, 16U);
+    CHECK_EQ(SPI_SlaveTransferNonBlocking(SPI1, &s_handle, &xfer), kStatus_Success);
+    HostSpi_Transfer(&s_masterTx[16], s_masterRx, 16U);
+    CHECK_EQ(s_callbacks, 1);
+    CHECK(memcmp(s_masterRx, &s_slaveTx[16], 16U) == 0);
+    CHECK(memcmp(s_slaveRx, &s_masterTx[16], 16U) == 0);
+    CHECK_EQ(HostSpi_GetStats()->unread, 2);
+    SPI_Deinit(SPI1);
+}
+
+// Frames land in memory as the receive channel moves them, both channels finish the transfer
+static void testDmaTransfer(void)
+{
+    for (uint32_t wide = 0; wide < 2U; wide++) {
+        spi_transfer_t xfer = transfer(s_slaveTx, s_slaveRx, FRAME_BYTES);
+        size_t count = 0;
+
+        setUp(wide);
+        requestChannels();
+
+        for (uint32_t round = 0; round < 2U; round++) {
+            CHECK_EQ(SPI_SlaveTransferDMA(SPI1, &s_dmaHandle, &xfer), kStatus_Success);
+            CHECK_EQ(SPI_SlaveTransferDMA(SPI1, &s_dmaHandle, &xfer), kStatus_SPI_Busy);
+            HostSpi_Transfer(s_masterTx, s_masterRx, 10U);
+            CHECK_EQ(SPI_SlaveTransferGetCountDMA(SPI1, &s_dmaHandle, &count), kStatus_Success);
+            CHECK_EQ(count, 10);
+            HostSpi_Transfer(&s_masterTx[10], &s_masterRx[10], FRAME_BYTES - 10U);
+
+            CHECK_EQ(s_callbacks, round + 1U);
+            CHECK_EQ(s_lastStatus, kStatus_Success);
+            CHECK(memcmp(s_masterRx, s_slaveTx, FRAME_BYTES) == 0);
+            CHECK(memcmp(s_slaveRx, s_masterTx, FRAME_BYTES) == 0);
+            CHECK_EQ(SPI1->C2 & (SPI_C2_TXDMAE_MASK | SPI_C2_RXDMAE_MASK), 0);
+        }
+        // One move per frame and direction, one interrupt per channel and transfer
+        CHECK_EQ(HostSpi_GetStats()->dmaMoves, 2U * 2U * (FRAME_BYTES >> wide));
+        CHECK_EQ(HostSpi_GetStats()->irqs, 0);
+        CHECK_EQ(HostSpi_GetStats()->unread, 0);
+        CHECK_EQ(HostDma_GetStats()->irqs, 4);
+        CHECK_EQ(HostDma_GetStats()->stalled, 0);
+
+        // Without TX data the dummy goes out, without RX data the frames are dropped
+        xfer = transfer(NULL, NULL, 8U);
+        CHECK_EQ(SPI_SlaveTransferDMA(SPI1, &s_dmaHandle, &xfer), kStatus_Success);
+        HostSpi_Transfer(s_masterTx, s_masterRx, 8U);
+        CHECK_EQ(s_callbacks, 3);
+        CHECK_EQ(s_masterRx[0], DUMMY);
+        CHECK_EQ(s_masterRx[7], DUMMY);
+
+        releaseChannels();
+        SPI_Deinit(SPI1);
+    }
+}
+
+/*
+ * Abort part way: the frame the transmit channel had loaded is dropped with the
+ * transfer, the next one starts with its own first frame both ways
+ */
+static void testDmaAbort(void)
+{
+    spi_transfer_t xfer = transfer(s_slaveTx, s_slaveRx, 18U);
+    size_t count = 0;
+
+    setUp(false);
+    requestChannels();
+
+    CHECK_EQ(SPI_SlaveTransferDMA(SPI1, &s_dmaHandle, &xfer), kStatus_Success);
+    HostSpi_Transfer(s_masterTx, s_masterRx, 10U);
+    CHECK_EQ(SPI_SlaveTransferGetCountDMA(SPI1, &s_dmaHandle, &count), kStatus_Success);
+    CHECK_EQ(count, 10);
+    SPI_SlaveTransferAbortDMA(SPI1, &s_dmaHandle);
+    CHECK_EQ(SPI_SlaveTransferGetCountDMA(SPI1, &s_dmaHandle, &count), kStatus_NoTransferInProgress);
+    HostSpi_Transfer(NULL, NULL, 3U);
+    CHECK_EQ(HostSpi_GetStats()->unread, 3);
+
+    xfer = transfer(&s_slaveTx[20], s_slaveRx, 18U);
+    CHECK_EQ(SPI_SlaveTransferDMA(SPI1, &s_dmaHandle, &xfer), kStatus_Success);
+    HostSpi_Transfer(&s_masterTx[20], s_masterRx, 18U);
+    CHECK_EQ(s_callbacks, 1);
+    CHECK(memcmp(s_masterRx, &s_slaveTx[20], 18U) == 0);
+    CHECK(memcmp(s_slaveRx, &s_masterTx[20], 18U) == 0);
+
+    releaseChannels();
+    SPI_Deinit(SPI1);
+}
+
+/*
+ * Driver_SPI0 with DMA, as the application opens it: channels taken on power up
+ * and given back on power down, slave frames in 8 and 16 bits, counts in frames,
+ * the default TX value, aborts
+ */
+static void testDriverSpi0(void)
+{
+    ARM_DRIVER_SPI *driver = &Driver_SPI0;
+    uint32_t slave8 = ARM_SPI_MODE_SLAVE | ARM_SPI_CPOL0_CPHA0 | ARM_SPI_DATA_BITS(8) | ARM_SPI_MSB_LSB |
+                      ARM_SPI_SS_SLAVE_HW;
+    uint8_t expected[18];
+
+    HostHw_Reset();
+    HostDma_Reset();
+    HostSpi_Attach(SPI0, SPI0_IRQn, SPI0_DriverIRQHandler, kDmaRequestMux0SPI0Rx, kDmaRequestMux0SPI0Tx);
+    s_events = 0;
+    fill(s_slaveTx, FRAME_BYTES, 5U);
+    fill(s_masterTx, FRAME_BYTES, 6U);
+
+    CHECK_EQ(driver->Initialize(spiEvent), ARM_DRIVER_OK);
+    CHECK_EQ(driver->Control(slave8, 0), ARM_DRIVER_ERROR);
+    CHECK_EQ(driver->PowerControl(ARM_POWER_FULL), ARM_DRIVER_OK);
+    CHECK(DMAMGR_IsChannelOccupied(0));
+    CHECK(DMAMGR_IsChannelOccupied(1));
+    CHECK(!DMAMGR_IsChannelOccupied(2));
+
+    // Only hardware slave select, and no bus speed for a slave
+    CHECK_EQ(driver->Control((slave8 & ~ARM_SPI_SS_SLAVE_MODE_Msk) | ARM_SPI_SS_SLAVE_SW, 0), ARM_SPI_ERROR_SS_MODE);
+    CHECK_EQ(driver->Control(slave8 | ARM_SPI_DATA_BITS(12), 0), ARM_SPI_ERROR_DATA_BITS);
+    CHECK_EQ(driver->Control(slave8, 0), ARM_DRIVER_OK);
+    CHECK_EQ(driver->Control(ARM_SPI_SET_BUS_SPEED, 1000000U), ARM_DRIVER_ERROR_UNSUPPORTED);
+    CHECK_EQ(driver->Control(ARM_SPI_SET_DEFAULT_TX_VALUE, 0x3CU), ARM_DRIVER_OK);
+
+    // Receive sends the default value
+    CHECK_EQ(driver->Receive(s_slaveRx, 18U), ARM_DRIVER_OK);
+    CHECK_EQ(driver->GetStatus().busy, 1);
+    CHECK_EQ(driver->Control(slave8, 0), ARM_DRIVER_ERROR_BUSY);
+    HostSpi_Transfer(s_masterTx, s_masterRx, 7U);
+    CHECK_EQ(driver->GetDataCount(), 7);
+    HostSpi_Transfer(&s_masterTx[7], &s_masterRx[7], 11U);
+    CHECK_EQ(s_events, ARM_SPI_EVENT_TRANSFER_COMPLETE);
+    CHECK_EQ(driver->GetStatus().busy, 0);
+    CHECK_EQ(driver->GetDataCount(), 18);
+    CHECK(memcmp(s_slaveRx, s_masterTx, 18U) == 0);
+    memset(expected, 0x3C, sizeof(expected));
+    CHECK(memcmp(s_masterRx, expected, 18U) == 0);
+
+    // An abort keeps the count, the next transfer is in step
+    s_events = 0;
+    CHECK_EQ(driver->Transfer(s_slaveTx, s_slaveRx, 18U), ARM_DRIVER_OK);
+    HostSpi_Transfer(s_masterTx, s_masterRx, 4U);
+    CHECK_EQ(driver->Control(ARM_SPI_ABORT_TRANSFER, 0), ARM_DRIVER_OK);
+    CHECK_EQ(driver->GetStatus().busy, 0);
+    CHECK_EQ(driver->GetDataCount(), 4);
+    CHECK_EQ(driver->Send(s_slaveTx, 18U), ARM_DRIVER_OK);
+    HostSpi_Transfer(s_masterTx, s_masterRx, 18U);
+    CHECK_EQ(s_events, ARM_SPI_EVENT_TRANSFER_COMPLETE);
+    CHECK(memcmp(s_masterRx, s_slaveTx, 18U) == 0);
+
+    // 16-bit frames: nine of them, counted as frames
+    s_events = 0;
+    CHECK_EQ(driver->Control((slave8 & ~ARM_SPI_DATA_BITS_Msk) | ARM_SPI_DATA_BITS(16), 0), ARM_DRIVER_OK);
+    CHECK_EQ(driver->Transfer(s_slaveTx, s_slaveRx, 9U), ARM_DRIVER_OK);
+    HostSpi_Transfer(s_masterTx, s_masterRx, 6U);
+    CHECK_EQ(driver->GetDataCount(), 3);
+    HostSpi_Transfer(&s_masterTx[6], &s_masterRx[6], 12U);
+    CHECK_EQ(s_events, ARM_SPI_EVENT_TRANSFER_COMPLETE);
+    CHECK_EQ(driver->GetDataCount(), 9);
+    CHECK(memcmp(s_masterRx, s_slaveTx, 18U) == 0);
+    CHECK(memcmp(s_slaveRx, s_masterTx, 18U) == 0);
+    CHECK_EQ(HostSpi_GetStats()->unread, 0);
+
+    // Power off in the middle of a transfer: stopped, the slave off, the channels free
+    CHECK_EQ(driver->Receive(s_slaveRx, 9U), ARM_DRIVER_OK);
+    HostSpi_Transfer(s_masterTx, s_masterRx, 4U);
+    CHECK_EQ(driver->PowerControl(ARM_POWER_OFF), ARM_DRIVER_OK);
+    CHECK(!DMAMGR_IsChannelOccupied(0));
+    CHECK(!DMAMGR_IsChannelOccupied(1));
+    HostSpi_Transfer(s_masterTx, s_masterRx, 4U);
+    CHECK_EQ(HostSpi_GetStats()->disabled, 2);
+    CHECK_EQ(driver->Uninitialize(), ARM_DRIVER_OK);
+}
+
+int main(void)
+{
+    printf("test_spi\n");
+    RUN_TEST(testInterruptTransfer);
+    RUN_TEST(testInterruptNullBuffers);
+    RUN_TEST(testInterruptAbort);
+    RUN_TEST(testDmaTransfer);
+    RUN_TEST(testDmaAbort);
+    RUN_TEST(testDriverSpi0);
+    return HostCheck_Result();
+}
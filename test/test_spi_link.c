@@ -0,0 +1,115 @@
+/*
+ * The application's SPI link end to end: frames clocked by the SPI bus model into
+ * Driver_SPI0, moved by the DMA model, parsed by the main loop; a frame the master
+ * stops sending part way is dropped so the next one is not shifted
+ */
+
+#include <string.h>
+
+#include "host_hw.h"
+#include "host_flash.h"
+#include "host_spi.h"
+#include "host_dma.h"
+#include "host_app.h"
+#include "host_check.h"
+
+#define FRAME_SIZE      18U         // BUFFER_SIZE of the application
+
+// Not reached: the flash holds no update image
+void AppUpdate_HostStartImage(uint32_t vectors)
+{
+    (void)vectors;
+    HostHw_Stop();
+}
+
+static void boot(void)
+{
+    HostApp_Boot();
+}
+
+static void setUp(void)
+{
+    HostFlash_Reset();
+    HostHw_Reset();
+    CHECK_EQ(HostHw_Run(boot), HOST_RUN_RETURNED);
+}
+
+// An LED frame: both states, then the node's IP address as text, zero padded
+static void makeFrame(uint8_t *frame, uint8_t led1, uint8_t led2, const char *ip)
+{
+    memset(frame, 0, FRAME_SIZE);
+    frame[0] = led1;
+    frame[1] = led2;
+    memcpy(&frame[2], ip, strlen(ip));
+}
+
+static void checkLeds(uint8_t led1, uint8_t led2)
+{
+    uint8_t actual1;
+    uint8_t actual2;
+
+    HostApp_GetLeds(&actual1, &actual2);
+    CHECK_EQ(actual1, led1);
+    CHECK_EQ(actual2, led2);
+}
+
+static void testFrames(void)
+{
+    uint8_t frame[FRAME_SIZE];
+    uint32_t frames;
+    uint32_t resyncs;
+
+    setUp();
+    makeFrame(frame, 1, 0, "192.168.1.20");
+    HostSpi_Transfer(frame, NULL, FRAME_SIZE);
+    HostApp_Poll(2);
+    checkLeds(1, 0);
+
+    // The next frame may come before the main loop got to the previous one
+    makeFrame(frame, 0, 1, "192.168.1.21");
+    HostSpi_Transfer(frame, NULL, FRAME_SIZE);
+    HostApp_Poll(2);
+    checkLeds(0, 1);
+
+    HostApp_GetSpiCounts(&frames, &resyncs);
+    CHECK_EQ(frames, 2);
+    CHECK_EQ(resyncs, 0);
+    CHECK_EQ(HostSpi_GetStats()->unread, 0);
+    CHECK_EQ(HostDma_GetStats()->stalled, 0);
+}
+
+// A short frame is dropped once it stalls, the next full frame is parsed in place
+static void testStalledFrameResync(void)
+{
+    uint8_t frame[FRAME_SIZE];
+    uint32_t frames;
+    uint32_t resyncs;
+
+    setUp();
+    makeFrame(frame, 1, 1, "10.0.0.7");
+    HostSpi_Transfer(frame, NULL, 7U);
+    HostApp_Poll(20);
+    HostApp_GetSpiCounts(&frames, &resyncs);
+    CHECK_EQ(resyncs, 0);
+
+    HostApp_Poll(60);
+    HostApp_GetSpiCounts(&frames, &resyncs);
+    CHECK_EQ(frames, 0);
+    CHECK_EQ(resyncs, 1);
+
+    HostSpi_Transfer(frame, NULL, FRAME_SIZE);
+    HostApp_Poll(2);
+    checkLeds(1, 1);
+    HostApp_GetSpiCounts(&frames, &resyncs);
+    CHECK_EQ(frames, 1);
+    CHECK_EQ(resyncs, 1);
+    CHECK_EQ(HostSpi_GetStats()->unread, 0);
+}
+
+int main(void)
+{
+    printf("test_spi_link\n");
+    RUN_TEST(testFrames);
+    RUN_TEST(testStalledFrameResync);
+    return HostCheck_Result();
+}
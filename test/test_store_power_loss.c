@@ -0,0 +1,111 @@
+/*
+ * State store under power loss: cut the power in every flash command of a
+ * write sequence that spans a sector move, then check what boots back
+ */
+
+#include <string.h>
+
+#include "app_store.h"
+#include "host_hw.h"
+#include "host_flash.h"
+#include "host_check.h"
+
+#define ROUNDS      40U     // Writes per key in the sequence, enough for two sector moves
+
+// Value of a key after its n-th write: the key and n in every byte pair
+static void makeValue(uint8_t key, uint32_t n, uint8_t *value)
+{
+    for (uint32_t i = 0; i < APP_STORE_VALUE_MAX; i += 2U) {
+        value[i] = key;
+        value[i + 1U] = (uint8_t)n;
+    }
+}
+
+// Write number of a stored value, -1 if it is not one this test wrote for the key
+static int valueRound(uint8_t key, const uint8_t *value, uint32_t length)
+{
+    uint8_t expected[APP_STORE_VALUE_MAX];
+
+    if (length != APP_STORE_VALUE_MAX) {
+        return -1;
+    }
+    makeValue(key, value[1], expected);
+    return (memcmp(value, expected, sizeof(expected)) == 0) ? value[1] : -1;
+}
+
+static void writeSequence(void)
+{
+    uint8_t value[APP_STORE_VALUE_MAX];
+
+    for (uint32_t n = 1; n <= ROUNDS; n++) {
+        for (uint8_t key = 0; key < APP_STORE_KEY_COUNT; key++) {
+            makeValue(key, n, value);
+            AppStore_Write(key, value, sizeof(value));
+            AppStore_Flush();
+        }
+    }
+}
+
+static void boot(void)
+{
+    CHECK_EQ(AppStore_Init(), kStatus_Success);
+}
+
+static void testPowerLossInEveryCommand(void)
+{
+    uint8_t value[APP_STORE_VALUE_MAX];
+    uint32_t commands;
+    uint32_t cut;
+
+    // Commands of the whole sequence without a power loss
+    HostFlash_Reset();
+    boot();
+    HostFlash_ClearStats();
+    CHECK_EQ(HostHw_Run(writeSequence), HOST_RUN_RETURNED);
+    commands = HostFlash_GetStats()->commands;
+    CHECK(HostFlash_GetStats()->erases >= 2U);
+
+    for (cut = 1; cut <= commands; cut++) {
+        int lastRound[APP_STORE_KEY_COUNT];
+
+        HostFlash_Reset();
+        boot();
+        HostFlash_SetPowerLoss(cut);
+        CHECK_EQ(HostHw_Run(writeSequence), HOST_RUN_POWER_LOSS);
+        HostHw_Reset();
+
+        // Each key boots with a value of its own, no older than the one before the cut
+        CHECK_EQ(HostHw_Run(boot), HOST_RUN_RETURNED);
+        for (uint8_t key = 0; key < APP_STORE_KEY_COUNT; key++) {
+            uint32_t length = AppStore_Read(key, value, sizeof(value));
+
+            lastRound[key] = (length == 0U) ? 0 : valueRound(key, value, length);
+            CHECK(lastRound[key] >= 0);
+        }
+        for (uint8_t key = 1; key < APP_STORE_KEY_COUNT; key++) {
+            CHECK((lastRound[key] == lastRound[0]) || (lastRound[key] + 1 == lastRound[0]));
+        }
+
+        // And keeps working: new values land and survive another reset
+        makeValue(3, 200, value);
+        CHECK_EQ(AppStore_Write(3, value, sizeof(value)), kStatus_Success);
+        CHECK_EQ(AppStore_Flush(), kStatus_Success);
+        boot();
+        CHECK_EQ(AppStore_Read(3, value, sizeof(value)), sizeof(value));
+        CHECK_EQ(valueRound(3, value, sizeof(value)), 200);
+        CHECK_EQ(HostFlash_GetStats()->overwrites, 0);
+
+        if (g_hostCheckFailures) {
+            printf("  power cut in command %lu of %lu\n", (unsigned long)cut, (unsigned long)commands);
+            break;
+        }
+    }
+    printf("  %lu power cuts\n", (unsigned long)(cut - 1U));
+}
+
+int main(void)
+{
+    printf("test_store_power_loss\n");
+    RUN_TEST(testPowerLossInEveryCommand);
+    return HostCheck_Result();
+}
@@ -0,0 +1,268 @@
+/*
+ * State store under bus traffic: LED frames written by the I2C bus model at random
+ * gaps while the main loop runs on the event clock (host_clock.h), the flash
+ * commands it issues timed by the flash model. Writes wait for a quiet bus, no byte
+ * is refused and the last frame is what boots back.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "app_store.h"
+#include "host_hw.h"
+#include "host_clock.h"
+#include "host_flash.h"
+#include "host_i2c.h"
+#include "host_app.h"
+#include "host_check.h"
+
+#define FRAME_SIZE      18U         // BUFFER_SIZE of the application
+#define FRAME_US        500U        // 18 bytes and the address at 400 kHz
+#define QUIET_MS        20U         // STORE_BUS_IDLE_MS of the application
+#define STORE_KEY_LEDS  0U
+#define STORE_KEY_IP    1U
+
+typedef struct {
+    uint32_t frames;            // Frames written
+    uint32_t refused;           // Frames not acknowledged to the last byte
+    uint32_t quietGaps;         // Gaps between frames of at least QUIET_MS
+    uint32_t steps;             // Main loop passes that ran flash commands
+    uint32_t early;             // Steps started less than QUIET_MS after a frame
+    uint32_t stretched;         // Frames due while a step ran, held by clock stretching
+    uint64_t longestUs;         // Longest step
+    uint64_t maxStretchUs;      // Longest a frame was held
+} traffic_stats_t;
+
+static uint64_t s_lastFrameUs;      // End of the last frame on the bus
+static host_event_t s_frameEvent;   // Due at the end of the next frame
+static uint32_t (*s_nextGapMs)(void);
+static uint32_t s_seed;
+static traffic_stats_t s_traffic;
+static uint8_t s_lastFrame[FRAME_SIZE];
+static app_store_stats_t s_storeAtBoot;     // A blank store is formatted by the boot
+
+// Not reached: the flash holds no update image
+void AppUpdate_HostStartImage(uint32_t vectors)
+{
+    (void)vectors;
+    HostHw_Stop();
+}
+
+static uint32_t nextRandom(void)
+{
+    s_seed = s_seed * 1103515245U + 12345U;
+    return s_seed >> 16;
+}
+
+static void boot(void)
+{
+    HostApp_Boot();
+}
+
+static void setUp(uint32_t seed)
+{
+    HostFlash_Reset();
+    HostHw_Reset();
+    HostClock_Reset();
+    CHECK_EQ(HostHw_Run(boot), HOST_RUN_RETURNED);
+    HostFlash_ClearStats();
+    AppStore_GetStats(&s_storeAtBoot);
+
+    HostClock_Reset();
+    s_lastFrameUs = 0;
+    s_seed = seed;
+    memset(&s_traffic, 0, sizeof(s_traffic));
+}
+
+// LED states and an IP address that change from frame to frame; the slave takes the
+// bytes as the frame ends, a frame due during a step was held by clock stretching
+static void sendFrame(host_event_t *event)
+{
+    uint8_t frame[FRAME_SIZE] = {0};
+    uint64_t now = HostClock_Now();
+    uint32_t r = nextRandom();
+    uint32_t gapMs;
+
+    if (now > event->atUs) {
+        s_traffic.stretched++;
+        if (now - event->atUs > s_traffic.maxStretchUs) {
+            s_traffic.maxStretchUs = now - event->atUs;
+        }
+    }
+
+    frame[0] = r & 1U;
+    frame[1] = (r >> 1) & 1U;
+    snprintf((char *)&frame[2], FRAME_SIZE - 2U, "10.0.%lu.%lu",
+             (unsigned long)((r >> 2) % 4U), (unsigned long)(s_traffic.frames % 250U));
+
+    if (now - FRAME_US - s_lastFrameUs >= QUIET_MS * 1000U) {
+        s_traffic.quietGaps++;
+    }
+    if (HostI2c_Write(HOST_APP_I2C_ADDRESS, frame, FRAME_SIZE) != (int32_t)FRAME_SIZE) {
+        s_traffic.refused++;
+    }
+    s_traffic.frames++;
+    s_lastFrameUs = now;
+    memcpy(s_lastFrame, frame, sizeof(frame));
+
+    gapMs = s_nextGapMs();
+    if (gapMs != 0U) {
+        HostClock_Schedule(event, now + gapMs * 1000ULL + FRAME_US);
+    }
+}
+
+// Time the flash commands of a main loop pass: the CPU stalls with them, masked
+static void runStep(uint64_t busyUs)
+{
+    uint32_t primask;
+
+    s_traffic.steps++;
+    if (HostClock_Now() - s_lastFrameUs < (QUIET_MS - 1U) * 1000U) {
+        s_traffic.early++;
+    }
+    if (busyUs > s_traffic.longestUs) {
+        s_traffic.longestUs = busyUs;
+    }
+
+    // Frames and ticks due meanwhile come after, a tick once
+    primask = DisableGlobalIRQ();
+    HostClock_Advance(busyUs);
+    EnableGlobalIRQ(primask);
+}
+
+/*
+ * Run the main loop for durationMs, a frame after each gap nextGapMs returns;
+ * no more frames once it returns 0
+ */
+static void runTraffic(uint32_t durationMs, uint32_t (*nextGapMs)(void))
+{
+    const host_flash_stats_t *flash = HostFlash_GetStats();
+    uint64_t end = HostClock_Now() + durationMs * 1000ULL;
+
+    s_frameEvent.fn = sendFrame;
+    s_nextGapMs = nextGapMs;
+    if (nextGapMs != NULL) {
+        HostClock_Schedule(&s_frameEvent, HostClock_Now() + nextGapMs() * 1000ULL + FRAME_US);
+    } else {
+        HostClock_Cancel(&s_frameEvent);
+    }
+    while (HostClock_Now() < end) {
+        uint64_t busyUs = flash->busyUs;
+
+        HostApp_Poll(1);
+        if (flash->busyUs != busyUs) {
+            runStep(flash->busyUs - busyUs);
+        }
+    }
+}
+
+// Mostly bursts shorter than the quiet time, every fourth gap long enough to write
+static uint32_t mixedGap(void)
+{
+    uint32_t r = nextRandom();
+
+    return ((r & 3U) == 0U) ? QUIET_MS + 5U + (r >> 2) % 100U : 1U + (r >> 2) % (QUIET_MS - 5U);
+}
+
+// Never quiet long enough
+static uint32_t busyGap(void)
+{
+    return 1U + nextRandom() % (QUIET_MS - 2U);
+}
+
+static void checkBusUntouched(void)
+{
+    const host_i2c_stats_t *i2c = HostI2c_GetStats();
+    const host_flash_stats_t *flash = HostFlash_GetStats();
+
+    CHECK_EQ(s_traffic.refused, 0);
+    CHECK_EQ(i2c->stalled, 0);
+    CHECK_EQ(i2c->addressNaks, 0);
+    CHECK_EQ(i2c->dataNaks, 0);
+    CHECK_EQ(HostApp_GetPacketCount(), s_traffic.frames);
+    CHECK_EQ(s_traffic.early, 0);
+    CHECK_EQ(flash->irqUnmasked, 0);
+    CHECK_EQ(flash->overwrites, 0);
+    CHECK_EQ(flash->accessErrors, 0);
+}
+
+// After a reboot the LEDs and the IP field are those of the last frame
+static void checkRestored(void)
+{
+    uint8_t ip[APP_STORE_VALUE_MAX] = {0};
+    uint8_t led1;
+    uint8_t led2;
+
+    HostHw_Reset();
+    HostClock_Reset();
+    CHECK_EQ(HostHw_Run(boot), HOST_RUN_RETURNED);
+    HostApp_GetLeds(&led1, &led2);
+    CHECK_EQ(led1, s_lastFrame[0]);
+    CHECK_EQ(led2, s_lastFrame[1]);
+    CHECK_EQ(AppStore_Read(STORE_KEY_IP, ip, sizeof(ip)), FRAME_SIZE - 2U);
+    CHECK(memcmp(ip, &s_lastFrame[2], FRAME_SIZE - 2U) == 0);
+}
+
+static void testMixedTraffic(void)
+{
+    app_store_stats_t store;
+    uint32_t programs;
+    uint32_t erases;
+    uint32_t stretched = 0;
+
+    for (uint32_t seed = 1; seed <= 4U; seed++) {
+        setUp(seed);
+        runTraffic(20000U, mixedGap);
+        runTraffic(3U * QUIET_MS, NULL);
+        checkBusUntouched();
+
+        // Several sector moves, split so no pass stalls longer than an erase and its trailer word
+        AppStore_GetStats(&store);
+        programs = store.programs - s_storeAtBoot.programs;
+        erases = store.erases - s_storeAtBoot.erases;
+        CHECK_EQ(store.failures, 0);
+        CHECK_EQ(store.pendingKeys, 0);
+        CHECK(erases >= 2U);
+        CHECK(s_traffic.longestUs <= HOST_FLASH_ERASE_SECTOR_US + HOST_FLASH_PROGRAM_WORD_US);
+        CHECK(s_traffic.maxStretchUs <= s_traffic.longestUs);
+
+        // Coalesced: one record per key and quiet gap at most, plus trailer, two copies
+        // and header per move
+        CHECK(programs <= 2U * (s_traffic.quietGaps + 1U) + 4U * erases);
+        CHECK(programs < s_traffic.frames);
+
+        stretched += s_traffic.stretched;
+        checkRestored();
+    }
+    // Some frames started during a step, they were held and still taken in full
+    CHECK(stretched > 0U);
+}
+
+// A bus never quiet for long defers every write, the first quiet gap writes the last values
+static void testContinuousTraffic(void)
+{
+    app_store_stats_t store;
+
+    setUp(7);
+    runTraffic(2000U, busyGap);
+    AppStore_GetStats(&store);
+    CHECK(s_traffic.frames > 100U);
+    CHECK_EQ(s_traffic.steps, 0);
+    CHECK_EQ(store.pendingKeys, (1U << STORE_KEY_LEDS) | (1U << STORE_KEY_IP));
+
+    runTraffic(2U * QUIET_MS, NULL);
+    AppStore_GetStats(&store);
+    CHECK_EQ(store.pendingKeys, 0);
+    CHECK_EQ(store.programs - s_storeAtBoot.programs, 2);
+    CHECK_EQ(s_traffic.steps, 2);
+    checkBusUntouched();
+    checkRestored();
+}
+
+int main(void)
+{
+    printf("test_store_traffic\n");
+    RUN_TEST(testMixedTraffic);
+    RUN_TEST(testContinuousTraffic);
+    return HostCheck_Result();
+}
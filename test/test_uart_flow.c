@@ -0,0 +1,317 @@
+/*
+ * RX ring overflow policies and flow control of the UART driver: what a full ring
+ * keeps, when the sender is throttled and resumed, and that a sender honouring the
+ * throttle loses nothing however it bursts
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "fsl_uart.h"
+#include "host_hw.h"
+#include "host_uart.h"
+#include "host_check.h"
+
+#define RING_SIZE       32U         // Holds RING_SIZE - 1 bytes
+#define HIGH_WATERMARK  24U
+#define LOW_WATERMARK   8U
+
+static host_uart_t s_line;
+static uint8_t s_ring[RING_SIZE];
+static uart_handle_t s_handle;
+
+// RTS as seen by the sender, and the callback calls that set it
+static bool s_rtsReady;
+static uint32_t s_rtsCalls;
+
+void UART1_DriverIRQHandler(void);
+
+static void rtsCallback(UART_Type *base, uart_handle_t *handle, bool ready)
+{
+    CHECK(base == UART1);
+    CHECK(handle == &s_handle);
+    // Only edges are signalled
+    CHECK(ready != s_rtsReady);
+    s_rtsReady = ready;
+    s_rtsCalls++;
+}
+
+static status_t setPolicy(uart_rx_ring_policy_t policy, size_t high, size_t low)
+{
+    uart_rx_ring_config_t config = {policy, high, low, rtsCallback};
+
+    return UART_TransferSetRxRingPolicy(UART1, &s_handle, &config);
+}
+
+static void setUp(uart_rx_ring_policy_t policy)
+{
+    uart_config_t config;
+
+    HostHw_Reset();
+    memset(&s_handle, 0, sizeof(s_handle));
+    UART_GetDefaultConfig(&config);
+    config.enableTx = true;
+    config.enableRx = true;
+    UART_Init(UART1, &config, 24000000U);
+    UART_TransferCreateHandle(UART1, &s_handle, NULL, NULL);
+    UART_TransferStartRingBuffer(UART1, &s_handle, s_ring, RING_SIZE);
+    HostUart_Attach(&s_line, UART1, UART1_IRQn, UART1_DriverIRQHandler);
+
+    s_rtsReady = false;
+    s_rtsCalls = 0;
+    CHECK_EQ(setPolicy(policy, HIGH_WATERMARK, LOW_WATERMARK), kStatus_Success);
+}
+
+static void sendRange(uint8_t first, uint32_t count)
+{
+    while (count--) {
+        HostUart_Receive(&s_line, first++);
+    }
+}
+
+// Read count bytes and check they run on from first
+static bool readRange(uint8_t first, uint32_t count)
+{
+    uint8_t data[RING_SIZE];
+    uart_transfer_t xfer = {data, count};
+    size_t received = 0;
+
+    CHECK_EQ(UART_TransferReceiveNonBlocking(UART1, &s_handle, &xfer, &received), kStatus_Success);
+    CHECK_EQ(received, count);
+    for (uint32_t i = 0; i < count; i++) {
+        if (data[i] != (uint8_t)(first + i)) {
+            CHECK_EQ(data[i], (uint8_t)(first + i));
+            return false;
+        }
+    }
+    return true;
+}
+
+// What the transmitter sends now
+static uint32_t drainLine(uint8_t *data)
+{
+    return HostUart_Transmit(&s_line, data, RING_SIZE);
+}
+
+static void testWatermarkValidation(void)
+{
+    uart_rx_ring_config_t noCallback = {kUART_RxRingFlowControlRts, HIGH_WATERMARK, LOW_WATERMARK, NULL};
+
+    setUp(kUART_RxRingOverwriteOldest);
+    CHECK_EQ(setPolicy(kUART_RxRingFlowControlXonXoff, RING_SIZE - 1U, LOW_WATERMARK), kStatus_InvalidArgument);
+    CHECK_EQ(setPolicy(kUART_RxRingFlowControlXonXoff, HIGH_WATERMARK, HIGH_WATERMARK), kStatus_InvalidArgument);
+    CHECK_EQ(UART_TransferSetRxRingPolicy(UART1, &s_handle, &noCallback), kStatus_InvalidArgument);
+    CHECK_EQ(setPolicy(kUART_RxRingFlowControlXonXoff, RING_SIZE - 2U, 0), kStatus_Success);
+
+    // The non flow control policies ignore the watermarks
+    CHECK_EQ(setPolicy(kUART_RxRingDropNewest, 0, 0), kStatus_Success);
+
+    UART_TransferStopRingBuffer(UART1, &s_handle);
+    CHECK_EQ(setPolicy(kUART_RxRingDropNewest, 0, 0), kStatus_InvalidArgument);
+}
+
+// The default policy keeps the newest RING_SIZE - 1 bytes
+static void testOverwriteOldest(void)
+{
+    setUp(kUART_RxRingOverwriteOldest);
+    sendRange(0, RING_SIZE + 9U);
+    CHECK_EQ(s_handle.rxRingOverrunCount, 10);
+    CHECK_EQ(UART_TransferGetRxRingBufferLength(&s_handle), RING_SIZE - 1U);
+    readRange(10, RING_SIZE - 1U);
+    CHECK_EQ(s_line.stats.overruns, 0);
+}
+
+// DropNewest keeps the oldest ones instead, and takes new bytes once read
+static void testDropNewest(void)
+{
+    setUp(kUART_RxRingDropNewest);
+    sendRange(0, RING_SIZE + 9U);
+    CHECK_EQ(s_handle.rxRingOverrunCount, 10);
+    readRange(0, RING_SIZE - 1U);
+
+    sendRange(100, 5);
+    readRange(100, 5);
+    CHECK_EQ(s_handle.rxRingOverrunCount, 10);
+}
+
+/*
+ * RTS drops when the ring reaches the high watermark and rises again once it has been
+ * read down to the low one. Bytes already on the way still fit, a sender that ignores
+ * RTS altogether loses only the bytes that find the ring full.
+ */
+static void testRtsWatermarks(void)
+{
+    setUp(kUART_RxRingFlowControlRts);
+    CHECK(s_rtsReady);
+    CHECK_EQ(s_rtsCalls, 1);
+
+    sendRange(0, HIGH_WATERMARK - 1U);
+    CHECK(s_rtsReady);
+    sendRange(HIGH_WATERMARK - 1U, 1);
+    CHECK(!s_rtsReady);
+    CHECK(s_handle.rxRingThrottled);
+
+    sendRange(HIGH_WATERMARK, RING_SIZE - 1U - HIGH_WATERMARK + 3U);
+    CHECK_EQ(s_handle.rxRingOverrunCount, 3);
+    CHECK_EQ(s_rtsCalls, 2);
+
+    // Still above the low watermark
+    readRange(0, RING_SIZE - 2U - LOW_WATERMARK);
+    CHECK(!s_rtsReady);
+    readRange(RING_SIZE - 2U - LOW_WATERMARK, 1);
+    CHECK(s_rtsReady);
+    CHECK_EQ(s_rtsCalls, 3);
+    CHECK(!s_handle.rxRingThrottled);
+
+    // Peek and commit resume the sender too
+    sendRange(200, HIGH_WATERMARK - LOW_WATERMARK);
+    CHECK(!s_rtsReady);
+    UART_TransferCommitRxRingBuffer(UART1, &s_handle, UART_TransferGetRxRingBufferLength(&s_handle) - LOW_WATERMARK);
+    CHECK(s_rtsReady);
+    CHECK_EQ(s_rtsCalls, 5);
+}
+
+/*
+ * XOFF goes out at the high watermark and XON at the low one, ahead of any data
+ * being sent.
+ */
+static void testXonXoff(void)
+{
+    static const uint8_t message[] = "abc";
+    uint8_t line[RING_SIZE];
+    uart_transfer_t xfer = {(uint8_t *)message, 3};
+
+    setUp(kUART_RxRingFlowControlXonXoff);
+    CHECK_EQ(drainLine(line), 0);
+
+    sendRange(0, HIGH_WATERMARK);
+    CHECK_EQ(drainLine(line), 1);
+    CHECK_EQ(line[0], UART_XOFF_CHAR);
+    // The interrupt was only on for the flow control character
+    CHECK(!(UART1->C2 & UART_C2_TIE_MASK));
+
+    CHECK_EQ(UART_TransferSendNonBlocking(UART1, &s_handle, &xfer), kStatus_Success);
+    readRange(0, HIGH_WATERMARK - LOW_WATERMARK);
+    CHECK_EQ(drainLine(line), 4);
+    CHECK_EQ(line[0], UART_XON_CHAR);
+    CHECK(memcmp(&line[1], message, 3) == 0);
+    CHECK(!s_handle.rxRingThrottled);
+    CHECK_EQ(s_handle.rxRingOverrunCount, 0);
+}
+
+/*
+ * Bytes that arrive while the interrupt cannot be taken overrun the receiver: the
+ * driver counts it, drops the held byte and goes on receiving.
+ */
+static void testHardwareOverrun(void)
+{
+    setUp(kUART_RxRingDropNewest);
+    sendRange(0, 3);
+    __disable_irq();
+    sendRange(3, 3);
+    CHECK_EQ(s_line.stats.overruns, 2);
+    __enable_irq();
+
+    CHECK(!HostUart_Service(&s_line));
+    CHECK_EQ(s_handle.rxHardwareOverrunCount, 1);
+    CHECK_EQ(s_handle.rxRingOverrunCount, 0);
+    sendRange(6, 2);
+    readRange(0, 3);
+    readRange(6, 2);
+}
+
+/*
+ * A sender that bursts at random and stops a few bytes after being throttled,
+ * against a reader that empties the ring in random steps: every byte arrives, in
+ * order, the ring never overflows and the sender always gets going again.
+ */
+static void burstySender(uart_rx_ring_policy_t policy)
+{
+    const uint32_t total = 200000U;
+    const uint32_t latency = RING_SIZE - 1U - HIGH_WATERMARK;  // Bytes in flight once throttled
+    uint8_t line[RING_SIZE];
+    uint32_t sent = 0;
+    uint32_t read = 0;
+    uint32_t inFlight = 0;
+    uint32_t throttles = 0;
+    bool paused = false;
+
+    setUp(policy);
+    srand(39);
+    while ((sent < total) || UART_TransferGetRxRingBufferLength(&s_handle)) {
+        uint32_t burst = (uint32_t)rand() % 40U;
+        uint32_t chunk = (uint32_t)rand() % 12U;
+
+        while (burst-- && (sent < total)) {
+            if (paused) {
+                if (!inFlight) {
+                    break;
+                }
+                inFlight--;
+            }
+            HostUart_Receive(&s_line, (uint8_t)sent++);
+
+            // The sender sees RTS, or reads the line, a few bytes late
+            if (policy == kUART_RxRingFlowControlRts) {
+                if (!paused && !s_rtsReady) {
+                    paused = true;
+                    inFlight = (uint32_t)rand() % (latency + 1U);
+                    throttles++;
+                }
+            } else {
+                for (uint32_t n = drainLine(line), i = 0; i < n; i++) {
+                    CHECK(!paused == (line[i] == UART_XOFF_CHAR));
+                    paused = (line[i] == UART_XOFF_CHAR);
+                    inFlight = (uint32_t)rand() % (latency + 1U);
+                    throttles += paused;
+                }
+            }
+        }
+
+        chunk = MIN(chunk, UART_TransferGetRxRingBufferLength(&s_handle));
+        if (chunk && !readRange((uint8_t)read, chunk)) {
+            break;
+        }
+        read += chunk;
+
+        if (policy == kUART_RxRingFlowControlRts) {
+            paused = paused && !s_rtsReady;
+        } else {
+            for (uint32_t n = drainLine(line), i = 0; i < n; i++) {
+                CHECK(paused && (line[i] == UART_XON_CHAR));
+                paused = false;
+            }
+        }
+    }
+
+    CHECK_EQ(read, total);
+    CHECK_EQ(s_handle.rxRingOverrunCount, 0);
+    CHECK_EQ(s_handle.rxHardwareOverrunCount, 0);
+    CHECK_EQ(s_line.stats.overruns, 0);
+    CHECK(throttles > 100U);
+    printf("  %u bytes, %u throttles\n", total, throttles);
+}
+
+static void testBurstySenderRts(void)
+{
+    burstySender(kUART_RxRingFlowControlRts);
+}
+
+static void testBurstySenderXonXoff(void)
+{
+    burstySender(kUART_RxRingFlowControlXonXoff);
+}
+
+int main(void)
+{
+    printf("test_uart_flow\n");
+    RUN_TEST(testWatermarkValidation);
+    RUN_TEST(testOverwriteOldest);
+    RUN_TEST(testDropNewest);
+    RUN_TEST(testRtsWatermarks);
+    RUN_TEST(testXonXoff);
+    RUN_TEST(testHardwareOverrun);
+    RUN_TEST(testBurstySenderRts);
+    RUN_TEST(testBurstySenderXonXoff);
+    return HostCheck_Result();
+}
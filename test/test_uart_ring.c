@@ -0,0 +1,288 @@
+/*
+ * Zero-copy access to the RX ring buffers of the UART and LPSCI drivers: peek returns
+ * the pending bytes as up to two spans in order, commit releases them, wherever the
+ * tail sits and however the data wraps
+ */
+
+#include <string.h>
+
+#include "fsl_uart.h"
+#include "fsl_lpsci.h"
+#include "host_hw.h"
+#include "host_uart.h"
+#include "host_check.h"
+
+#define RING_SIZE       16U         // Holds RING_SIZE - 1 bytes
+
+// The calls under test, on one driver; uart_transfer_t and lpsci_transfer_t are alike
+typedef struct {
+    const char *name;
+    void (*setUp)(void);
+    size_t (*peek)(uart_transfer_t spans[2]);
+    void (*commit)(size_t count);
+    size_t (*length)(void);
+    size_t (*receive)(uint8_t *data, size_t length);
+} ring_ops_t;
+
+static host_uart_t s_line;
+static uint8_t s_ring[RING_SIZE];
+static uart_handle_t s_uartHandle;
+static lpsci_handle_t s_lpsciHandle;
+
+void UART1_DriverIRQHandler(void);
+void UART0_DriverIRQHandler(void);
+
+/*
+ * UART1
+ */
+
+static void uartSetUp(void)
+{
+    uart_config_t config;
+
+    HostHw_Reset();
+    UART_GetDefaultConfig(&config);
+    config.enableTx = true;
+    config.enableRx = true;
+    UART_Init(UART1, &config, 24000000U);
+    UART_TransferCreateHandle(UART1, &s_uartHandle, NULL, NULL);
+    UART_TransferStartRingBuffer(UART1, &s_uartHandle, s_ring, RING_SIZE);
+    HostUart_Attach(&s_line, UART1, UART1_IRQn, UART1_DriverIRQHandler);
+}
+
+static size_t uartPeek(uart_transfer_t spans[2])
+{
+    return UART_TransferPeekRxRingBuffer(UART1, &s_uartHandle, spans);
+}
+
+static void uartCommit(size_t count)
+{
+    UART_TransferCommitRxRingBuffer(UART1, &s_uartHandle, count);
+}
+
+static size_t uartLength(void)
+{
+    return UART_TransferGetRxRingBufferLength(&s_uartHandle);
+}
+
+static size_t uartReceive(uint8_t *data, size_t length)
+{
+    uart_transfer_t xfer = {data, length};
+    size_t received = 0;
+
+    CHECK_EQ(UART_TransferReceiveNonBlocking(UART1, &s_uartHandle, &xfer, &received), kStatus_Success);
+    return received;
+}
+
+/*
+ * LPSCI (UART0)
+ */
+
+static void lpsciSetUp(void)
+{
+    lpsci_config_t config;
+
+    HostHw_Reset();
+    LPSCI_GetDefaultConfig(&config);
+    config.enableTx = true;
+    config.enableRx = true;
+    LPSCI_Init(UART0, &config, 48000000U);
+    LPSCI_TransferCreateHandle(UART0, &s_lpsciHandle, NULL, NULL);
+    LPSCI_TransferStartRingBuffer(UART0, &s_lpsciHandle, s_ring, RING_SIZE);
+    HostUart_Attach(&s_line, UART0, UART0_IRQn, UART0_DriverIRQHandler);
+}
+
+static size_t lpsciPeek(uart_transfer_t spans[2])
+{
+    return LPSCI_TransferPeekRxRingBuffer(UART0, &s_lpsciHandle, (lpsci_transfer_t *)spans);
+}
+
+static void lpsciCommit(size_t count)
+{
+    LPSCI_TransferCommitRxRingBuffer(UART0, &s_lpsciHandle, count);
+}
+
+static size_t lpsciLength(void)
+{
+    return LPSCI_TransferGetRxRingBufferLength(&s_lpsciHandle);
+}
+
+static size_t lpsciReceive(uint8_t *data, size_t length)
+{
+    lpsci_transfer_t xfer = {data, length};
+    size_t received = 0;
+
+    CHECK_EQ(LPSCI_TransferReceiveNonBlocking(UART0, &s_lpsciHandle, &xfer, &received), kStatus_Success);
+    return received;
+}
+
+static const ring_ops_t s_drivers[] = {
+    {"uart1", uartSetUp, uartPeek, uartCommit, uartLength, uartReceive},
+    {"lpsci0", lpsciSetUp, lpsciPeek, lpsciCommit, lpsciLength, lpsciReceive},
+};
+
+/*
+ * Checks
+ */
+
+static uint8_t s_next;              // Next byte value sent down the line
+static uint8_t s_expected;          // Next byte value the reader should see
+
+static void sendBytes(uint32_t count)
+{
+    while (count--) {
+        CHECK(HostUart_Receive(&s_line, s_next++));
+    }
+}
+
+// Peek and check that the spans hold the next pending bytes, in order and inside the ring
+static size_t peekAndCheck(const ring_ops_t *ops, size_t pending)
+{
+    uart_transfer_t spans[2];
+    size_t total = ops->peek(spans);
+    uint8_t value = s_expected;
+
+    CHECK_EQ(total, pending);
+    CHECK_EQ(spans[0].dataSize + spans[1].dataSize, total);
+    if (spans[0].dataSize) {
+        CHECK((spans[0].data >= s_ring) && (spans[0].data + spans[0].dataSize <= s_ring + RING_SIZE));
+    }
+    if (spans[1].dataSize) {
+        // Only a wrapped run has a second span, and it starts the ring
+        CHECK(spans[1].data == s_ring);
+        CHECK(spans[0].data + spans[0].dataSize == s_ring + RING_SIZE);
+    }
+    for (uint32_t s = 0; s < 2U; s++) {
+        for (size_t i = 0; i < spans[s].dataSize; i++) {
+            CHECK_EQ(spans[s].data[i], value);
+            value++;
+        }
+    }
+    return total;
+}
+
+// Put the tail at position: the ring is empty afterwards
+static void moveTail(const ring_ops_t *ops, uint32_t position)
+{
+    uart_transfer_t spans[2];
+    size_t pending;
+
+    while ((pending = ops->peek(spans)) != 0U) {
+        s_expected += (uint8_t)pending;
+        ops->commit(pending);
+    }
+    while (s_lpsciHandle.rxRingBufferTail + s_uartHandle.rxRingBufferTail != position) {
+        sendBytes(1);
+        s_expected++;
+        ops->commit(1);
+    }
+}
+
+static void forEachDriver(void (*test)(const ring_ops_t *ops))
+{
+    for (uint32_t d = 0; d < ARRAY_SIZE(s_drivers); d++) {
+        memset(&s_uartHandle, 0, sizeof(s_uartHandle));
+        memset(&s_lpsciHandle, 0, sizeof(s_lpsciHandle));
+        s_drivers[d].setUp();
+        s_next = 0;
+        s_expected = 0;
+        test(&s_drivers[d]);
+    }
+}
+
+/*
+ * Every tail position, every fill level, every commit size: the spans cover the
+ * pending bytes exactly, and what is left after a commit starts where it stopped.
+ */
+static void peekCommitAllPositions(const ring_ops_t *ops)
+{
+    for (uint32_t tail = 0; tail < RING_SIZE; tail++) {
+        for (uint32_t fill = 0; fill < RING_SIZE; fill++) {
+            for (uint32_t consumed = 0; consumed <= fill; consumed++) {
+                moveTail(ops, tail);
+                sendBytes(fill);
+                CHECK_EQ(ops->length(), fill);
+
+                CHECK_EQ(peekAndCheck(ops, fill), fill);
+                ops->commit(consumed);
+                s_expected += (uint8_t)consumed;
+
+                CHECK_EQ(ops->length(), fill - consumed);
+                peekAndCheck(ops, fill - consumed);
+            }
+        }
+    }
+}
+
+static void testPeekCommitAllPositions(void)
+{
+    forEachDriver(peekCommitAllPositions);
+}
+
+/*
+ * Bytes arriving between peek and commit stay behind the peeked ones, and the copying
+ * receive picks up exactly where a commit left off.
+ */
+static void peekWhileReceiving(const ring_ops_t *ops)
+{
+    uart_transfer_t spans[2];
+    uint8_t copy[RING_SIZE];
+    size_t peeked;
+
+    moveTail(ops, RING_SIZE - 3U);
+    sendBytes(5);
+    peeked = ops->peek(spans);
+    CHECK_EQ(peeked, 5);
+
+    // More data wraps in behind the peeked run
+    sendBytes(6);
+    CHECK_EQ(spans[0].data[0], s_expected);
+    CHECK_EQ(spans[1].data[spans[1].dataSize - 1U], (uint8_t)(s_expected + 4U));
+    ops->commit(peeked);
+    s_expected += (uint8_t)peeked;
+
+    CHECK_EQ(ops->receive(copy, 6), 6);
+    for (uint32_t i = 0; i < 6U; i++) {
+        CHECK_EQ(copy[i], (uint8_t)(s_expected + i));
+    }
+    s_expected += 6U;
+    CHECK_EQ(ops->length(), 0);
+    CHECK_EQ(peekAndCheck(ops, 0), 0);
+}
+
+static void testPeekWhileReceiving(void)
+{
+    forEachDriver(peekWhileReceiving);
+}
+
+/*
+ * A full ring: peek sees all RING_SIZE - 1 bytes, committing more than is pending
+ * releases only what is there.
+ */
+static void fullRing(const ring_ops_t *ops)
+{
+    moveTail(ops, 7);
+    sendBytes(RING_SIZE - 1U);
+    CHECK_EQ(peekAndCheck(ops, RING_SIZE - 1U), RING_SIZE - 1U);
+
+    ops->commit(RING_SIZE + 4U);
+    s_expected += RING_SIZE - 1U;
+    CHECK_EQ(ops->length(), 0);
+
+    sendBytes(3);
+    CHECK_EQ(peekAndCheck(ops, 3), 3);
+}
+
+static void testFullRing(void)
+{
+    forEachDriver(fullRing);
+}
+
+int main(void)
+{
+    printf("test_uart_ring\n");
+    RUN_TEST(testPeekCommitAllPositions);
+    RUN_TEST(testPeekWhileReceiving);
+    RUN_TEST(testFullRing);
+    return HostCheck_Result();
+}
@@ -0,0 +1,333 @@
+/*
+ * Firmware update end to end: frames written by the I2C bus model into the
+ * application, programmed by the flash model, handed over after the reset
+ */
+
+#include <string.h>
+
+#include "app_update.h"
+#include "host_hw.h"
+#include "host_flash.h"
+#include "host_i2c.h"
+#include "host_app.h"
+#include "host_check.h"
+
+#define IMAGE_SIZE      3000U       // Three slot sectors, the last chunk short
+#define IMAGE_CHUNKS    ((IMAGE_SIZE + APP_UPDATE_CHUNK_MAX - 1U) / APP_UPDATE_CHUNK_MAX)
+#define SLOT_SECTOR     ((APP_UPDATE_SLOT_BASE - HOST_FLASH_BASE) / HOST_FLASH_SECTOR_SIZE)
+
+static uint8_t s_image[IMAGE_SIZE];
+static uint32_t s_imageCrc;
+
+// Stream variations
+static uint32_t s_crcError;         // XORed into the CRC announced by BEGIN
+static uint32_t s_skipChunk;        // Chunk left out, IMAGE_CHUNKS for none
+static uint32_t s_noiseChunk;       // Chunk followed by malformed LED frames, IMAGE_CHUNKS for none
+
+// Hand-overs seen by AppUpdate_HostStartImage
+static uint32_t s_starts;
+static uint32_t s_startVectors;
+
+// The assembly trampoline of app_update.c on the target
+void AppUpdate_HostStartImage(uint32_t vectors)
+{
+    s_starts++;
+    s_startVectors = vectors;
+    HostHw_Stop();
+}
+
+// Magic and command: the bytes every update frame opens with
+static void writeHeader(uint8_t *frame, uint8_t command)
+{
+    frame[0] = APP_UPDATE_MAGIC0;
+    frame[1] = APP_UPDATE_MAGIC1;
+    frame[2] = command;
+}
+
+static void writeLe32(uint8_t *data, uint32_t value)
+{
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+    data[2] = (uint8_t)(value >> 16);
+    data[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t crc32(const uint8_t *data, uint32_t length)
+{
+    uint32_t crc = 0xFFFFFFFFU;
+
+    while (length--) {
+        crc ^= *data++;
+        for (uint32_t bit = 0; bit < 8U; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
+
+// An image BootSelect accepts: stack at the top of SRAM, entry inside the image
+static void makeImage(uint32_t seed)
+{
+    uint32_t x = seed;
+
+    for (uint32_t i = 0; i < IMAGE_SIZE; i++) {
+        x = x * 1103515245U + 12345U;
+        s_image[i] = (uint8_t)(x >> 16);
+    }
+    writeLe32(&s_image[0], 0x20003000U);
+    writeLe32(&s_image[4], APP_UPDATE_SLOT_BASE + 0x101U);
+    s_imageCrc = crc32(s_image, IMAGE_SIZE);
+}
+
+static bool slotHoldsImage(void)
+{
+    return memcmp((const void *)APP_UPDATE_SLOT_BASE, s_image, IMAGE_SIZE) == 0;
+}
+
+// One frame over the bus, then the main loop passes that handle it
+static int32_t sendFrame(const uint8_t *frame, uint32_t length, uint32_t passes)
+{
+    int32_t acked = HostI2c_Write(HOST_APP_I2C_ADDRESS, frame, length);
+
+    HostApp_Poll(passes);
+    return acked;
+}
+
+static void sendChunk(uint32_t chunk, uint32_t passes)
+{
+    static uint8_t frame[APP_UPDATE_FRAME_MAX];
+    uint32_t offset = chunk * APP_UPDATE_CHUNK_MAX;
+    uint32_t length = MIN(APP_UPDATE_CHUNK_MAX, IMAGE_SIZE - offset);
+
+    writeHeader(frame, APP_UPDATE_CMD_DATA);
+    writeLe32(&frame[3], offset);
+    memcpy(&frame[7], &s_image[offset], length);
+    CHECK_EQ(sendFrame(frame, 7U + length, passes), 7U + length);
+}
+
+/*
+ * LED frames with invalid LED states whose first byte is an update command, and
+ * whose next bytes would pass for the fields of a BEGIN: both are LED frames
+ */
+static void sendMalformedLedFrames(void)
+{
+    static uint8_t frame[18] = {APP_UPDATE_CMD_BEGIN, 0x00, 0x01, 0x00, 0x00, 0x78, 0x56, 0x34, 0x12, '1', '.', '2'};
+    uint32_t packets = HostApp_GetPacketCount();
+
+    CHECK_EQ(sendFrame(frame, sizeof(frame), 2), sizeof(frame));
+    frame[0] = APP_UPDATE_CMD_ABORT;
+    CHECK_EQ(sendFrame(frame, sizeof(frame), 2), sizeof(frame));
+    CHECK_EQ(HostApp_GetPacketCount(), packets + 2U);
+}
+
+static void sendBegin(void)
+{
+    static uint8_t frame[11];
+
+    writeHeader(frame, APP_UPDATE_CMD_BEGIN);
+    writeLe32(&frame[3], IMAGE_SIZE);
+    writeLe32(&frame[7], s_imageCrc ^ s_crcError);
+    CHECK_EQ(sendFrame(frame, 11, 2), 11);
+}
+
+static void sendCommit(void)
+{
+    static uint8_t frame[3];
+
+    writeHeader(frame, APP_UPDATE_CMD_COMMIT);
+    sendFrame(frame, 3, 2);
+}
+
+// BEGIN, every chunk, COMMIT; resets on success
+static void streamImage(void)
+{
+    sendBegin();
+
+    for (uint32_t chunk = 0; chunk < IMAGE_CHUNKS; chunk++) {
+        if (chunk == s_skipChunk) {
+            continue;
+        }
+        // Odd chunks land before the main loop has programmed the previous one
+        sendChunk(chunk, (chunk & 1U) ? 1U : 2U);
+        if (chunk == 1U) {
+            // A resend after a lost ACK is ignored
+            sendChunk(0, 2);
+        }
+        if (chunk == s_noiseChunk) {
+            sendMalformedLedFrames();
+        }
+    }
+
+    sendCommit();
+}
+
+/*
+ * Chunks two at a time, the second right behind the first: the main loop only gets
+ * the pass that takes each frame, then the passes for its flash commands before the
+ * next pair. Neither frame pass may run a flash command, the slave is re-armed at once.
+ */
+static void streamPairs(void)
+{
+    const host_flash_stats_t *flash = HostFlash_GetStats();
+
+    sendBegin();
+    for (uint32_t chunk = 0; chunk < IMAGE_CHUNKS; chunk += 2U) {
+        uint64_t busyUs = flash->busyUs;
+
+        sendChunk(chunk, 1);
+        if (chunk + 1U < IMAGE_CHUNKS) {
+            sendChunk(chunk + 1U, 1);
+        }
+        CHECK_EQ(flash->busyUs, busyUs);
+        // One erase at most and a program per chunk, one flash command per pass
+        HostApp_Poll(3);
+    }
+    sendCommit();
+}
+
+static void boot(void)
+{
+    HostApp_Boot();
+}
+
+// Fresh flash, booted primary image
+static void setUp(uint32_t seed)
+{
+    HostFlash_Reset();
+    HostHw_Reset();
+    makeImage(seed);
+    s_crcError = 0;
+    s_skipChunk = IMAGE_CHUNKS;
+    s_noiseChunk = IMAGE_CHUNKS;
+    s_starts = 0;
+    CHECK_EQ(HostHw_Run(boot), HOST_RUN_RETURNED);
+}
+
+static void testLedFrame(void)
+{
+    static const uint8_t frame[] = {1, 0, '1', '9', '2', '.', '1', '6', '8', '.', '1', '.', '2', '0'};
+    uint8_t led1;
+    uint8_t led2;
+
+    setUp(1);
+    CHECK_EQ(sendFrame(frame, sizeof(frame), 2), sizeof(frame));
+    HostApp_GetLeds(&led1, &led2);
+    CHECK_EQ(led1, 1);
+    CHECK_EQ(led2, 0);
+    CHECK_EQ(HostApp_GetPacketCount(), 1);
+    CHECK_EQ(HostI2c_GetStats()->stalled, 0);
+}
+
+static void testUpdateAndHandOver(void)
+{
+    const host_flash_stats_t *flash = HostFlash_GetStats();
+
+    setUp(2);
+    HostFlash_ClearStats();
+    CHECK_EQ(HostHw_Run(streamImage), HOST_RUN_SYSTEM_RESET);
+
+    CHECK(slotHoldsImage());
+    CHECK_EQ(flash->overwrites, 0);
+    CHECK_EQ(flash->irqUnmasked, 0);
+    CHECK_EQ(flash->sectorErases[SLOT_SECTOR], 1);
+    CHECK_EQ(flash->sectorErases[SLOT_SECTOR + 2U], 1);
+    CHECK_EQ(flash->sectorErases[SLOT_SECTOR + 3U], 0);
+    CHECK_EQ(HostI2c_GetStats()->stalled, 0);
+
+    // The next boot hands over, and keeps doing so
+    CHECK_EQ(HostHw_Run(boot), HOST_RUN_STOPPED);
+    CHECK_EQ(s_startVectors, APP_UPDATE_SLOT_BASE);
+    CHECK_EQ(HostHw_Run(boot), HOST_RUN_STOPPED);
+    CHECK_EQ(s_starts, 2);
+}
+
+static void testCrcMismatch(void)
+{
+    setUp(3);
+    s_crcError = 1;
+    CHECK_EQ(HostHw_Run(streamImage), HOST_RUN_RETURNED);
+    CHECK_EQ(HostHw_Run(boot), HOST_RUN_RETURNED);
+    CHECK_EQ(s_starts, 0);
+}
+
+static void testMissingChunk(void)
+{
+    setUp(4);
+    s_skipChunk = 5;
+    CHECK_EQ(HostHw_Run(streamImage), HOST_RUN_RETURNED);
+    CHECK_EQ(HostHw_Run(boot), HOST_RUN_RETURNED);
+    CHECK_EQ(s_starts, 0);
+}
+
+// A second chunk right behind the first lands in the other buffer, not behind a flash command
+static void testChunkPairsWithoutStall(void)
+{
+    setUp(7);
+    CHECK_EQ(HostHw_Run(streamPairs), HOST_RUN_SYSTEM_RESET);
+    CHECK(slotHoldsImage());
+    CHECK_EQ(HostFlash_GetStats()->overwrites, 0);
+    CHECK_EQ(HostI2c_GetStats()->stalled, 0);
+    CHECK_EQ(HostHw_Run(boot), HOST_RUN_STOPPED);
+    CHECK_EQ(s_starts, 1);
+}
+
+// LED frames opening with a command byte neither restart nor abort the update
+static void testMalformedLedFrames(void)
+{
+    setUp(6);
+    s_noiseChunk = 3;
+    CHECK_EQ(HostHw_Run(streamImage), HOST_RUN_SYSTEM_RESET);
+    CHECK(slotHoldsImage());
+    CHECK_EQ(HostHw_Run(boot), HOST_RUN_STOPPED);
+    CHECK_EQ(s_starts, 1);
+}
+
+/*
+ * Cut the power in every flash command of an update: the next boot runs the
+ * primary or the complete new image, never a partial one, and a retry of the
+ * whole update after booting the primary activates it.
+ */
+static void testPowerLossDuringUpdate(void)
+{
+    uint32_t commands;
+    uint32_t cut;
+    uint32_t activated = 0;
+
+    setUp(5);
+    HostFlash_ClearStats();
+    CHECK_EQ(HostHw_Run(streamImage), HOST_RUN_SYSTEM_RESET);
+    commands = HostFlash_GetStats()->commands;
+
+    for (cut = 1; cut <= commands; cut++) {
+        setUp(5);
+        HostFlash_SetPowerLoss(cut);
+        CHECK_EQ(HostHw_Run(streamImage), HOST_RUN_POWER_LOSS);
+        HostFlash_SetPowerLoss(0);
+        HostHw_Reset();
+
+        if (HostHw_Run(boot) == HOST_RUN_STOPPED) {
+            // Only once the activation record made it
+            CHECK(slotHoldsImage());
+            activated++;
+            continue;
+        }
+        CHECK_EQ(s_starts, 0);
+        CHECK_EQ(HostHw_Run(streamImage), HOST_RUN_SYSTEM_RESET);
+        CHECK(slotHoldsImage());
+        CHECK_EQ(HostHw_Run(boot), HOST_RUN_STOPPED);
+    }
+    printf("  %u power cuts, %u of them after the activation\n", commands, activated);
+}
+
+int main(void)
+{
+    printf("test_update\n");
+    RUN_TEST(testLedFrame);
+    RUN_TEST(testUpdateAndHandOver);
+    RUN_TEST(testCrcMismatch);
+    RUN_TEST(testMissingChunk);
+    RUN_TEST(testMalformedLedFrames);
+    RUN_TEST(testChunkPairsWithoutStall);
+    RUN_TEST(testPowerLossDuringUpdate);
+    return HostCheck_Result();
+}
@@ -0,0 +1,450 @@
+/*
+ * CMSIS Driver_USART0..2 over the LPSCI and UART register models: power and
+ * configuration, asynchronous send and receive with their counts and events, aborts,
+ * the RX ring buffer and RTS flow control
+ */
+
+#include <string.h>
+
+#include "fsl_uart.h"
+#include "host_hw.h"
+#include "host_uart.h"
+#include "host_usart_cmsis.h"
+#include "host_check.h"
+
+#define MODE_8N1    (ARM_USART_MODE_ASYNCHRONOUS | ARM_USART_DATA_BITS_8 | ARM_USART_PARITY_NONE | ARM_USART_STOP_BITS_1)
+
+typedef struct {
+    const char *name;
+    ARM_DRIVER_USART *driver;
+    void *base;
+    IRQn_Type irqn;
+    void (*handler)(void);
+    uint32_t events;                // Events signalled since setUp
+    uint32_t lastEvent;
+    uint32_t pins;                  // InitPins minus DeinitPins calls
+} usart_t;
+
+void UART0_DriverIRQHandler(void);
+void UART1_DriverIRQHandler(void);
+void UART2_DriverIRQHandler(void);
+
+static usart_t s_usarts[] = {
+    {"usart0", &Driver_USART0, UART0, UART0_IRQn, UART0_DriverIRQHandler},
+    {"usart1", &Driver_USART1, UART1, UART1_IRQn, UART1_DriverIRQHandler},
+    {"usart2", &Driver_USART2, UART2, UART2_IRQn, UART2_DriverIRQHandler},
+};
+
+static host_uart_t s_line;
+static bool s_rts;
+static uint32_t s_rtsCalls;
+
+/*
+ * What the board provides
+ */
+
+uint32_t UART0_GetFreq(void)
+{
+    return 48000000U;
+}
+
+uint32_t UART1_GetFreq(void)
+{
+    return 24000000U;
+}
+
+uint32_t UART2_GetFreq(void)
+{
+    return 24000000U;
+}
+
+void UART0_InitPins(void)
+{
+    s_usarts[0].pins++;
+}
+
+void UART0_DeinitPins(void)
+{
+    s_usarts[0].pins--;
+}
+
+void UART1_InitPins(void)
+{
+    s_usarts[1].pins++;
+}
+
+void UART1_DeinitPins(void)
+{
+    s_usarts[1].pins--;
+}
+
+void UART2_InitPins(void)
+{
+    s_usarts[2].pins++;
+}
+
+void UART2_DeinitPins(void)
+{
+    s_usarts[2].pins--;
+}
+
+void HostUsart_SetRts1(bool active)
+{
+    s_rts = active;
+    s_rtsCalls++;
+}
+
+static void signalEvent(usart_t *usart, uint32_t event)
+{
+    usart->events |= event;
+    usart->lastEvent = event;
+}
+
+static void usart0Event(uint32_t event)
+{
+    signalEvent(&s_usarts[0], event);
+}
+
+static void usart1Event(uint32_t event)
+{
+    signalEvent(&s_usarts[1], event);
+}
+
+static void usart2Event(uint32_t event)
+{
+    signalEvent(&s_usarts[2], event);
+}
+
+static const ARM_USART_SignalEvent_t s_eventCallbacks[] = {usart0Event, usart1Event, usart2Event};
+
+/*
+ * Set up
+ */
+
+// Initialized, powered, 8N1 at 115200 with both directions on, the line attached
+static void setUp(usart_t *usart)
+{
+    ARM_DRIVER_USART *driver = usart->driver;
+
+    HostHw_Reset();
+    usart->events = 0;
+    usart->lastEvent = 0;
+    s_rts = false;
+    s_rtsCalls = 0;
+
+    HostUart_Attach(&s_line, usart->base, usart->irqn, usart->handler);
+    CHECK_EQ(driver->Initialize(s_eventCallbacks[usart - s_usarts]), ARM_DRIVER_OK);
+    CHECK_EQ(driver->PowerControl(ARM_POWER_FULL), ARM_DRIVER_OK);
+    CHECK_EQ(driver->Control(MODE_8N1, 115200U), ARM_DRIVER_OK);
+    CHECK_EQ(driver->Control(ARM_USART_CONTROL_TX, 1), ARM_DRIVER_OK);
+    CHECK_EQ(driver->Control(ARM_USART_CONTROL_RX, 1), ARM_DRIVER_OK);
+}
+
+static void tearDown(usart_t *usart)
+{
+    CHECK_EQ(usart->driver->PowerControl(ARM_POWER_OFF), ARM_DRIVER_OK);
+    CHECK_EQ(usart->driver->Uninitialize(), ARM_DRIVER_OK);
+    CHECK_EQ(usart->pins, 0);
+}
+
+static void forEachUsart(void (*test)(usart_t *usart))
+{
+    for (uint32_t i = 0; i < ARRAY_SIZE(s_usarts); i++) {
+        setUp(&s_usarts[i]);
+        test(&s_usarts[i]);
+        tearDown(&s_usarts[i]);
+    }
+}
+
+static void receiveBytes(const uint8_t *data, uint32_t length)
+{
+    while (length--) {
+        HostUart_Receive(&s_line, *data++);
+    }
+}
+
+/*
+ * Tests
+ */
+
+static void testPowerAndConfiguration(void)
+{
+    for (uint32_t i = 0; i < ARRAY_SIZE(s_usarts); i++) {
+        usart_t *usart = &s_usarts[i];
+        ARM_DRIVER_USART *driver = usart->driver;
+        UART_Type *base = (UART_Type *)usart->base;
+
+        HostHw_Reset();
+        HostUart_Attach(&s_line, usart->base, usart->irqn, usart->handler);
+        CHECK_EQ(driver->PowerControl(ARM_POWER_FULL), ARM_DRIVER_ERROR);
+        CHECK_EQ(driver->Initialize(NULL), ARM_DRIVER_OK);
+        CHECK_EQ(usart->pins, 1);
+        CHECK_EQ(driver->PowerControl(ARM_POWER_LOW), ARM_DRIVER_ERROR_UNSUPPORTED);
+        CHECK_EQ(driver->PowerControl(ARM_POWER_FULL), ARM_DRIVER_OK);
+        // Powered up with the transmitter and receiver off
+        CHECK(!(base->C2 & (UART_C2_TE_MASK | UART_C2_RE_MASK)));
+        CHECK(driver->GetCapabilities().asynchronous);
+        CHECK_EQ(driver->Transfer("x", NULL, 1), ARM_DRIVER_ERROR_UNSUPPORTED);
+
+        CHECK_EQ(driver->Control(ARM_USART_CONTROL_TX, 1), ARM_DRIVER_OK);
+        CHECK_EQ(driver->Control(MODE_8N1 | ARM_USART_PARITY_EVEN, 9600U), ARM_DRIVER_OK);
+        CHECK_EQ(base->C1 & (UART_C1_PE_MASK | UART_C1_PT_MASK | UART_C1_M_MASK), UART_C1_PE_MASK | UART_C1_M_MASK);
+        CHECK_EQ(driver->Control(MODE_8N1 | ARM_USART_PARITY_ODD | ARM_USART_STOP_BITS_2, 9600U), ARM_DRIVER_OK);
+        CHECK_EQ(base->C1 & (UART_C1_PE_MASK | UART_C1_PT_MASK), UART_C1_PE_MASK | UART_C1_PT_MASK);
+        CHECK(base->BDH & UART_BDH_SBNS_MASK);
+        // The format change kept the directions as they were
+        CHECK_EQ(base->C2 & (UART_C2_TE_MASK | UART_C2_RE_MASK), UART_C2_TE_MASK);
+
+        CHECK_EQ(driver->Control(MODE_8N1, 115200U), ARM_DRIVER_OK);
+        if (usart->base != UART0) {
+            // 24 MHz / (16 x 115200)
+            CHECK_EQ(base->BDL, 13);
+            CHECK_EQ(driver->Control(MODE_8N1, 1000000U), ARM_USART_ERROR_BAUDRATE);
+        }
+        CHECK_EQ(driver->Control(MODE_8N1 | ARM_USART_DATA_BITS_7, 9600U), ARM_USART_ERROR_DATA_BITS);
+        CHECK_EQ(driver->Control(MODE_8N1 | ARM_USART_PARITY_Msk, 9600U), ARM_USART_ERROR_PARITY);
+        CHECK_EQ(driver->Control(MODE_8N1 | ARM_USART_STOP_BITS_1_5, 9600U), ARM_USART_ERROR_STOP_BITS);
+        CHECK_EQ(driver->Control(MODE_8N1 | ARM_USART_FLOW_CONTROL_CTS, 9600U), ARM_USART_ERROR_FLOW_CONTROL);
+        CHECK_EQ(driver->Control(ARM_USART_MODE_IRDA, 9600U), ARM_DRIVER_ERROR_UNSUPPORTED);
+
+        CHECK_EQ(driver->PowerControl(ARM_POWER_OFF), ARM_DRIVER_OK);
+        // LPSCI_Deinit only gates the clock
+        if (usart->base != UART0) {
+            CHECK_EQ(base->C2, 0);
+        }
+        CHECK_EQ(driver->Uninitialize(), ARM_DRIVER_OK);
+        CHECK_EQ(usart->pins, 0);
+    }
+}
+
+/*
+ * A send completes one byte per TDRE interrupt, a receive once all its bytes are in;
+ * the counts follow the transfer in progress and keep the final one afterwards.
+ */
+static void sendAndReceive(usart_t *usart)
+{
+    static const uint8_t message[] = "Hello, master";
+    ARM_DRIVER_USART *driver = usart->driver;
+    uint8_t line[sizeof(message)];
+    uint8_t data[8];
+
+    CHECK_EQ(driver->Send(message, sizeof(message)), ARM_DRIVER_OK);
+    CHECK(driver->GetStatus().tx_busy);
+    CHECK_EQ(driver->GetTxCount(), 0);
+    CHECK_EQ(driver->Send(message, 1), ARM_DRIVER_ERROR_BUSY);
+    CHECK_EQ(driver->Control(MODE_8N1, 9600U), ARM_DRIVER_ERROR_BUSY);
+
+    CHECK_EQ(HostUart_Transmit(&s_line, line, 5), 5);
+    CHECK_EQ(driver->GetTxCount(), 5);
+    CHECK_EQ(usart->events, 0);
+    CHECK_EQ(HostUart_Transmit(&s_line, &line[5], sizeof(message)), sizeof(message) - 5U);
+    CHECK(memcmp(line, message, sizeof(message)) == 0);
+    CHECK_EQ(usart->events, ARM_USART_EVENT_SEND_COMPLETE);
+    CHECK(!driver->GetStatus().tx_busy);
+    CHECK_EQ(driver->GetTxCount(), sizeof(message));
+
+    usart->events = 0;
+    CHECK_EQ(driver->Receive(data, sizeof(data)), ARM_DRIVER_OK);
+    CHECK(driver->GetStatus().rx_busy);
+    CHECK_EQ(driver->Receive(data, 1), ARM_DRIVER_ERROR_BUSY);
+    receiveBytes(message, 3);
+    CHECK_EQ(driver->GetRxCount(), 3);
+    CHECK_EQ(usart->events, 0);
+    receiveBytes(&message[3], sizeof(data) - 3U);
+    CHECK_EQ(usart->events, ARM_USART_EVENT_RECEIVE_COMPLETE);
+    CHECK(!driver->GetStatus().rx_busy);
+    CHECK_EQ(driver->GetRxCount(), sizeof(data));
+    CHECK(memcmp(data, message, sizeof(data)) == 0);
+
+    // Both directions at once
+    usart->events = 0;
+    CHECK_EQ(driver->Receive(data, 4), ARM_DRIVER_OK);
+    CHECK_EQ(driver->Send(message, 4), ARM_DRIVER_OK);
+    receiveBytes((const uint8_t *)"ping", 4);
+    CHECK_EQ(HostUart_Transmit(&s_line, line, 4), 4);
+    CHECK_EQ(usart->events, ARM_USART_EVENT_SEND_COMPLETE | ARM_USART_EVENT_RECEIVE_COMPLETE);
+    CHECK(memcmp(data, "ping", 4) == 0);
+    CHECK_EQ(s_line.stats.overruns, 0);
+}
+
+static void testSendAndReceive(void)
+{
+    forEachUsart(sendAndReceive);
+}
+
+// Aborts keep the counts of what was transferred
+static void abortTransfers(usart_t *usart)
+{
+    static const uint8_t message[] = "0123456789";
+    ARM_DRIVER_USART *driver = usart->driver;
+    uint8_t line[sizeof(message)];
+    uint8_t data[8];
+
+    CHECK_EQ(driver->Send(message, 10), ARM_DRIVER_OK);
+    CHECK_EQ(HostUart_Transmit(&s_line, line, 3), 3);
+    CHECK_EQ(driver->Control(ARM_USART_ABORT_SEND, 0), ARM_DRIVER_OK);
+    CHECK(!driver->GetStatus().tx_busy);
+    CHECK_EQ(driver->GetTxCount(), 3);
+    CHECK_EQ(HostUart_Transmit(&s_line, line, sizeof(line)), 0);
+
+    CHECK_EQ(driver->Receive(data, sizeof(data)), ARM_DRIVER_OK);
+    receiveBytes(message, 5);
+    CHECK_EQ(driver->Control(ARM_USART_ABORT_RECEIVE, 0), ARM_DRIVER_OK);
+    CHECK(!driver->GetStatus().rx_busy);
+    CHECK_EQ(driver->GetRxCount(), 5);
+    CHECK_EQ(usart->events, 0);
+
+    // Aborting nothing changes nothing
+    CHECK_EQ(driver->Control(ARM_USART_ABORT_SEND, 0), ARM_DRIVER_OK);
+    CHECK_EQ(driver->Control(ARM_USART_ABORT_RECEIVE, 0), ARM_DRIVER_OK);
+    CHECK_EQ(driver->GetTxCount(), 3);
+    CHECK_EQ(driver->GetRxCount(), 5);
+}
+
+static void testAbort(void)
+{
+    forEachUsart(abortTransfers);
+}
+
+// Power off in the middle of both transfers
+static void testPowerOffAborts(void)
+{
+    usart_t *usart = &s_usarts[2];
+    ARM_DRIVER_USART *driver = usart->driver;
+    uint8_t line[4];
+    uint8_t data[4];
+
+    setUp(usart);
+    CHECK_EQ(driver->Send("abcd", 4), ARM_DRIVER_OK);
+    CHECK_EQ(driver->Receive(data, 4), ARM_DRIVER_OK);
+    CHECK_EQ(HostUart_Transmit(&s_line, line, 1), 1);
+    tearDown(usart);
+    CHECK(!(UART2->C2 & (UART_C2_TIE_MASK | UART_C2_RIE_MASK)));
+    CHECK_EQ(driver->GetTxCount(), 1);
+    CHECK_EQ(usart->events, 0);
+}
+
+/*
+ * Bytes arriving while no receive is running are lost without a ring buffer: the
+ * receiver overruns and the next receive reports it. USART1 keeps them in its ring,
+ * and a receive takes them from there first.
+ */
+static void testEarlyBytes(void)
+{
+    usart_t *usart = &s_usarts[0];
+    ARM_DRIVER_USART *driver;
+    uint8_t data[6];
+
+    setUp(usart);
+    driver = usart->driver;
+    receiveBytes((const uint8_t *)"xyz", 3);
+    CHECK_EQ(s_line.stats.overruns, 2);
+    CHECK_EQ(driver->Receive(data, 2), ARM_DRIVER_OK);
+    CHECK(!HostUart_Service(&s_line));
+    CHECK_EQ(usart->events, ARM_USART_EVENT_RX_OVERFLOW);
+    CHECK(driver->GetStatus().rx_overflow);
+    receiveBytes((const uint8_t *)"ok", 2);
+    CHECK_EQ(usart->lastEvent, ARM_USART_EVENT_RECEIVE_COMPLETE);
+    CHECK(memcmp(data, "ok", 2) == 0);
+    // A new receive clears the error
+    CHECK_EQ(driver->Receive(data, 2), ARM_DRIVER_OK);
+    CHECK(!driver->GetStatus().rx_overflow);
+    tearDown(usart);
+
+    usart = &s_usarts[1];
+    setUp(usart);
+    driver = usart->driver;
+    receiveBytes((const uint8_t *)"early", 5);
+    CHECK_EQ(s_line.stats.overruns, 0);
+    CHECK_EQ(driver->Receive(data, 3), ARM_DRIVER_OK);
+    CHECK_EQ(usart->events, ARM_USART_EVENT_RECEIVE_COMPLETE);
+    CHECK_EQ(driver->GetRxCount(), 3);
+    CHECK(memcmp(data, "ear", 3) == 0);
+
+    usart->events = 0;
+    CHECK_EQ(driver->Receive(data, 6), ARM_DRIVER_OK);
+    CHECK_EQ(driver->GetRxCount(), 2);
+    receiveBytes((const uint8_t *)"late", 4);
+    CHECK_EQ(usart->events, ARM_USART_EVENT_RECEIVE_COMPLETE);
+    CHECK_EQ(driver->GetRxCount(), 6);
+    CHECK(memcmp(data, "lylate", 6) == 0);
+
+    // A full ring overwrites the oldest bytes and reports the overflow
+    usart->events = 0;
+    for (uint32_t i = 0; i < HOST_USART_RX_BUFFER_SIZE + 2U; i++) {
+        HostUart_Receive(&s_line, (uint8_t)i);
+    }
+    CHECK_EQ(usart->events, ARM_USART_EVENT_RX_OVERFLOW);
+    CHECK_EQ(driver->Receive(data, 1), ARM_DRIVER_OK);
+    CHECK_EQ(data[0], 3);
+    tearDown(usart);
+}
+
+/*
+ * RTS flow control needs the ring buffer and an RTS hook, which only USART1 has. The
+ * line drops at 3/4 of the ring and rises when a receive has read it down to 1/4, and
+ * then belongs to the driver: driving it by hand is refused until flow control is off.
+ */
+static void testRtsFlowControl(void)
+{
+    usart_t *usart = &s_usarts[1];
+    ARM_DRIVER_USART *driver;
+    uint8_t data[HOST_USART_RX_BUFFER_SIZE];
+
+    setUp(&s_usarts[0]);
+    CHECK_EQ(s_usarts[0].driver->Control(MODE_8N1 | ARM_USART_FLOW_CONTROL_RTS, 115200U), ARM_USART_ERROR_FLOW_CONTROL);
+    CHECK_EQ(s_usarts[0].driver->SetModemControl(ARM_USART_RTS_SET), ARM_DRIVER_ERROR_UNSUPPORTED);
+    tearDown(&s_usarts[0]);
+
+    setUp(usart);
+    driver = usart->driver;
+    CHECK(driver->GetCapabilities().flow_control_rts);
+
+    // By hand
+    CHECK_EQ(driver->SetModemControl(ARM_USART_RTS_SET), ARM_DRIVER_OK);
+    CHECK(s_rts);
+    CHECK_EQ(driver->SetModemControl(ARM_USART_RTS_CLEAR), ARM_DRIVER_OK);
+    CHECK(!s_rts);
+    CHECK_EQ(driver->SetModemControl(ARM_USART_DTR_SET), ARM_DRIVER_ERROR_UNSUPPORTED);
+
+    // By the ring buffer fill level
+    CHECK_EQ(driver->Control(MODE_8N1 | ARM_USART_FLOW_CONTROL_RTS, 115200U), ARM_DRIVER_OK);
+    CHECK(s_rts);
+    CHECK_EQ(driver->SetModemControl(ARM_USART_RTS_CLEAR), ARM_DRIVER_ERROR);
+    s_rtsCalls = 0;
+    for (uint32_t i = 0; i < HOST_USART_RX_BUFFER_SIZE * 3U / 4U - 1U; i++) {
+        HostUart_Receive(&s_line, (uint8_t)i);
+    }
+    CHECK(s_rts);
+    HostUart_Receive(&s_line, 0xAA);
+    CHECK(!s_rts);
+
+    CHECK_EQ(driver->Receive(data, HOST_USART_RX_BUFFER_SIZE / 2U - 1U), ARM_DRIVER_OK);
+    CHECK(!s_rts);
+    CHECK_EQ(driver->Receive(data, 1), ARM_DRIVER_OK);
+    CHECK(s_rts);
+    CHECK_EQ(s_rtsCalls, 2);
+    CHECK_EQ(usart->events & ARM_USART_EVENT_RX_OVERFLOW, 0);
+
+    // Flow control off hands the line back
+    CHECK_EQ(driver->Control(MODE_8N1, 115200U), ARM_DRIVER_OK);
+    CHECK_EQ(driver->SetModemControl(ARM_USART_RTS_CLEAR), ARM_DRIVER_OK);
+    CHECK(!s_rts);
+    tearDown(usart);
+
+    setUp(&s_usarts[2]);
+    CHECK_EQ(s_usarts[2].driver->Control(MODE_8N1 | ARM_USART_FLOW_CONTROL_RTS, 115200U), ARM_USART_ERROR_FLOW_CONTROL);
+    tearDown(&s_usarts[2]);
+}
+
+int main(void)
+{
+    printf("test_usart_cmsis\n");
+    RUN_TEST(testPowerAndConfiguration);
+    RUN_TEST(testSendAndReceive);
+    RUN_TEST(testAbort);
+    RUN_TEST(testPowerOffAborts);
+    RUN_TEST(testEarlyBytes);
+    RUN_TEST(testRtsFlowControl);
+    return HostCheck_Result();
+}
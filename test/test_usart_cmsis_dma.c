@@ -0,0 +1,286 @@
+/*
+ * CMSIS Driver_USART0 and Driver_USART1 in their DMA variants, over the LPSCI, UART
+ * and DMA models: send and receive with their counts and completion events, aborts,
+ * and the channels going back to the DMA manager at power off
+ */
+
+#include <string.h>
+
+#include "fsl_uart.h"
+#include "host_hw.h"
+#include "host_uart.h"
+#include "host_dma.h"
+#include "host_usart_cmsis.h"
+#include "host_check.h"
+
+#ifndef HOST_USART_DMA
+#error "Link with the HOST_USART_DMA build of host_usart_cmsis.c"
+#endif
+
+#define MODE_8N1    (ARM_USART_MODE_ASYNCHRONOUS | ARM_USART_DATA_BITS_8 | ARM_USART_PARITY_NONE | ARM_USART_STOP_BITS_1)
+#define DMA_CHANNELS 4U
+
+typedef struct {
+    const char *name;
+    ARM_DRIVER_USART *driver;
+    void *base;
+    IRQn_Type irqn;
+    void (*handler)(void);
+    uint32_t events;                // Events signalled since setUp
+    uint32_t lastEvent;
+    uint32_t pins;                  // InitPins minus DeinitPins calls
+} usart_t;
+
+void UART0_DriverIRQHandler(void);
+void UART1_DriverIRQHandler(void);
+
+static usart_t s_usarts[] = {
+    {"usart0", &Driver_USART0, UART0, UART0_IRQn, UART0_DriverIRQHandler},
+    {"usart1", &Driver_USART1, UART1, UART1_IRQn, UART1_DriverIRQHandler},
+};
+
+static host_uart_t s_line;
+
+// The DMA registers hold 32-bit addresses: buffers live in static data, below 4 GB
+static const uint8_t s_message[] = "Hello, master";
+static uint8_t s_data[16];
+
+/*
+ * What the board provides
+ */
+
+uint32_t UART0_GetFreq(void)
+{
+    return 48000000U;
+}
+
+uint32_t UART1_GetFreq(void)
+{
+    return 24000000U;
+}
+
+void UART0_InitPins(void)
+{
+    s_usarts[0].pins++;
+}
+
+void UART0_DeinitPins(void)
+{
+    s_usarts[0].pins--;
+}
+
+void UART1_InitPins(void)
+{
+    s_usarts[1].pins++;
+}
+
+void UART1_DeinitPins(void)
+{
+    s_usarts[1].pins--;
+}
+
+static void signalEvent(usart_t *usart, uint32_t event)
+{
+    usart->events |= event;
+    usart->lastEvent = event;
+}
+
+static void usart0Event(uint32_t event)
+{
+    signalEvent(&s_usarts[0], event);
+}
+
+static void usart1Event(uint32_t event)
+{
+    signalEvent(&s_usarts[1], event);
+}
+
+static const ARM_USART_SignalEvent_t s_eventCallbacks[] = {usart0Event, usart1Event};
+
+/*
+ * Set up
+ */
+
+// Channels the DMAMUX routes somewhere: those the driver holds
+static uint32_t routedChannels(void)
+{
+    uint32_t routed = 0;
+
+    for (uint32_t channel = 0; channel < DMA_CHANNELS; channel++) {
+        if (DMAMUX0->CHCFG[channel] & DMAMUX_CHCFG_ENBL_MASK) {
+            routed++;
+        }
+    }
+    return routed;
+}
+
+// Initialized, powered, 8N1 at 115200 with both directions on, the line attached
+static void setUp(usart_t *usart)
+{
+    ARM_DRIVER_USART *driver = usart->driver;
+
+    HostHw_Reset();
+    HostDma_Reset();
+    usart->events = 0;
+    usart->lastEvent = 0;
+    memset(s_data, 0, sizeof(s_data));
+
+    HostUart_Attach(&s_line, usart->base, usart->irqn, usart->handler);
+    CHECK_EQ(driver->Initialize(s_eventCallbacks[usart - s_usarts]), ARM_DRIVER_OK);
+    CHECK_EQ(driver->PowerControl(ARM_POWER_FULL), ARM_DRIVER_OK);
+    CHECK_EQ(routedChannels(), 2);
+    CHECK_EQ(driver->Control(MODE_8N1, 115200U), ARM_DRIVER_OK);
+    CHECK_EQ(driver->Control(ARM_USART_CONTROL_TX, 1), ARM_DRIVER_OK);
+    CHECK_EQ(driver->Control(ARM_USART_CONTROL_RX, 1), ARM_DRIVER_OK);
+}
+
+// Power off hands both channels back, or the next setUp would run out of them
+static void tearDown(usart_t *usart)
+{
+    CHECK_EQ(usart->driver->PowerControl(ARM_POWER_OFF), ARM_DRIVER_OK);
+    CHECK_EQ(usart->driver->Uninitialize(), ARM_DRIVER_OK);
+    CHECK_EQ(usart->pins, 0);
+    CHECK_EQ(routedChannels(), 0);
+}
+
+static void forEachUsart(void (*test)(usart_t *usart))
+{
+    for (uint32_t i = 0; i < ARRAY_SIZE(s_usarts); i++) {
+        setUp(&s_usarts[i]);
+        test(&s_usarts[i]);
+        tearDown(&s_usarts[i]);
+    }
+}
+
+static void receiveBytes(const uint8_t *data, uint32_t length)
+{
+    while (length--) {
+        HostUart_Receive(&s_line, *data++);
+    }
+}
+
+/*
+ * Tests
+ */
+
+/*
+ * The channels move every byte, the peripheral interrupt stays quiet; the counts follow
+ * the channel's remaining byte count and keep the final one after the completion event
+ */
+static void sendAndReceive(usart_t *usart)
+{
+    ARM_DRIVER_USART *driver = usart->driver;
+    uint8_t line[sizeof(s_message)];
+
+    CHECK_EQ(driver->Send(s_message, sizeof(s_message)), ARM_DRIVER_OK);
+    CHECK(driver->GetStatus().tx_busy);
+    CHECK_EQ(driver->GetTxCount(), 0);
+    CHECK_EQ(driver->Send(s_message, 1), ARM_DRIVER_ERROR_BUSY);
+    CHECK_EQ(driver->Control(MODE_8N1, 9600U), ARM_DRIVER_ERROR_BUSY);
+
+    CHECK_EQ(HostUart_Transmit(&s_line, line, 5), 5);
+    CHECK_EQ(driver->GetTxCount(), 5);
+    CHECK_EQ(usart->events, 0);
+    CHECK_EQ(HostUart_Transmit(&s_line, &line[5], sizeof(s_message)), sizeof(s_message) - 5U);
+    CHECK(memcmp(line, s_message, sizeof(s_message)) == 0);
+    CHECK_EQ(usart->events, ARM_USART_EVENT_SEND_COMPLETE);
+    CHECK(!driver->GetStatus().tx_busy);
+    CHECK_EQ(driver->GetTxCount(), sizeof(s_message));
+
+    usart->events = 0;
+    CHECK_EQ(driver->Receive(s_data, 8), ARM_DRIVER_OK);
+    CHECK(driver->GetStatus().rx_busy);
+    CHECK_EQ(driver->Receive(s_data, 1), ARM_DRIVER_ERROR_BUSY);
+    receiveBytes(s_message, 3);
+    CHECK_EQ(driver->GetRxCount(), 3);
+    CHECK_EQ(usart->events, 0);
+    receiveBytes(&s_message[3], 5);
+    CHECK_EQ(usart->events, ARM_USART_EVENT_RECEIVE_COMPLETE);
+    CHECK(!driver->GetStatus().rx_busy);
+    CHECK_EQ(driver->GetRxCount(), 8);
+    CHECK(memcmp(s_data, s_message, 8) == 0);
+
+    // Both directions at once
+    usart->events = 0;
+    CHECK_EQ(driver->Receive(s_data, 4), ARM_DRIVER_OK);
+    CHECK_EQ(driver->Send(s_message, 4), ARM_DRIVER_OK);
+    receiveBytes((const uint8_t *)"ping", 4);
+    CHECK_EQ(HostUart_Transmit(&s_line, line, 4), 4);
+    CHECK_EQ(usart->events, ARM_USART_EVENT_SEND_COMPLETE | ARM_USART_EVENT_RECEIVE_COMPLETE);
+    CHECK(memcmp(s_data, "ping", 4) == 0);
+    CHECK_EQ(s_line.stats.overruns, 0);
+
+    CHECK_EQ(s_line.stats.dmaMoves, sizeof(s_message) + 8U + 8U);
+    CHECK_EQ(HostDma_GetStats()->completions, 4);
+}
+
+static void testSendAndReceive(void)
+{
+    forEachUsart(sendAndReceive);
+}
+
+// Aborts stop the channels and keep the counts of what was transferred
+static void abortTransfers(usart_t *usart)
+{
+    ARM_DRIVER_USART *driver = usart->driver;
+    uint8_t line[sizeof(s_message)];
+
+    CHECK_EQ(driver->Send(s_message, 10), ARM_DRIVER_OK);
+    CHECK_EQ(HostUart_Transmit(&s_line, line, 3), 3);
+    CHECK_EQ(driver->Control(ARM_USART_ABORT_SEND, 0), ARM_DRIVER_OK);
+    CHECK(!driver->GetStatus().tx_busy);
+    CHECK_EQ(driver->GetTxCount(), 3);
+    CHECK_EQ(HostUart_Transmit(&s_line, line, sizeof(line)), 0);
+
+    CHECK_EQ(driver->Receive(s_data, 8), ARM_DRIVER_OK);
+    receiveBytes(s_message, 5);
+    CHECK_EQ(driver->Control(ARM_USART_ABORT_RECEIVE, 0), ARM_DRIVER_OK);
+    CHECK(!driver->GetStatus().rx_busy);
+    CHECK_EQ(driver->GetRxCount(), 5);
+    CHECK_EQ(usart->events, 0);
+    CHECK_EQ(s_line.stats.dmaMoves, 8);
+
+    // Aborting nothing changes nothing
+    CHECK_EQ(driver->Control(ARM_USART_ABORT_SEND, 0), ARM_DRIVER_OK);
+    CHECK_EQ(driver->Control(ARM_USART_ABORT_RECEIVE, 0), ARM_DRIVER_OK);
+    CHECK_EQ(driver->GetTxCount(), 3);
+    CHECK_EQ(driver->GetRxCount(), 5);
+
+    // A transfer after the abort starts from the beginning of its buffer
+    CHECK_EQ(driver->Send(s_message, 2), ARM_DRIVER_OK);
+    CHECK_EQ(driver->GetTxCount(), 0);
+    CHECK_EQ(HostUart_Transmit(&s_line, line, sizeof(line)), 2);
+    CHECK(memcmp(line, s_message, 2) == 0);
+    CHECK_EQ(usart->events, ARM_USART_EVENT_SEND_COMPLETE);
+}
+
+static void testAbort(void)
+{
+    forEachUsart(abortTransfers);
+}
+
+// Power off in the middle of both transfers
+static void testPowerOffAborts(void)
+{
+    usart_t *usart = &s_usarts[1];
+    ARM_DRIVER_USART *driver = usart->driver;
+    uint8_t line[4];
+
+    setUp(usart);
+    CHECK_EQ(driver->Send(s_message, 4), ARM_DRIVER_OK);
+    CHECK_EQ(driver->Receive(s_data, 4), ARM_DRIVER_OK);
+    CHECK_EQ(HostUart_Transmit(&s_line, line, 1), 1);
+    tearDown(usart);
+    CHECK(!(UART1->C4 & (UART_C4_TDMAS_MASK | UART_C4_RDMAS_MASK)));
+    CHECK_EQ(driver->GetTxCount(), 1);
+    CHECK_EQ(usart->events, 0);
+}
+
+int main(void)
+{
+    printf("test_usart_cmsis_dma\n");
+    RUN_TEST(testSendAndReceive);
+    RUN_TEST(testAbort);
+    RUN_TEST(testPowerOffAborts);
+    return HostCheck_Result();
+}
@@ -79,6 +79,11 @@
 #include "fsl_lpuart.h"
 #endif /* FSL_FEATURE_SOC_LPUART_COUNT */
 
+#if (!SDK_DEBUGCONSOLE) && (defined(SDK_DEBUGCONSOLE_UART)) && DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE
+#include "fsl_dma_manager.h"
+#include "fsl_lpsci_dma.h"
+#endif
+
 #if defined(FSL_FEATURE_SOC_USB_COUNT) && (FSL_FEATURE_SOC_USB_COUNT > 0) && defined(BOARD_USE_VIRTUALCOM)
 #include "usb_device_config.h"
 #include "usb.h"
@@ -165,9 +170,36 @@ typedef struct DebugConsoleState
     debug_console_ops_t ops; /*!< Operation function pointers for debug UART operations. */
 } debug_console_state_t;
 
+#if (!SDK_DEBUGCONSOLE) && (defined(SDK_DEBUGCONSOLE_UART))
+/*! @brief RAM ring holding toolchain printf output until the peripheral takes it. */
+typedef struct DebugConsoleTxRing
+{
+    uint8_t buffer[DEBUG_CONSOLE_TX_RING_SIZE]; /*!< Queued output bytes. */
+    volatile uint16_t head;                     /*!< Index of the next byte written by printf. */
+    volatile uint16_t tail;                     /*!< Index of the next byte sent to the peripheral. */
+    volatile uint16_t inFlight; /*!< Bytes from tail on handed to the transmit interrupt, not yet sent. */
+    bool irqDriven;             /*!< An interrupt drains the ring, no polling needed. */
+    bool dmaDriven;             /*!< Runs are sent by DMA rather than by the LPSCI interrupt. */
+    volatile uint32_t dropCount; /*!< Bytes discarded by the overflow policy. */
+} debug_console_tx_ring_t;
+
+/*! @brief Drain the ring from the LPSCI transmit interrupt when the console is an LPSCI. */
+#if DEBUG_CONSOLE_TX_INTERRUPT && defined(FSL_FEATURE_SOC_LPSCI_COUNT) && (FSL_FEATURE_SOC_LPSCI_COUNT > 0)
+#define DEBUG_CONSOLE_TX_LPSCI_IRQ 1U
+#else
+#define DEBUG_CONSOLE_TX_LPSCI_IRQ 0U
+#endif
+#endif /* (!SDK_DEBUGCONSOLE) && (defined(SDK_DEBUGCONSOLE_UART)) */
+
 /*! @brief Type of KSDK printf function pointer. */
 typedef int (*PUTCHAR_FUNC)(int a);
 
+/*! @brief Type of KSDK printf output sink taking a run of characters. */
+typedef int (*PUTSPAN_FUNC)(const char *span, size_t length);
+
+/*! @brief Longest run of padding characters handed to the sink in one call. */
+#define PRINTF_PADDING_CHUNK 16U
+
 #if PRINTF_ADVANCED_ENABLE
 /*! @brief Specification modifier flags for printf. */
 enum _debugconsole_printf_flag
@@ -213,14 +245,42 @@ enum _debugconsole_scanf_flag
 /*! @brief Debug UART state information. */
 static debug_console_state_t s_debugConsole = {.type = DEBUG_CONSOLE_DEVICE_TYPE_NONE, .base = NULL, .ops = {{0}, {0}}};
 
+#if (!SDK_DEBUGCONSOLE) && (defined(SDK_DEBUGCONSOLE_UART))
+/*! @brief Toolchain printf output waiting for the peripheral. */
+static debug_console_tx_ring_t s_debugConsoleTxRing;
+
+#if DEBUG_CONSOLE_TX_LPSCI_IRQ
+/*! @brief LPSCI transactional handle sending spans of the ring and filling the receive ring. */
+static lpsci_handle_t s_debugConsoleLpsciHandle;
+
+/*! @brief Receive ring filled by the LPSCI interrupt once DbgConsole_StartRxRing is called. */
+static uint8_t s_debugConsoleRxRing[DEBUG_CONSOLE_RX_RING_SIZE];
+
+/*! @brief Received bytes lost because the receive ring or the receiver overflowed. */
+static volatile uint32_t s_debugConsoleRxOverrunCount;
+#endif /* DEBUG_CONSOLE_TX_LPSCI_IRQ */
+
+#if DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE
+/*! @brief DMA channel and LPSCI DMA handle sending spans of the ring once DMA is enabled. */
+static dma_handle_t s_debugConsoleTxDma;
+static lpsci_dma_handle_t s_debugConsoleTxDmaHandle;
+#endif /* DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE */
+#endif /* (!SDK_DEBUGCONSOLE) && (defined(SDK_DEBUGCONSOLE_UART)) */
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
 #if SDK_DEBUGCONSOLE
-static int DbgConsole_PrintfFormattedData(PUTCHAR_FUNC func_ptr, const char *fmt, va_list ap);
+static int DbgConsole_PrintfFormattedData(PUTSPAN_FUNC span_ptr, const char *fmt, va_list ap);
 static int DbgConsole_ScanfFormattedData(const char *line_ptr, char *format, va_list args_ptr);
 double modf(double input_dbl, double *intpart_ptr);
 #endif /* SDK_DEBUGCONSOLE */
+#if (!SDK_DEBUGCONSOLE) && (defined(SDK_DEBUGCONSOLE_UART)) && DEBUG_CONSOLE_TX_LPSCI_IRQ
+static void DbgConsole_LpsciCallback(UART0_Type *base, lpsci_handle_t *handle, status_t status, void *userData);
+#endif
+#if (!SDK_DEBUGCONSOLE) && (defined(SDK_DEBUGCONSOLE_UART)) && DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE
+static void DbgConsole_TxRingDmaCallback(UART0_Type *base, lpsci_dma_handle_t *handle, status_t status, void *userData);
+#endif
 
 /*******************************************************************************
  * Code
@@ -275,6 +335,11 @@ status_t DbgConsole_Init(uint32_t baseAddr, uint32_t baudRate, uint8_t device, u
             /* Set the function pointer for send and receive for this kind of device. */
             s_debugConsole.ops.tx_union.LPSCI_PutChar = LPSCI_WriteBlocking;
             s_debugConsole.ops.rx_union.LPSCI_GetChar = LPSCI_ReadBlocking;
+#if (!SDK_DEBUGCONSOLE) && (defined(SDK_DEBUGCONSOLE_UART)) && DEBUG_CONSOLE_TX_LPSCI_IRQ
+            /* Buffered printf output is drained by the transmit interrupt. */
+            LPSCI_TransferCreateHandle(s_debugConsole.base, &s_debugConsoleLpsciHandle, DbgConsole_LpsciCallback, NULL);
+            s_debugConsoleTxRing.irqDriven = true;
+#endif
         }
         break;
 #endif /* FSL_FEATURE_SOC_LPSCI_COUNT */
@@ -338,6 +403,11 @@ status_t DbgConsole_Deinit(void)
         return kStatus_Success;
     }
 
+#if (!SDK_DEBUGCONSOLE) && (defined(SDK_DEBUGCONSOLE_UART))
+    /* Do not lose output that is still queued. */
+    DbgConsole_Flush();
+#endif /* (!SDK_DEBUGCONSOLE) && (defined(SDK_DEBUGCONSOLE_UART)) */
+
     switch (s_debugConsole.type)
     {
 #if (defined(FSL_FEATURE_SOC_UART_COUNT) && (FSL_FEATURE_SOC_UART_COUNT > 0)) || \
@@ -388,6 +458,396 @@ status_t DbgConsole_Deinit(void)
     return kStatus_Success;
 }
 
+#if (!SDK_DEBUGCONSOLE) && (defined(SDK_DEBUGCONSOLE_UART))
+/*!
+ * @brief Checks whether the peripheral accepts a byte without blocking.
+ *
+ * Devices without a readable transmit flag report ready and are written blocking.
+ */
+static bool DbgConsole_TxReady(void)
+{
+    switch (s_debugConsole.type)
+    {
+#if (defined(FSL_FEATURE_SOC_UART_COUNT) && (FSL_FEATURE_SOC_UART_COUNT > 0)) || \
+    (defined(FSL_FEATURE_SOC_IUART_COUNT) && (FSL_FEATURE_SOC_IUART_COUNT > 0))
+        case DEBUG_CONSOLE_DEVICE_TYPE_UART:
+        case DEBUG_CONSOLE_DEVICE_TYPE_IUART:
+            return (UART_GetStatusFlags((UART_Type *)s_debugConsole.base) & kUART_TxDataRegEmptyFlag) != 0U;
+#endif /* FSL_FEATURE_SOC_UART_COUNT */
+#if defined(FSL_FEATURE_SOC_LPSCI_COUNT) && (FSL_FEATURE_SOC_LPSCI_COUNT > 0)
+        case DEBUG_CONSOLE_DEVICE_TYPE_LPSCI:
+            return (LPSCI_GetStatusFlags((UART0_Type *)s_debugConsole.base) & kLPSCI_TxDataRegEmptyFlag) != 0U;
+#endif /* FSL_FEATURE_SOC_LPSCI_COUNT */
+#if defined(FSL_FEATURE_SOC_LPUART_COUNT) && (FSL_FEATURE_SOC_LPUART_COUNT > 0)
+        case DEBUG_CONSOLE_DEVICE_TYPE_LPUART:
+            return (LPUART_GetStatusFlags((LPUART_Type *)s_debugConsole.base) & kLPUART_TxDataRegEmptyFlag) != 0U;
+#endif /* FSL_FEATURE_SOC_LPUART_COUNT */
+        default:
+            return true;
+    }
+}
+
+/*!
+ * @brief Returns the ring index following index.
+ */
+static inline uint16_t DbgConsole_TxRingNext(uint16_t index)
+{
+    return (index + 1U == DEBUG_CONSOLE_TX_RING_SIZE) ? 0U : (index + 1U);
+}
+
+/*!
+ * @brief Sends the oldest queued byte, waiting for the peripheral if needed.
+ */
+static void DbgConsole_TxRingSendOne(void)
+{
+    debug_console_tx_ring_t *ring = &s_debugConsoleTxRing;
+    uint16_t tail = ring->tail;
+
+    s_debugConsole.ops.tx_union.PutChar(s_debugConsole.base, &ring->buffer[tail], 1);
+    ring->tail = DbgConsole_TxRingNext(tail);
+}
+
+#if DEBUG_CONSOLE_TX_LPSCI_IRQ
+/*!
+ * @brief Hands the next contiguous run of queued bytes to the transmit interrupt.
+ *
+ * Must run with interrupts masked or from the LPSCI interrupt. A run ends at the ring end,
+ * the wrapped part follows as the next run.
+ */
+static void DbgConsole_TxRingStartSpan(void)
+{
+    debug_console_tx_ring_t *ring = &s_debugConsoleTxRing;
+    uint16_t head = ring->head;
+    uint16_t tail = ring->tail;
+    lpsci_transfer_t xfer;
+
+    if ((ring->inFlight != 0U) || (head == tail))
+    {
+        return;
+    }
+
+    xfer.data = &ring->buffer[tail];
+    xfer.dataSize = (head > tail) ? (head - tail) : (DEBUG_CONSOLE_TX_RING_SIZE - tail);
+    ring->inFlight = xfer.dataSize;
+#if DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE
+    if (ring->dmaDriven)
+    {
+        /* One DMA completion interrupt per run instead of one interrupt per byte. */
+        LPSCI_TransferSendDMA((UART0_Type *)s_debugConsole.base, &s_debugConsoleTxDmaHandle, &xfer);
+        return;
+    }
+#endif /* DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE */
+    LPSCI_TransferSendNonBlocking((UART0_Type *)s_debugConsole.base, &s_debugConsoleLpsciHandle, &xfer);
+}
+
+/*!
+ * @brief Releases a sent run and starts the next one.
+ */
+static void DbgConsole_TxRingSpanDone(void)
+{
+    debug_console_tx_ring_t *ring = &s_debugConsoleTxRing;
+    uint32_t tail;
+
+    tail = ring->tail + ring->inFlight;
+    ring->tail = (tail >= DEBUG_CONSOLE_TX_RING_SIZE) ? (tail - DEBUG_CONSOLE_TX_RING_SIZE) : tail;
+    ring->inFlight = 0U;
+    DbgConsole_TxRingStartSpan();
+}
+
+static void DbgConsole_LpsciCallback(UART0_Type *base, lpsci_handle_t *handle, status_t status, void *userData)
+{
+    if (status == kStatus_LPSCI_TxIdle)
+    {
+        DbgConsole_TxRingSpanDone();
+    }
+    else if ((status == kStatus_LPSCI_RxRingBufferOverrun) || (status == kStatus_LPSCI_RxHardwareOverrun))
+    {
+        s_debugConsoleRxOverrunCount++;
+    }
+}
+
+#if DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE
+static void DbgConsole_TxRingDmaCallback(UART0_Type *base, lpsci_dma_handle_t *handle, status_t status, void *userData)
+{
+    if (status == kStatus_LPSCI_TxIdle)
+    {
+        DbgConsole_TxRingSpanDone();
+    }
+}
+#endif /* DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE */
+#endif /* DEBUG_CONSOLE_TX_LPSCI_IRQ */
+
+#if DEBUG_CONSOLE_TX_LPSCI_IRQ
+/*!
+ * @brief Runs the handler of whichever interrupt drains the ring if its event is pending.
+ */
+static void DbgConsole_TxRingServiceIRQ(void)
+{
+#if DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE
+    if (s_debugConsoleTxRing.dmaDriven)
+    {
+        if (DMA_GetChannelStatusFlags(s_debugConsoleTxDma.base, s_debugConsoleTxDma.channel) &
+            kDMA_TransactionsDoneFlag)
+        {
+            DMA_HandleIRQ(&s_debugConsoleTxDma);
+            /* DONE is clear now, the interrupt it latched would release the next run as well. */
+            NVIC_ClearPendingIRQ((IRQn_Type)(DMA0_IRQn + s_debugConsoleTxDma.channel));
+        }
+        return;
+    }
+#endif /* DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE */
+
+    if (DbgConsole_TxReady())
+    {
+        LPSCI_TransferHandleIRQ((UART0_Type *)s_debugConsole.base, &s_debugConsoleLpsciHandle);
+    }
+}
+#endif /* DEBUG_CONSOLE_TX_LPSCI_IRQ */
+
+/*!
+ * @brief Moves queued bytes towards the peripheral without waiting.
+ */
+static void DbgConsole_TxRingKick(void)
+{
+#if DEBUG_CONSOLE_TX_LPSCI_IRQ
+    uint32_t primask;
+
+    if (s_debugConsoleTxRing.irqDriven)
+    {
+        primask = DisableGlobalIRQ();
+        DbgConsole_TxRingStartSpan();
+        EnableGlobalIRQ(primask);
+        return;
+    }
+#endif /* DEBUG_CONSOLE_TX_LPSCI_IRQ */
+
+    while ((s_debugConsoleTxRing.tail != s_debugConsoleTxRing.head) && DbgConsole_TxReady())
+    {
+        DbgConsole_TxRingSendOne();
+    }
+}
+
+/*!
+ * @brief Waits until at least one queued byte has left the ring.
+ *
+ * In interrupt mode the caller may itself be masked or running at a priority that keeps the
+ * LPSCI interrupt out, so the handler is serviced by hand with interrupts masked.
+ */
+static void DbgConsole_TxRingWaitProgress(void)
+{
+#if DEBUG_CONSOLE_TX_LPSCI_IRQ
+    uint32_t primask;
+
+    if (s_debugConsoleTxRing.irqDriven)
+    {
+        primask = DisableGlobalIRQ();
+        DbgConsole_TxRingStartSpan();
+        DbgConsole_TxRingServiceIRQ();
+        EnableGlobalIRQ(primask);
+        return;
+    }
+#endif /* DEBUG_CONSOLE_TX_LPSCI_IRQ */
+
+    DbgConsole_TxRingSendOne();
+}
+
+/*!
+ * @brief Makes room for one byte in a full ring according to DEBUG_CONSOLE_TX_OVERFLOW_POLICY.
+ *
+ * @return false if the byte has to be dropped.
+ */
+static bool DbgConsole_TxRingMakeRoom(void)
+{
+    debug_console_tx_ring_t *ring = &s_debugConsoleTxRing;
+
+#if (DEBUG_CONSOLE_TX_OVERFLOW_POLICY == DEBUG_CONSOLE_TX_OVERFLOW_DROP)
+    (void)ring;
+    return false;
+#elif (DEBUG_CONSOLE_TX_OVERFLOW_POLICY == DEBUG_CONSOLE_TX_OVERFLOW_DROP_OLDEST)
+    uint32_t primask;
+    uint32_t keep;
+    uint32_t queued;
+    bool room;
+
+    /* Discard the backlog behind the run already handed to the peripheral. */
+    primask = DisableGlobalIRQ();
+    keep = ring->tail + ring->inFlight;
+    keep = (keep >= DEBUG_CONSOLE_TX_RING_SIZE) ? (keep - DEBUG_CONSOLE_TX_RING_SIZE) : keep;
+    queued = (ring->head >= keep) ? (ring->head - keep) : (ring->head + DEBUG_CONSOLE_TX_RING_SIZE - keep);
+    ring->head = keep;
+    ring->dropCount += queued;
+    room = (DbgConsole_TxRingNext(ring->head) != ring->tail);
+    EnableGlobalIRQ(primask);
+
+    return room;
+#else
+    while (DbgConsole_TxRingNext(ring->head) == ring->tail)
+    {
+        DbgConsole_TxRingWaitProgress();
+    }
+    return true;
+#endif /* DEBUG_CONSOLE_TX_OVERFLOW_POLICY */
+}
+
+/*!
+ * @brief Queues toolchain printf output and starts sending it.
+ */
+static void DbgConsole_TxRingWrite(const uint8_t *buffer, size_t length)
+{
+    debug_console_tx_ring_t *ring = &s_debugConsoleTxRing;
+
+    while (length)
+    {
+        uint16_t head = ring->head;
+        uint16_t next = DbgConsole_TxRingNext(head);
+
+        if ((next == ring->tail) && !DbgConsole_TxRingMakeRoom())
+        {
+            ring->dropCount += length;
+            break;
+        }
+        /* Make room may have moved head back. */
+        head = ring->head;
+        ring->buffer[head] = *buffer++;
+        ring->head = DbgConsole_TxRingNext(head);
+        length--;
+    }
+
+    DbgConsole_TxRingKick();
+}
+
+/* See fsl_debug_console.h for documentation of this function. */
+bool DbgConsole_TryFlush(void)
+{
+    if (s_debugConsole.type == DEBUG_CONSOLE_DEVICE_TYPE_NONE)
+    {
+        return false;
+    }
+
+    DbgConsole_TxRingKick();
+
+    return (!s_debugConsoleTxRing.irqDriven) && (s_debugConsoleTxRing.tail != s_debugConsoleTxRing.head);
+}
+
+/* See fsl_debug_console.h for documentation of this function. */
+status_t DbgConsole_Flush(void)
+{
+    debug_console_tx_ring_t *ring = &s_debugConsoleTxRing;
+
+    if (s_debugConsole.type == DEBUG_CONSOLE_DEVICE_TYPE_NONE)
+    {
+        return kStatus_Fail;
+    }
+
+    while (ring->tail != ring->head)
+    {
+        DbgConsole_TxRingWaitProgress();
+    }
+
+    return kStatus_Success;
+}
+
+/* See fsl_debug_console.h for documentation of this function. */
+uint32_t DbgConsole_GetTxDropCount(void)
+{
+    return s_debugConsoleTxRing.dropCount;
+}
+
+#if DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE
+/* See fsl_debug_console.h for documentation of this function. */
+status_t DbgConsole_EnableTxDMA(uint32_t channel, uint32_t request)
+{
+    dmamgr_channel_config_t config;
+    status_t status;
+    uint32_t primask;
+
+    if ((s_debugConsole.type != DEBUG_CONSOLE_DEVICE_TYPE_LPSCI) || (!s_debugConsoleTxRing.irqDriven))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    /* Let the run owned by the LPSCI interrupt finish before DMA takes over. */
+    DbgConsole_Flush();
+
+    /* Console output only costs latency, leave the channels that win arbitration to others. */
+    DMAMGR_GetDefaultChannelConfig(&config);
+    config.requestSource = request;
+    config.channel = channel;
+    config.priority = kDMAMGR_PriorityLow;
+    status = DMAMGR_RequestChannel(&s_debugConsoleTxDma, &config);
+    if (status != kStatus_Success)
+    {
+        return status;
+    }
+    /* The DMA completion takes over from the LPSCI transmit interrupt, at the same priority. */
+    NVIC_SetPriority((IRQn_Type)(DMA0_IRQn + s_debugConsoleTxDma.channel), NVIC_GetPriority(UART0_IRQn));
+    LPSCI_TransferCreateHandleDMA((UART0_Type *)s_debugConsole.base, &s_debugConsoleTxDmaHandle,
+                                  DbgConsole_TxRingDmaCallback, NULL, &s_debugConsoleTxDma, NULL);
+
+    primask = DisableGlobalIRQ();
+    s_debugConsoleTxRing.dmaDriven = true;
+    EnableGlobalIRQ(primask);
+
+    return kStatus_Success;
+}
+#endif /* DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE */
+
+/* See fsl_debug_console.h for documentation of this function. */
+status_t DbgConsole_StartRxRing(void)
+{
+#if DEBUG_CONSOLE_TX_LPSCI_IRQ
+    if ((s_debugConsole.type != DEBUG_CONSOLE_DEVICE_TYPE_LPSCI) || (!s_debugConsoleTxRing.irqDriven))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    LPSCI_TransferStartRingBuffer((UART0_Type *)s_debugConsole.base, &s_debugConsoleLpsciHandle, s_debugConsoleRxRing,
+                                  sizeof(s_debugConsoleRxRing));
+
+    return kStatus_Success;
+#else
+    return kStatus_InvalidArgument;
+#endif /* DEBUG_CONSOLE_TX_LPSCI_IRQ */
+}
+
+/* See fsl_debug_console.h for documentation of this function. */
+size_t DbgConsole_ReadNonBlocking(uint8_t *buffer, size_t length)
+{
+#if DEBUG_CONSOLE_TX_LPSCI_IRQ
+    lpsci_transfer_t xfer;
+    size_t received = 0U;
+
+    if ((s_debugConsole.type != DEBUG_CONSOLE_DEVICE_TYPE_LPSCI) || (s_debugConsoleLpsciHandle.rxRingBuffer == NULL))
+    {
+        return 0U;
+    }
+
+    /* Never ask for more than the ring holds, so no receive is left pending on the handle. */
+    xfer.data = buffer;
+    xfer.dataSize = MIN(length, LPSCI_TransferGetRxRingBufferLength(&s_debugConsoleLpsciHandle));
+    if (xfer.dataSize)
+    {
+        LPSCI_TransferReceiveNonBlocking((UART0_Type *)s_debugConsole.base, &s_debugConsoleLpsciHandle, &xfer,
+                                         &received);
+    }
+
+    return received;
+#else
+    return 0U;
+#endif /* DEBUG_CONSOLE_TX_LPSCI_IRQ */
+}
+
+/* See fsl_debug_console.h for documentation of this function. */
+uint32_t DbgConsole_GetRxOverrunCount(void)
+{
+#if DEBUG_CONSOLE_TX_LPSCI_IRQ
+    return s_debugConsoleRxOverrunCount;
+#else
+    return 0U;
+#endif /* DEBUG_CONSOLE_TX_LPSCI_IRQ */
+}
+#endif /* (!SDK_DEBUGCONSOLE) && (defined(SDK_DEBUGCONSOLE_UART)) */
+
 #if SDK_DEBUGCONSOLE
 /* See fsl_debug_console.h for documentation of this function. */
 int DbgConsole_Printf(const char *fmt_s, ...)
@@ -401,12 +861,28 @@ int DbgConsole_Printf(const char *fmt_s, ...)
         return -1;
     }
     va_start(ap, fmt_s);
-    result = DbgConsole_PrintfFormattedData(DbgConsole_Putchar, fmt_s, ap);
+    result = DbgConsole_PrintfFormattedData(DbgConsole_WriteSpan, fmt_s, ap);
     va_end(ap);
 
     return result;
 }
 
+/* See fsl_debug_console.h for documentation of this function. */
+int DbgConsole_WriteSpan(const char *span, size_t length)
+{
+    /* Do nothing if the debug UART is not initialized. */
+    if (s_debugConsole.type == DEBUG_CONSOLE_DEVICE_TYPE_NONE)
+    {
+        return -1;
+    }
+    if (length)
+    {
+        s_debugConsole.ops.tx_union.PutChar(s_debugConsole.base, (const uint8_t *)span, length);
+    }
+
+    return (int)length;
+}
+
 /* See fsl_debug_console.h for documentation of this function. */
 int DbgConsole_Putchar(int ch)
 {
@@ -509,30 +985,97 @@ static uint32_t DbgConsole_ScanIgnoreWhiteSpace(const char **s)
     return count;
 }
 
+/*!
+ * @brief This function puts one character through the span sink.
+ *
+ * @param[in] c         Character to put out.
+ * @param[in] span_ptr  Function to put characters out.
+ */
+static inline void DbgConsole_PrintfCharacter(char c, PUTSPAN_FUNC span_ptr)
+{
+    span_ptr(&c, 1);
+}
+
 /*!
  * @brief This function puts padding character.
  *
- * @param[in] c         Padding character.
+ * @param[in] c         Padding character, '0' or ' '.
  * @param[in] curlen    Length of current formatted string .
  * @param[in] width     Width of expected formatted string.
  * @param[in] count     Number of characters.
- * @param[in] func_ptr  Function to put character out.
+ * @param[in] span_ptr  Function to put characters out.
  */
 static void DbgConsole_PrintfPaddingCharacter(
-    char c, int32_t curlen, int32_t width, int32_t *count, PUTCHAR_FUNC func_ptr)
+    char c, int32_t curlen, int32_t width, int32_t *count, PUTSPAN_FUNC span_ptr)
 {
-    int32_t i;
+    static const char s_zeroPadding[PRINTF_PADDING_CHUNK] = {'0', '0', '0', '0', '0', '0', '0', '0',
+                                                              '0', '0', '0', '0', '0', '0', '0', '0'};
+    static const char s_spacePadding[PRINTF_PADDING_CHUNK] = {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ',
+                                                               ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '};
+    const char *padding = (c == '0') ? s_zeroPadding : s_spacePadding;
+    int32_t remaining = width - curlen;
+    int32_t chunk;
+
+    while (remaining > 0)
+    {
+        chunk = (remaining > (int32_t)PRINTF_PADDING_CHUNK) ? (int32_t)PRINTF_PADDING_CHUNK : remaining;
+        span_ptr(padding, chunk);
+        *count += chunk;
+        remaining -= chunk;
+    }
+}
 
-    for (i = curlen; i < width; i++)
+#if PRINTF_ADVANCED_ENABLE
+/*! @brief Widest integer the printf conversions handle. */
+typedef uint64_t printf_uint_t;
+typedef int64_t printf_int_t;
+#else
+typedef uint32_t printf_uint_t;
+typedef int32_t printf_int_t;
+#endif /* PRINTF_ADVANCED_ENABLE */
+
+/*!
+ * @brief Divides by ten with shifts and adds only.
+ *
+ * Cortex-M0+ has no divide instruction, so '/' and '%' become library calls per digit.
+ * The quotient estimate n * 0.8 / 8 is built from shifted sums and is at most one too small;
+ * the remainder check corrects it.
+ *
+ * @param[in]  n    Dividend.
+ * @param[out] rem  Remainder, 0..9.
+ *
+ * @return n / 10.
+ */
+static inline printf_uint_t DbgConsole_DivideBy10(printf_uint_t n, uint32_t *rem)
+{
+    printf_uint_t q;
+    uint32_t r;
+
+    q = (n >> 1) + (n >> 2);
+    q += (q >> 4);
+    q += (q >> 8);
+    q += (q >> 16);
+#if PRINTF_ADVANCED_ENABLE
+    q += (q >> 32);
+#endif /* PRINTF_ADVANCED_ENABLE */
+    q >>= 3;
+    r = (uint32_t)(n - ((q << 3) + (q << 1)));
+    while (r > 9U)
     {
-        func_ptr(c);
-        (*count)++;
+        q++;
+        r -= 10U;
     }
+    *rem = r;
+    return q;
 }
 
 /*!
  * @brief Converts a radix number to a string and return its length.
  *
+ * The digits are stored least significant first after a leading '\0'. Power of two radixes
+ * are split with shifts and masks, radix 10 with DbgConsole_DivideBy10, so no digit needs a
+ * division.
+ *
  * @param[in] numstr    Converted string of the number.
  * @param[in] nump      Pointer to the number.
  * @param[in] neg       Polarity of the number.
@@ -543,24 +1086,11 @@ static void DbgConsole_PrintfPaddingCharacter(
  */
 static int32_t DbgConsole_ConvertRadixNumToString(char *numstr, void *nump, int32_t neg, int32_t radix, bool use_caps)
 {
-#if PRINTF_ADVANCED_ENABLE
-    int64_t a;
-    int64_t b;
-    int64_t c;
-
-    uint64_t ua;
-    uint64_t ub;
-    uint64_t uc;
-#else
-    int32_t a;
-    int32_t b;
-    int32_t c;
-
-    uint32_t ua;
-    uint32_t ub;
-    uint32_t uc;
-#endif /* PRINTF_ADVANCED_ENABLE */
-
+    const char *digits = use_caps ? "0123456789ABCDEF" : "0123456789abcdef";
+    printf_uint_t ua;
+    uint32_t shift;
+    uint32_t mask;
+    uint32_t rem;
     int32_t nlen;
     char *nstrp;
 
@@ -570,80 +1100,55 @@ static int32_t DbgConsole_ConvertRadixNumToString(char *numstr, void *nump, int3
 
     if (neg)
     {
-#if PRINTF_ADVANCED_ENABLE
-        a = *(int64_t *)nump;
-#else
-        a = *(int32_t *)nump;
-#endif /* PRINTF_ADVANCED_ENABLE */
-        if (a == 0)
-        {
-            *nstrp = '0';
-            ++nlen;
-            return nlen;
-        }
-        while (a != 0)
-        {
-#if PRINTF_ADVANCED_ENABLE
-            b = (int64_t)a / (int64_t)radix;
-            c = (int64_t)a - ((int64_t)b * (int64_t)radix);
-            if (c < 0)
-            {
-                uc = (uint64_t)c;
-                c = (int64_t)(~uc) + 1 + '0';
-            }
-#else
-            b = a / radix;
-            c = a - (b * radix);
-            if (c < 0)
-            {
-                uc = (uint32_t)c;
-                c = (uint32_t)(~uc) + 1 + '0';
-            }
-#endif /* PRINTF_ADVANCED_ENABLE */
-            else
-            {
-                c = c + '0';
-            }
-            a = b;
-            *nstrp++ = (char)c;
-            ++nlen;
-        }
+        printf_int_t a = *(printf_int_t *)nump;
+
+        /* Digits of the magnitude only, the sign is put out by the caller. */
+        ua = (a < 0) ? ((printf_uint_t)0U - (printf_uint_t)a) : (printf_uint_t)a;
     }
     else
     {
-#if PRINTF_ADVANCED_ENABLE
-        ua = *(uint64_t *)nump;
-#else
-        ua = *(uint32_t *)nump;
-#endif /* PRINTF_ADVANCED_ENABLE */
-        if (ua == 0)
-        {
-            *nstrp = '0';
-            ++nlen;
-            return nlen;
-        }
-        while (ua != 0)
-        {
-#if PRINTF_ADVANCED_ENABLE
-            ub = (uint64_t)ua / (uint64_t)radix;
-            uc = (uint64_t)ua - ((uint64_t)ub * (uint64_t)radix);
-#else
-            ub = ua / (uint32_t)radix;
-            uc = ua - (ub * (uint32_t)radix);
-#endif /* PRINTF_ADVANCED_ENABLE */
+        ua = *(printf_uint_t *)nump;
+    }
 
-            if (uc < 10)
+    if (ua == 0U)
+    {
+        *nstrp = '0';
+        ++nlen;
+        return nlen;
+    }
+
+    switch (radix)
+    {
+        case 2:
+        case 8:
+        case 16:
+            shift = (radix == 16) ? 4U : ((radix == 8) ? 3U : 1U);
+            mask = (uint32_t)radix - 1U;
+            while (ua != 0U)
             {
-                uc = uc + '0';
+                *nstrp++ = digits[(uint32_t)ua & mask];
+                ua >>= shift;
+                ++nlen;
             }
-            else
+            break;
+
+        case 10:
+            while (ua != 0U)
             {
-                uc = uc - 10 + (use_caps ? 'A' : 'a');
+                ua = DbgConsole_DivideBy10(ua, &rem);
+                *nstrp++ = (char)('0' + rem);
+                ++nlen;
             }
-            ua = ub;
-            *nstrp++ = (char)uc;
-            ++nlen;
-        }
+            break;
+
+        default:
+            while (ua != 0U)
+            {
+                *nstrp++ = digits[ua % (printf_uint_t)radix];
+                ua /= (printf_uint_t)radix;
+                ++nlen;
+            }
+            break;
     }
     return nlen;
 }
@@ -763,16 +1268,18 @@ static int32_t DbgConsole_ConvertFloatRadixNumToString(char *numstr,
 /*!
  * @brief This function outputs its parameters according to a formatted string.
  *
- * @note I/O is performed by calling given function pointer using following
- * (*func_ptr)(c);
+ * @note I/O is performed in runs by calling given function pointer using following
+ * (*span_ptr)(s, length);
+ * Literal text between conversions, converted numbers, strings and padding each go out as
+ * one run rather than one call per character.
  *
- * @param[in] func_ptr  Function to put character out.
+ * @param[in] span_ptr  Function to put characters out.
  * @param[in] fmt_ptr   Format string for printf.
  * @param[in] args_ptr  Arguments to printf.
  *
  * @return Number of characters
  */
-static int DbgConsole_PrintfFormattedData(PUTCHAR_FUNC func_ptr, const char *fmt, va_list ap)
+static int DbgConsole_PrintfFormattedData(PUTSPAN_FUNC span_ptr, const char *fmt, va_list ap)
 {
     /* va_list ap; */
     char *p;
@@ -818,8 +1325,14 @@ static int DbgConsole_PrintfFormattedData(PUTCHAR_FUNC func_ptr, const char *fmt
          */
         if (c != '%')
         {
-            func_ptr(c);
-            count++;
+            /* Put the whole run of literal text up to the next conversion at once. */
+            sval = p;
+            while ((p[1] != '%') && (p[1] != 0))
+            {
+                p++;
+            }
+            span_ptr(sval, (size_t)(p - sval) + 1U);
+            count += (p - sval) + 1;
             /* By using 'continue', the next iteration of the loop is used, skipping the code that follows. */
             continue;
         }
@@ -1007,22 +1520,22 @@ static int DbgConsole_PrintfFormattedData(PUTCHAR_FUNC func_ptr, const char *fmt
                     {
                         if (schar)
                         {
-                            func_ptr(schar);
+                            DbgConsole_PrintfCharacter(schar, span_ptr);
                             count++;
                         }
                         dschar = true;
 
-                        DbgConsole_PrintfPaddingCharacter('0', vlen, field_width, &count, func_ptr);
+                        DbgConsole_PrintfPaddingCharacter('0', vlen, field_width, &count, span_ptr);
                         vlen = field_width;
                     }
                     else
                     {
                         if (!(flags_used & kPRINTF_Minus))
                         {
-                            DbgConsole_PrintfPaddingCharacter(' ', vlen, field_width, &count, func_ptr);
+                            DbgConsole_PrintfPaddingCharacter(' ', vlen, field_width, &count, span_ptr);
                             if (schar)
                             {
-                                func_ptr(schar);
+                                DbgConsole_PrintfCharacter(schar, span_ptr);
                                 count++;
                             }
                             dschar = true;
@@ -1031,7 +1544,7 @@ static int DbgConsole_PrintfFormattedData(PUTCHAR_FUNC func_ptr, const char *fmt
                     /* The string was built in reverse order, now display in correct order. */
                     if ((!dschar) && schar)
                     {
-                        func_ptr(schar);
+                        DbgConsole_PrintfCharacter(schar, span_ptr);
                         count++;
                     }
 #endif /* PRINTF_ADVANCED_ENABLE */
@@ -1075,21 +1588,21 @@ static int DbgConsole_PrintfFormattedData(PUTCHAR_FUNC func_ptr, const char *fmt
                     {
                         if (schar)
                         {
-                            func_ptr(schar);
+                            DbgConsole_PrintfCharacter(schar, span_ptr);
                             count++;
                         }
                         dschar = true;
-                        DbgConsole_PrintfPaddingCharacter('0', vlen, field_width, &count, func_ptr);
+                        DbgConsole_PrintfPaddingCharacter('0', vlen, field_width, &count, span_ptr);
                         vlen = field_width;
                     }
                     else
                     {
                         if (!(flags_used & kPRINTF_Minus))
                         {
-                            DbgConsole_PrintfPaddingCharacter(' ', vlen, field_width, &count, func_ptr);
+                            DbgConsole_PrintfPaddingCharacter(' ', vlen, field_width, &count, span_ptr);
                             if (schar)
                             {
-                                func_ptr(schar);
+                                DbgConsole_PrintfCharacter(schar, span_ptr);
                                 count++;
                             }
                             dschar = true;
@@ -1097,7 +1610,7 @@ static int DbgConsole_PrintfFormattedData(PUTCHAR_FUNC func_ptr, const char *fmt
                     }
                     if ((!dschar) && schar)
                     {
-                        func_ptr(schar);
+                        DbgConsole_PrintfCharacter(schar, span_ptr);
                         count++;
                     }
 #endif /* PRINTF_ADVANCED_ENABLE */
@@ -1128,13 +1641,12 @@ static int DbgConsole_PrintfFormattedData(PUTCHAR_FUNC func_ptr, const char *fmt
                     {
                         if (flags_used & kPRINTF_Pound)
                         {
-                            func_ptr('0');
-                            func_ptr((use_caps ? 'X' : 'x'));
+                            span_ptr(use_caps ? "0X" : "0x", 2);
                             count += 2;
                             /*vlen += 2;*/
                             dschar = true;
                         }
-                        DbgConsole_PrintfPaddingCharacter('0', vlen, field_width, &count, func_ptr);
+                        DbgConsole_PrintfPaddingCharacter('0', vlen, field_width, &count, span_ptr);
                         vlen = field_width;
                     }
                     else
@@ -1145,11 +1657,10 @@ static int DbgConsole_PrintfFormattedData(PUTCHAR_FUNC func_ptr, const char *fmt
                             {
                                 vlen += 2;
                             }
-                            DbgConsole_PrintfPaddingCharacter(' ', vlen, field_width, &count, func_ptr);
+                            DbgConsole_PrintfPaddingCharacter(' ', vlen, field_width, &count, span_ptr);
                             if (flags_used & kPRINTF_Pound)
                             {
-                                func_ptr('0');
-                                func_ptr(use_caps ? 'X' : 'x');
+                                span_ptr(use_caps ? "0X" : "0x", 2);
                                 count += 2;
 
                                 dschar = true;
@@ -1159,8 +1670,7 @@ static int DbgConsole_PrintfFormattedData(PUTCHAR_FUNC func_ptr, const char *fmt
 
                     if ((flags_used & kPRINTF_Pound) && (!dschar))
                     {
-                        func_ptr('0');
-                        func_ptr(use_caps ? 'X' : 'x');
+                        span_ptr(use_caps ? "0X" : "0x", 2);
                         count += 2;
                         vlen += 2;
                     }
@@ -1200,40 +1710,48 @@ static int DbgConsole_PrintfFormattedData(PUTCHAR_FUNC func_ptr, const char *fmt
 #if PRINTF_ADVANCED_ENABLE
                     if (flags_used & kPRINTF_Zero)
                     {
-                        DbgConsole_PrintfPaddingCharacter('0', vlen, field_width, &count, func_ptr);
+                        DbgConsole_PrintfPaddingCharacter('0', vlen, field_width, &count, span_ptr);
                         vlen = field_width;
                     }
                     else
                     {
                         if (!(flags_used & kPRINTF_Minus))
                         {
-                            DbgConsole_PrintfPaddingCharacter(' ', vlen, field_width, &count, func_ptr);
+                            DbgConsole_PrintfPaddingCharacter(' ', vlen, field_width, &count, span_ptr);
                         }
                     }
 #endif /* PRINTF_ADVANCED_ENABLE */
                 }
 #if !PRINTF_ADVANCED_ENABLE
-                DbgConsole_PrintfPaddingCharacter(' ', vlen, field_width, &count, func_ptr);
+                DbgConsole_PrintfPaddingCharacter(' ', vlen, field_width, &count, span_ptr);
 #endif /* !PRINTF_ADVANCED_ENABLE */
                 if (vstrp != NULL)
                 {
-                    while (*vstrp)
+                    /* The digits were built in reverse order behind a leading '\0', turn them around in place. */
+                    char *first = &vstr[1];
+                    char *last = vstrp;
+                    int32_t ndigits = vstrp - vstr;
+
+                    while (first < last)
                     {
-                        func_ptr(*vstrp--);
-                        count++;
+                        char tmp = *first;
+                        *first++ = *last;
+                        *last-- = tmp;
                     }
+                    span_ptr(&vstr[1], ndigits);
+                    count += ndigits;
                 }
 #if PRINTF_ADVANCED_ENABLE
                 if (flags_used & kPRINTF_Minus)
                 {
-                    DbgConsole_PrintfPaddingCharacter(' ', vlen, field_width, &count, func_ptr);
+                    DbgConsole_PrintfPaddingCharacter(' ', vlen, field_width, &count, span_ptr);
                 }
 #endif /* PRINTF_ADVANCED_ENABLE */
             }
             else if (c == 'c')
             {
                 cval = (char)va_arg(ap, uint32_t);
-                func_ptr(cval);
+                DbgConsole_PrintfCharacter(cval, span_ptr);
                 count++;
             }
             else if (c == 's')
@@ -1257,29 +1775,29 @@ static int DbgConsole_PrintfFormattedData(PUTCHAR_FUNC func_ptr, const char *fmt
                     if (!(flags_used & kPRINTF_Minus))
 #endif /* PRINTF_ADVANCED_ENABLE */
                     {
-                        DbgConsole_PrintfPaddingCharacter(' ', vlen, field_width, &count, func_ptr);
+                        DbgConsole_PrintfPaddingCharacter(' ', vlen, field_width, &count, span_ptr);
                     }
 
 #if PRINTF_ADVANCED_ENABLE
                     if (valid_precision_width)
                     {
-                        while ((*sval) && (vlen > 0))
+                        cval = 0;
+                        while ((sval[cval]) && (vlen > 0))
                         {
-                            func_ptr(*sval++);
-                            count++;
+                            cval++;
                             vlen--;
                         }
+                        span_ptr(sval, cval);
+                        count += cval;
                         /* In case that vlen sval is shorter than vlen */
                         vlen = precision_width - vlen;
                     }
                     else
                     {
 #endif /* PRINTF_ADVANCED_ENABLE */
-                        while (*sval)
-                        {
-                            func_ptr(*sval++);
-                            count++;
-                        }
+                        /* vlen is strlen(sval) here. */
+                        span_ptr(sval, vlen);
+                        count += vlen;
 #if PRINTF_ADVANCED_ENABLE
                     }
 #endif /* PRINTF_ADVANCED_ENABLE */
@@ -1287,14 +1805,14 @@ static int DbgConsole_PrintfFormattedData(PUTCHAR_FUNC func_ptr, const char *fmt
 #if PRINTF_ADVANCED_ENABLE
                     if (flags_used & kPRINTF_Minus)
                     {
-                        DbgConsole_PrintfPaddingCharacter(' ', vlen, field_width, &count, func_ptr);
+                        DbgConsole_PrintfPaddingCharacter(' ', vlen, field_width, &count, span_ptr);
                     }
 #endif /* PRINTF_ADVANCED_ENABLE */
                 }
             }
             else
             {
-                func_ptr(c);
+                DbgConsole_PrintfCharacter(c, span_ptr);
                 count++;
             }
         }
@@ -1834,15 +2352,20 @@ int __attribute__((weak)) __sys_write(int handle, char *buffer, int size)
         return -1;
     }
 
+#if DEBUG_CONSOLE_TX_DISCARD
+    /* Output is compiled out: report it as written. */
+    return 0;
+#else
     /* Do nothing if the debug UART is not initialized. */
     if (s_debugConsole.type == DEBUG_CONSOLE_DEVICE_TYPE_NONE)
     {
         return -1;
     }
 
-    /* Send data. */
-    s_debugConsole.ops.tx_union.PutChar(s_debugConsole.base, (uint8_t *)buffer, size);
+    /* Queue data, the peripheral drains it behind the caller. */
+    DbgConsole_TxRingWrite((const uint8_t *)buffer, size);
     return 0;
+#endif /* DEBUG_CONSOLE_TX_DISCARD */
 }
 
 int __attribute__((weak)) __sys_readc(void)
@@ -1854,6 +2377,17 @@ int __attribute__((weak)) __sys_readc(void)
         return -1;
     }
 
+#if DEBUG_CONSOLE_TX_LPSCI_IRQ
+    /* Once the receive interrupt owns the data register, read through its ring. */
+    if (s_debugConsoleLpsciHandle.rxRingBuffer)
+    {
+        while (!DbgConsole_ReadNonBlocking((uint8_t *)&tmp, sizeof(tmp)))
+        {
+        }
+        return tmp;
+    }
+#endif /* DEBUG_CONSOLE_TX_LPSCI_IRQ */
+
     /* Receive data. */
     s_debugConsole.ops.rx_union.GetChar(s_debugConsole.base, (uint8_t *)&tmp, sizeof(tmp));
     return tmp;
@@ -1886,9 +2420,19 @@ int __attribute__((weak)) _write(int handle, char *buffer, int size)
         return -1;
     }
 
+#if (!SDK_DEBUGCONSOLE) && (defined(SDK_DEBUGCONSOLE_UART))
+#if DEBUG_CONSOLE_TX_DISCARD
+    return size;
+#else
+    /* Queue data, the peripheral drains it behind the caller. */
+    DbgConsole_TxRingWrite((const uint8_t *)buffer, size);
+    return size;
+#endif /* DEBUG_CONSOLE_TX_DISCARD */
+#else
     /* Send data. */
     s_debugConsole.ops.tx_union.PutChar(s_debugConsole.base, (uint8_t *)buffer, size);
     return size;
+#endif /* (!SDK_DEBUGCONSOLE) && (defined(SDK_DEBUGCONSOLE_UART)) */
 }
 
 int __attribute__((weak)) _read(int handle, char *buffer, int size)
@@ -64,6 +64,49 @@
 #include <stdio.h>
 #endif
 
+/*! @brief Definition to drop toolchain printf output instead of sending it to the console. */
+#ifndef DEBUG_CONSOLE_TX_DISCARD
+#define DEBUG_CONSOLE_TX_DISCARD 0U
+#endif /* DEBUG_CONSOLE_TX_DISCARD */
+
+/*! @brief Size of the RAM ring that buffers toolchain printf output for the console peripheral. */
+#ifndef DEBUG_CONSOLE_TX_RING_SIZE
+#define DEBUG_CONSOLE_TX_RING_SIZE 256U
+#endif /* DEBUG_CONSOLE_TX_RING_SIZE */
+
+/*! @brief Size of the receive ring filled by the LPSCI interrupt after DbgConsole_StartRxRing. */
+#ifndef DEBUG_CONSOLE_RX_RING_SIZE
+#define DEBUG_CONSOLE_RX_RING_SIZE 64U
+#endif
+
+/*! @brief Drain the printf ring from the transmit interrupt (LPSCI console) instead of by polling. */
+#ifndef DEBUG_CONSOLE_TX_INTERRUPT
+#define DEBUG_CONSOLE_TX_INTERRUPT 1U
+#endif /* DEBUG_CONSOLE_TX_INTERRUPT */
+
+/*! @brief The printf ring can be sent by DMA (see DbgConsole_EnableTxDMA) on this SoC. */
+#if DEBUG_CONSOLE_TX_INTERRUPT && defined(FSL_FEATURE_SOC_LPSCI_COUNT) && (FSL_FEATURE_SOC_LPSCI_COUNT > 0) && \
+    defined(FSL_FEATURE_SOC_DMA_COUNT) && (FSL_FEATURE_SOC_DMA_COUNT > 0) &&                              \
+    defined(FSL_FEATURE_SOC_DMAMUX_COUNT) && (FSL_FEATURE_SOC_DMAMUX_COUNT > 0)
+#define DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE 1U
+#else
+#define DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE 0U
+#endif
+
+#if DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE
+#include "fsl_dma_manager.h"
+#endif
+
+/*! @brief Debug console transmit ring overflow policies. */
+#define DEBUG_CONSOLE_TX_OVERFLOW_BLOCK 0U       /*!< Wait until the peripheral makes room. */
+#define DEBUG_CONSOLE_TX_OVERFLOW_DROP 1U        /*!< Discard the bytes that do not fit. */
+#define DEBUG_CONSOLE_TX_OVERFLOW_DROP_OLDEST 2U /*!< Discard the queued backlog to make room. */
+
+/*! @brief Policy applied when printf output does not fit into the transmit ring. */
+#ifndef DEBUG_CONSOLE_TX_OVERFLOW_POLICY
+#define DEBUG_CONSOLE_TX_OVERFLOW_POLICY DEBUG_CONSOLE_TX_OVERFLOW_BLOCK
+#endif /* DEBUG_CONSOLE_TX_OVERFLOW_POLICY */
+
 /*! @brief Definition to printf the float number. */
 #ifndef PRINTF_FLOAT_ENABLE
 #define PRINTF_FLOAT_ENABLE 0U
@@ -140,6 +183,75 @@ status_t DbgConsole_Init(uint32_t baseAddr, uint32_t baudRate, uint8_t device, u
  */
 status_t DbgConsole_Deinit(void);
 
+#if (!SDK_DEBUGCONSOLE) && (defined(SDK_DEBUGCONSOLE_UART))
+/*!
+ * @brief Moves buffered toolchain printf output to the peripheral without waiting.
+ *
+ * Starts the transmit interrupt, or when the console is polled, sends queued bytes for as
+ * long as the peripheral can take them immediately. Call it from the idle loop.
+ *
+ * @return true if bytes are still queued and need another call to make progress.
+ */
+bool DbgConsole_TryFlush(void);
+
+/*!
+ * @brief Waits until all buffered toolchain printf output has been handed to the peripheral.
+ *
+ * @return Indicates whether the flush was successful or not.
+ */
+status_t DbgConsole_Flush(void);
+
+/*!
+ * @brief Returns the number of printf output bytes discarded by the overflow policy.
+ */
+uint32_t DbgConsole_GetTxDropCount(void);
+
+#if DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE
+/*!
+ * @brief Sends buffered printf output by DMA instead of the LPSCI transmit interrupt.
+ *
+ * Each contiguous run of the ring becomes one DMA transfer, so the CPU takes one interrupt
+ * per run instead of one per byte. Call it after DbgConsole_Init on an LPSCI console.
+ *
+ * The DMA0 channel is taken from the DMA manager at low priority and its interrupt gets the
+ * priority of the LPSCI interrupt, so set that first.
+ *
+ * @param channel    DMA channel for the console, or DMAMGR_DYNAMIC_ALLOCATE.
+ * @param request    DMAMUX request source of the console transmitter.
+ * @retval kStatus_Success          Execution successfully
+ * @retval kStatus_InvalidArgument  The console is not an interrupt-driven LPSCI
+ * @retval kStatus_DMAMGR_ChannelOccupied, kStatus_DMAMGR_NoFreeChannel  No DMA channel for the console
+ */
+status_t DbgConsole_EnableTxDMA(uint32_t channel, uint32_t request);
+#endif /* DEBUG_CONSOLE_TX_LPSCI_DMA_AVAILABLE */
+
+/*!
+ * @brief Starts receiving console input into a RAM ring from the LPSCI receive interrupt.
+ *
+ * Input is then collected in the background and read with DbgConsole_ReadNonBlocking, so a
+ * command line can be served from the idle loop. Toolchain scanf/getchar read through the
+ * same ring afterwards.
+ *
+ * @retval kStatus_Success          Execution successfully
+ * @retval kStatus_InvalidArgument  The console is not an interrupt-driven LPSCI
+ */
+status_t DbgConsole_StartRxRing(void);
+
+/*!
+ * @brief Copies up to length received bytes out of the receive ring without waiting.
+ *
+ * @param buffer Destination of the received bytes.
+ * @param length Size of buffer.
+ * @return Number of bytes copied, 0 if nothing was pending or the ring is not started.
+ */
+size_t DbgConsole_ReadNonBlocking(uint8_t *buffer, size_t length);
+
+/*!
+ * @brief Returns how many times received console input was lost to a full ring or receiver overrun.
+ */
+uint32_t DbgConsole_GetRxOverrunCount(void);
+#endif /* (!SDK_DEBUGCONSOLE) && (defined(SDK_DEBUGCONSOLE_UART)) */
+
 #if SDK_DEBUGCONSOLE
 /*!
  * @brief Writes formatted output to the standard output stream.
@@ -151,6 +263,17 @@ status_t DbgConsole_Deinit(void);
  */
 int DbgConsole_Printf(const char *fmt_s, ...);
 
+/*!
+ * @brief Writes a run of characters to stdout.
+ *
+ * Call this function to write several characters with one call to the low level device.
+ *
+ * @param   span   Characters to be written.
+ * @param   length Number of characters.
+ * @return  Returns the number of characters written or a negative value if an error occurs.
+ */
+int DbgConsole_WriteSpan(const char *span, size_t length);
+
 /*!
  * @brief Writes a character to stdout.
  *